@@ -17,8 +17,13 @@
 #include "ptr.h"
 #include "simple-ref-count.h"
 
+#include <array>
+#include <cstring>
 #include <functional>
 #include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
 #include <typeinfo>
 #include <utility>
 #include <vector>
@@ -114,243 +119,510 @@ class CallbackImplBase : public SimpleRefCount<CallbackImplBase>
 
 /**
  * \ingroup callbackimpl
- * Abstract base class for CallbackComponent.
- * Provides equality test.
+ * A component of a callback, i.e., the callable object or a bound
+ * argument, as seen by the callback equality test.
  */
-class CallbackComponentBase
+struct CallbackComponent
 {
-  public:
-    /** Virtual destructor */
-    virtual ~CallbackComponentBase()
-    {
-    }
+    /** The component value. */
+    const void* value;
+    /** The component type. */
+    const std::type_info* type;
+    /**
+     * Compare the values of two components of this type, or \c nullptr if
+     * the values cannot be compared.
+     */
+    bool (*isEqual)(const void* a, const void* b);
 
     /**
-     * Equality test
+     * Describe a component.
      *
-     * \param [in] other CallbackComponent Ptr
-     * \return \c true if we are equal
+     * \tparam T \deduced The type of the component.
+     * \tparam isComparable Whether the component values can be compared with
+     *         operator!=; otherwise, the values of an empty type are equal,
+     *         and those of a type whose bytes represent its value are
+     *         compared byte by byte.
+     * \param [in] value The component.
+     * \return The component description.
      */
-    virtual bool IsEqual(std::shared_ptr<const CallbackComponentBase> other) const = 0;
+    template <bool isComparable = true, typename T>
+    static CallbackComponent Make(const T* value)
+    {
+        if constexpr (isComparable)
+        {
+            return {value, &typeid(T), [](const void* a, const void* b) {
+                        return !(*static_cast<const T*>(a) != *static_cast<const T*>(b));
+                    }};
+        }
+        else if constexpr (std::is_empty_v<T>)
+        {
+            // e.g., a lambda without captures, whose only byte is padding
+            return {value, &typeid(T), [](const void* a, const void* b) { return true; }};
+        }
+        else if constexpr (std::has_unique_object_representations_v<T>)
+        {
+            // e.g., a lambda: copies of the same lambda, with the same
+            // captures, are equal
+            return {value, &typeid(T), [](const void* a, const void* b) {
+                        return std::memcmp(a, b, sizeof(T)) == 0;
+                    }};
+        }
+        else
+        {
+            return {value, &typeid(T), nullptr};
+        }
+    }
 };
 
 /**
  * \ingroup callbackimpl
- * Stores a component of a callback, i.e., the callable object
- * or a bound argument. The purpose of this class is to test
- * the equality of the components of two callbacks.
+ * CallbackImpl class with varying numbers of argument types
  *
- * \tparam T The type of the callback component.
- * \tparam isComparable whether this callback component can be compared to others of the same type
+ * The concrete implementations store the callable object and the bound
+ * arguments, if any, in the same object; the call operator dispatches to
+ * them through a function pointer set at construction.
+ *
+ * \tparam R \explicit The return type of the Callback.
+ * \tparam UArgs \explicit The types of any arguments to the Callback.
  */
-template <typename T, bool isComparable = true>
-class CallbackComponent : public CallbackComponentBase
+template <typename R, typename... UArgs>
+class CallbackImpl : public CallbackImplBase
 {
   public:
     /**
-     * Constructor
+     * Function call operator.
      *
-     * \param [in] t The value of the callback component
+     * \param uargs The arguments to the Callback.
+     * \return Callback value
      */
-    CallbackComponent(const T& t)
-        : m_comp(t)
+    R operator()(UArgs... uargs) const
     {
+        return m_invoke(this, std::forward<UArgs>(uargs)...);
     }
 
     /**
-     * Equality test between the values of two components
-     *
-     * \param [in] other CallbackComponentBase Ptr
-     * \return \c true if we are equal
+     * Get the number of callback components.
+     * \return The number of components: the callable object and the bound arguments.
+     */
+    virtual std::size_t GetComponentCount() const = 0;
+
+    /**
+     * Get a callback component.
+     * \param [in] i The component index; the callable object comes first.
+     * \return The component.
      */
-    bool IsEqual(std::shared_ptr<const CallbackComponentBase> other) const override
+    virtual CallbackComponent GetComponent(std::size_t i) const = 0;
+
+    bool IsEqual(Ptr<const CallbackImplBase> other) const override
+    {
+        const auto otherDerived =
+            dynamic_cast<const CallbackImpl<R, UArgs...>*>(PeekPointer(other));
+
+        if (otherDerived == nullptr)
+        {
+            return false;
+        }
+
+        // if the two callback implementations are made of a distinct number of
+        // components, they are different
+        std::size_t n = GetComponentCount();
+        if (n != otherDerived->GetComponentCount())
+        {
+            return false;
+        }
+
+        for (std::size_t i = 0; i < n; i++)
+        {
+            CallbackComponent mine = GetComponent(i);
+            CallbackComponent theirs = otherDerived->GetComponent(i);
+            // the two functions are also equal if they are the same object,
+            // i.e., one callback is a copy of the other or was bound from it
+            if (i == 0 && mine.value == theirs.value)
+            {
+                continue;
+            }
+            if (*mine.type != *theirs.type || mine.isEqual == nullptr ||
+                !mine.isEqual(mine.value, theirs.value))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    std::string GetTypeid() const override
+    {
+        return DoGetTypeid();
+    }
+
+    /** \copydoc GetTypeid() */
+    static std::string DoGetTypeid()
     {
-        auto p = std::dynamic_pointer_cast<const CallbackComponent<T>>(other);
+        static std::vector<std::string> vec = {GetCppTypeid<R>(), GetCppTypeid<UArgs>()...};
+
+        static std::string id("CallbackImpl<");
+        for (auto& s : vec)
+        {
+            id.append(s + ",");
+        }
+        if (id.back() == ',')
+        {
+            id.pop_back();
+        }
+        id.push_back('>');
 
-        // other must have the same type and value as ours
-        return !(p == nullptr || p->m_comp != m_comp);
+        return id;
+    }
+
+  protected:
+    /** Signature of the function invoking the concrete implementation. */
+    typedef R (*Invoker)(const CallbackImpl*, UArgs...);
+
+    /**
+     * Constructor.
+     *
+     * \param [in] invoke The function invoking the concrete implementation.
+     */
+    CallbackImpl(Invoker invoke)
+        : m_invoke(invoke)
+    {
     }
 
   private:
-    T m_comp; //!< the value of the callback component
+    /// Invokes the concrete implementation
+    Invoker m_invoke;
 };
 
 /**
  * \ingroup callbackimpl
- * Partial specialization of class CallbackComponent with isComparable equal
- * to false. This is required to handle callable objects (such as lambdas and
- * objects returned by std::function and std::bind) that do not provide the
- * equality operator. Given that these objects cannot be compared and the only
- * purpose of the class CallbackComponent is to compare values, no object is
- * stored in this specialized class.
- *
- * \tparam T The type of the callback component.
+ * Invoke a callable object with its bound arguments, converting the
+ * result to the callback return type.
+ *
+ * The bound arguments are copied, so that they outlive the call even if
+ * the callback is released by the callable object (e.g., an object bound
+ * by Ptr and deallocated by the member function invoked on it), unless
+ * the callable object takes them by non-const reference.
+ *
+ * \tparam R \explicit The return type of the Callback.
+ * \tparam F \deduced The type of the callable object.
+ * \tparam BArgs \deduced The types of the bound arguments.
+ * \tparam UArgs \deduced The types of the arguments to the Callback.
+ * \param [in] func The callable object.
+ * \param [in] bargs The bound arguments.
+ * \param [in] uargs The arguments to the Callback.
+ * \return The return value of the callable object.
  */
-template <typename T>
-class CallbackComponent<T, false> : public CallbackComponentBase
+template <typename R, typename F, typename... BArgs, typename... UArgs>
+R
+CallbackInvoke(F& func, std::tuple<BArgs...>& bargs, UArgs&&... uargs)
+{
+    return std::apply(
+        [&func, &uargs...](BArgs&... bargs) -> R {
+            if constexpr (std::is_invocable_v<F&, BArgs..., UArgs...>)
+            {
+                return static_cast<R>(
+                    std::invoke(func, BArgs(bargs)..., std::forward<UArgs>(uargs)...));
+            }
+            else
+            {
+                return static_cast<R>(
+                    std::invoke(func, bargs..., std::forward<UArgs>(uargs)...));
+            }
+        },
+        bargs);
+}
+
+/**
+ * \ingroup callbackimpl
+ * Describe the bound arguments of a callback.
+ *
+ * \tparam BArgs \deduced The types of the bound arguments.
+ * \param [in] bargs The bound arguments.
+ * \param [in] i The index of the bound argument.
+ * \return The component.
+ */
+template <typename... BArgs>
+CallbackComponent
+GetBoundCallbackComponent(const std::tuple<BArgs...>& bargs, std::size_t i)
+{
+    return std::apply(
+        [i](const BArgs&... bargs) {
+            std::array<CallbackComponent, sizeof...(BArgs)> components{
+                CallbackComponent::Make(&bargs)...};
+            return components.at(i);
+        },
+        bargs);
+}
+
+/**
+ * \ingroup callbackimpl
+ * CallbackImpl storing a callable object and the values of its bound
+ * arguments, if any.
+ *
+ * \tparam Signature \explicit The signature of the Callback.
+ * \tparam T \explicit The type of the callable object.
+ * \tparam BArgs \explicit The types of the bound arguments.
+ */
+template <typename Signature, typename T, typename... BArgs>
+class CallbackFunctorImpl;
+
+/**
+ * \ingroup callbackimpl
+ * \copydoc CallbackFunctorImpl
+ *
+ * \tparam R \explicit The return type of the Callback.
+ * \tparam UArgs \explicit The types of any arguments to the Callback.
+ */
+template <typename R, typename... UArgs, typename T, typename... BArgs>
+class CallbackFunctorImpl<R(UArgs...), T, BArgs...> final : public CallbackImpl<R, UArgs...>
 {
   public:
     /**
-     * Constructor
+     * Constructor.
      *
-     * \param [in] t The value of the callback component
+     * \param [in] func The callable object.
+     * \param [in] bargs The values of the bound arguments.
      */
-    CallbackComponent(const T& t)
+    CallbackFunctorImpl(const T& func, const BArgs&... bargs)
+        : CallbackImpl<R, UArgs...>(&DoInvoke),
+          m_func(func),
+          m_bargs(bargs...)
     {
     }
 
+    std::size_t GetComponentCount() const override
+    {
+        return 1 + sizeof...(BArgs);
+    }
+
+    CallbackComponent GetComponent(std::size_t i) const override
+    {
+        // The original function is comparable if it is a function pointer or
+        // a pointer to a member function or a pointer to a member data.
+        constexpr bool isComp =
+            std::is_function_v<std::remove_pointer_t<T>> || std::is_member_pointer_v<T>;
+
+        if (i == 0)
+        {
+            return CallbackComponent::Make<isComp>(&m_func);
+        }
+        return GetBoundCallbackComponent(m_bargs, i - 1);
+    }
+
+  private:
     /**
-     * Equality test between functions
+     * Invoke the callable object.
      *
-     * \param [in] other CallbackParam Ptr
-     * \return \c true if we are equal
+     * \param [in] impl This object.
+     * \param [in] uargs The arguments to the Callback.
+     * \return Callback value
      */
-    bool IsEqual(std::shared_ptr<const CallbackComponentBase> other) const override
+    static R DoInvoke(const CallbackImpl<R, UArgs...>* impl, UArgs... uargs)
     {
-        return false;
+        auto self = static_cast<const CallbackFunctorImpl*>(impl);
+        return CallbackInvoke<R>(self->m_func, self->m_bargs, std::forward<UArgs>(uargs)...);
     }
+
+    /// The callable object; stateful lambdas may modify their state
+    mutable T m_func;
+    /// The values of the bound arguments, which the callable object may modify
+    mutable std::tuple<BArgs...> m_bargs;
 };
 
-/// Vector of callback components
-typedef std::vector<std::shared_ptr<CallbackComponentBase>> CallbackComponentVector;
+/**
+ * \ingroup callbackimpl
+ * CallbackImpl binding the first arguments of another CallbackImpl.
+ *
+ * \tparam Signature \explicit The signature of the Callback.
+ * \tparam Impl \explicit The type of the CallbackImpl whose arguments are bound.
+ * \tparam BArgs \explicit The types of the bound arguments.
+ */
+template <typename Signature, typename Impl, typename... BArgs>
+class CallbackBoundImpl;
 
 /**
  * \ingroup callbackimpl
- * CallbackImpl class with varying numbers of argument types
+ * \copydoc CallbackBoundImpl
  *
  * \tparam R \explicit The return type of the Callback.
  * \tparam UArgs \explicit The types of any arguments to the Callback.
  */
-template <typename R, typename... UArgs>
-class CallbackImpl : public CallbackImplBase
+template <typename R, typename... UArgs, typename Impl, typename... BArgs>
+class CallbackBoundImpl<R(UArgs...), Impl, BArgs...> final : public CallbackImpl<R, UArgs...>
 {
   public:
     /**
      * Constructor.
      *
-     * \param func the callable object
-     * \param components the callback components (callable object and bound arguments)
+     * \param [in] impl The CallbackImpl whose arguments are bound.
+     * \param [in] bargs The values of the bound arguments.
      */
-    CallbackImpl(std::function<R(UArgs...)> func, const CallbackComponentVector& components)
-        : m_func(func),
-          m_components(components)
+    CallbackBoundImpl(Ptr<Impl> impl, const BArgs&... bargs)
+        : CallbackImpl<R, UArgs...>(&DoInvoke),
+          m_impl(impl),
+          m_bargs(bargs...)
     {
     }
 
-    /**
-     * Get the stored function.
-     * \return A const reference to the stored function.
-     */
-    const std::function<R(UArgs...)>& GetFunction() const
+    std::size_t GetComponentCount() const override
     {
-        return m_func;
+        return m_impl->GetComponentCount() + sizeof...(BArgs);
     }
 
-    /**
-     * Get the vector of callback components.
-     * \return A const reference to the vector of callback components.
-     */
-    const CallbackComponentVector& GetComponents() const
+    CallbackComponent GetComponent(std::size_t i) const override
     {
-        return m_components;
+        std::size_t n = m_impl->GetComponentCount();
+        if (i < n)
+        {
+            return m_impl->GetComponent(i);
+        }
+        return GetBoundCallbackComponent(m_bargs, i - n);
     }
 
+  private:
     /**
-     * Function call operator.
+     * Invoke the CallbackImpl whose arguments are bound.
      *
-     * \param uargs The arguments to the Callback.
+     * \param [in] impl This object.
+     * \param [in] uargs The arguments to the Callback.
      * \return Callback value
      */
-    R operator()(UArgs... uargs) const
+    static R DoInvoke(const CallbackImpl<R, UArgs...>* impl, UArgs... uargs)
     {
-        return m_func(uargs...);
+        auto self = static_cast<const CallbackBoundImpl*>(impl);
+        return CallbackInvoke<R>(*self->m_impl, self->m_bargs, std::forward<UArgs>(uargs)...);
     }
 
-    bool IsEqual(Ptr<const CallbackImplBase> other) const override
-    {
-        const auto otherDerived =
-            dynamic_cast<const CallbackImpl<R, UArgs...>*>(PeekPointer(other));
-
-        if (otherDerived == nullptr)
-        {
-            return false;
-        }
-
-        // if the two callback implementations are made of a distinct number of
-        // components, they are different
-        if (m_components.size() != otherDerived->GetComponents().size())
-        {
-            return false;
-        }
-
-        // the two functions are equal if they compare equal or the shared pointers
-        // point to the same locations
-        if (!m_components.at(0)->IsEqual(otherDerived->GetComponents().at(0)) &&
-            m_components.at(0) != otherDerived->GetComponents().at(0))
-        {
-            return false;
-        }
+    /// The CallbackImpl whose arguments are bound
+    Ptr<Impl> m_impl;
+    /// The values of the bound arguments, which the callable object may modify
+    mutable std::tuple<BArgs...> m_bargs;
+};
 
-        // check if the remaining components are equal one by one
-        for (std::size_t i = 1; i < m_components.size(); i++)
-        {
-            if (!m_components.at(i)->IsEqual(otherDerived->GetComponents().at(i)))
-            {
-                return false;
-            }
-        }
+/**
+ * \ingroup callbackimpl
+ * A callable object and its bound arguments, stored inline in a Callback.
+ *
+ * Only the callable objects with no bound argument, e.g., a function
+ * pointer or a small lambda, and the pointers to member functions bound
+ * to an object pointer are stored inline.
+ *
+ * \tparam T \explicit The type of the callable object.
+ * \tparam BArgs \explicit The types of the bound arguments.
+ */
+template <typename T, typename... BArgs>
+struct CallbackInlineTarget;
 
-        return true;
-    }
+/**
+ * \ingroup callbackimpl
+ * \copydoc CallbackInlineTarget
+ */
+template <typename T>
+struct CallbackInlineTarget<T>
+{
+    T func; //!< The callable object
 
-    std::string GetTypeid() const override
+    /**
+     * Invoke the callable object.
+     *
+     * \tparam R \explicit The return type of the Callback.
+     * \tparam UArgs \deduced The types of the arguments to the Callback.
+     * \param [in] uargs The arguments to the Callback.
+     * \return The return value of the callable object.
+     */
+    template <typename R, typename... UArgs>
+    R Invoke(UArgs&&... uargs) const
     {
-        return DoGetTypeid();
+        return static_cast<R>(std::invoke(func, std::forward<UArgs>(uargs)...));
     }
 
-    /** \copydoc GetTypeid() */
-    static std::string DoGetTypeid()
+    /**
+     * Build a CallbackImpl storing a copy of this target.
+     *
+     * \tparam Signature \explicit The signature of the Callback.
+     * \return The CallbackImpl.
+     */
+    template <typename Signature>
+    Ptr<CallbackImplBase> MakeImpl() const
     {
-        static std::vector<std::string> vec = {GetCppTypeid<R>(), GetCppTypeid<UArgs>()...};
+        return Create<CallbackFunctorImpl<Signature, T>>(func);
+    }
+};
 
-        static std::string id("CallbackImpl<");
-        for (auto& s : vec)
-        {
-            id.append(s + ",");
-        }
-        if (id.back() == ',')
-        {
-            id.pop_back();
-        }
-        id.push_back('>');
+/**
+ * \ingroup callbackimpl
+ * \copydoc CallbackInlineTarget
+ */
+template <typename T, typename B>
+struct CallbackInlineTarget<T, B>
+{
+    T func; //!< The callable object
+    B barg; //!< The bound argument
 
-        return id;
+    /** \copydoc CallbackInlineTarget<T>::Invoke */
+    template <typename R, typename... UArgs>
+    R Invoke(UArgs&&... uargs) const
+    {
+        return static_cast<R>(std::invoke(func, barg, std::forward<UArgs>(uargs)...));
     }
 
-  private:
-    /// Stores the callable object associated with this callback (as a lambda)
-    std::function<R(UArgs...)> m_func;
+    /** \copydoc CallbackInlineTarget<T>::MakeImpl */
+    template <typename Signature>
+    Ptr<CallbackImplBase> MakeImpl() const
+    {
+        return Create<CallbackFunctorImpl<Signature, T, B>>(func, barg);
+    }
+};
 
-    /// Stores the original callable object and the bound arguments, if any
-    std::vector<std::shared_ptr<CallbackComponentBase>> m_components;
+/**
+ * \ingroup callbackimpl
+ * The operations on the target stored inline in a Callback.
+ */
+struct CallbackInlineOps
+{
+    /** The type of the CallbackImpl of the same signature. */
+    const std::type_info* signature;
+    /** The type of the target. */
+    const std::type_info* type;
+    /** The function invoking the target, whose type depends on the signature. */
+    void (*invoke)();
+    /** The function building a CallbackImpl storing a copy of the target. */
+    Ptr<CallbackImplBase> (*makeImpl)(const void* storage);
 };
 
 /**
  * \ingroup callbackimpl
  * Base class for Callback class.
  * Provides pimpl abstraction.
+ *
+ * The small targets (see CallbackInlineTarget) are stored inline rather
+ * than in a CallbackImpl, so that building and copying them does not
+ * allocate memory.  Their CallbackImpl is built when GetImpl() is called.
  */
 class CallbackBase
 {
+    template <typename R, typename... UArgs>
+    friend class Callback;
+
   public:
     CallbackBase()
-        : m_impl()
+        : m_impl(),
+          m_ops(nullptr),
+          m_storage{}
     {
     }
 
-    /** \return The impl pointer */
+    /**
+     * \return The impl pointer; for a target stored inline, a new
+     *         CallbackImpl storing a copy of the target
+     */
     Ptr<CallbackImplBase> GetImpl() const
     {
+        if (m_ops != nullptr)
+        {
+            return m_ops->makeImpl(m_storage);
+        }
         return m_impl;
     }
 
@@ -360,11 +632,18 @@ class CallbackBase
      * \param [in] impl The CallbackImplBase Ptr
      */
     CallbackBase(Ptr<CallbackImplBase> impl)
-        : m_impl(impl)
+        : m_impl(impl),
+          m_ops(nullptr),
+          m_storage{}
     {
     }
 
-    Ptr<CallbackImplBase> m_impl; //!< the pimpl
+    /// Size of the inline storage, enough for a pointer to member function and an object
+    static constexpr std::size_t INLINE_SIZE = 3 * sizeof(void*);
+
+    Ptr<CallbackImplBase> m_impl;    //!< the pimpl, null if the target is stored inline
+    const CallbackInlineOps* m_ops;  //!< the operations on the target stored inline, if any
+    alignas(void*) unsigned char m_storage[INLINE_SIZE]; //!< the target stored inline
 };
 
 /**
@@ -402,6 +681,9 @@ class CallbackBase
  *   - the pimpl idiom: the Callback class is passed around by
  *     value and delegates the crux of the work to its pimpl
  *     pointer.
+ *   - a small buffer: a function pointer, a small lambda or a
+ *     pointer to member function with its object pointer are
+ *     stored inline instead, without a pimpl.
  *   - a reference list implementation to implement the Callback's
  *     value semantics.
  *
@@ -448,17 +730,9 @@ class Callback : public CallbackBase
     template <typename... BArgs>
     Callback(const Callback<R, BArgs..., UArgs...>& cb, BArgs... bargs)
     {
-        auto f = cb.DoPeekImpl()->GetFunction();
-
-        CallbackComponentVector components(cb.DoPeekImpl()->GetComponents());
-        components.insert(components.end(),
-                          {std::make_shared<CallbackComponent<std::decay_t<BArgs>>>(bargs)...});
-
-        m_impl = Create<CallbackImpl<R, UArgs...>>(
-            [f, bargs...](auto&&... uargs) -> R {
-                return f(bargs..., std::forward<decltype(uargs)>(uargs)...);
-            },
-            components);
+        m_impl = Create<CallbackBoundImpl<R(UArgs...),
+                                          CallbackImpl<R, BArgs..., UArgs...>,
+                                          std::decay_t<BArgs>...>>(cb.DoGetImpl(), bargs...);
     }
 
     /**
@@ -480,23 +754,17 @@ class Callback : public CallbackBase
                                int> = 0>
     Callback(T func, BArgs... bargs)
     {
-        // store the function in a std::function object
-        std::function<R(BArgs..., UArgs...)> f(func);
-
-        // The original function is comparable if it is a function pointer or
-        // a pointer to a member function or a pointer to a member data.
-        constexpr bool isComp =
-            std::is_function_v<std::remove_pointer_t<T>> || std::is_member_pointer_v<T>;
-
-        CallbackComponentVector components(
-            {std::make_shared<CallbackComponent<T, isComp>>(func),
-             std::make_shared<CallbackComponent<std::decay_t<BArgs>>>(bargs)...});
-
-        m_impl = Create<CallbackImpl<R, UArgs...>>(
-            [f, bargs...](auto&&... uargs) -> R {
-                return f(bargs..., std::forward<decltype(uargs)>(uargs)...);
-            },
-            components);
+        if constexpr (IsInline<T, std::decay_t<BArgs>...>())
+        {
+            using Target = CallbackInlineTarget<T, std::decay_t<BArgs>...>;
+            new (m_storage) Target{func, bargs...};
+            m_ops = GetInlineOps<Target>();
+        }
+        else
+        {
+            m_impl = Create<CallbackFunctorImpl<R(UArgs...), T, std::decay_t<BArgs>...>>(func,
+                                                                                      bargs...);
+        }
     }
 
   private:
@@ -516,17 +784,10 @@ class Callback : public CallbackBase
     {
         Callback<R, std::tuple_element_t<sizeof...(bargs) + INDEX, std::tuple<UArgs...>>...> cb;
 
-        const auto f = DoPeekImpl()->GetFunction();
-
-        CallbackComponentVector components(DoPeekImpl()->GetComponents());
-        components.insert(components.end(),
-                          {std::make_shared<CallbackComponent<std::decay_t<BoundArgs>>>(bargs)...});
-
-        cb.m_impl = Create<std::remove_pointer_t<decltype(cb.DoPeekImpl())>>(
-            [f, bargs...](auto&&... uargs) mutable {
-                return f(bargs..., std::forward<decltype(uargs)>(uargs)...);
-            },
-            components);
+        cb.m_impl = Create<CallbackBoundImpl<
+            R(std::tuple_element_t<sizeof...(bargs) + INDEX, std::tuple<UArgs...>>...),
+            CallbackImpl<R, UArgs...>,
+            std::decay_t<BoundArgs>...>>(DoGetImpl(), std::forward<BoundArgs>(bargs)...);
 
         return cb;
     }
@@ -554,13 +815,14 @@ class Callback : public CallbackBase
      */
     bool IsNull() const
     {
-        return (DoPeekImpl() == nullptr);
+        return (m_ops == nullptr && DoPeekImpl() == nullptr);
     }
 
     /** Discard the implementation, set it to null */
     void Nullify()
     {
         m_impl = nullptr;
+        m_ops = nullptr;
     }
 
     /**
@@ -571,7 +833,12 @@ class Callback : public CallbackBase
      */
     R operator()(UArgs... uargs) const
     {
-        return (*(DoPeekImpl()))(uargs...);
+        if (m_ops != nullptr)
+        {
+            auto invoke = reinterpret_cast<InlineInvoker>(m_ops->invoke);
+            return invoke(m_storage, std::forward<UArgs>(uargs)...);
+        }
+        return (*(DoPeekImpl()))(std::forward<UArgs>(uargs)...);
     }
 
     /**
@@ -582,7 +849,15 @@ class Callback : public CallbackBase
      */
     bool IsEqual(const CallbackBase& other) const
     {
-        return m_impl->IsEqual(other.GetImpl());
+        if (m_ops != nullptr && other.m_ops != nullptr)
+        {
+            // The inline targets are trivially copyable, they are equal if
+            // their bytes are
+            return *m_ops->signature == *other.m_ops->signature &&
+                   *m_ops->type == *other.m_ops->type &&
+                   std::memcmp(m_storage, other.m_storage, INLINE_SIZE) == 0;
+        }
+        return GetImpl()->IsEqual(other.GetImpl());
     }
 
     /**
@@ -593,7 +868,11 @@ class Callback : public CallbackBase
      */
     bool CheckType(const CallbackBase& other) const
     {
-        return DoCheckType(other.GetImpl());
+        if (other.m_ops != nullptr)
+        {
+            return *other.m_ops->signature == typeid(CallbackImpl<R, UArgs...>);
+        }
+        return DoCheckType(other.m_impl);
     }
 
     /**
@@ -604,6 +883,13 @@ class Callback : public CallbackBase
      */
     bool Assign(const CallbackBase& other)
     {
+        if (other.m_ops != nullptr && CheckType(other))
+        {
+            m_impl = nullptr;
+            m_ops = other.m_ops;
+            std::memcpy(m_storage, other.m_storage, INLINE_SIZE);
+            return true;
+        }
         auto otherImpl = other.GetImpl();
         if (!DoCheckType(otherImpl))
         {
@@ -616,16 +902,102 @@ class Callback : public CallbackBase
             return false;
         }
         m_impl = const_cast<CallbackImplBase*>(PeekPointer(otherImpl));
+        m_ops = nullptr;
         return true;
     }
 
   private:
-    /** \return The pimpl pointer */
+    /** Signature of the function invoking a target stored inline. */
+    typedef R (*InlineInvoker)(const void* storage, UArgs... uargs);
+
+    /**
+     * Check whether a callable object and its bound arguments are stored inline.
+     *
+     * They are if they fit in the inline storage, can be copied byte by
+     * byte, and the callable object does not modify itself nor its bound
+     * arguments, which would be shared by the copies of a CallbackImpl.
+     *
+     * \tparam T \explicit The type of the callable object.
+     * \tparam BArgs \explicit The types of the bound arguments.
+     * \return \c true if they are stored inline.
+     */
+    template <typename T, typename... BArgs>
+    static constexpr bool IsInline()
+    {
+        if constexpr (sizeof...(BArgs) > 1 ||
+                      !std::is_invocable_r_v<R, const T&, const BArgs&..., UArgs...>)
+        {
+            return false;
+        }
+        else
+        {
+            using Target = CallbackInlineTarget<T, BArgs...>;
+            return std::is_trivially_copyable_v<Target> && sizeof(Target) <= INLINE_SIZE &&
+                   alignof(Target) <= alignof(void*);
+        }
+    }
+
+    /**
+     * Invoke a target stored inline.
+     *
+     * The target is copied first: the callback may be released or moved
+     * by the invoked function, e.g., when a TracedCallback sink connects
+     * another sink.
+     *
+     * \tparam Target \explicit The type of the target.
+     * \param [in] storage The inline storage.
+     * \param [in] uargs The arguments to the callback.
+     * \return Callback value
+     */
+    template <typename Target>
+    static R InlineInvoke(const void* storage, UArgs... uargs)
+    {
+        const Target target = *std::launder(static_cast<const Target*>(storage));
+        return target.template Invoke<R>(std::forward<UArgs>(uargs)...);
+    }
+
+    /**
+     * Build a CallbackImpl storing a copy of a target stored inline.
+     *
+     * \tparam Target \explicit The type of the target.
+     * \param [in] storage The inline storage.
+     * \return The CallbackImpl.
+     */
+    template <typename Target>
+    static Ptr<CallbackImplBase> MakeInlineImpl(const void* storage)
+    {
+        return std::launder(static_cast<const Target*>(storage))
+            ->template MakeImpl<R(UArgs...)>();
+    }
+
+    /**
+     * \tparam Target \explicit The type of the target.
+     * \return The operations on a target stored inline.
+     */
+    template <typename Target>
+    static const CallbackInlineOps* GetInlineOps()
+    {
+        static const CallbackInlineOps ops{&typeid(CallbackImpl<R, UArgs...>),
+                                           &typeid(Target),
+                                           reinterpret_cast<void (*)()>(&InlineInvoke<Target>),
+                                           &MakeInlineImpl<Target>};
+        return &ops;
+    }
+
+    /** \return The pimpl pointer, null if the target is stored inline */
     CallbackImpl<R, UArgs...>* DoPeekImpl() const
     {
         return static_cast<CallbackImpl<R, UArgs...>*>(PeekPointer(m_impl));
     }
 
+    /** \return The pimpl pointer, built if the target is stored inline */
+    Ptr<CallbackImpl<R, UArgs...>> DoGetImpl() const
+    {
+        auto impl = GetImpl();
+        return Ptr<CallbackImpl<R, UArgs...>>(
+            static_cast<CallbackImpl<R, UArgs...>*>(PeekPointer(impl)));
+    }
+
     /**
      * Check for compatible types
      *
@@ -15,7 +15,10 @@
 #include "pointer.h"
 #include "singleton.h"
 
+#include <algorithm>
+#include <map>
 #include <sstream>
+#include <unordered_map>
 
 /**
  * \file
@@ -190,6 +193,8 @@ MatchContainer::DisconnectWithoutContext(std::string name, const CallbackBase& c
 /**
  * \ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once, at construction time.
  */
 class ArrayMatcher
 {
@@ -207,6 +212,14 @@ class ArrayMatcher
      * \returns \c true if the index matches the Config Path.
      */
     bool Matches(std::size_t i) const;
+    /**
+     * Get the indices matching the Config path, if they are listed explicitly.
+     *
+     * \param [out] indices The matching indices, sorted, without duplicates.
+     * \returns \c true if the specification is made of explicit indices
+     * only, \c false if it holds a wildcard or a range.
+     */
+    bool GetIndices(std::vector<std::size_t>* indices) const;
 
   private:
     /**
@@ -217,79 +230,111 @@ class ArrayMatcher
      * \returns \c true if the string could be converted.
      */
     bool StringToUint32(std::string str, uint32_t* value) const;
+    /**
+     * Parse one of the alternatives of the specification.
+     *
+     * \param [in] element The alternative.
+     */
+    void Parse(std::string element);
+
     /** The Config path element. */
     std::string m_element;
+    /** Whether the specification holds the \c * wildcard. */
+    bool m_any;
+    /** The closed ranges of matching indices, single indices included. */
+    std::vector<std::pair<uint32_t, uint32_t>> m_ranges;
+    /** Whether all the ranges are single indices. */
+    bool m_explicit;
 
 }; // class ArrayMatcher
 
 ArrayMatcher::ArrayMatcher(std::string element)
-    : m_element(element)
+    : m_element(element),
+      m_any(false),
+      m_explicit(true)
 {
     NS_LOG_FUNCTION(this << element);
+    std::string::size_type start = 0;
+    std::string::size_type bar;
+    while ((bar = element.find('|', start)) != std::string::npos)
+    {
+        Parse(element.substr(start, bar - start));
+        start = bar + 1;
+    }
+    Parse(element.substr(start));
 }
 
-bool
-ArrayMatcher::Matches(std::size_t i) const
+void
+ArrayMatcher::Parse(std::string element)
 {
-    NS_LOG_FUNCTION(this << i);
-    if (m_element == "*")
-    {
-        NS_LOG_DEBUG("Array " << i << " matches *");
-        return true;
-    }
-    std::string::size_type tmp;
-    tmp = m_element.find('|');
-    if (tmp != std::string::npos)
+    NS_LOG_FUNCTION(this << element);
+    if (element == "*")
     {
-        std::string left = m_element.substr(0, tmp - 0);
-        std::string right = m_element.substr(tmp + 1, m_element.size() - (tmp + 1));
-        ArrayMatcher matcher = ArrayMatcher(left);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << left);
-            return true;
-        }
-        matcher = ArrayMatcher(right);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << right);
-            return true;
-        }
-        NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
-        return false;
+        m_any = true;
+        m_explicit = false;
+        return;
     }
-    std::string::size_type leftBracket = m_element.find('[');
-    std::string::size_type rightBracket = m_element.find(']');
-    std::string::size_type dash = m_element.find('-');
-    if (leftBracket == 0 && rightBracket == m_element.size() - 1 && dash > leftBracket &&
+    std::string::size_type leftBracket = element.find('[');
+    std::string::size_type rightBracket = element.find(']');
+    std::string::size_type dash = element.find('-');
+    if (leftBracket == 0 && rightBracket == element.size() - 1 && dash > leftBracket &&
         dash < rightBracket)
     {
-        std::string lowerBound = m_element.substr(leftBracket + 1, dash - (leftBracket + 1));
-        std::string upperBound = m_element.substr(dash + 1, rightBracket - (dash + 1));
+        std::string lowerBound = element.substr(leftBracket + 1, dash - (leftBracket + 1));
+        std::string upperBound = element.substr(dash + 1, rightBracket - (dash + 1));
         uint32_t min;
         uint32_t max;
-        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && i >= min &&
-            i <= max)
+        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max))
         {
-            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
-            return true;
-        }
-        else
-        {
-            NS_LOG_DEBUG("Array " << i << " does not " << m_element);
-            return false;
+            m_ranges.emplace_back(min, max);
+            m_explicit = false;
         }
+        return;
     }
     uint32_t value;
-    if (StringToUint32(m_element, &value) && i == value)
+    if (StringToUint32(element, &value))
+    {
+        m_ranges.emplace_back(value, value);
+    }
+}
+
+bool
+ArrayMatcher::Matches(std::size_t i) const
+{
+    if (m_any)
     {
-        NS_LOG_DEBUG("Array " << i << " matches " << m_element);
+        NS_LOG_DEBUG("Array " << i << " matches *");
         return true;
     }
+    for (const auto& [min, max] : m_ranges)
+    {
+        if (i >= min && i <= max)
+        {
+            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
+            return true;
+        }
+    }
     NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
     return false;
 }
 
+bool
+ArrayMatcher::GetIndices(std::vector<std::size_t>* indices) const
+{
+    if (!m_explicit)
+    {
+        return false;
+    }
+    indices->clear();
+    for (const auto& range : m_ranges)
+    {
+        indices->push_back(range.first);
+    }
+    std::sort(indices->begin(), indices->end());
+    indices->erase(std::unique(indices->begin(), indices->end()), indices->end());
+    return true;
+}
+
 bool
 ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
 {
@@ -300,24 +345,156 @@ ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
     return !iss.bad() && !iss.fail();
 }
 
+/**
+ * \ingroup config-impl
+ * Index of the attributes through which Config paths can go.
+ *
+ * For each TypeId, the pointer and object container attributes of the
+ * type and of its parents are listed once, by name, so that resolving a
+ * path element does not scan all the attributes of the object and test
+ * their checkers.  The entry of a TypeId is rebuilt if attributes have
+ * been added to it, or to one of its parents, since.
+ */
+class AttributeIndex
+{
+  public:
+    /** An attribute which a Config path can go through. */
+    struct Entry
+    {
+        /** The attribute. */
+        TypeId::AttributeInformation info;
+        /** Whether the attribute is an object container, rather than a pointer. */
+        bool isContainer;
+        /** The container accessor, if it gives access to each object. */
+        const ObjectPtrContainerAccessor* accessor;
+    };
+
+    /** A list of attributes. */
+    typedef std::vector<Entry> Entries;
+
+    /**
+     * Find the attributes matching a Config path element.
+     *
+     * \param [in] tid The object type.
+     * \param [in] item The path element, an attribute name or \c *.
+     * \returns The matching attributes, in the order of the TypeId
+     * hierarchy, from the object type up.
+     */
+    const Entries& Lookup(TypeId tid, const std::string& item);
+
+  private:
+    /** The attributes of a TypeId. */
+    struct TypeEntries
+    {
+        /** The total number of attributes of the type and its parents. */
+        std::size_t nAttributes;
+        /** All the pointer and container attributes. */
+        Entries all;
+        /** The pointer and container attributes, by name. */
+        std::unordered_map<std::string, Entries> byName;
+    };
+
+    /**
+     * Count the attributes of a type and its parents.
+     *
+     * \param [in] tid The type.
+     * \returns The number of attributes.
+     */
+    static std::size_t CountAttributes(TypeId tid);
+
+    /** The attributes, by TypeId uid. */
+    std::unordered_map<uint16_t, TypeEntries> m_types;
+};
+
+std::size_t
+AttributeIndex::CountAttributes(TypeId tid)
+{
+    std::size_t n = 0;
+    TypeId nextTid = tid;
+    do
+    {
+        tid = nextTid;
+        n += tid.GetAttributeN();
+        nextTid = tid.GetParent();
+    } while (nextTid != tid);
+    return n;
+}
+
+const AttributeIndex::Entries&
+AttributeIndex::Lookup(TypeId tid, const std::string& item)
+{
+    std::size_t nAttributes = CountAttributes(tid);
+    auto [it, inserted] = m_types.try_emplace(tid.GetUid());
+    TypeEntries& entries = it->second;
+    if (inserted || entries.nAttributes != nAttributes)
+    {
+        NS_LOG_LOGIC("Index the attributes of " << tid.GetName());
+        entries.nAttributes = nAttributes;
+        entries.all.clear();
+        entries.byName.clear();
+        // An attribute shadowed by one of the same name in a derived type
+        // is accessed through the derived one, as by GetAttribute()
+        std::unordered_map<std::string, TypeId::AttributeInformation> first;
+        TypeId current;
+        TypeId nextTid = tid;
+        do
+        {
+            current = nextTid;
+            for (std::size_t i = 0; i < current.GetAttributeN(); i++)
+            {
+                TypeId::AttributeInformation info = current.GetAttribute(i);
+                const auto& visible = first.try_emplace(info.name, info).first->second;
+                Entry entry{visible, false, nullptr};
+                if (dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker)))
+                {
+                    entry.isContainer = true;
+                    entry.accessor = dynamic_cast<const ObjectPtrContainerAccessor*>(
+                        PeekPointer(visible.accessor));
+                }
+                else if (!dynamic_cast<const PointerChecker*>(PeekPointer(info.checker)))
+                {
+                    // this could be anything else and we don't know what to do with it.
+                    // So, we just ignore it.
+                    continue;
+                }
+                entries.all.push_back(entry);
+                entries.byName[info.name].push_back(entry);
+            }
+            nextTid = current.GetParent();
+        } while (nextTid != current);
+    }
+
+    if (item == "*")
+    {
+        return entries.all;
+    }
+    static const Entries none;
+    auto found = entries.byName.find(item);
+    return found != entries.byName.end() ? found->second : none;
+}
+
 /**
  * \ingroup config-impl
  * Abstract class to parse Config paths into object references.
+ *
+ * Several paths can be resolved at once: they are merged into a tree of
+ * path elements, so that their common prefixes are only resolved once.
  */
 class Resolver
 {
   public:
     /**
-     * Construct from a base Config path.
+     * Construct from several base Config paths.
      *
-     * \param [in] path The Config path.
+     * \param [in] paths The Config paths.
+     * \param [in] index The attribute index.
      */
-    Resolver(std::string path);
+    Resolver(const std::vector<std::string>& paths, AttributeIndex& index);
     /** Destructor. */
     virtual ~Resolver();
 
     /**
-     * Parse the stored Config path into an object reference,
+     * Parse the stored Config paths into object references,
      * beginning at the indicated root object.
      *
      * \param [in] root The object corresponding to the current position in
@@ -326,29 +503,61 @@ class Resolver
     void Resolve(Ptr<Object> root);
 
   private:
-    /** Ensure the Config path starts and ends with a '/'. */
-    void Canonicalize();
+    /** A node of the tree of path elements. */
+    struct PathNode
+    {
+        /** The next elements of the paths, and the index of their node. */
+        std::map<std::string, std::size_t> children;
+        /** The indices of the paths which end here. */
+        std::vector<std::size_t> paths;
+    };
+
+    /**
+     * Add a path to the tree.
+     *
+     * \param [in] path The Config path.
+     * \param [in] index The index of the path.
+     */
+    void Add(std::string path, std::size_t index);
+    /**
+     * Ensure the Config path starts and ends with a '/'.
+     *
+     * \param [in,out] path The Config path.
+     */
+    static void Canonicalize(std::string& path);
+    /**
+     * Resolve the paths which end at a node, and the next elements.
+     *
+     * \param [in] node The index of the tree node.
+     * \param [in] root The object corresponding to the current position
+     *                  in the Config path.
+     */
+    void DoResolve(std::size_t node, Ptr<Object> root);
     /**
      * Parse the next element in the Config path.
      *
-     * \param [in] path The remaining portion of the Config path.
+     * \param [in] item The path element.
+     * \param [in] node The index of the tree node of the remaining Config path.
      * \param [in] root The object corresponding to the current position
      *                  in the Config path.
      */
-    void DoResolve(std::string path, Ptr<Object> root);
+    void DoResolveItem(const std::string& item, std::size_t node, Ptr<Object> root);
     /**
      * Parse an index on the Config path.
      *
-     * \param [in] path The remaining Config path.
-     * \param [in,out] vector The resulting list of matching objects.
+     * \param [in] node The index of the tree node following the container
+     *                  attribute.
+     * \param [in] root The object holding the container.
+     * \param [in] entry The container attribute.
      */
-    void DoArrayResolve(std::string path, const ObjectPtrContainerValue& vector);
+    void DoArrayResolve(std::size_t node, Ptr<Object> root, const AttributeIndex::Entry& entry);
     /**
      * Handle one object found on the path.
      *
      * \param [in] object The current object on the Config path.
+     * \param [in] index The index of the path.
      */
-    void DoResolveOne(Ptr<Object> object);
+    void DoResolveOne(Ptr<Object> object, std::size_t index);
     /**
      * Get the current Config path.
      *
@@ -360,21 +569,28 @@ class Resolver
      *
      * \param [in] object The found object.
      * \param [in] path The matching Config path context.
+     * \param [in] index The index of the matched path.
      */
-    virtual void DoOne(Ptr<Object> object, std::string path) = 0;
+    virtual void DoOne(Ptr<Object> object, std::string path, std::size_t index) = 0;
 
     /** Current list of path tokens. */
     std::vector<std::string> m_workStack;
-    /** The Config path. */
-    std::string m_path;
+    /** The tree of the Config paths, starting with its root. */
+    std::vector<PathNode> m_nodes;
+    /** The attribute index. */
+    AttributeIndex& m_index;
 
 }; // class Resolver
 
-Resolver::Resolver(std::string path)
-    : m_path(path)
+Resolver::Resolver(const std::vector<std::string>& paths, AttributeIndex& index)
+    : m_nodes(1),
+      m_index(index)
 {
-    NS_LOG_FUNCTION(this << path);
-    Canonicalize();
+    NS_LOG_FUNCTION(this << paths.size());
+    for (std::size_t i = 0; i < paths.size(); i++)
+    {
+        Add(paths[i], i);
+    }
 }
 
 Resolver::~Resolver()
@@ -383,22 +599,45 @@ Resolver::~Resolver()
 }
 
 void
-Resolver::Canonicalize()
+Resolver::Add(std::string path, std::size_t index)
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION(this << path << index);
+    Canonicalize(path);
+
+    std::size_t node = 0;
+    std::string::size_type start = 1;
+    std::string::size_type next;
+    while ((next = path.find('/', start)) != std::string::npos)
+    {
+        auto [it, inserted] =
+            m_nodes[node].children.try_emplace(path.substr(start, next - start), m_nodes.size());
+        if (inserted)
+        {
+            m_nodes.emplace_back();
+        }
+        node = it->second;
+        start = next + 1;
+    }
+    m_nodes[node].paths.push_back(index);
+}
+
+void
+Resolver::Canonicalize(std::string& path)
+{
+    NS_LOG_FUNCTION(path);
 
     // ensure that we start and end with a '/'
-    std::string::size_type tmp = m_path.find('/');
+    std::string::size_type tmp = path.find('/');
     if (tmp != 0)
     {
         // no slash at start
-        m_path = "/" + m_path;
+        path = "/" + path;
     }
-    tmp = m_path.find_last_of('/');
-    if (tmp != (m_path.size() - 1))
+    tmp = path.find_last_of('/');
+    if (tmp != (path.size() - 1))
     {
         // no slash at end
-        m_path = m_path + "/";
+        path = path + "/";
     }
 }
 
@@ -407,7 +646,7 @@ Resolver::Resolve(Ptr<Object> root)
 {
     NS_LOG_FUNCTION(this << root);
 
-    DoResolve(m_path, root);
+    DoResolve(0, root);
 }
 
 std::string
@@ -424,39 +663,44 @@ Resolver::GetResolvedPath() const
 }
 
 void
-Resolver::DoResolveOne(Ptr<Object> object)
+Resolver::DoResolveOne(Ptr<Object> object, std::size_t index)
 {
-    NS_LOG_FUNCTION(this << object);
+    NS_LOG_FUNCTION(this << object << index);
 
     NS_LOG_DEBUG("resolved=" << GetResolvedPath());
-    DoOne(object, GetResolvedPath());
+    DoOne(object, GetResolvedPath(), index);
 }
 
 void
-Resolver::DoResolve(std::string path, Ptr<Object> root)
+Resolver::DoResolve(std::size_t node, Ptr<Object> root)
 {
-    NS_LOG_FUNCTION(this << path << root);
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
+    NS_LOG_FUNCTION(this << node << root);
 
-    if (next == std::string::npos)
+    //
+    // If root is zero, we're beginning to see if we can use the object name
+    // service to resolve this path.  It is impossible to have a object name
+    // associated with the root of the object name service since that root
+    // is not an object.  This path must be referring to something in another
+    // namespace and it will have been found already since the name service
+    // is always consulted last.
+    //
+    if (root)
     {
-        //
-        // If root is zero, we're beginning to see if we can use the object name
-        // service to resolve this path.  It is impossible to have a object name
-        // associated with the root of the object name service since that root
-        // is not an object.  This path must be referring to something in another
-        // namespace and it will have been found already since the name service
-        // is always consulted last.
-        //
-        if (root)
+        for (auto index : m_nodes[node].paths)
         {
-            DoResolveOne(root);
+            DoResolveOne(root, index);
         }
-        return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    for (const auto& [item, child] : m_nodes[node].children)
+    {
+        DoResolveItem(item, child, root);
+    }
+}
+
+void
+Resolver::DoResolveItem(const std::string& item, std::size_t node, Ptr<Object> root)
+{
+    NS_LOG_FUNCTION(this << item << root);
 
     //
     // If root is zero, we're beginning to see if we can use the object name
@@ -467,11 +711,10 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     //
     if (!root)
     {
-        std::string::size_type offset = path.find("/Names");
-        if (offset == 0)
+        if (item.compare(0, 5, "Names") == 0)
         {
             m_workStack.push_back(item);
-            DoResolve(pathLeft, root);
+            DoResolve(node, root);
             m_workStack.pop_back();
             return;
         }
@@ -488,7 +731,7 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     {
         NS_LOG_DEBUG("Name system resolved item = " << item << " to " << namedObject);
         m_workStack.push_back(item);
-        DoResolve(pathLeft, namedObject);
+        DoResolve(node, namedObject);
         m_workStack.pop_back();
         return;
     }
@@ -518,71 +761,54 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
             return;
         }
         m_workStack.push_back(item);
-        DoResolve(pathLeft, object);
+        DoResolve(node, object);
         m_workStack.pop_back();
     }
     else
     {
         // this is a normal attribute.
-        TypeId tid;
-        TypeId nextTid = root->GetInstanceTypeId();
+        const auto& entries = m_index.Lookup(root->GetInstanceTypeId(), item);
         bool foundMatch = false;
 
-        do
+        for (const auto& entry : entries)
         {
-            tid = nextTid;
-
-            for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+            const auto& info = entry.info;
+            if (!entry.isContainer)
             {
-                TypeId::AttributeInformation info;
-                info = tid.GetAttribute(i);
-                if (info.name != item && item != "*")
-                {
-                    continue;
-                }
-                // attempt to cast to a pointer checker.
-                const auto pChecker =
-                    dynamic_cast<const PointerChecker*>(PeekPointer(info.checker));
-                if (pChecker != nullptr)
+                NS_LOG_DEBUG("GetAttribute(ptr)=" << info.name
+                                                  << " on path=" << GetResolvedPath());
+                PointerValue pValue;
+                if (info.supportLevel != TypeId::SUPPORTED || !(info.flags & TypeId::ATTR_GET) ||
+                    !info.accessor->HasGetter() || !info.accessor->Get(PeekPointer(root), pValue))
                 {
-                    NS_LOG_DEBUG("GetAttribute(ptr)=" << info.name
-                                                      << " on path=" << GetResolvedPath());
-                    PointerValue pValue;
+                    // Let ObjectBase::GetAttribute report the deprecated,
+                    // obsolete or not gettable attributes
                     root->GetAttribute(info.name, pValue);
-                    Ptr<Object> object = pValue.Get<Object>();
-                    if (!object)
-                    {
-                        NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
-                                                                << GetResolvedPath()
-                                                                << "\""
-                                                                   " but is null.");
-                        continue;
-                    }
-                    foundMatch = true;
-                    m_workStack.push_back(info.name);
-                    DoResolve(pathLeft, object);
-                    m_workStack.pop_back();
                 }
-                // attempt to cast to an object vector.
-                const auto vectorChecker =
-                    dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker));
-                if (vectorChecker != nullptr)
+                Ptr<Object> object = pValue.Get<Object>();
+                if (!object)
                 {
-                    NS_LOG_DEBUG("GetAttribute(vector)=" << info.name << " on path="
-                                                         << GetResolvedPath() << pathLeft);
-                    foundMatch = true;
-                    ObjectPtrContainerValue vector;
-                    root->GetAttribute(info.name, vector);
-                    m_workStack.push_back(info.name);
-                    DoArrayResolve(pathLeft, vector);
-                    m_workStack.pop_back();
+                    NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
+                                                            << GetResolvedPath()
+                                                            << "\""
+                                                               " but is null.");
+                    continue;
                 }
-                // this could be anything else and we don't know what to do with it.
-                // So, we just ignore it.
+                foundMatch = true;
+                m_workStack.push_back(info.name);
+                DoResolve(node, object);
+                m_workStack.pop_back();
             }
-
-            nextTid = tid.GetParent();
-        } while (nextTid != tid);
+            else
+            {
+                NS_LOG_DEBUG("GetAttribute(vector)=" << info.name
+                                                     << " on path=" << GetResolvedPath());
+                foundMatch = true;
+                m_workStack.push_back(info.name);
+                DoArrayResolve(node, root, entry);
+                m_workStack.pop_back();
+            }
+        }
 
         if (!foundMatch)
         {
@@ -594,30 +820,67 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
 }
 
 void
-Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& container)
+Resolver::DoArrayResolve(std::size_t node, Ptr<Object> root, const AttributeIndex::Entry& entry)
 {
-    NS_LOG_FUNCTION(this << path << &container);
-    NS_ASSERT(!path.empty());
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
-    if (next == std::string::npos)
+    NS_LOG_FUNCTION(this << node << root << entry.info.name);
+
+    // The whole container is only fetched if an element of the paths is
+    // not made of explicit indices, or if the container indices are not
+    // the positions of the objects in the container
+    ObjectPtrContainerValue container;
+    bool fetched = false;
+    std::size_t n = 0;
+    bool direct = entry.accessor && entry.info.supportLevel == TypeId::SUPPORTED &&
+                  (entry.info.flags & TypeId::ATTR_GET) &&
+                  entry.accessor->GetN(PeekPointer(root), &n);
+
+    for (const auto& [item, child] : m_nodes[node].children)
     {
-        return;
-    }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+        ArrayMatcher matcher = ArrayMatcher(item);
+        std::vector<std::size_t> indices;
+        if (direct && matcher.GetIndices(&indices))
+        {
+            std::vector<std::pair<std::size_t, Ptr<Object>>> objects;
+            for (auto i : indices)
+            {
+                if (i >= n)
+                {
+                    break;
+                }
+                std::size_t index;
+                Ptr<Object> object = entry.accessor->Get(PeekPointer(root), i, &index);
+                if (index != i)
+                {
+                    break;
+                }
+                objects.emplace_back(i, object);
+            }
+            if (objects.size() == indices.size())
+            {
+                for (const auto& [i, object] : objects)
+                {
+                    NS_LOG_DEBUG("Array " << i << " matches " << item);
+                    m_workStack.push_back(std::to_string(i));
+                    DoResolve(child, object);
+                    m_workStack.pop_back();
+                }
+                continue;
+            }
+        }
 
-    ArrayMatcher matcher = ArrayMatcher(item);
-    ObjectPtrContainerValue::Iterator it;
-    for (it = container.Begin(); it != container.End(); ++it)
-    {
-        if (matcher.Matches((*it).first))
+        if (!fetched)
         {
-            std::ostringstream oss;
-            oss << (*it).first;
-            m_workStack.push_back(oss.str());
-            DoResolve(pathLeft, (*it).second);
-            m_workStack.pop_back();
+            root->GetAttribute(entry.info.name, container);
+            fetched = true;
+        }
+        for (auto it = container.Begin(); it != container.End(); ++it)
+        {
+            if (matcher.Matches((*it).first))
+            {
+                m_workStack.push_back(std::to_string((*it).first));
+                DoResolve(child, (*it).second);
+                m_workStack.pop_back();
+            }
         }
     }
 }
@@ -643,8 +906,10 @@ class ConfigImpl : public Singleton<ConfigImpl>
     void DisconnectWithoutContext(std::string path, const CallbackBase& cb);
     /** \copydoc ns3::Config::Disconnect() */
     void Disconnect(std::string path, const CallbackBase& cb);
-    /** \copydoc ns3::Config::LookupMatches() */
+    /** \copydoc ns3::Config::LookupMatches(std::string) */
     MatchContainer LookupMatches(std::string path);
+    /** \copydoc ns3::Config::LookupMatches(const std::vector<std::string>&) */
+    std::vector<MatchContainer> LookupMatches(const std::vector<std::string>& paths);
 
     /** \copydoc ns3::Config::RegisterRootNamespaceObject() */
     void RegisterRootNamespaceObject(Ptr<Object> obj);
@@ -671,6 +936,8 @@ class ConfigImpl : public Singleton<ConfigImpl>
 
     /** The list of Config path roots. */
     Roots m_roots;
+    /** The attributes through which the Config paths can go. */
+    AttributeIndex m_index;
 
 }; // class ConfigImpl
 
@@ -775,23 +1042,33 @@ ConfigImpl::LookupMatches(std::string path)
 {
     NS_LOG_FUNCTION(this << path);
 
+    return LookupMatches(std::vector<std::string>{path})[0];
+}
+
+std::vector<MatchContainer>
+ConfigImpl::LookupMatches(const std::vector<std::string>& paths)
+{
+    NS_LOG_FUNCTION(this << paths.size());
+
     class LookupMatchesResolver : public Resolver
     {
       public:
-        LookupMatchesResolver(std::string path)
-            : Resolver(path)
+        LookupMatchesResolver(const std::vector<std::string>& paths, AttributeIndex& index)
+            : Resolver(paths, index),
+              m_objects(paths.size()),
+              m_contexts(paths.size())
         {
         }
 
-        void DoOne(Ptr<Object> object, std::string path) override
+        void DoOne(Ptr<Object> object, std::string path, std::size_t index) override
         {
-            m_objects.push_back(object);
-            m_contexts.push_back(path);
+            m_objects[index].push_back(object);
+            m_contexts[index].push_back(path);
         }
 
-        std::vector<Ptr<Object>> m_objects;
-        std::vector<std::string> m_contexts;
-    } resolver = LookupMatchesResolver(path);
+        std::vector<std::vector<Ptr<Object>>> m_objects;
+        std::vector<std::vector<std::string>> m_contexts;
+    } resolver = LookupMatchesResolver(paths, m_index);
 
     for (auto i = m_roots.begin(); i != m_roots.end(); i++)
     {
@@ -805,7 +1082,13 @@ ConfigImpl::LookupMatches(std::string path)
     //
     resolver.Resolve(nullptr);
 
-    return MatchContainer(resolver.m_objects, resolver.m_contexts, path);
+    std::vector<MatchContainer> containers;
+    containers.reserve(paths.size());
+    for (std::size_t i = 0; i < paths.size(); i++)
+    {
+        containers.emplace_back(resolver.m_objects[i], resolver.m_contexts[i], paths[i]);
+    }
+    return containers;
 }
 
 void
@@ -994,6 +1277,13 @@ LookupMatches(std::string path)
     return ConfigImpl::Get()->LookupMatches(path);
 }
 
+std::vector<MatchContainer>
+LookupMatches(const std::vector<std::string>& paths)
+{
+    NS_LOG_FUNCTION(paths.size());
+    return ConfigImpl::Get()->LookupMatches(paths);
+}
+
 void
 RegisterRootNamespaceObject(Ptr<Object> obj)
 {
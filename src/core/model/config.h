@@ -349,6 +349,31 @@ class MatchContainer
  *          path.
  */
 MatchContainer LookupMatches(std::string path);
+/**
+ * \ingroup config
+ * \param [in] paths The paths to perform a match against
+ * \returns For each input path, in the same order, a container which
+ *          contains all the objects which match it.
+ *
+ * The paths are resolved in a single traversal of the object graph,
+ * their common prefixes being resolved only once.  This is much faster
+ * than matching the paths one by one when, e.g., connecting a trace
+ * sink to each of the devices of a large number of nodes:
+ *
+ * \code
+ *   std::vector<std::string> paths;
+ *   for (uint32_t i = 0; i < NodeList::GetNNodes(); i++)
+ *   {
+ *       paths.push_back("/NodeList/" + std::to_string(i) + "/DeviceList/0");
+ *   }
+ *   auto matches = Config::LookupMatches(paths);
+ *   for (uint32_t i = 0; i < matches.size(); i++)
+ *   {
+ *       matches[i].ConnectWithoutContext("MacTx", MakeBoundCallback(&MacTx, i));
+ *   }
+ * \endcode
+ */
+std::vector<MatchContainer> LookupMatches(const std::vector<std::string>& paths);
 
 /**
  * \ingroup config
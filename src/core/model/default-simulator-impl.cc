@@ -9,9 +9,11 @@
 #include "default-simulator-impl.h"
 
 #include "assert.h"
+#include "global-value.h"
 #include "log.h"
 #include "scheduler.h"
 #include "simulator.h"
+#include "string.h"
 
 #include <cmath>
 
@@ -31,6 +33,21 @@ NS_LOG_COMPONENT_DEFINE("DefaultSimulatorImpl");
 
 NS_OBJECT_ENSURE_REGISTERED(DefaultSimulatorImpl);
 
+/**
+ * \ingroup events
+ * \anchor GlobalValueEventProfile
+ * The output files prefix of the EventProfiler.
+ *
+ * The DefaultSimulatorImpl profiles the events it executes if this
+ * global value is not empty.
+ */
+static GlobalValue g_eventProfile =
+    GlobalValue("EventProfile",
+                "The output files prefix of the event profile, "
+                "or empty to disable the event profiler",
+                StringValue(""),
+                MakeStringChecker());
+
 TypeId
 DefaultSimulatorImpl::GetTypeId()
 {
@@ -51,13 +68,22 @@ DefaultSimulatorImpl::DefaultSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
-    m_eventsWithContextEmpty = true;
     m_mainThreadId = std::this_thread::get_id();
+
+    StringValue profile;
+    g_eventProfile.GetValue(profile);
+    m_profilePrefix = profile.Get();
+    if (!m_profilePrefix.empty())
+    {
+        m_profiler = std::make_unique<EventProfiler>();
+    }
 }
 
 DefaultSimulatorImpl::~DefaultSimulatorImpl()
 {
     NS_LOG_FUNCTION(this);
+    // Release the events scheduled from other threads since DoDispose()
+    m_eventsWithContext.Drain([](const EventWithContext& event) { event.event->Unref(); });
 }
 
 void
@@ -89,6 +115,11 @@ DefaultSimulatorImpl::Destroy()
             ev->Invoke();
         }
     }
+
+    if (m_profiler)
+    {
+        m_profiler->Write(m_profilePrefix);
+    }
 }
 
 void
@@ -130,7 +161,14 @@ DefaultSimulatorImpl::ProcessOneEvent()
     m_currentTs = next.key.m_ts;
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
-    next.impl->Invoke();
+    if (m_profiler)
+    {
+        m_profiler->Invoke(next.impl, next.key.m_context);
+    }
+    else
+    {
+        next.impl->Invoke();
+    }
     next.impl->Unref();
 
     ProcessEventsWithContext();
@@ -145,22 +183,13 @@ DefaultSimulatorImpl::IsFinished() const
 void
 DefaultSimulatorImpl::ProcessEventsWithContext()
 {
-    if (m_eventsWithContextEmpty)
+    if (m_eventsWithContext.IsEmpty())
     {
         return;
     }
 
-    // swap queues
-    EventsWithContext eventsWithContext;
-    {
-        std::unique_lock lock{m_eventsWithContextMutex};
-        m_eventsWithContext.swap(eventsWithContext);
-        m_eventsWithContextEmpty = true;
-    }
-    while (!eventsWithContext.empty())
-    {
-        EventWithContext event = eventsWithContext.front();
-        eventsWithContext.pop_front();
+    // Move all the pending events at once
+    m_eventsWithContext.Drain([this](const EventWithContext& event) {
         Scheduler::Event ev;
         ev.impl = event.event;
         ev.key.m_ts = m_currentTs + event.timestamp;
@@ -169,7 +198,7 @@ DefaultSimulatorImpl::ProcessEventsWithContext()
         m_uid++;
         m_unscheduledEvents++;
         m_events->Insert(ev);
-    }
+    });
 }
 
 void
@@ -253,11 +282,7 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
         // Current time added in ProcessEventsWithContext()
         ev.timestamp = delay.GetTimeStep();
         ev.event = event;
-        {
-            std::unique_lock lock{m_eventsWithContextMutex};
-            m_eventsWithContext.push_back(ev);
-            m_eventsWithContextEmpty = false;
-        }
+        m_eventsWithContext.Push(ev);
     }
 }
 
@@ -9,10 +9,12 @@
 #ifndef DEFAULT_SIMULATOR_IMPL_H
 #define DEFAULT_SIMULATOR_IMPL_H
 
+#include "event-profiler.h"
+#include "mpsc-queue.h"
 #include "simulator-impl.h"
 
 #include <list>
-#include <mutex>
+#include <memory>
 #include <thread>
 
 /**
@@ -86,17 +88,8 @@ class DefaultSimulatorImpl : public SimulatorImpl
         EventImpl* event;
     };
 
-    /** Container type for the events from a different context. */
-    typedef std::list<EventWithContext> EventsWithContext;
-    /** The container of events from a different context. */
-    EventsWithContext m_eventsWithContext;
-    /**
-     * Flag \c true if all events with context have been moved to the
-     * primary event queue.
-     */
-    bool m_eventsWithContextEmpty;
-    /** Mutex to control access to the list of events with context. */
-    std::mutex m_eventsWithContextMutex;
+    /** The lock-free inbox of events scheduled from other threads. */
+    MpscQueue<EventWithContext> m_eventsWithContext;
 
     /** Container type for the events to run at Simulator::Destroy() */
     typedef std::list<EventId> DestroyEvents;
@@ -125,6 +118,11 @@ class DefaultSimulatorImpl : public SimulatorImpl
 
     /** Main execution thread. */
     std::thread::id m_mainThreadId;
+
+    /** The event profiler, if enabled by the EventProfile global value. */
+    std::unique_ptr<EventProfiler> m_profiler;
+    /** The event profile output files prefix. */
+    std::string m_profilePrefix;
 };
 
 } // namespace ns3
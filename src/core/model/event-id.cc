@@ -26,18 +26,30 @@ EventId::EventId()
     : m_eventImpl(nullptr),
       m_ts(0),
       m_context(0),
-      m_uid(0)
+      m_uid(0),
+      m_generation(0)
 {
     NS_LOG_FUNCTION(this);
 }
 
 EventId::EventId(const Ptr<EventImpl>& impl, uint64_t ts, uint32_t context, uint32_t uid)
-    : m_eventImpl(impl),
+    : m_eventImpl(PeekPointer(impl)),
       m_ts(ts),
       m_context(context),
-      m_uid(uid)
+      m_uid(uid),
+      m_generation(0)
 {
     NS_LOG_FUNCTION(this << impl << ts << context << uid);
+    // The simulator holds the reference to the pooled events in its event
+    // queue, but not to the destroy events, which are owned by their EventId
+    if (m_eventImpl != nullptr && uid != UID::DESTROY)
+    {
+        m_generation = m_eventImpl->GetGeneration();
+    }
+    if (IsOwner())
+    {
+        m_eventImpl->Ref();
+    }
 }
 
 void
@@ -74,13 +86,6 @@ EventId::IsRunning() const
     return IsPending();
 }
 
-EventImpl*
-EventId::PeekEventImpl() const
-{
-    NS_LOG_FUNCTION(this);
-    return PeekPointer(m_eventImpl);
-}
-
 uint64_t
 EventId::GetTs() const
 {
@@ -10,6 +10,7 @@
 
 #include "deprecated.h"
 #include "event-impl.h"
+#include "event-pool.h"
 #include "ptr.h"
 
 #include <stdint.h>
@@ -40,6 +41,11 @@ class EventImpl;
  * Simulator::Schedule() method:  calling Simulator::Cancel(), IsPending(),
  * IsExpired() or passing around instances of this object
  * will not result in crashes or memory leaks.
+ *
+ * An EventId normally holds a reference to its EventImpl.  When the
+ * EventPool is enabled, an EventId referring to a pooled event holds
+ * the generation of its slot instead, and behaves as an expired event
+ * once the slot has been recycled by the simulator.
  */
 class EventId
 {
@@ -70,6 +76,21 @@ class EventId
      * \param [in] uid The unique id for this EventId.
      */
     EventId(const Ptr<EventImpl>& impl, uint64_t ts, uint32_t context, uint32_t uid);
+    /**
+     * Copy constructor.
+     *
+     * \param [in] o The EventId to copy.
+     */
+    EventId(const EventId& o);
+    /**
+     * Copy assignment operator.
+     *
+     * \param [in] o The EventId to copy.
+     * \return This EventId.
+     */
+    EventId& operator=(const EventId& o);
+    /** Destructor. */
+    ~EventId();
     /**
      * This method is syntactic sugar for the ns3::Simulator::Cancel
      * method.
@@ -108,7 +129,10 @@ class EventId
      * subclasses of the Scheduler base class.
      */
     /**@{*/
-    /** \return The underlying EventImpl pointer. */
+    /**
+     * \return The underlying EventImpl pointer, or \c nullptr if the event
+     * was pooled and has since been recycled.
+     */
     EventImpl* PeekEventImpl() const;
     /** \return The virtual time stamp. */
     uint64_t GetTs() const;
@@ -141,16 +165,79 @@ class EventId
     friend bool operator<(const EventId& a, const EventId& b);
 
   private:
-    Ptr<EventImpl> m_eventImpl; /**< The underlying event implementation. */
-    uint64_t m_ts;              /**< The virtual time stamp. */
-    uint32_t m_context;         /**< The context. */
-    uint32_t m_uid;             /**< The unique id. */
+    /**
+     * \return \c true if this EventId holds a reference to its EventImpl,
+     * i.e. if the event is not pooled.
+     */
+    bool IsOwner() const;
+
+    EventImpl* m_eventImpl; /**< The underlying event implementation. */
+    uint64_t m_ts;          /**< The virtual time stamp. */
+    uint32_t m_context;     /**< The context. */
+    uint32_t m_uid;         /**< The unique id. */
+    uint32_t m_generation;  /**< The slot generation of a pooled event, or 0. */
 };
 
 /*************************************************
  **  Inline implementations
  ************************************************/
 
+inline bool
+EventId::IsOwner() const
+{
+    return m_eventImpl != nullptr && m_generation == 0;
+}
+
+inline EventId::EventId(const EventId& o)
+    : m_eventImpl(o.m_eventImpl),
+      m_ts(o.m_ts),
+      m_context(o.m_context),
+      m_uid(o.m_uid),
+      m_generation(o.m_generation)
+{
+    if (IsOwner())
+    {
+        m_eventImpl->Ref();
+    }
+}
+
+inline EventId&
+EventId::operator=(const EventId& o)
+{
+    if (o.IsOwner())
+    {
+        o.m_eventImpl->Ref();
+    }
+    if (IsOwner())
+    {
+        m_eventImpl->Unref();
+    }
+    m_eventImpl = o.m_eventImpl;
+    m_ts = o.m_ts;
+    m_context = o.m_context;
+    m_uid = o.m_uid;
+    m_generation = o.m_generation;
+    return *this;
+}
+
+inline EventId::~EventId()
+{
+    if (IsOwner())
+    {
+        m_eventImpl->Unref();
+    }
+}
+
+inline EventImpl*
+EventId::PeekEventImpl() const
+{
+    if (m_generation != 0 && EventPool::IsRecycled(m_eventImpl, m_generation))
+    {
+        return nullptr;
+    }
+    return m_eventImpl;
+}
+
 inline bool
 operator==(const EventId& a, const EventId& b)
 {
@@ -8,6 +8,7 @@
 
 #include "event-impl.h"
 
+#include "event-pool.h"
 #include "log.h"
 
 /**
@@ -27,7 +28,8 @@ EventImpl::~EventImpl()
 }
 
 EventImpl::EventImpl()
-    : m_cancel(false)
+    : m_generation(EventPool::Adopt(this)),
+      m_cancel(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -56,4 +58,35 @@ EventImpl::IsCancelled()
     return m_cancel;
 }
 
+EventImpl::Handler
+EventImpl::GetHandler() const
+{
+    return {&typeid(*this), nullptr};
+}
+
+void*
+EventImpl::operator new(std::size_t size)
+{
+    return EventPool::Allocate(size);
+}
+
+void
+EventImpl::operator delete(void* p)
+{
+    EventPool::Deallocate(p);
+}
+
+void
+EventImplDeleter::Delete(EventImpl* impl)
+{
+    if (impl->GetGeneration() == 0)
+    {
+        delete impl;
+        return;
+    }
+    // A pooled event lies at the start of its slot, see EventPool::Adopt()
+    impl->~EventImpl();
+    EventPool::Release(impl);
+}
+
 } // namespace ns3
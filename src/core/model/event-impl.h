@@ -10,7 +10,9 @@
 
 #include "simple-ref-count.h"
 
+#include <cstddef>
 #include <stdint.h>
+#include <typeinfo>
 
 /**
  * \file
@@ -21,6 +23,22 @@
 namespace ns3
 {
 
+class EventImpl;
+
+/**
+ * \ingroup events
+ * \brief Release an EventImpl, to the heap or to its EventPool slot.
+ */
+struct EventImplDeleter
+{
+    /**
+     * Destroy an event and release its memory.
+     *
+     * \param [in] impl The event.
+     */
+    static void Delete(EventImpl* impl);
+};
+
 /**
  * \ingroup events
  * \brief A simulation event.
@@ -31,9 +49,16 @@ namespace ns3
  * are usually created by one of the many Simulator::Schedule
  * methods.
  */
-class EventImpl : public SimpleRefCount<EventImpl>
+class EventImpl : public SimpleRefCount<EventImpl, Empty, EventImplDeleter>
 {
   public:
+    /** The function invoked by an event, see GetHandler(). */
+    struct Handler
+    {
+        const std::type_info* type; //!< The function type, or the event type.
+        const void* function;       //!< The function address, or \c nullptr if unknown.
+    };
+
     /** Default constructor. */
     EventImpl();
     /** Destructor. */
@@ -55,6 +80,38 @@ class EventImpl : public SimpleRefCount<EventImpl>
      * Checked by the simulation engine before calling Invoke().
      */
     bool IsCancelled();
+    /**
+     * \returns The generation of the EventPool slot of the event, or 0 if
+     * the event is allocated on the heap.
+     */
+    uint32_t GetGeneration() const
+    {
+        return m_generation;
+    }
+    /**
+     * Get the function invoked by the event, e.g., to profile it.
+     *
+     * \return For the events created by MakeEvent(), the type and address of
+     *         the function, or the type of the functor; otherwise, the
+     *         dynamic type of the event.
+     */
+    virtual Handler GetHandler() const;
+
+    /**
+     * Allocate an event, through the EventPool.
+     *
+     * \param [in] size The object size.
+     * \return The allocated memory.
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Release an event allocated on the heap, through the EventPool.
+     *
+     * The pooled events are released by EventImplDeleter.
+     *
+     * \param [in] p The object memory.
+     */
+    static void operator delete(void* p);
 
   protected:
     /**
@@ -66,7 +123,8 @@ class EventImpl : public SimpleRefCount<EventImpl>
     virtual void Notify() = 0;
 
   private:
-    bool m_cancel; /**< Has this event been cancelled. */
+    uint32_t m_generation; /**< The generation of the EventPool slot, or 0. */
+    bool m_cancel;         /**< Has this event been cancelled. */
 };
 
 } // namespace ns3
@@ -0,0 +1,150 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "event-pool.h"
+
+#include "abort.h"
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+
+#include <mutex>
+#include <new>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::EventPool implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EventPool");
+
+std::atomic<bool> EventPool::m_enabled = false;
+thread_local EventPool::Slot* EventPool::m_free[EventPool::N_CLASSES] = {};
+thread_local EventPool::Slot* EventPool::m_pending[EventPool::MAX_PENDING] = {};
+thread_local std::size_t EventPool::m_nPending = 0;
+
+void
+EventPool::Enable()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    m_enabled.store(true, std::memory_order_relaxed);
+}
+
+void
+EventPool::Disable()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    m_enabled.store(false, std::memory_order_relaxed);
+}
+
+bool
+EventPool::IsEnabled()
+{
+    return m_enabled.load(std::memory_order_relaxed);
+}
+
+void
+EventPool::Grow(uint32_t sizeClass)
+{
+    NS_LOG_FUNCTION(sizeClass);
+    // The slabs are never released, see the class documentation; keeping
+    // them in a list only tells memory checkers they are still reachable.
+    static std::mutex mutex;
+    static auto slabs = new std::vector<void*>;
+
+    std::size_t slotSize = sizeof(Header) + (sizeClass + 1) * CLASS_SIZE;
+    auto slab = static_cast<char*>(::operator new(slotSize * SLAB_SLOTS));
+    {
+        std::lock_guard lock(mutex);
+        slabs->push_back(slab);
+    }
+    for (std::size_t i = 0; i < SLAB_SLOTS; ++i)
+    {
+        auto slot = reinterpret_cast<Slot*>(slab + i * slotSize);
+        slot->header.generation = 1;
+        slot->header.sizeClass = sizeClass;
+        slot->next = m_free[sizeClass];
+        m_free[sizeClass] = slot;
+    }
+}
+
+void*
+EventPool::Allocate(std::size_t size)
+{
+    if (!m_enabled.load(std::memory_order_relaxed) || size > MAX_SIZE ||
+        m_nPending == MAX_PENDING)
+    {
+        return ::operator new(size);
+    }
+
+    uint32_t sizeClass = (size - 1) / CLASS_SIZE;
+    if (m_free[sizeClass] == nullptr)
+    {
+        Grow(sizeClass);
+    }
+    Slot* slot = m_free[sizeClass];
+    m_free[sizeClass] = slot->next;
+    // The EventImpl constructor picks the slot up, see Adopt()
+    m_pending[m_nPending++] = slot;
+    return &slot->header + 1;
+}
+
+void
+EventPool::Deallocate(void* p)
+{
+    ::operator delete(p);
+}
+
+uint32_t
+EventPool::Adopt(const EventImpl* impl)
+{
+    if (m_nPending == 0)
+    {
+        return 0;
+    }
+    // The events built while building a pooled event, e.g., from its
+    // constructor arguments, are allocated and constructed in between, so
+    // the slot of the event is the last pending one
+    Slot* slot = m_pending[m_nPending - 1];
+    auto object = reinterpret_cast<const char*>(&slot->header + 1);
+    auto p = reinterpret_cast<const char*>(impl);
+    if (p != object)
+    {
+        NS_ABORT_MSG_IF(p > object && p < object + (slot->header.sizeClass + 1) * CLASS_SIZE,
+                        "EventImpl must be the first base class of a pooled event");
+        // An event allocated on the heap while building the pooled one
+        return 0;
+    }
+    m_nPending--;
+    return slot->header.generation;
+}
+
+void
+EventPool::Release(EventImpl* impl)
+{
+    Header* header = reinterpret_cast<Header*>(impl) - 1;
+    // Invalidate the EventIds referring to the previous occupant
+    if (++header->generation == 0)
+    {
+        header->generation = 1;
+    }
+    auto slot = reinterpret_cast<Slot*>(header);
+    NS_ASSERT(header->sizeClass < N_CLASSES);
+    slot->next = m_free[header->sizeClass];
+    m_free[header->sizeClass] = slot;
+}
+
+bool
+EventPool::IsRecycled(const EventImpl* impl, uint32_t generation)
+{
+    NS_ASSERT(generation != 0);
+    return (reinterpret_cast<const Header*>(impl) - 1)->generation != generation;
+}
+
+} // namespace ns3
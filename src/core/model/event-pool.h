@@ -0,0 +1,161 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef EVENT_POOL_H
+#define EVENT_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::EventPool declaration.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * \ingroup events
+ * \brief Slab allocator for EventImpl instances.
+ *
+ * All the EventImpl instances, including the ones created by
+ * MakeEvent() for the Simulator::Schedule() methods, are allocated
+ * through this class.  By default they are simply allocated on the
+ * heap.  Once Enable() has been called, the small ones (up to
+ * \c MAX_SIZE bytes, which covers the member function and small
+ * lambda events) are instead carved out of fixed-size slabs, one per
+ * size class, and recycled as soon as the simulator has executed or
+ * removed them.
+ *
+ * Each pooled slot carries a generation number, incremented every time
+ * the slot is recycled.  An EventId referring to a pooled event does not
+ * hold a reference to it; instead it records the generation of the slot
+ * and compares it to the current one before touching the event, so that
+ * EventId::Cancel() and EventId::IsExpired() keep their usual semantics
+ * once the slot has been reused.  The EventImpl constructor copies the
+ * generation of its slot, see Adopt(), so that the EventId finds it
+ * without looking for the slot; this requires EventImpl to be the first
+ * base class of the pooled events.  The events allocated on the heap
+ * carry no slot header, and have a generation of 0.
+ *
+ * The free lists are per thread, and the slabs are never returned to the
+ * system, so that a stale EventId can always safely check the generation
+ * of its slot.  A slot freed by a thread is reused by that thread, so
+ * events can be scheduled from a thread and executed by another one.
+ */
+class EventPool
+{
+  public:
+    /** Largest object size, in bytes, served from the slabs. */
+    static constexpr std::size_t MAX_SIZE = 256;
+
+    /**
+     * Serve the small EventImpl allocations from the slabs.
+     *
+     * Should be called before the simulation starts; the events
+     * allocated before this call remain on the heap.
+     */
+    static void Enable();
+    /** Allocate all new EventImpl instances on the heap. */
+    static void Disable();
+    /**
+     * \return \c true if the small EventImpl allocations are pooled.
+     */
+    static bool IsEnabled();
+
+    /**
+     * Allocate the memory for an EventImpl.
+     *
+     * \param [in] size The object size.
+     * \return The allocated memory.
+     */
+    static void* Allocate(std::size_t size);
+    /**
+     * Release the memory of an EventImpl allocated on the heap.
+     *
+     * \param [in] p The memory returned by Allocate().
+     */
+    static void Deallocate(void* p);
+    /**
+     * Get the generation of the slot of an EventImpl being constructed.
+     *
+     * \param [in] impl The event.
+     * \return The slot generation, or 0 if the event is not pooled.
+     */
+    static uint32_t Adopt(const EventImpl* impl);
+    /**
+     * Recycle the slot of a pooled event, once it has been destroyed.
+     *
+     * \param [in] impl The event, whose generation was not 0.
+     */
+    static void Release(EventImpl* impl);
+    /**
+     * Check if the slot of a pooled event has been recycled.
+     *
+     * Unlike EventImpl::GetGeneration(), this method can be called once
+     * the event has been destroyed.
+     *
+     * \param [in] impl The event.
+     * \param [in] generation The generation returned by EventImpl::GetGeneration()
+     *             while the event was alive; must not be 0.
+     * \return \c true if the event has been released since.
+     */
+    static bool IsRecycled(const EventImpl* impl, uint32_t generation);
+
+  private:
+    /** Memory header preceding every pooled EventImpl. */
+    struct alignas(std::max_align_t) Header
+    {
+        /** Slot generation, never 0. */
+        uint32_t generation;
+        /** Size class index. */
+        uint32_t sizeClass;
+    };
+
+    /** A pooled slot: the header, followed by the object. */
+    struct Slot
+    {
+        /** The header. */
+        Header header;
+        /** Next free slot of the same size class, while the slot is free. */
+        Slot* next;
+    };
+
+    /** Size class granularity, in bytes. */
+    static constexpr std::size_t CLASS_SIZE = alignof(std::max_align_t);
+    /** Number of size classes. */
+    static constexpr std::size_t N_CLASSES = MAX_SIZE / CLASS_SIZE;
+    /** Number of slots allocated at once. */
+    static constexpr std::size_t SLAB_SLOTS = 64;
+    /**
+     * Maximum number of pooled events under construction at once in a
+     * thread, i.e. allocated while building another pooled event.
+     */
+    static constexpr std::size_t MAX_PENDING = 4;
+
+    /**
+     * Allocate a new slab and add its slots to the free list.
+     *
+     * \param [in] sizeClass The size class.
+     */
+    static void Grow(uint32_t sizeClass);
+
+    /** Whether the allocations are pooled. */
+    static std::atomic<bool> m_enabled;
+    /** Free lists of the calling thread, by size class. */
+    static thread_local Slot* m_free[N_CLASSES];
+    /** Slots allocated by the calling thread, whose EventImpl is not constructed yet. */
+    static thread_local Slot* m_pending[MAX_PENDING];
+    /** Number of pending slots of the calling thread. */
+    static thread_local std::size_t m_nPending;
+};
+
+} // namespace ns3
+
+#endif /* EVENT_POOL_H */
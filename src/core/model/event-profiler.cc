@@ -0,0 +1,146 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "event-profiler.h"
+
+#include "demangle.h"
+#include "event-impl.h"
+#include "fatal-error.h"
+#include "log.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <typeindex>
+#include <vector>
+
+#if __has_include(<dlfcn.h>)
+#include <dlfcn.h>
+#define NS3_EVENT_PROFILER_DLADDR
+#endif
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EventProfiler");
+
+void
+EventProfiler::Invoke(EventImpl* impl, uint32_t context)
+{
+    // The event may be deleted once invoked
+    EventImpl::Handler handler = impl->GetHandler();
+    Key key{handler.type, handler.function, context};
+    auto start = std::chrono::steady_clock::now();
+    impl->Invoke();
+    auto end = std::chrono::steady_clock::now();
+
+    int64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    Counters& counters = m_counters[key];
+    counters.count++;
+    counters.total += duration;
+    counters.max = std::max(counters.max, duration);
+}
+
+std::string
+EventProfiler::GetHandlerName(const EventImpl::Handler& handler)
+{
+    std::string name = Demangle(handler.type->name());
+    if (handler.function == nullptr)
+    {
+        return name;
+    }
+#ifdef NS3_EVENT_PROFILER_DLADDR
+    Dl_info info;
+    if (dladdr(handler.function, &info) != 0)
+    {
+        // dladdr() returns the closest symbol below the address, which is
+        // another function if the handler has no dynamic symbol
+        if (info.dli_sname != nullptr && info.dli_saddr == handler.function)
+        {
+            return Demangle(info.dli_sname);
+        }
+        std::ostringstream oss;
+        oss << name << " [" << (info.dli_fname != nullptr ? info.dli_fname : "") << "+0x"
+            << std::hex
+            << reinterpret_cast<uintptr_t>(handler.function) -
+                   reinterpret_cast<uintptr_t>(info.dli_fbase)
+            << "]";
+        return oss.str();
+    }
+#endif
+    std::ostringstream oss;
+    oss << name << " [" << handler.function << "]";
+    return oss.str();
+}
+
+void
+EventProfiler::Write(const std::string& prefix) const
+{
+    NS_LOG_FUNCTION(this << prefix);
+
+    struct Entry
+    {
+        std::string handler;
+        uint32_t context;
+        Counters counters;
+    };
+
+    std::map<std::pair<std::type_index, const void*>, std::string> names;
+    std::vector<Entry> entries;
+    for (const auto& [key, counters] : m_counters)
+    {
+        std::pair<std::type_index, const void*> handler{*key.type, key.function};
+        auto it = names.find(handler);
+        if (it == names.end())
+        {
+            it = names.emplace(handler, GetHandlerName({key.type, key.function})).first;
+        }
+        entries.push_back({it->second, key.context, counters});
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.counters.total > b.counters.total;
+    });
+
+    std::ofstream folded(prefix + ".folded");
+    std::ofstream csv(prefix + ".csv");
+    if (!folded.is_open() || !csv.is_open())
+    {
+        NS_FATAL_ERROR("Cannot open the event profile files " << prefix << ".*");
+    }
+
+    csv << "handler,context,count,total_ns,mean_ns,max_ns\n";
+    for (const auto& entry : entries)
+    {
+        // Frames are separated by semicolons in the folded stacks
+        std::string frame = entry.handler;
+        std::replace(frame.begin(), frame.end(), ';', ':');
+        std::string quoted;
+        for (auto c : entry.handler)
+        {
+            quoted += (c == '"') ? "\"\"" : std::string(1, c);
+        }
+        std::string context = entry.context == Simulator::NO_CONTEXT
+                                  ? "no context"
+                                  : "context " + std::to_string(entry.context);
+
+        folded << frame << ";" << context << " " << entry.counters.total << "\n";
+        csv << "\"" << quoted << "\","
+            << (entry.context == Simulator::NO_CONTEXT ? "" : std::to_string(entry.context))
+            << "," << entry.counters.count << "," << entry.counters.total << ","
+            << entry.counters.total / static_cast<int64_t>(entry.counters.count) << ","
+            << entry.counters.max << "\n";
+    }
+    NS_LOG_INFO("wrote " << entries.size() << " profile entries");
+}
+
+} // namespace ns3
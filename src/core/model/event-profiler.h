@@ -0,0 +1,130 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include "event-impl.h"
+
+#include <stdint.h>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::EventProfiler declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup events
+ * \brief Attribute the wall clock time spent in events to their handlers.
+ *
+ * The profiler executes the events on behalf of the simulator,
+ * measuring the wall clock duration of each one, and accumulates it per
+ * handler and per context.  The handler of an event is the function
+ * it invokes, see EventImpl::GetHandler(): for the events created by
+ * MakeEvent(), the address of the function or member function, with
+ * the virtual functions resolved on the object, or the type of the
+ * lambda or functor.  The functions are named after the symbols of
+ * the shared libraries, where available.
+ *
+ * The DefaultSimulatorImpl profiles all the events it executes when the
+ * \ref GlobalValueEventProfile "EventProfile" global value is set to an
+ * output file prefix, and writes the profile at Simulator::Destroy():
+ *
+ * - \c <prefix>.folded, in the folded stacks format of the flame graph
+ *   tools, with the handler as the root frame and the context as the leaf
+ *   frame, weighted by the total duration in nanoseconds;
+ * - \c <prefix>.csv, with one line per handler and context, giving the
+ *   number of events and their total, mean and maximum durations in
+ *   nanoseconds, sorted by decreasing total duration.
+ *
+ * \code
+ *   ./ns3 run "my-program --EventProfile=my-profile"
+ *   flamegraph.pl my-profile.folded > my-profile.svg
+ * \endcode
+ */
+class EventProfiler
+{
+  public:
+    /**
+     * Execute an event, and record its duration.
+     *
+     * \param [in] impl The event.
+     * \param [in] context The event context.
+     */
+    void Invoke(EventImpl* impl, uint32_t context);
+
+    /**
+     * Write the profile in the folded stacks and CSV formats.
+     *
+     * \param [in] prefix The output files prefix.
+     */
+    void Write(const std::string& prefix) const;
+
+    /**
+     * Get a readable name for an event handler.
+     *
+     * \param [in] handler The event handler.
+     * \return The handler name: the demangled name of the function symbol,
+     *         if found; otherwise the demangled type, followed by the
+     *         function offset in its shared object, if known.
+     */
+    static std::string GetHandlerName(const EventImpl::Handler& handler);
+
+  private:
+    /** Profile entry key. */
+    struct Key
+    {
+        const std::type_info* type; //!< Type of the handler.
+        const void* function;       //!< Address of the handler, if known.
+        uint32_t context;           //!< Event context.
+
+        /**
+         * Equality operator.
+         * \param [in] other The other key.
+         * \return \c true if both keys are equal.
+         */
+        bool operator==(const Key& other) const
+        {
+            return *type == *other.type && function == other.function &&
+                   context == other.context;
+        }
+    };
+
+    /** Hash function for the profile keys. */
+    struct KeyHash
+    {
+        /**
+         * Hash a key.
+         * \param [in] key The key.
+         * \return The hash value.
+         */
+        std::size_t operator()(const Key& key) const
+        {
+            return key.type->hash_code() ^ (std::hash<const void*>()(key.function) << 1) ^
+                   (std::hash<uint32_t>()(key.context) << 2);
+        }
+    };
+
+    /** Profile entry. */
+    struct Counters
+    {
+        uint64_t count{0}; //!< Number of events.
+        int64_t total{0};  //!< Total duration, in nanoseconds.
+        int64_t max{0};    //!< Maximum duration, in nanoseconds.
+    };
+
+    /** The profile. */
+    std::unordered_map<Key, Counters, KeyHash> m_counters;
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
@@ -0,0 +1,342 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ladder-scheduler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+#include "uinteger.h"
+
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler class implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(LadderScheduler);
+
+/**
+ * Compare two events by key.
+ *
+ * \param [in] a The first event.
+ * \param [in] b The second event.
+ * \return \c true if \p a is earlier than \p b.
+ */
+static bool
+EventLess(const Scheduler::Event& a, const Scheduler::Event& b)
+{
+    return a.key < b.key;
+}
+
+TypeId
+LadderScheduler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::LadderScheduler")
+            .SetParent<Scheduler>()
+            .SetGroupName("Core")
+            .AddConstructor<LadderScheduler>()
+            .AddAttribute("Threshold",
+                          "Maximum number of events sorted at once: larger buckets are "
+                          "split into a new rung, and a larger Bottom is converted into a rung",
+                          UintegerValue(50),
+                          MakeUintegerAccessor(&LadderScheduler::m_threshold),
+                          MakeUintegerChecker<uint32_t>(2))
+            .AddAttribute("MaxRungs",
+                          "Maximum number of rungs in the ladder",
+                          UintegerValue(8),
+                          MakeUintegerAccessor(&LadderScheduler::m_maxRungs),
+                          MakeUintegerChecker<uint32_t>(1));
+    return tid;
+}
+
+LadderScheduler::LadderScheduler()
+    : m_topStart(0),
+      m_topMin(0),
+      m_topMax(0),
+      m_nRungs(0),
+      m_qSize(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LadderScheduler::~LadderScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LadderScheduler::Rung&
+LadderScheduler::AddRung(uint64_t start, uint64_t width, uint32_t nBuckets)
+{
+    NS_LOG_FUNCTION(this << start << width << nBuckets);
+    if (m_nRungs == m_rungs.size())
+    {
+        m_rungs.emplace_back();
+    }
+    Rung& rung = m_rungs[m_nRungs];
+    m_nRungs++;
+    // Buckets of a reused rung are empty, but keep their capacity
+    rung.buckets.resize(nBuckets);
+    rung.width = width;
+    rung.start = start;
+    rung.current = start;
+    rung.currentBucket = 0;
+    rung.count = 0;
+    return rung;
+}
+
+void
+LadderScheduler::InsertInRung(Rung& rung, const Scheduler::Event& ev)
+{
+    uint64_t bucket = (ev.key.m_ts - rung.start) / rung.width;
+    NS_ASSERT(bucket >= rung.currentBucket && bucket < rung.buckets.size());
+    rung.buckets[bucket].push_back(ev);
+    rung.count++;
+}
+
+uint32_t
+LadderScheduler::FindRung(uint64_t ts) const
+{
+    uint32_t i = 0;
+    while (i < m_nRungs && ts < m_rungs[i].current)
+    {
+        i++;
+    }
+    return i;
+}
+
+void
+LadderScheduler::InsertInBottom(const Scheduler::Event& ev)
+{
+    // Events are most often scheduled after all the ones already in Bottom
+    if (m_bottom.empty() || m_bottom.back().key < ev.key)
+    {
+        m_bottom.push_back(ev);
+        return;
+    }
+    auto it = std::upper_bound(m_bottom.begin(), m_bottom.end(), ev, EventLess);
+    m_bottom.insert(it, ev);
+}
+
+void
+LadderScheduler::TransferTop()
+{
+    NS_LOG_FUNCTION(this << m_top.size() << m_topMin << m_topMax);
+    NS_ASSERT(!m_top.empty() && m_bottom.empty() && m_nRungs == 0);
+
+    if (m_top.size() <= m_threshold || m_topMin == m_topMax)
+    {
+        std::sort(m_top.begin(), m_top.end(), EventLess);
+        m_bottom.assign(m_top.begin(), m_top.end());
+        m_topStart = m_topMax + 1;
+        m_top.clear();
+        return;
+    }
+
+    // About one event per bucket, if the events are uniformly spread
+    uint64_t width = (m_topMax - m_topMin) / m_top.size() + 1;
+    uint32_t nBuckets = (m_topMax - m_topMin) / width + 1;
+    Rung& rung = AddRung(m_topMin, width, nBuckets);
+    for (const auto& ev : m_top)
+    {
+        InsertInRung(rung, ev);
+    }
+    m_topStart = m_topMin + nBuckets * width;
+    m_top.clear();
+}
+
+void
+LadderScheduler::SpawnFromBottom()
+{
+    uint64_t start = m_bottom.front().key.m_ts;
+    uint64_t end = m_nRungs > 0 ? m_rungs[m_nRungs - 1].current : m_topStart;
+    if (m_nRungs >= m_maxRungs || start == m_bottom.back().key.m_ts || end <= start)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this << m_bottom.size() << start << end);
+
+    uint64_t width = (end - start) / m_threshold + 1;
+    uint32_t nBuckets = (end - start - 1) / width + 1;
+    Rung& rung = AddRung(start, width, nBuckets);
+    for (const auto& ev : m_bottom)
+    {
+        InsertInRung(rung, ev);
+    }
+    m_bottom.clear();
+    Refill();
+}
+
+void
+LadderScheduler::Refill()
+{
+    while (m_bottom.empty() && m_qSize > 0)
+    {
+        if (m_nRungs == 0)
+        {
+            TransferTop();
+            continue;
+        }
+
+        Rung& rung = m_rungs[m_nRungs - 1];
+        if (rung.count == 0)
+        {
+            m_nRungs--;
+            continue;
+        }
+        while (rung.buckets[rung.currentBucket].empty())
+        {
+            rung.currentBucket++;
+            rung.current += rung.width;
+        }
+        uint64_t bucketStart = rung.current;
+        uint32_t bucketIndex = rung.currentBucket;
+        rung.currentBucket++;
+        rung.current += rung.width;
+        rung.count -= rung.buckets[bucketIndex].size();
+
+        if (rung.buckets[bucketIndex].size() > m_threshold && m_nRungs < m_maxRungs &&
+            rung.width > 1)
+        {
+            // Split the bucket into a finer rung, covering the bucket span
+            uint64_t width = (rung.width - 1) / m_threshold + 1;
+            uint32_t nBuckets = (rung.width - 1) / width + 1;
+            Bucket events;
+            events.swap(m_rungs[m_nRungs - 1].buckets[bucketIndex]);
+            // Adding a rung invalidates the references to the existing ones
+            Rung& child = AddRung(bucketStart, width, nBuckets);
+            for (const auto& ev : events)
+            {
+                InsertInRung(child, ev);
+            }
+            continue;
+        }
+
+        Bucket& bucket = rung.buckets[bucketIndex];
+        std::sort(bucket.begin(), bucket.end(), EventLess);
+        m_bottom.assign(bucket.begin(), bucket.end());
+        bucket.clear();
+    }
+}
+
+void
+LadderScheduler::Insert(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    m_qSize++;
+
+    uint64_t ts = ev.key.m_ts;
+    if (ts >= m_topStart)
+    {
+        if (m_top.empty())
+        {
+            m_topMin = ts;
+            m_topMax = ts;
+        }
+        m_topMin = std::min(m_topMin, ts);
+        m_topMax = std::max(m_topMax, ts);
+        m_top.push_back(ev);
+    }
+    else
+    {
+        uint32_t i = FindRung(ts);
+        if (i < m_nRungs)
+        {
+            InsertInRung(m_rungs[i], ev);
+        }
+        else
+        {
+            InsertInBottom(ev);
+            if (m_bottom.size() > m_threshold)
+            {
+                SpawnFromBottom();
+            }
+        }
+    }
+
+    if (m_bottom.empty())
+    {
+        Refill();
+    }
+}
+
+bool
+LadderScheduler::IsEmpty() const
+{
+    return m_qSize == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    return m_bottom.front();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+
+    Scheduler::Event ev = m_bottom.front();
+    m_bottom.pop_front();
+    m_qSize--;
+    if (m_bottom.empty())
+    {
+        Refill();
+    }
+    NS_LOG_DEBUG("remove " << ev.key.m_ts << ", " << ev.key.m_uid << ", " << ev.impl);
+    return ev;
+}
+
+void
+LadderScheduler::Remove(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    NS_ASSERT(!IsEmpty());
+
+    auto sameUid = [&ev](const Scheduler::Event& other) { return other.key == ev.key; };
+    uint64_t ts = ev.key.m_ts;
+    if (ts >= m_topStart)
+    {
+        auto it = std::find_if(m_top.begin(), m_top.end(), sameUid);
+        NS_ASSERT(it != m_top.end());
+        *it = m_top.back();
+        m_top.pop_back();
+    }
+    else if (uint32_t i = FindRung(ts); i < m_nRungs)
+    {
+        Rung& rung = m_rungs[i];
+        Bucket& bucket = rung.buckets[(ts - rung.start) / rung.width];
+        auto it = std::find_if(bucket.begin(), bucket.end(), sameUid);
+        NS_ASSERT(it != bucket.end());
+        *it = bucket.back();
+        bucket.pop_back();
+        rung.count--;
+    }
+    else
+    {
+        auto it = std::lower_bound(m_bottom.begin(), m_bottom.end(), ev, EventLess);
+        NS_ASSERT(it != m_bottom.end() && it->key == ev.key);
+        m_bottom.erase(it);
+    }
+    m_qSize--;
+
+    if (m_bottom.empty())
+    {
+        Refill();
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,175 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <deque>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler class declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue described in
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Tang, Goh and Thng][Tang].
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * Events are kept in three tiers:
+ *
+ * - \em Top is an unsorted list of the events beyond the range of the
+ *   ladder, typically the long-horizon timers;
+ * - the \em ladder is a stack of rungs, each made of buckets of uniform
+ *   width holding unsorted events.  The width of the first rung is derived
+ *   from the spread of the events transferred from Top; a bucket holding
+ *   more than \c Threshold events is split into a new, finer, rung rather
+ *   than being sorted;
+ * - \em Bottom is a short sorted list of the earliest events, from
+ *   which events are dequeued.
+ *
+ * Only the events which reach Bottom are ever sorted, and the bucket
+ * widths adapt to the local event density, so that clusters of events
+ * in time do not degrade the performance as in the CalendarScheduler.
+ * When Bottom grows beyond \c Threshold events, it is itself converted
+ * into a new rung.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | Append to Top or to a bucket; short sorted Bottom
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | Bottom is never empty
+ * Remove()     | Linear          | Search in Top, a bucket, or Bottom
+ * RemoveNext() | ~Constant       | Transfer and sort one bucket at a time
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                             | Reason
+ * :-------- | :--------------------------------- | :-----
+ * Overhead  | `sizeof (std::deque)` + 2 vectors  | Top, rungs, Bottom
+ * Per Event | ~`sizeof (std::vector)` (24 bytes) | About one bucket per event
+ */
+class LadderScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    LadderScheduler();
+    /** Destructor. */
+    ~LadderScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /** A list of unsorted events. */
+    typedef std::vector<Scheduler::Event> Bucket;
+
+    /** A rung of the ladder. */
+    struct Rung
+    {
+        /** The buckets. */
+        std::vector<Bucket> buckets;
+        /** Width of each bucket, in dimensionless time units. */
+        uint64_t width;
+        /** Start time of the first bucket. */
+        uint64_t start;
+        /** Start time of the current bucket. */
+        uint64_t current;
+        /** Index of the current bucket. */
+        uint32_t currentBucket;
+        /** Number of events in the rung. */
+        uint32_t count;
+    };
+
+    /**
+     * Push a new rung on the ladder.
+     *
+     * \param [in] start The start time of the rung.
+     * \param [in] width The width of the buckets.
+     * \param [in] nBuckets The number of buckets.
+     * \return The new rung.
+     */
+    Rung& AddRung(uint64_t start, uint64_t width, uint32_t nBuckets);
+    /**
+     * Insert an event in a rung.
+     *
+     * \param [in] rung The rung.
+     * \param [in] ev The event.
+     */
+    void InsertInRung(Rung& rung, const Scheduler::Event& ev);
+    /**
+     * Find the rung in which an event belongs.
+     *
+     * \param [in] ts The event timestamp.
+     * \return The rung index, or the number of rungs if the event belongs
+     * to Bottom.
+     */
+    uint32_t FindRung(uint64_t ts) const;
+    /**
+     * Insert an event in Bottom, keeping it sorted.
+     *
+     * \param [in] ev The event.
+     */
+    void InsertInBottom(const Scheduler::Event& ev);
+    /** Move the events of Top into a new first rung. */
+    void TransferTop();
+    /** Convert Bottom into a new rung, when it has grown too large. */
+    void SpawnFromBottom();
+    /** Move the next bucket of the ladder to Bottom, if Bottom is empty. */
+    void Refill();
+
+    /** The events beyond the ladder. */
+    Bucket m_top;
+    /** Start time of Top: events at or after this time are stored in Top. */
+    uint64_t m_topStart;
+    /** Smallest timestamp in Top. */
+    uint64_t m_topMin;
+    /** Largest timestamp in Top. */
+    uint64_t m_topMax;
+
+    /** The rungs, of which the first \c m_nRungs are in use. */
+    std::vector<Rung> m_rungs;
+    /** Number of rungs in use. */
+    uint32_t m_nRungs;
+
+    /** The earliest events, sorted. */
+    std::deque<Scheduler::Event> m_bottom;
+
+    /** Number of events in the queue. */
+    uint32_t m_qSize;
+
+    /** Maximum number of events sorted at once into Bottom. */
+    uint32_t m_threshold;
+    /** Maximum number of rungs. */
+    uint32_t m_maxRungs;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
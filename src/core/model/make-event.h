@@ -10,7 +10,9 @@
 
 #include "warnings.h"
 
+#include <cstring>
 #include <functional>
+#include <stdint.h>
 #include <tuple>
 #include <type_traits>
 
@@ -126,6 +128,92 @@ struct EventMemberImplObjTraits<T*>
     }
 };
 
+/**
+ * \ingroup events
+ * Helper for the MakeEvent functions which take a class method:
+ * the class of a pointer to member.
+ *
+ * \tparam MEM \explicit The pointer to member type.
+ */
+template <typename MEM>
+struct EventMemberClass;
+
+/**
+ * \ingroup events
+ * \copydoc EventMemberClass
+ *
+ * \tparam R \explicit The member type.
+ * \tparam C \explicit The class type.
+ */
+template <typename R, typename C>
+struct EventMemberClass<R C::*>
+{
+    /** The class type. */
+    using Type = C;
+};
+
+/**
+ * \ingroup events
+ * Get the address of the function a pointer to member function refers to,
+ * looking up the virtual functions in the vtable of the object.
+ *
+ * Pointers to member functions are only decoded with the Itanium C++ ABI,
+ * used by GCC and Clang.
+ *
+ * \tparam MEM \deduced The class method function signature.
+ * \tparam OBJ \deduced The class instance type.
+ * \param [in] mem The class method member function pointer.
+ * \param [in] obj The class instance.
+ * \returns The function address, or \c nullptr if unknown.
+ */
+template <typename MEM, typename OBJ>
+const void*
+GetMemberFunctionAddress(MEM mem, const OBJ& obj)
+{
+#ifdef __GXX_ABI_VERSION
+    if constexpr (std::is_member_function_pointer_v<MEM> && sizeof(MEM) == 2 * sizeof(void*))
+    {
+        struct
+        {
+            uintptr_t ptr;  // function address, or vtable offset
+            ptrdiff_t adj;  // this adjustment
+        } pmf;
+
+        std::memcpy(&pmf, &mem, sizeof(pmf));
+#if defined(__arm__) || defined(__aarch64__)
+        bool isVirtual = (pmf.adj & 1) != 0;
+        ptrdiff_t adj = pmf.adj >> 1;
+        uintptr_t offset = pmf.ptr;
+#else
+        bool isVirtual = (pmf.ptr & 1) != 0;
+        ptrdiff_t adj = pmf.adj;
+        uintptr_t offset = pmf.ptr - 1;
+#endif
+        if (!isVirtual)
+        {
+            return reinterpret_cast<const void*>(pmf.ptr);
+        }
+        using C = typename EventMemberClass<MEM>::Type;
+        const C* object = nullptr;
+        if constexpr (std::is_base_of_v<C, OBJ>)
+        {
+            object = &obj;
+        }
+        else if constexpr (requires { &*obj; })
+        {
+            object = &*obj;
+        }
+        if (object != nullptr)
+        {
+            auto self = reinterpret_cast<const char*>(object) + adj;
+            auto vtable = *reinterpret_cast<const char* const*>(self);
+            return *reinterpret_cast<const void* const*>(vtable + offset);
+        }
+    }
+#endif
+    return nullptr;
+}
+
 } // namespace internal
 
 template <typename MEM, typename OBJ, typename... Ts>
@@ -138,10 +226,17 @@ MakeEvent(MEM mem_ptr, OBJ obj, Ts... args)
         EventMemberImpl() = delete;
 
         EventMemberImpl(OBJ obj, MEM function, Ts... args)
-            : m_function(std::bind(function, obj, args...))
+            : m_function(function),
+              m_obj(obj),
+              m_arguments(args...)
         {
         }
 
+        Handler GetHandler() const override
+        {
+            return {&typeid(MEM), internal::GetMemberFunctionAddress(m_function, m_obj)};
+        }
+
       protected:
         ~EventMemberImpl() override
         {
@@ -150,10 +245,13 @@ MakeEvent(MEM mem_ptr, OBJ obj, Ts... args)
       private:
         void Notify() override
         {
-            m_function();
+            std::apply([this](auto&... args) { std::invoke(m_function, m_obj, args...); },
+                       m_arguments);
         }
 
-        std::function<void()> m_function;
+        MEM m_function;
+        OBJ m_obj;
+        std::tuple<std::remove_reference_t<Ts>...> m_arguments;
     }* ev = new EventMemberImpl(obj, mem_ptr, args...);
 
     return ev;
@@ -172,6 +270,11 @@ MakeEvent(void (*f)(Us...), Ts... args)
         {
         }
 
+        Handler GetHandler() const override
+        {
+            return {&typeid(m_function), reinterpret_cast<const void*>(m_function)};
+        }
+
       protected:
         ~EventFunctionImpl() override
         {
@@ -202,6 +305,11 @@ MakeEvent(T function)
         {
         }
 
+        Handler GetHandler() const override
+        {
+            return {&typeid(T), nullptr};
+        }
+
         ~EventImplFunctional() override
         {
         }
@@ -0,0 +1,163 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::MpscQueue declaration and template implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup core
+ * \brief A lock-free, multiple producer, single consumer queue.
+ *
+ * Any number of threads can Push() items concurrently, without ever
+ * taking a lock; a single consumer thread collects all the items pushed
+ * so far with Drain(), in the order they were pushed by each producer.
+ *
+ * The pushed items are linked in a stack, with a single compare and
+ * swap per Push().  Drain() takes the whole stack at once with a single
+ * atomic exchange, then reverses it, so that the consumer never competes
+ * with the producers for individual items.
+ *
+ * \tparam T \explicit The item type.
+ */
+template <typename T>
+class MpscQueue
+{
+  public:
+    /** Constructor. */
+    MpscQueue();
+    /**
+     * Destructor: the items which have not been drained are discarded.  The
+     * owner of the queue must Drain() it first if the items hold resources.
+     */
+    ~MpscQueue();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * Add an item to the queue.  Can be called from any thread.
+     *
+     * \param [in] item The item.
+     */
+    void Push(const T& item);
+
+    /**
+     * Check if the queue is empty.  Items pushed concurrently may not
+     * be visible yet.
+     *
+     * \return \c true if no item is waiting to be drained.
+     */
+    bool IsEmpty() const;
+
+    /**
+     * Remove all the items from the queue, in push order.  Must only be
+     * called from the consumer thread.
+     *
+     * \tparam F \deduced The type of the item consumer.
+     * \param [in] consume The function called on each item.
+     * \return The number of items removed.
+     */
+    template <typename F>
+    std::size_t Drain(F consume);
+
+  private:
+    /** A queued item. */
+    struct Node
+    {
+        T item;     //!< The item.
+        Node* next; //!< The previously pushed item.
+    };
+
+    /** The last pushed item. */
+    std::atomic<Node*> m_head;
+};
+
+/*************************************************
+ **  Template implementation
+ ************************************************/
+
+template <typename T>
+MpscQueue<T>::MpscQueue()
+    : m_head(nullptr)
+{
+}
+
+template <typename T>
+MpscQueue<T>::~MpscQueue()
+{
+    Node* node = m_head.load(std::memory_order_acquire);
+    while (node != nullptr)
+    {
+        Node* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+template <typename T>
+void
+MpscQueue<T>::Push(const T& item)
+{
+    auto node = new Node{item, m_head.load(std::memory_order_relaxed)};
+    // On failure node->next is updated to the current head
+    while (!m_head.compare_exchange_weak(node->next,
+                                         node,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed))
+    {
+    }
+}
+
+template <typename T>
+bool
+MpscQueue<T>::IsEmpty() const
+{
+    return m_head.load(std::memory_order_relaxed) == nullptr;
+}
+
+template <typename T>
+template <typename F>
+std::size_t
+MpscQueue<T>::Drain(F consume)
+{
+    Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+
+    // Reverse the stack into push order
+    Node* first = nullptr;
+    while (node != nullptr)
+    {
+        Node* next = node->next;
+        node->next = first;
+        first = node;
+        node = next;
+    }
+
+    std::size_t count = 0;
+    while (first != nullptr)
+    {
+        Node* next = first->next;
+        consume(first->item);
+        delete first;
+        first = next;
+        ++count;
+    }
+    return count;
+}
+
+} // namespace ns3
+
+#endif /* MPSC_QUEUE_H */
@@ -245,6 +245,26 @@ class ObjectPtrContainerAccessor : public AttributeAccessor
     bool HasGetter() const override;
     bool HasSetter() const override;
 
+    /**
+     * Get the number of instances in the container.
+     *
+     * \param [in] object The container object.
+     * \param [out] n The number of instances in the container.
+     * \returns true if the value could be obtained successfully.
+     */
+    bool GetN(const ObjectBase* object, std::size_t* n) const;
+    /**
+     * Get a single instance from the container, without copying
+     * the whole container into an ObjectPtrContainerValue.
+     *
+     * \param [in] object The container object, for which GetN() succeeded.
+     * \param [in] i The position of the instance, less than the number
+     *            of instances.
+     * \param [out] index The index of the instance in the container.
+     * \returns The instance.
+     */
+    Ptr<Object> Get(const ObjectBase* object, std::size_t i, std::size_t* index) const;
+
   private:
     /**
      * Get the number of instances in the container.
@@ -74,7 +74,7 @@ struct ObjectDeleter
  * invoked from the Unref() method before destroying the Object,
  * even if the user did not call Dispose() directly.
  */
-class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
+class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter, true>
 {
   public:
     /**
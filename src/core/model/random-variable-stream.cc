@@ -13,6 +13,7 @@
  */
 #include "random-variable-stream.h"
 
+#include "abort.h"
 #include "assert.h"
 #include "boolean.h"
 #include "double.h"
@@ -25,6 +26,7 @@
 #include "uinteger.h"
 
 #include <algorithm> // upper_bound
+#include <atomic>
 #include <cmath>
 #include <iostream>
 #include <numbers>
@@ -42,6 +44,156 @@ NS_LOG_COMPONENT_DEFINE("RandomVariableStream");
 
 NS_OBJECT_ENSURE_REGISTERED(RandomVariableStream);
 
+namespace
+{
+
+/**
+ * \ingroup randomvariable
+ * Lock-free registry of the live RandomVariableStream instances.
+ *
+ * Each stream takes a slot in an array of segments which are never moved
+ * nor released, so that streams can register and unregister themselves
+ * from any thread without a lock.  The slots of the destroyed streams are
+ * recycled through a lock-free free list, whose head is tagged with a
+ * counter against the ABA problem.
+ */
+class StreamRegistry
+{
+  public:
+    /**
+     * Register a stream.
+     * \param [in] stream The stream.
+     * \return The slot of the stream.
+     */
+    static uint32_t Add(RandomVariableStream* stream);
+    /**
+     * Unregister a stream.
+     * \param [in] slot The slot returned by Add().
+     */
+    static void Remove(uint32_t slot);
+    /**
+     * Get the registered streams.
+     * \return The registered streams, in slot order.
+     */
+    static std::vector<RandomVariableStream*> GetStreams();
+
+  private:
+    /** A registry slot. */
+    struct Slot
+    {
+        std::atomic<RandomVariableStream*> stream; //!< The stream, if any.
+        std::atomic<uint32_t> next; //!< Next free slot plus one, or 0, while free.
+    };
+
+    /** Number of slots per segment. */
+    static constexpr uint32_t SEGMENT_SLOTS = 4096;
+    /** Maximum number of segments. */
+    static constexpr uint32_t MAX_SEGMENTS = 16384;
+
+    /**
+     * Get a slot, allocating its segment if needed.
+     * \param [in] index The slot index.
+     * \return The slot.
+     */
+    static Slot& GetSlot(uint32_t index);
+
+    /** The segments. */
+    static std::atomic<Slot*> m_segments[MAX_SEGMENTS];
+    /** Number of slots ever used. */
+    static std::atomic<uint32_t> m_size;
+    /** Free list head: tag in the high 32 bits, first free slot plus one, or 0, below. */
+    static std::atomic<uint64_t> m_free;
+};
+
+std::atomic<StreamRegistry::Slot*> StreamRegistry::m_segments[StreamRegistry::MAX_SEGMENTS] = {};
+std::atomic<uint32_t> StreamRegistry::m_size = 0;
+std::atomic<uint64_t> StreamRegistry::m_free = 0;
+
+StreamRegistry::Slot&
+StreamRegistry::GetSlot(uint32_t index)
+{
+    NS_ABORT_MSG_IF(index >= SEGMENT_SLOTS * MAX_SEGMENTS, "Too many live random variables");
+    std::atomic<Slot*>& segment = m_segments[index / SEGMENT_SLOTS];
+    Slot* slots = segment.load(std::memory_order_acquire);
+    if (slots == nullptr)
+    {
+        // Several threads may race to allocate the segment: one of them wins
+        auto allocated = new Slot[SEGMENT_SLOTS]{};
+        if (segment.compare_exchange_strong(slots, allocated, std::memory_order_acq_rel))
+        {
+            slots = allocated;
+        }
+        else
+        {
+            delete[] allocated;
+        }
+    }
+    return slots[index % SEGMENT_SLOTS];
+}
+
+uint32_t
+StreamRegistry::Add(RandomVariableStream* stream)
+{
+    uint64_t head = m_free.load(std::memory_order_acquire);
+    while (static_cast<uint32_t>(head) != 0)
+    {
+        uint32_t index = static_cast<uint32_t>(head) - 1;
+        Slot& slot = GetSlot(index);
+        uint64_t next = ((head >> 32) + 1) << 32 | slot.next.load(std::memory_order_relaxed);
+        if (m_free.compare_exchange_weak(head,
+                                         next,
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire))
+        {
+            slot.stream.store(stream, std::memory_order_release);
+            return index;
+        }
+    }
+    uint32_t index = m_size.fetch_add(1, std::memory_order_relaxed);
+    GetSlot(index).stream.store(stream, std::memory_order_release);
+    return index;
+}
+
+void
+StreamRegistry::Remove(uint32_t index)
+{
+    Slot& slot = GetSlot(index);
+    slot.stream.store(nullptr, std::memory_order_relaxed);
+    uint64_t head = m_free.load(std::memory_order_relaxed);
+    uint64_t next;
+    do
+    {
+        slot.next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        next = ((head >> 32) + 1) << 32 | (index + 1);
+    } while (!m_free.compare_exchange_weak(head,
+                                           next,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed));
+}
+
+std::vector<RandomVariableStream*>
+StreamRegistry::GetStreams()
+{
+    std::vector<RandomVariableStream*> streams;
+    uint32_t size = m_size.load(std::memory_order_acquire);
+    for (uint32_t index = 0; index < size; index++)
+    {
+        Slot* slots = m_segments[index / SEGMENT_SLOTS].load(std::memory_order_acquire);
+        RandomVariableStream* stream =
+            slots ? slots[index % SEGMENT_SLOTS].stream.load(std::memory_order_acquire) : nullptr;
+        if (stream != nullptr)
+        {
+            streams.push_back(stream);
+        }
+    }
+    return streams;
+}
+
+/** Number of streams ever created, see RandomVariableStream::m_creation. */
+std::atomic<uint64_t> g_streamsCreated = 0;
+
+} // namespace
+
 TypeId
 RandomVariableStream::GetTypeId()
 {
@@ -68,16 +220,30 @@ RandomVariableStream::GetTypeId()
 }
 
 RandomVariableStream::RandomVariableStream()
-    : m_rng(nullptr)
+    : m_rngStream(0),
+      m_rng(nullptr)
 {
     NS_LOG_FUNCTION(this);
+    m_creation = g_streamsCreated.fetch_add(1, std::memory_order_relaxed);
+    m_registration = StreamRegistry::Add(this);
 }
 
 RandomVariableStream::~RandomVariableStream()
 {
+    StreamRegistry::Remove(m_registration);
     delete m_rng;
 }
 
+std::vector<RandomVariableStream*>
+RandomVariableStream::GetLiveStreams()
+{
+    auto streams = StreamRegistry::GetStreams();
+    std::sort(streams.begin(), streams.end(), [](auto a, auto b) {
+        return a->m_creation < b->m_creation;
+    });
+    return streams;
+}
+
 void
 RandomVariableStream::SetAntithetic(bool isAntithetic)
 {
@@ -115,6 +281,7 @@ RandomVariableStream::SetStream(int64_t stream)
         NS_ASSERT(nextStream <= ((1ULL) << 63));
         NS_LOG_INFO(GetInstanceTypeId().GetName() << " automatic stream: " << nextStream);
         m_rng = new RngStream(RngSeedManager::GetSeed(), nextStream, RngSeedManager::GetRun());
+        m_rngStream = nextStream;
     }
     else
     {
@@ -124,10 +291,23 @@ RandomVariableStream::SetStream(int64_t stream)
         uint64_t target = base + stream;
         NS_LOG_INFO(GetInstanceTypeId().GetName() << " configured stream: " << stream);
         m_rng = new RngStream(RngSeedManager::GetSeed(), target, RngSeedManager::GetRun());
+        m_rngStream = target;
     }
     m_stream = stream;
 }
 
+void
+RandomVariableStream::Reseed()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_rng == nullptr)
+    {
+        return;
+    }
+    delete m_rng;
+    m_rng = new RngStream(RngSeedManager::GetSeed(), m_rngStream, RngSeedManager::GetRun());
+}
+
 int64_t
 RandomVariableStream::GetStream() const
 {
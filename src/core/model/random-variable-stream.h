@@ -21,6 +21,7 @@
 
 #include <map>
 #include <stdint.h>
+#include <vector>
 
 /**
  * \file
@@ -151,6 +152,36 @@ class RandomVariableStream : public Object
     RngStream* Peek() const;
 
   private:
+    /** RngCheckpoint saves and restores the live streams. */
+    friend class RngCheckpoint;
+    /** ReplicationRunner reseeds the live streams in each replication. */
+    friend class ReplicationRunner;
+
+    /**
+     * Get the live streams.
+     *
+     * The streams register themselves without a lock, from any thread.
+     * This method must not be called while other threads create or
+     * destroy streams.
+     *
+     * \return The live streams, in creation order.
+     */
+    static std::vector<RandomVariableStream*> GetLiveStreams();
+
+    /** Slot of this stream in the registry of the live streams. */
+    uint32_t m_registration;
+    /** Creation rank of this stream, which orders the live streams. */
+    uint64_t m_creation;
+
+    /**
+     * Restart the underlying RngStream from the current seed and run,
+     * keeping the same stream.
+     */
+    void Reseed();
+
+    /** The index of the underlying RngStream. */
+    uint64_t m_rngStream;
+
     /** Pointer to the underlying RngStream. */
     RngStream* m_rng;
 
@@ -19,6 +19,7 @@
 #include "synchronizer.h"
 #include "wall-clock-synchronizer.h"
 
+#include <algorithm>
 #include <cmath>
 #include <mutex>
 #include <thread>
@@ -86,12 +87,15 @@ RealtimeSimulatorImpl::RealtimeSimulatorImpl()
 RealtimeSimulatorImpl::~RealtimeSimulatorImpl()
 {
     NS_LOG_FUNCTION(this);
+    // Release the events scheduled from other threads since DoDispose()
+    m_eventsWithContext.Drain([](const EventWithContext& event) { event.event->Unref(); });
 }
 
 void
 RealtimeSimulatorImpl::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    ProcessEventsWithContext();
     while (!m_events->IsEmpty())
     {
         Scheduler::Event next = m_events->RemoveNext();
@@ -214,6 +218,14 @@ RealtimeSimulatorImpl::ProcessOneEvent()
             //
             // tsNext is the simulation time of the next event we want to execute.
             //
+            // We're going to sleep, but need to work with the synchronizer to make
+            // sure we're awakened if something external happens (like a packet is
+            // received).  The condition is reset before the inbox of the other
+            // threads is drained: those threads push without taking m_mutex, and a
+            // Signal() they send after the drain must survive until Synchronize().
+            //
+            m_synchronizer->SetCondition(false);
+            ProcessEventsWithContext();
             tsNow = m_synchronizer->GetCurrentRealtime();
             tsNext = NextTs();
 
@@ -235,14 +247,6 @@ RealtimeSimulatorImpl::ProcessOneEvent()
                 tsDelay = tsNext - tsNow;
             }
 
-            //
-            // We've figured out how long we need to delay in order to pace the
-            // simulation time with the real time.  We're going to sleep, but need
-            // to work with the synchronizer to make sure we're awakened if something
-            // external happens (like a packet is received).  This next line resets
-            // the synchronizer so that any future event will cause it to interrupt.
-            //
-            m_synchronizer->SetCondition(false);
         }
 
         //
@@ -310,8 +314,10 @@ RealtimeSimulatorImpl::ProcessOneEvent()
         // We do know we're waiting for an event, so there had better be an event on the
         // event queue.  Let's pull it off.  When we release the critical section, the
         // event we're working on won't be on the list and so subsequent operations won't
-        // mess with us.
+        // mess with us.  Events scheduled by other threads in the meantime might
+        // be due earlier.
         //
+        ProcessEventsWithContext();
         NS_ASSERT_MSG(m_events->IsEmpty() == false,
                       "RealtimeSimulatorImpl::ProcessOneEvent(): event queue is empty");
         next = m_events->RemoveNext();
@@ -390,7 +396,7 @@ RealtimeSimulatorImpl::IsFinished() const
     bool rc;
     {
         std::unique_lock lock{m_mutex};
-        rc = m_events->IsEmpty() || m_stop;
+        rc = (m_events->IsEmpty() && m_eventsWithContext.IsEmpty()) || m_stop;
     }
 
     return rc;
@@ -432,6 +438,10 @@ RealtimeSimulatorImpl::Run()
         {
             std::unique_lock lock{m_mutex};
 
+            // Reset before draining, as in ProcessOneEvent(), so that an event
+            // pushed by another thread after the drain wakes us up
+            m_synchronizer->SetCondition(false);
+            ProcessEventsWithContext();
             if (!m_events->IsEmpty())
             {
                 process = true;
@@ -531,24 +541,30 @@ RealtimeSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay,
 {
     NS_LOG_FUNCTION(this << context << delay << impl);
 
+    if (m_main != std::this_thread::get_id())
     {
-        std::unique_lock lock{m_mutex};
-        uint64_t ts;
-
-        if (m_main == std::this_thread::get_id())
+        //
+        // If the simulator is running, we're pacing and have a meaningful
+        // realtime clock.  If we're not, then the event is relative to where
+        // we stopped.
+        //
+        if (m_running)
         {
-            ts = m_currentTs + delay.GetTimeStep();
+            ScheduleFromOtherThread(context,
+                                    m_synchronizer->GetCurrentRealtime() + delay.GetTimeStep(),
+                                    false,
+                                    impl);
         }
         else
         {
-            //
-            // If the simulator is running, we're pacing and have a meaningful
-            // realtime clock.  If we're not, then m_currentTs is where we stopped.
-            //
-            ts = m_running ? m_synchronizer->GetCurrentRealtime() : m_currentTs;
-            ts += delay.GetTimeStep();
+            ScheduleFromOtherThread(context, delay.GetTimeStep(), true, impl);
         }
+        return;
+    }
 
+    {
+        std::unique_lock lock{m_mutex};
+        uint64_t ts = m_currentTs + delay.GetTimeStep();
         NS_ASSERT_MSG(ts >= m_currentTs,
                       "RealtimeSimulatorImpl::ScheduleRealtime(): schedule for time < m_currentTs");
         Scheduler::Event ev;
@@ -563,6 +579,50 @@ RealtimeSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay,
     }
 }
 
+void
+RealtimeSimulatorImpl::ScheduleFromOtherThread(uint32_t context,
+                                               uint64_t ts,
+                                               bool relative,
+                                               EventImpl* impl)
+{
+    EventWithContext ev;
+    ev.context = context;
+    ev.timestamp = ts;
+    ev.relative = relative;
+    ev.event = impl;
+    m_eventsWithContext.Push(ev);
+    m_synchronizer->Signal();
+}
+
+void
+RealtimeSimulatorImpl::ProcessEventsWithContext()
+{
+    if (m_eventsWithContext.IsEmpty())
+    {
+        return;
+    }
+
+    m_eventsWithContext.Drain([this](const EventWithContext& event) {
+        Scheduler::Event ev;
+        ev.impl = event.event;
+        if (event.relative)
+        {
+            ev.key.m_ts = m_currentTs + event.timestamp;
+        }
+        else
+        {
+            // The simulation time may have moved past the realtime at
+            // which the event was scheduled before we collected it
+            ev.key.m_ts = std::max(event.timestamp, m_currentTs);
+        }
+        ev.key.m_context = event.context;
+        ev.key.m_uid = m_uid;
+        m_uid++;
+        m_unscheduledEvents++;
+        m_events->Insert(ev);
+    });
+}
+
 EventId
 RealtimeSimulatorImpl::ScheduleNow(EventImpl* impl)
 {
@@ -586,6 +646,15 @@ RealtimeSimulatorImpl::ScheduleRealtimeWithContext(uint32_t context,
 {
     NS_LOG_FUNCTION(this << context << time << impl);
 
+    if (m_main != std::this_thread::get_id())
+    {
+        ScheduleFromOtherThread(context,
+                                m_synchronizer->GetCurrentRealtime() + time.GetTimeStep(),
+                                false,
+                                impl);
+        return;
+    }
+
     {
         std::unique_lock lock{m_mutex};
 
@@ -614,6 +683,20 @@ void
 RealtimeSimulatorImpl::ScheduleRealtimeNowWithContext(uint32_t context, EventImpl* impl)
 {
     NS_LOG_FUNCTION(this << context << impl);
+
+    if (m_main != std::this_thread::get_id())
+    {
+        if (m_running)
+        {
+            ScheduleFromOtherThread(context, m_synchronizer->GetCurrentRealtime(), false, impl);
+        }
+        else
+        {
+            ScheduleFromOtherThread(context, 0, true, impl);
+        }
+        return;
+    }
+
     {
         std::unique_lock lock{m_mutex};
 
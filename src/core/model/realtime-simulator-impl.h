@@ -10,11 +10,13 @@
 #include "assert.h"
 #include "event-impl.h"
 #include "log.h"
+#include "mpsc-queue.h"
 #include "ptr.h"
 #include "scheduler.h"
 #include "simulator-impl.h"
 #include "synchronizer.h"
 
+#include <atomic>
 #include <list>
 #include <mutex>
 #include <thread>
@@ -170,6 +172,22 @@ class RealtimeSimulatorImpl : public SimulatorImpl
     uint64_t NextTs() const;
     /** Process the next event. */
     void ProcessOneEvent();
+    /**
+     * Move the events scheduled from other threads into the event list.
+     * Should be called with critical section locked.
+     */
+    void ProcessEventsWithContext();
+    /**
+     * Schedule an event from a thread other than the main thread.
+     *
+     * \param [in] context The event context.
+     * \param [in] ts The event timestamp: absolute if \p relative is
+     *             \c false, otherwise relative to the time the event is
+     *             moved into the event list.
+     * \param [in] relative Whether \p ts is relative.
+     * \param [in] impl The event implementation.
+     */
+    void ScheduleFromOtherThread(uint32_t context, uint64_t ts, bool relative, EventImpl* impl);
     /** Destructor implementation. */
     void DoDispose() override;
 
@@ -180,7 +198,23 @@ class RealtimeSimulatorImpl : public SimulatorImpl
     /** Has the stopping condition been reached? */
     bool m_stop;
     /** Is the simulator currently running. */
-    bool m_running;
+    std::atomic<bool> m_running;
+
+    /** Wrap an event scheduled from another thread with its execution context. */
+    struct EventWithContext
+    {
+        /** The event context. */
+        uint32_t context;
+        /** Event timestamp. */
+        uint64_t timestamp;
+        /** Whether the timestamp is relative to the collection time. */
+        bool relative;
+        /** The event implementation. */
+        EventImpl* event;
+    };
+
+    /** The lock-free inbox of events scheduled from other threads. */
+    MpscQueue<EventWithContext> m_eventsWithContext;
 
     /**
      * \name Mutex-protected variables.
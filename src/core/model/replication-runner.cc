@@ -0,0 +1,200 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "replication-runner.h"
+
+#include "assert.h"
+#include "fatal-error.h"
+#include "log.h"
+#include "random-variable-stream.h"
+#include "rng-seed-manager.h"
+#include "system-path.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+/**
+ * \file
+ * \ingroup randomvariable
+ * ns3::ReplicationRunner implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ReplicationRunner");
+
+bool
+ReplicationRunner::Result::Succeeded() const
+{
+    return signal == 0 && exitCode == 0;
+}
+
+ReplicationRunner::ReplicationRunner()
+    : m_parallelism(std::max(1U, std::thread::hardware_concurrency())),
+      m_directory(".")
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+ReplicationRunner::AddRun(uint64_t run)
+{
+    NS_LOG_FUNCTION(this << run);
+    std::string directory = SystemPath::Append(m_directory, "run-" + std::to_string(run));
+    m_results.push_back({run, directory, -1, 0, {}});
+}
+
+void
+ReplicationRunner::AddRuns(uint64_t first, uint64_t count)
+{
+    NS_LOG_FUNCTION(this << first << count);
+    for (uint64_t run = first; run < first + count; ++run)
+    {
+        AddRun(run);
+    }
+}
+
+void
+ReplicationRunner::SetParallelism(uint32_t parallelism)
+{
+    NS_LOG_FUNCTION(this << parallelism);
+    NS_ASSERT_MSG(parallelism > 0, "At least one worker is needed");
+    m_parallelism = parallelism;
+}
+
+void
+ReplicationRunner::SetOutputDirectory(const std::string& directory)
+{
+    NS_LOG_FUNCTION(this << directory);
+    m_directory = directory;
+    for (auto& result : m_results)
+    {
+        result.directory = SystemPath::Append(m_directory, "run-" + std::to_string(result.run));
+    }
+}
+
+bool
+ReplicationRunner::Fork()
+{
+    NS_LOG_FUNCTION(this);
+    for (std::size_t i = 0; i < m_results.size(); ++i)
+    {
+        while (m_running.size() >= m_parallelism)
+        {
+            WaitWorker();
+        }
+
+        SystemPath::MakeDirectories(m_results[i].directory);
+        // Do not let the workers output what is still buffered
+        std::cout.flush();
+        std::cerr.flush();
+        std::fflush(nullptr);
+
+        pid_t pid = fork();
+        if (pid < 0)
+        {
+            NS_FATAL_ERROR("Cannot fork replication " << m_results[i].run << ": "
+                                                      << std::strerror(errno));
+        }
+        if (pid == 0)
+        {
+            SetUpWorker(m_results[i]);
+            return true;
+        }
+        NS_LOG_INFO("run " << m_results[i].run << " started, pid " << pid);
+        m_running.emplace_back(pid, i);
+    }
+
+    while (!m_running.empty())
+    {
+        WaitWorker();
+    }
+    return false;
+}
+
+void
+ReplicationRunner::SetUpWorker(const Result& result)
+{
+    // The parent's replications are not this worker's business
+    m_running.clear();
+
+    RngSeedManager::SetRun(result.run);
+    for (auto stream : RandomVariableStream::GetLiveStreams())
+    {
+        stream->Reseed();
+    }
+
+    if (chdir(result.directory.c_str()) != 0)
+    {
+        NS_FATAL_ERROR("Cannot enter " << result.directory << ": " << std::strerror(errno));
+    }
+    for (const auto& [fd, name] : {std::make_pair(STDOUT_FILENO, "stdout.txt"),
+                                   std::make_pair(STDERR_FILENO, "stderr.txt")})
+    {
+        int file = open(name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (file < 0 || dup2(file, fd) < 0)
+        {
+            NS_FATAL_ERROR("Cannot redirect the output to " << name << ": "
+                                                           << std::strerror(errno));
+        }
+        close(file);
+    }
+}
+
+void
+ReplicationRunner::WaitWorker()
+{
+    int status = 0;
+    pid_t pid = waitpid(-1, &status, 0);
+    if (pid < 0)
+    {
+        NS_FATAL_ERROR("Cannot wait for the replications: " << std::strerror(errno));
+    }
+    auto it = std::find_if(m_running.begin(), m_running.end(), [pid](const auto& running) {
+        return running.first == pid;
+    });
+    if (it == m_running.end())
+    {
+        // Not one of the workers
+        return;
+    }
+
+    Result& result = m_results[it->second];
+    m_running.erase(it);
+    if (WIFEXITED(status))
+    {
+        result.exitCode = WEXITSTATUS(status);
+    }
+    else if (WIFSIGNALED(status))
+    {
+        result.signal = WTERMSIG(status);
+    }
+    result.files = SystemPath::ReadFiles(result.directory);
+    NS_LOG_INFO("run " << result.run << " exited, code " << result.exitCode << " signal "
+                       << result.signal);
+}
+
+const std::vector<ReplicationRunner::Result>&
+ReplicationRunner::GetResults() const
+{
+    return m_results;
+}
+
+uint32_t
+ReplicationRunner::GetFailureCount() const
+{
+    return std::count_if(m_results.begin(), m_results.end(), [](const Result& result) {
+        return !result.Succeeded();
+    });
+}
+
+} // namespace ns3
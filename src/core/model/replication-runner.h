@@ -0,0 +1,176 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef REPLICATION_RUNNER_H
+#define REPLICATION_RUNNER_H
+
+#include <list>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup randomvariable
+ * ns3::ReplicationRunner declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup randomvariable
+ * \brief Run independent replications of a simulation in forked processes.
+ *
+ * The program builds its scenario once, then calls Fork(), which forks
+ * one worker process per replication, each one a copy-on-write clone of
+ * the program at that point, running at most \c parallelism workers at
+ * once.  In each worker, Fork() sets the \ref GlobalValueRngRun "RngRun"
+ * global value to the run number of the replication, restarts all the
+ * existing random variables on that run, makes the replication output
+ * directory the working directory, redirects the standard output and
+ * error to files in that directory, and returns \c true: the worker then
+ * runs the simulation, and exits.  In the parent process, Fork() returns
+ * \c false once all the workers have exited, and GetResults() gives the
+ * exit status and output files of each one.
+ *
+ * \code
+ *   int main(int argc, char* argv[])
+ *   {
+ *       CommandLine cmd;
+ *       cmd.Parse(argc, argv);
+ *       BuildScenario();
+ *
+ *       ReplicationRunner runner;
+ *       runner.AddRuns(1, 1000);
+ *       runner.SetParallelism(16);
+ *       runner.SetOutputDirectory("results");
+ *       if (runner.Fork())
+ *       {
+ *           // Worker: per-replication attributes can be set here
+ *           Simulator::Run();
+ *           Simulator::Destroy();
+ *           return 0;
+ *       }
+ *       return runner.GetFailureCount() == 0 ? 0 : 1;
+ *   }
+ * \endcode
+ *
+ * The replications are independent of each other, as the random
+ * variables of each worker draw from the substream of its run number.
+ * The random values drawn by the parent, while building the scenario,
+ * are the same in all the replications.  Fork() may also be called once
+ * a warm-up period has been simulated, with Simulator::Stop() and
+ * Simulator::Run(): the warm-up is then simulated once, by the parent,
+ * and each worker resumes the simulation from there with the random
+ * variables restarted on its own run.
+ *
+ * Only the thread calling Fork() exists in the workers: Fork() must not
+ * be called while other threads are running, e.g. with the
+ * multithreaded simulator implementations.  Forking is not available on
+ * Windows.
+ */
+class ReplicationRunner
+{
+  public:
+    /** The outcome of a replication. */
+    struct Result
+    {
+        /** The run number. */
+        uint64_t run;
+        /** The output directory. */
+        std::string directory;
+        /** The exit code of the worker, if it exited normally. */
+        int exitCode;
+        /** The signal which terminated the worker, or 0 if it exited normally. */
+        int signal;
+        /** The files found in the output directory once the worker exited. */
+        std::list<std::string> files;
+
+        /**
+         * \return \c true if the worker exited normally, with a 0 exit code.
+         */
+        bool Succeeded() const;
+    };
+
+    /** Constructor. */
+    ReplicationRunner();
+
+    /**
+     * Add a replication.
+     *
+     * \param [in] run The run number of the replication.
+     */
+    void AddRun(uint64_t run);
+    /**
+     * Add replications with consecutive run numbers.
+     *
+     * \param [in] first The first run number.
+     * \param [in] count The number of replications.
+     */
+    void AddRuns(uint64_t first, uint64_t count);
+    /**
+     * Set the maximum number of workers running at once.
+     *
+     * The default is the number of hardware threads.
+     *
+     * \param [in] parallelism The number of workers.
+     */
+    void SetParallelism(uint32_t parallelism);
+    /**
+     * Set the directory holding the replication output directories.
+     *
+     * Each replication runs in the \c run-<run> subdirectory of this
+     * directory, which is created if needed.  The default is the current
+     * directory.
+     *
+     * \param [in] directory The output directory.
+     */
+    void SetOutputDirectory(const std::string& directory);
+
+    /**
+     * Run all the replications.
+     *
+     * \return \c true in the workers, with the replication set up; \c false
+     *         in the parent process, once all the workers have exited.
+     */
+    bool Fork();
+
+    /**
+     * Get the outcome of the replications, once Fork() has returned in the
+     * parent process.
+     *
+     * \return The outcome of the replications, in the order they were added.
+     */
+    const std::vector<Result>& GetResults() const;
+    /**
+     * \return The number of replications which did not succeed.
+     */
+    uint32_t GetFailureCount() const;
+
+  private:
+    /**
+     * Set up a replication in the worker process.
+     *
+     * \param [in] result The replication.
+     */
+    void SetUpWorker(const Result& result);
+    /**
+     * Wait for a worker to exit, and record its outcome.
+     */
+    void WaitWorker();
+
+    /** The replications. */
+    std::vector<Result> m_results;
+    /** The maximum number of workers running at once. */
+    uint32_t m_parallelism;
+    /** The output directory. */
+    std::string m_directory;
+    /** The process id of the running workers, with their replication index. */
+    std::vector<std::pair<int, std::size_t>> m_running;
+};
+
+} // namespace ns3
+
+#endif /* REPLICATION_RUNNER_H */
@@ -0,0 +1,133 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "rng-checkpoint.h"
+
+#include "fatal-error.h"
+#include "log.h"
+#include "random-variable-stream.h"
+#include "rng-seed-manager.h"
+#include "rng-stream.h"
+
+#include <fstream>
+
+/**
+ * \file
+ * \ingroup randomvariable
+ * ns3::RngCheckpoint implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("RngCheckpoint");
+
+/** Header line of the checkpoint files. */
+static const std::string RNG_CHECKPOINT_MAGIC = "ns3-rng-checkpoint";
+/** Version of the checkpoint format. */
+static const uint32_t RNG_CHECKPOINT_VERSION = 1;
+
+void
+RngCheckpoint::Save(std::ostream& os)
+{
+    NS_LOG_FUNCTION_NOARGS();
+    const auto registry = RandomVariableStream::GetLiveStreams();
+
+    os << RNG_CHECKPOINT_MAGIC << " " << RNG_CHECKPOINT_VERSION << "\n";
+    os << RngSeedManager::GetSeed() << " " << RngSeedManager::GetRun() << " "
+       << RngSeedManager::PeekNextStreamIndex() << " " << registry.size() << "\n";
+    for (const auto stream : registry)
+    {
+        uint32_t state[6] = {};
+        if (stream->m_rng != nullptr)
+        {
+            stream->m_rng->GetState(state);
+        }
+        os << stream->m_stream;
+        for (auto component : state)
+        {
+            os << " " << component;
+        }
+        os << "\n";
+    }
+    NS_LOG_INFO("saved " << registry.size() << " streams");
+}
+
+void
+RngCheckpoint::Save(const std::string& filename)
+{
+    NS_LOG_FUNCTION(filename);
+    std::ofstream os(filename);
+    if (!os.is_open())
+    {
+        NS_FATAL_ERROR("Cannot open RNG checkpoint file " << filename);
+    }
+    Save(os);
+}
+
+void
+RngCheckpoint::Restore(std::istream& is)
+{
+    NS_LOG_FUNCTION_NOARGS();
+    const auto registry = RandomVariableStream::GetLiveStreams();
+
+    std::string magic;
+    uint32_t version = 0;
+    uint32_t seed = 0;
+    uint64_t run = 0;
+    uint64_t nextStream = 0;
+    std::size_t nStreams = 0;
+    is >> magic >> version >> seed >> run >> nextStream >> nStreams;
+    if (!is || magic != RNG_CHECKPOINT_MAGIC || version != RNG_CHECKPOINT_VERSION)
+    {
+        NS_FATAL_ERROR("Invalid RNG checkpoint");
+    }
+    if (nStreams != registry.size())
+    {
+        NS_FATAL_ERROR("RNG checkpoint of " << nStreams << " streams restored with "
+                                            << registry.size() << " live streams");
+    }
+
+    RngSeedManager::SetSeed(seed);
+    RngSeedManager::SetRun(run);
+    RngSeedManager::SetNextStreamIndex(nextStream);
+    for (const auto stream : registry)
+    {
+        int64_t number = 0;
+        uint32_t state[6] = {};
+        is >> number;
+        for (auto& component : state)
+        {
+            is >> component;
+        }
+        if (!is)
+        {
+            NS_FATAL_ERROR("Truncated RNG checkpoint");
+        }
+        if (number != stream->m_stream)
+        {
+            NS_FATAL_ERROR("RNG checkpoint stream " << number << " restored into stream "
+                                                    << stream->m_stream);
+        }
+        if (stream->m_rng != nullptr)
+        {
+            stream->m_rng->SetState(state);
+        }
+    }
+    NS_LOG_INFO("restored " << nStreams << " streams");
+}
+
+void
+RngCheckpoint::Restore(const std::string& filename)
+{
+    NS_LOG_FUNCTION(filename);
+    std::ifstream is(filename);
+    if (!is.is_open())
+    {
+        NS_FATAL_ERROR("Cannot open RNG checkpoint file " << filename);
+    }
+    Restore(is);
+}
+
+} // namespace ns3
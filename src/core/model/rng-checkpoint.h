@@ -0,0 +1,92 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef RNG_CHECKPOINT_H
+#define RNG_CHECKPOINT_H
+
+#include <iostream>
+#include <string>
+
+/**
+ * \file
+ * \ingroup randomvariable
+ * ns3::RngCheckpoint declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup randomvariable
+ * \brief Save and restore the state of all the random number generators.
+ *
+ * A checkpoint records the \ref GlobalValueRngSeed "RngSeed" and
+ * \ref GlobalValueRngRun "RngRun" values, the next automatically
+ * assigned stream index, and the stream number and current position of
+ * every live RandomVariableStream.  Restoring it puts all these
+ * generators back in the saved state, so that the same random values are
+ * drawn again from that point on.
+ *
+ * The streams are matched by creation order: the checkpoint can only be
+ * restored in a scenario which has created the same random variables,
+ * in the same order, as the one which saved it, typically the same
+ * program with the same configuration.  Restore() aborts the simulation
+ * if the number of streams, or any stream number, differs.
+ *
+ * Only the random number generators are saved: the pending events and
+ * the state of the models are not.  A checkpoint is thus not a snapshot
+ * of the simulation, and does not skip any part of it: the later run
+ * simulates the same scenario up to the checkpoint, and the checkpoint
+ * makes the random values drawn after it the same as in the run which
+ * saved it, e.g. to replay the part of a scenario after a given time with
+ * the same random inputs, while varying a model parameter.
+ *
+ * Save() and Restore() must not be called while the random variables are
+ * in use by other threads, e.g. from an event of a partition of
+ * ThreadedSimulatorImpl.
+ *
+ * \code
+ *   // Save the generators at 10 s
+ *   Simulator::Schedule(Seconds(10), [] { RngCheckpoint::Save("replay.rng"); });
+ *   ...
+ *   // Draw the same random values after 10 s in a later run
+ *   Simulator::Schedule(Seconds(10), [] { RngCheckpoint::Restore("replay.rng"); });
+ * \endcode
+ *
+ * The checkpoint is a text file: a header line, then one line with the
+ * seed, the run and the next stream index, then one line per stream with
+ * its stream number and its six state components.
+ */
+class RngCheckpoint
+{
+  public:
+    /**
+     * Save the generators to a stream.
+     *
+     * \param [in,out] os The output stream.
+     */
+    static void Save(std::ostream& os);
+    /**
+     * Save the generators to a file.
+     *
+     * \param [in] filename The file name.
+     */
+    static void Save(const std::string& filename);
+    /**
+     * Restore the generators from a stream.
+     *
+     * \param [in,out] is The input stream.
+     */
+    static void Restore(std::istream& is);
+    /**
+     * Restore the generators from a file.
+     *
+     * \param [in] filename The file name.
+     */
+    static void Restore(const std::string& filename);
+};
+
+} // namespace ns3
+
+#endif /* RNG_CHECKPOINT_H */
@@ -107,4 +107,17 @@ RngSeedManager::ResetNextStreamIndex()
     g_nextStreamIndex = 0;
 }
 
+uint64_t
+RngSeedManager::PeekNextStreamIndex()
+{
+    return g_nextStreamIndex;
+}
+
+void
+RngSeedManager::SetNextStreamIndex(uint64_t index)
+{
+    NS_LOG_FUNCTION(index);
+    g_nextStreamIndex = index;
+}
+
 } // namespace ns3
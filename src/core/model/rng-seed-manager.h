@@ -98,6 +98,19 @@ class RngSeedManager
      * Resets the global stream index counter.
      */
     static void ResetNextStreamIndex();
+
+    /**
+     * Get the next automatically assigned stream index, without
+     * consuming it.
+     * \returns The next stream index.
+     */
+    static uint64_t PeekNextStreamIndex();
+
+    /**
+     * Set the global stream index counter.
+     * \param [in] index The next stream index to assign.
+     */
+    static void SetNextStreamIndex(uint64_t index);
 };
 
 /** Alias for compatibility. */
@@ -60,6 +60,21 @@ class RngStream
      */
     double RandU01();
 
+    /**
+     * Get the current state of the generator.
+     *
+     * The state components are integers smaller than \f$ 2^{32} \f$.
+     *
+     * \param [out] state The state vector.
+     */
+    void GetState(uint32_t state[6]) const;
+    /**
+     * Set the current state of the generator, as saved by GetState().
+     *
+     * \param [in] state The state vector.
+     */
+    void SetState(const uint32_t state[6]);
+
   private:
     /**
      * Advance \pname{state} of the RNG by leaps and bounds.
@@ -13,7 +13,9 @@
 #include "assert.h"
 #include "default-deleter.h"
 
+#include <atomic>
 #include <limits>
+#include <type_traits>
 #include <stdint.h>
 
 /**
@@ -62,10 +64,18 @@ class Empty
  *      a public static method named 'Delete'. This method will be called
  *      whenever the SimpleRefCount template detects that no references
  *      to the object it manages exist anymore.
+ * \tparam ATOMIC \explicit Whether the reference count is atomic.  Only
+ *      the types whose instances are referenced from several threads
+ *      need it, e.g. ns3::Object, as the nodes and devices of a channel
+ *      are shared by the partitions of ThreadedSimulatorImpl.  The other
+ *      types, e.g. ns3::Packet, keep a plain count.
  *
  * Interesting users of this class include ns3::Object as well as ns3::Packet.
  */
-template <typename T, typename PARENT = Empty, typename DELETER = DefaultDeleter<T>>
+template <typename T,
+          typename PARENT = Empty,
+          typename DELETER = DefaultDeleter<T>,
+          bool ATOMIC = false>
 class SimpleRefCount : public PARENT
 {
   public:
@@ -102,8 +112,15 @@ class SimpleRefCount : public PARENT
      */
     inline void Ref() const
     {
-        NS_ASSERT(m_count < std::numeric_limits<uint32_t>::max());
-        m_count++;
+        NS_ASSERT(GetReferenceCount() < std::numeric_limits<uint32_t>::max());
+        if constexpr (ATOMIC)
+        {
+            m_count.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            m_count++;
+        }
     }
 
     /**
@@ -114,8 +131,17 @@ class SimpleRefCount : public PARENT
      */
     inline void Unref() const
     {
-        m_count--;
-        if (m_count == 0)
+        bool last;
+        if constexpr (ATOMIC)
+        {
+            last = m_count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        }
+        else
+        {
+            m_count--;
+            last = m_count == 0;
+        }
+        if (last)
         {
             DELETER::Delete(static_cast<T*>(const_cast<SimpleRefCount*>(this)));
         }
@@ -129,7 +155,14 @@ class SimpleRefCount : public PARENT
      */
     inline uint32_t GetReferenceCount() const
     {
-        return m_count;
+        if constexpr (ATOMIC)
+        {
+            return m_count.load(std::memory_order_relaxed);
+        }
+        else
+        {
+            return m_count;
+        }
     }
 
   private:
@@ -140,7 +173,7 @@ class SimpleRefCount : public PARENT
      * Note we make this mutable so that the const methods can still
      * change it.
      */
-    mutable uint32_t m_count;
+    mutable std::conditional_t<ATOMIC, std::atomic<uint32_t>, uint32_t> m_count;
 };
 
 } // namespace ns3
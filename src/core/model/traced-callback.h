@@ -11,7 +11,7 @@
 
 #include "callback.h"
 
-#include <list>
+#include <vector>
 
 /**
  * \file
@@ -19,6 +19,40 @@
  * ns3::TracedCallback declaration and template implementation.
  */
 
+/**
+ * \ingroup tracing
+ * \brief Invoke a TracedCallback only if a sink is connected.
+ *
+ * The arguments are not evaluated at all when \p trace has no sink,
+ * so that building them (copying a packet, adding a header to it,
+ * looking up an address...) costs nothing in runs which do not trace
+ * this source:
+ *
+ * \code
+ *   NS_TRACE(m_txTrace, packet->Copy(), this, interface);
+ * \endcode
+ *
+ * is equivalent to
+ *
+ * \code
+ *   if (!m_txTrace.IsEmpty())
+ *   {
+ *       m_txTrace(packet->Copy(), this, interface);
+ *   }
+ * \endcode
+ *
+ * \param [in] trace The TracedCallback.
+ * \param [in] ... The arguments passed to the sinks.
+ */
+#define NS_TRACE(trace, ...)                                                                       \
+    do                                                                                             \
+    {                                                                                              \
+        if (!(trace).IsEmpty())                                                                    \
+        {                                                                                          \
+            (trace)(__VA_ARGS__);                                                                  \
+        }                                                                                          \
+    } while (false)
+
 namespace ns3
 {
 
@@ -34,7 +68,14 @@ namespace ns3
  *
  * This is a functor: the chain of Callbacks is invoked by
  * calling the \c operator() form with the appropriate
- * number of arguments.
+ * number of arguments.  When the arguments are costly to build,
+ * use NS_TRACE() to skip them when no Callback is connected.
+ *
+ * The Callbacks are stored contiguously, in connection order.  A
+ * Callback connected while the chain is being invoked is invoked
+ * before the call returns.  A Callback disconnected while the chain is
+ * being invoked, e.g., by itself, is no longer invoked, and is erased
+ * once the invocation returns.
  *
  * \tparam Ts \explicit Types of the functor arguments.
  */
@@ -102,9 +143,16 @@ class TracedCallback
      *
      * \tparam Ts \deduced Types of the functor arguments.
      */
-    typedef std::list<Callback<void, Ts...>> CallbackList;
-    /** The chain of Callbacks. */
-    CallbackList m_callbackList;
+    typedef std::vector<Callback<void, Ts...>> CallbackList;
+    /**
+     * The chain of Callbacks; a Callback disconnected while the chain is
+     * invoked is left null until the invocation returns.
+     */
+    mutable CallbackList m_callbackList;
+    /** The Callbacks disconnected while the chain is invoked, kept alive until it returns. */
+    mutable CallbackList m_disconnected;
+    /** The number of invocations of the chain in progress. */
+    mutable uint32_t m_invoking;
 };
 
 } // namespace ns3
@@ -118,7 +166,9 @@ namespace ns3
 
 template <typename... Ts>
 TracedCallback<Ts...>::TracedCallback()
-    : m_callbackList()
+    : m_callbackList(),
+      m_disconnected(),
+      m_invoking(0)
 {
 }
 
@@ -153,14 +203,22 @@ TracedCallback<Ts...>::DisconnectWithoutContext(const CallbackBase& callback)
 {
     for (auto i = m_callbackList.begin(); i != m_callbackList.end(); /* empty */)
     {
-        if ((*i).IsEqual(callback))
+        if (i->IsNull() || !i->IsEqual(callback))
         {
-            i = m_callbackList.erase(i);
+            i++;
         }
-        else
+        else if (m_invoking > 0)
         {
+            // The Callback may be the one being invoked, it is only erased
+            // once the invocation returns
+            m_disconnected.push_back(*i);
+            i->Nullify();
             i++;
         }
+        else
+        {
+            i = m_callbackList.erase(i);
+        }
     }
 }
 
@@ -181,9 +239,20 @@ template <typename... Ts>
 void
 TracedCallback<Ts...>::operator()(Ts... args) const
 {
-    for (auto i = m_callbackList.begin(); i != m_callbackList.end(); i++)
+    // A sink may connect another one, which reallocates the vector
+    m_invoking++;
+    for (std::size_t i = 0; i < m_callbackList.size(); ++i)
+    {
+        if (!m_callbackList[i].IsNull())
+        {
+            m_callbackList[i](args...);
+        }
+    }
+    m_invoking--;
+    if (m_invoking == 0 && !m_disconnected.empty())
     {
-        (*i)(args...);
+        std::erase_if(m_callbackList, [](const auto& cb) { return cb.IsNull(); });
+        m_disconnected.clear();
     }
 }
 
@@ -280,6 +280,7 @@ void
 WallClockSynchronizer::DoSetCondition(bool cond)
 {
     NS_LOG_FUNCTION(this << cond);
+    std::unique_lock<std::mutex> lock(m_mutex);
     m_condition = cond;
 }
 
@@ -5,6 +5,8 @@
  */
 
 #include "ns3/callback.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
 #include "ns3/test.h"
 
 #include <stdint.h>
@@ -980,6 +982,126 @@ NullifyCallbackTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(target1.IsNull(), true, "Nullified Callback reports not IsNull()");
 }
 
+/**
+ * \ingroup callback-tests
+ *
+ * Check the state and the return values of the callable objects.
+ */
+class CallbackStateTestCase : public TestCase
+{
+  public:
+    CallbackStateTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+CallbackStateTestCase::CallbackStateTestCase()
+    : TestCase("Check the state of callable objects")
+{
+}
+
+/**
+ * \ingroup callback-tests
+ *
+ * Callback target incrementing a bound argument.
+ *
+ * \param [in,out] count The counter.
+ * \return The new counter value.
+ */
+static int
+CallbackStateIncrement(int& count)
+{
+    return ++count;
+}
+
+/**
+ * \ingroup callback-tests
+ *
+ * Callback target releasing, from its member function, the only
+ * callback which holds a reference to it.
+ */
+class CallbackReleaseTarget : public SimpleRefCount<CallbackReleaseTarget>
+{
+  public:
+    /**
+     * Constructor.
+     * \param [in] callback The callback to release.
+     * \param [in] destroyed Set when this object is destroyed.
+     * \param [in] alive Set if this object is alive after the release.
+     */
+    CallbackReleaseTarget(Callback<void>* callback, bool* destroyed, bool* alive)
+        : m_callback(callback),
+          m_destroyed(destroyed),
+          m_alive(alive)
+    {
+    }
+
+    ~CallbackReleaseTarget()
+    {
+        *m_destroyed = true;
+    }
+
+    /**
+     * Release the callback and record whether this object is still alive.
+     */
+    void Release()
+    {
+        *m_callback = Callback<void>();
+        *m_alive = !*m_destroyed;
+    }
+
+  private:
+    Callback<void>* m_callback; //!< The callback to release
+    bool* m_destroyed;          //!< Set when this object is destroyed
+    bool* m_alive;              //!< Set if this object is alive after the release
+};
+
+void
+CallbackStateTestCase::DoRun()
+{
+    //
+    // Make sure that a mutable lambda keeps its state across calls, and
+    // that copies of the callback share it.
+    //
+    Callback<int> counter([count = 0]() mutable { return ++count; });
+    Callback<int> copy = counter;
+    counter();
+    NS_TEST_ASSERT_MSG_EQ(copy(), 2, "Lambda state not shared by the callback copies");
+
+    //
+    // Make sure that the bound arguments are passed by reference to the
+    // callable object when it takes a reference.
+    //
+    Callback<int> bound = MakeBoundCallback(&CallbackStateIncrement, 10);
+    bound();
+    NS_TEST_ASSERT_MSG_EQ(bound(), 12, "Bound argument state not kept");
+
+    //
+    // Make sure that an object bound by Ptr outlives the call, even if
+    // the member function invoked releases the callback.
+    //
+    bool destroyed = false;
+    bool alive = false;
+    Callback<void> release;
+    release = MakeCallback(&CallbackReleaseTarget::Release,
+                           Create<CallbackReleaseTarget>(&release, &destroyed, &alive));
+    release();
+    NS_TEST_ASSERT_MSG_EQ(alive, true, "Bound object destroyed during the call");
+    NS_TEST_ASSERT_MSG_EQ(destroyed, true, "Bound object not released");
+
+    //
+    // Make sure that a callback returning void can wrap a function
+    // returning a value, and that the return values are converted.
+    //
+    int value = 0;
+    Callback<void> discard([&value]() { return CallbackStateIncrement(value); });
+    discard();
+    NS_TEST_ASSERT_MSG_EQ(value, 1, "Function returning a value not called");
+    Callback<double> converted([]() { return 3; });
+    NS_TEST_ASSERT_MSG_EQ(converted(), 3.0, "Return value not converted");
+}
+
 /**
  * \ingroup callback-tests
  *
@@ -1186,6 +1308,7 @@ CallbackTestSuite::CallbackTestSuite()
     AddTestCase(new MakeBoundCallbackTestCase, TestCase::Duration::QUICK);
     AddTestCase(new CallbackEqualityTestCase, TestCase::Duration::QUICK);
     AddTestCase(new NullifyCallbackTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new CallbackStateTestCase, TestCase::Duration::QUICK);
     AddTestCase(new MakeCallbackTemplatesTestCase, TestCase::Duration::QUICK);
 }
 
@@ -853,6 +853,180 @@ SearchAttributesOfParentObjectsTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(iv.Get(), 42, "Object Attribute \"X\" not settable in derived class");
 }
 
+/**
+ * \ingroup config-tests
+ * An object with a vector of objects, counting the objects fetched from it.
+ */
+class CountingConfigTestObject : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * Add a node.
+     * \param node The node.
+     */
+    void AddNode(Ptr<ConfigTestObject> node);
+    /**
+     * Get a node.
+     * \param i The node index.
+     * \return The node.
+     */
+    Ptr<ConfigTestObject> GetNode(std::size_t i) const;
+    /**
+     * Get the number of nodes.
+     * \return The number of nodes.
+     */
+    std::size_t GetNNodes() const;
+
+    mutable uint64_t m_fetched{0}; //!< Number of nodes fetched with GetNode().
+
+  private:
+    std::vector<Ptr<ConfigTestObject>> m_nodes; //!< Nodes attribute target.
+};
+
+TypeId
+CountingConfigTestObject::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("CountingConfigTestObject")
+            .SetParent<Object>()
+            .AddAttribute("Nodes",
+                          "",
+                          ObjectVectorValue(),
+                          MakeObjectVectorAccessor(&CountingConfigTestObject::GetNNodes,
+                                                   &CountingConfigTestObject::GetNode),
+                          MakeObjectVectorChecker<ConfigTestObject>());
+    return tid;
+}
+
+void
+CountingConfigTestObject::AddNode(Ptr<ConfigTestObject> node)
+{
+    m_nodes.push_back(node);
+}
+
+Ptr<ConfigTestObject>
+CountingConfigTestObject::GetNode(std::size_t i) const
+{
+    m_fetched++;
+    return m_nodes[i];
+}
+
+std::size_t
+CountingConfigTestObject::GetNNodes() const
+{
+    return m_nodes.size();
+}
+
+/**
+ * \ingroup config-tests
+ * Test the resolution of many paths through a large vector of objects,
+ * such as the NodeList of a large scenario, one by one and in a batch.
+ */
+class LargeObjectVectorConfigTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    LargeObjectVectorConfigTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+LargeObjectVectorConfigTestCase::LargeObjectVectorConfigTestCase()
+    : TestCase("Check the objects fetched to resolve paths through a large vector of Object")
+{
+}
+
+void
+LargeObjectVectorConfigTestCase::DoRun()
+{
+    const uint32_t nObjects = 10000;
+
+    Ptr<CountingConfigTestObject> root = CreateObject<CountingConfigTestObject>();
+    Config::RegisterRootNamespaceObject(root);
+    std::vector<Ptr<ConfigTestObject>> objects;
+    for (uint32_t i = 0; i < nObjects; i++)
+    {
+        objects.push_back(CreateObject<ConfigTestObject>());
+        root->AddNode(objects.back());
+    }
+
+    // Each path used to fetch the whole vector, so that the time taken by
+    // the paths was proportional to the square of the vector size
+    for (uint32_t i = 0; i < nObjects; i++)
+    {
+        Config::Set("/Nodes/" + std::to_string(i) + "/A", IntegerValue(i % 100));
+    }
+    NS_TEST_ASSERT_MSG_EQ(root->m_fetched,
+                          nObjects,
+                          "Setting an attribute should fetch a single object per path");
+    for (uint32_t i = 0; i < nObjects; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(static_cast<uint32_t>(objects[i]->GetA()),
+                              i % 100,
+                              "Attribute \"A\" not set");
+    }
+
+    std::vector<std::string> paths;
+    for (uint32_t i = 0; i < nObjects; i++)
+    {
+        paths.push_back("/Nodes/" + std::to_string(i));
+    }
+    paths.emplace_back("/Nodes/[10-12]|3");
+    paths.emplace_back("/Nodes/*");
+    paths.push_back("/Nodes/" + std::to_string(nObjects));
+    paths.emplace_back("/Nodes/0");
+
+    root->m_fetched = 0;
+    auto matches = Config::LookupMatches(paths);
+    // The wildcard fetches the whole vector once
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(root->m_fetched,
+                                2 * paths.size(),
+                                "Looking up the paths fetched the vector more than once");
+    NS_TEST_ASSERT_MSG_EQ(matches.size(), paths.size(), "Not one container per path");
+
+    for (uint32_t i = 0; i < nObjects; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(matches[i].GetN(), 1, "Not a single match for " << paths[i]);
+        NS_TEST_ASSERT_MSG_EQ(matches[i].Get(0), objects[i], "Wrong match for " << paths[i]);
+        NS_TEST_ASSERT_MSG_EQ(matches[i].GetMatchedPath(0),
+                              paths[i] + "/",
+                              "Wrong matched path for " << paths[i]);
+        NS_TEST_ASSERT_MSG_EQ(matches[i].GetPath(), paths[i], "Wrong path");
+    }
+
+    const auto& range = matches[nObjects];
+    NS_TEST_ASSERT_MSG_EQ(range.GetN(), 4, "Wrong number of matches for " << range.GetPath());
+    NS_TEST_ASSERT_MSG_EQ(range.Get(0), objects[3], "Matches not in container order");
+    NS_TEST_ASSERT_MSG_EQ(range.Get(1), objects[10], "Matches not in container order");
+    NS_TEST_ASSERT_MSG_EQ(range.Get(3), objects[12], "Matches not in container order");
+    NS_TEST_ASSERT_MSG_EQ(matches[nObjects + 1].GetN(), nObjects, "Wildcard does not match all");
+    NS_TEST_ASSERT_MSG_EQ(matches[nObjects + 2].GetN(), 0, "Index beyond the vector matches");
+    NS_TEST_ASSERT_MSG_EQ(matches[nObjects + 3].Get(0), objects[0], "Duplicate path not matched");
+
+    // The batch gives the same results as the single path lookups
+    for (std::size_t i = nObjects; i < paths.size(); i++)
+    {
+        auto single = Config::LookupMatches(paths[i]);
+        NS_TEST_ASSERT_MSG_EQ(single.GetN(), matches[i].GetN(), "Different matches");
+        for (std::size_t j = 0; j < single.GetN(); j++)
+        {
+            NS_TEST_ASSERT_MSG_EQ(single.Get(j), matches[i].Get(j), "Different matches");
+            NS_TEST_ASSERT_MSG_EQ(single.GetMatchedPath(j),
+                                  matches[i].GetMatchedPath(j),
+                                  "Different matched paths");
+        }
+    }
+
+    Config::UnregisterRootNamespaceObject(root);
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -871,6 +1045,7 @@ ConfigTestSuite::ConfigTestSuite()
     AddTestCase(new UnderRootNamespaceConfigTestCase);
     AddTestCase(new ObjectVectorConfigTestCase);
     AddTestCase(new SearchAttributesOfParentObjectsTestCase);
+    AddTestCase(new LargeObjectVectorConfigTestCase);
 }
 
 /**
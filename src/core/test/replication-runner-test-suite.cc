@@ -0,0 +1,134 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/random-variable-stream.h"
+#include "ns3/replication-runner.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <unistd.h>
+
+/**
+ * \file
+ * \ingroup rng-tests
+ * ReplicationRunner test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup rng-tests
+ *
+ * Run a few replications, and check their outcome.
+ */
+class ReplicationRunnerTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ReplicationRunnerTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ReplicationRunnerTestCase::ReplicationRunnerTestCase()
+    : TestCase("Run replications in forked processes")
+{
+}
+
+void
+ReplicationRunnerTestCase::DoRun()
+{
+    uint64_t parentRun = RngSeedManager::GetRun();
+    // Created before forking: reseeded in each worker
+    Ptr<UniformRandomVariable> variable = CreateObject<UniformRandomVariable>();
+    double parentValue = variable->GetValue();
+
+    ReplicationRunner runner;
+    runner.AddRuns(1, 4);
+    runner.AddRun(10);
+    runner.SetParallelism(2);
+    runner.SetOutputDirectory(CreateTempDirFilename("replications"));
+    if (runner.Fork())
+    {
+        // Worker: must not return into the test framework
+        uint64_t run = RngSeedManager::GetRun();
+        {
+            std::ofstream value("value.txt");
+            value.precision(17);
+            value << variable->GetValue() << "\n";
+        }
+        std::cout << "run " << run << std::endl;
+        _exit(run == 3 ? 3 : 0);
+    }
+
+    NS_TEST_EXPECT_MSG_EQ(RngSeedManager::GetRun(), parentRun, "Parent run changed");
+    NS_TEST_EXPECT_MSG_NE(variable->GetValue(), parentValue, "Parent stream reset");
+
+    const auto& results = runner.GetResults();
+    NS_TEST_ASSERT_MSG_EQ(results.size(), 5, "Wrong number of replications");
+    NS_TEST_EXPECT_MSG_EQ(runner.GetFailureCount(), 1, "Only run 3 should fail");
+    std::set<std::string> values;
+    for (const auto& result : results)
+    {
+        NS_TEST_EXPECT_MSG_EQ(result.signal, 0, "Run " << result.run << " killed");
+        NS_TEST_EXPECT_MSG_EQ(result.exitCode,
+                              (result.run == 3 ? 3 : 0),
+                              "Wrong exit code for run " << result.run);
+        for (const auto& file : {"stdout.txt", "stderr.txt", "value.txt"})
+        {
+            NS_TEST_EXPECT_MSG_EQ(
+                std::count(result.files.begin(), result.files.end(), file),
+                1,
+                "Missing output file " << file << " of run " << result.run);
+        }
+
+        std::ifstream output(result.directory + "/stdout.txt");
+        std::string line;
+        std::getline(output, line);
+        NS_TEST_EXPECT_MSG_EQ(line,
+                              "run " + std::to_string(result.run),
+                              "Wrong output of run " << result.run);
+        std::ifstream value(result.directory + "/value.txt");
+        std::getline(value, line);
+        values.insert(line);
+    }
+    NS_TEST_EXPECT_MSG_EQ(values.size(), results.size(), "Replications should differ");
+}
+
+/**
+ * \ingroup rng-tests
+ *
+ * ReplicationRunner test suite.
+ */
+class ReplicationRunnerTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    ReplicationRunnerTestSuite();
+};
+
+ReplicationRunnerTestSuite::ReplicationRunnerTestSuite()
+    : TestSuite("replication-runner", Type::UNIT)
+{
+    AddTestCase(new ReplicationRunnerTestCase);
+}
+
+/**
+ * \ingroup rng-tests
+ * Static variable for test initialization.
+ */
+static ReplicationRunnerTestSuite g_replicationRunnerTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
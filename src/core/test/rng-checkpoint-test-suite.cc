@@ -0,0 +1,161 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-checkpoint.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/test.h"
+
+#include <sstream>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup rng-tests
+ * RngCheckpoint test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup rng-tests
+ *
+ * Check that restoring a checkpoint replays the same random values.
+ */
+class RngCheckpointTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    RngCheckpointTestCase();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * Draw values from all the variables.
+     *
+     * \param [in] variables The variables.
+     * \return The values drawn.
+     */
+    std::vector<double> Draw(const std::vector<Ptr<RandomVariableStream>>& variables);
+
+    uint32_t m_seed;       //!< Seed before the test.
+    uint64_t m_run;        //!< Run before the test.
+    uint64_t m_nextStream; //!< Next stream index before the test.
+};
+
+RngCheckpointTestCase::RngCheckpointTestCase()
+    : TestCase("Restore the random number generators")
+{
+}
+
+void
+RngCheckpointTestCase::DoSetup()
+{
+    m_seed = RngSeedManager::GetSeed();
+    m_run = RngSeedManager::GetRun();
+    m_nextStream = RngSeedManager::PeekNextStreamIndex();
+}
+
+void
+RngCheckpointTestCase::DoTeardown()
+{
+    RngSeedManager::SetSeed(m_seed);
+    RngSeedManager::SetRun(m_run);
+    RngSeedManager::SetNextStreamIndex(m_nextStream);
+}
+
+std::vector<double>
+RngCheckpointTestCase::Draw(const std::vector<Ptr<RandomVariableStream>>& variables)
+{
+    std::vector<double> values;
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        for (const auto& variable : variables)
+        {
+            values.push_back(variable->GetValue());
+        }
+    }
+    return values;
+}
+
+void
+RngCheckpointTestCase::DoRun()
+{
+    RngSeedManager::SetSeed(3);
+    RngSeedManager::SetRun(5);
+
+    std::vector<Ptr<RandomVariableStream>> variables;
+    variables.push_back(CreateObject<UniformRandomVariable>());
+    variables.push_back(CreateObject<ExponentialRandomVariable>());
+    variables.push_back(CreateObject<NormalRandomVariable>());
+    variables.back()->SetStream(7);
+    Draw(variables);
+
+    std::stringstream checkpoint;
+    RngCheckpoint::Save(checkpoint);
+    uint64_t nextStream = RngSeedManager::PeekNextStreamIndex();
+    std::vector<double> expected = Draw(variables);
+
+    // A temporary variable consumes a stream index
+    CreateObject<UniformRandomVariable>()->GetValue();
+    RngSeedManager::SetRun(9);
+
+    RngCheckpoint::Restore(checkpoint);
+    NS_TEST_ASSERT_MSG_EQ(RngSeedManager::GetSeed(), 3, "Seed not restored");
+    NS_TEST_ASSERT_MSG_EQ(RngSeedManager::GetRun(), 5, "Run not restored");
+    NS_TEST_ASSERT_MSG_EQ(RngSeedManager::PeekNextStreamIndex(),
+                          nextStream,
+                          "Next stream index not restored");
+    std::vector<double> values = Draw(variables);
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(values[i], expected[i], "Value " << i << " not replayed");
+    }
+
+    // Same thing through a file
+    std::string filename = CreateTempDirFilename("rng-checkpoint.txt");
+    RngCheckpoint::Save(filename);
+    expected = Draw(variables);
+    RngCheckpoint::Restore(filename);
+    values = Draw(variables);
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(values[i], expected[i], "Value " << i << " not replayed from file");
+    }
+}
+
+/**
+ * \ingroup rng-tests
+ *
+ * RngCheckpoint test suite.
+ */
+class RngCheckpointTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    RngCheckpointTestSuite();
+};
+
+RngCheckpointTestSuite::RngCheckpointTestSuite()
+    : TestSuite("rng-checkpoint", Type::UNIT)
+{
+    AddTestCase(new RngCheckpointTestCase);
+}
+
+/**
+ * \ingroup rng-tests
+ * Static variable for test initialization.
+ */
+static RngCheckpointTestSuite g_rngCheckpointTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
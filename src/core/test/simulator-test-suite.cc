@@ -6,13 +6,22 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "ns3/calendar-scheduler.h"
+#include "ns3/config.h"
+#include "ns3/event-pool.h"
+#include "ns3/event-profiler.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
 
+#include <fstream>
+#include <random>
+#include <set>
+
 using namespace ns3;
 
 /**
@@ -696,6 +705,320 @@ SimulatorTemplateTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the event ordering of a Scheduler against a reference, with
+ * a mix of short and long-horizon events, simultaneous events and removals.
+ */
+class SchedulerOrderTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * \param schedulerFactory Scheduler factory.
+     */
+    SchedulerOrderTestCase(ObjectFactory schedulerFactory);
+
+  private:
+    void DoRun() override;
+
+    ObjectFactory m_schedulerFactory; //!< Scheduler factory.
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase(ObjectFactory schedulerFactory)
+    : TestCase("Check the event ordering of " + schedulerFactory.GetTypeId().GetName()),
+      m_schedulerFactory(schedulerFactory)
+{
+}
+
+void
+SchedulerOrderTestCase::DoRun()
+{
+    Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler>();
+    std::set<std::pair<uint64_t, uint32_t>> reference;
+    std::mt19937_64 rng(1);
+    uint64_t now = 0;
+    uint32_t uid = EventId::UID::VALID;
+
+    // Returns true on failure
+    auto checkNext = [&]() {
+        Scheduler::Event next = scheduler->RemoveNext();
+        NS_TEST_ASSERT_MSG_EQ_RETURNS_BOOL(next.key.m_ts,
+                                           reference.begin()->first,
+                                           "Wrong event time");
+        NS_TEST_ASSERT_MSG_EQ_RETURNS_BOOL(next.key.m_uid,
+                                           reference.begin()->second,
+                                           "Wrong event uid");
+        reference.erase(reference.begin());
+        now = next.key.m_ts;
+        return false;
+    };
+
+    for (uint32_t step = 0; step < 20000; ++step)
+    {
+        uint32_t action = rng() % 100;
+        if (action < 70 || reference.empty())
+        {
+            // Mostly short delays, some simultaneous events, a few long timers
+            uint64_t delay = rng() % 1000;
+            if (action < 5)
+            {
+                delay = 0;
+            }
+            else if (action < 10)
+            {
+                delay = 1000000000 + rng() % 1000000000;
+            }
+            Scheduler::Event ev;
+            ev.impl = nullptr;
+            ev.key.m_ts = now + delay;
+            ev.key.m_uid = uid++;
+            ev.key.m_context = 0;
+            scheduler->Insert(ev);
+            reference.emplace(ev.key.m_ts, ev.key.m_uid);
+        }
+        else if (action < 95)
+        {
+            if (checkNext())
+            {
+                return;
+            }
+        }
+        else
+        {
+            auto it = std::next(reference.begin(), rng() % reference.size());
+            Scheduler::Event ev;
+            ev.impl = nullptr;
+            ev.key.m_ts = it->first;
+            ev.key.m_uid = it->second;
+            ev.key.m_context = 0;
+            scheduler->Remove(ev);
+            reference.erase(it);
+        }
+        NS_TEST_ASSERT_MSG_EQ(scheduler->IsEmpty(), reference.empty(), "Wrong queue state");
+        if (!reference.empty())
+        {
+            NS_TEST_ASSERT_MSG_EQ(scheduler->PeekNext().key.m_uid,
+                                  reference.begin()->second,
+                                  "Wrong next event");
+        }
+    }
+    while (!reference.empty())
+    {
+        if (checkNext())
+        {
+            return;
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(scheduler->IsEmpty(), true, "Scheduler should be empty");
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check that pooled events are recycled, and that the EventId of a
+ * recycled event behaves as expired.
+ */
+class SimulatorEventPoolTestCase : public TestCase
+{
+  public:
+    SimulatorEventPoolTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Test Event.
+     * \param value Event parameter.
+     */
+    void Event(int value);
+
+    int m_sum; //!< Sum of the parameters of the executed events.
+};
+
+SimulatorEventPoolTestCase::SimulatorEventPoolTestCase()
+    : TestCase("Check the pooled events")
+{
+}
+
+void
+SimulatorEventPoolTestCase::Event(int value)
+{
+    m_sum += value;
+}
+
+void
+SimulatorEventPoolTestCase::DoRun()
+{
+    m_sum = 0;
+    EventPool::Enable();
+
+    EventId a = Simulator::Schedule(MicroSeconds(1), &SimulatorEventPoolTestCase::Event, this, 1);
+    EventImpl* slot = a.PeekEventImpl();
+    NS_TEST_ASSERT_MSG_NE(slot, nullptr, "Event should be alive");
+    NS_TEST_EXPECT_MSG_NE(slot->GetGeneration(), 0, "Event should be pooled");
+    NS_TEST_EXPECT_MSG_EQ(a.IsPending(), true, "Event should not have expired yet");
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_sum, 1, "Event should have run");
+    NS_TEST_EXPECT_MSG_EQ(a.IsExpired(), true, "Event should have expired");
+    NS_TEST_EXPECT_MSG_EQ(a.PeekEventImpl(), nullptr, "Event should have been recycled");
+
+    // The next event of the same size reuses the slot
+    EventId b = Simulator::Schedule(MicroSeconds(1), &SimulatorEventPoolTestCase::Event, this, 10);
+    NS_TEST_EXPECT_MSG_EQ(b.PeekEventImpl(), slot, "Slot should have been reused");
+    NS_TEST_EXPECT_MSG_EQ(a.IsExpired(), true, "Recycled event should remain expired");
+    a.Cancel();
+    a.Remove();
+    NS_TEST_EXPECT_MSG_EQ(b.IsPending(), true, "Stale EventId should not affect the new event");
+
+    // Removed events are recycled as well, and copies of their EventId expire
+    EventId c =
+        Simulator::Schedule(MicroSeconds(2), &SimulatorEventPoolTestCase::Event, this, 100);
+    // NOLINTNEXTLINE(performance-unnecessary-copy-initialization)
+    EventId copy = c;
+    slot = c.PeekEventImpl();
+    c.Remove();
+    NS_TEST_EXPECT_MSG_EQ(copy.IsExpired(), true, "Event was removed: it is now expired");
+    NS_TEST_EXPECT_MSG_EQ(copy.PeekEventImpl(), nullptr, "Event should have been recycled");
+    EventId d =
+        Simulator::Schedule(MicroSeconds(3), &SimulatorEventPoolTestCase::Event, this, 1000);
+    NS_TEST_EXPECT_MSG_EQ(d.PeekEventImpl(), slot, "Slot should have been reused");
+    copy.Cancel();
+
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_sum, 1011, "Wrong events executed");
+
+    // Destroy events hold a reference to their EventImpl, as usual
+    EventId e = Simulator::ScheduleDestroy(&SimulatorEventPoolTestCase::Event, this, 10000);
+    NS_TEST_EXPECT_MSG_EQ(e.IsPending(), true, "Event should not have expired yet");
+    Simulator::Destroy();
+    NS_TEST_EXPECT_MSG_EQ(m_sum, 11011, "Destroy event should have run");
+    NS_TEST_EXPECT_MSG_EQ(e.IsExpired(), true, "Event should have expired now");
+
+    EventPool::Disable();
+    EventId f = Simulator::Schedule(MicroSeconds(1), &SimulatorEventPoolTestCase::Event, this, 1);
+    NS_TEST_EXPECT_MSG_EQ(f.PeekEventImpl()->GetGeneration(), 0, "Event should not be pooled");
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the event profiler output.
+ */
+class SimulatorEventProfilerTestCase : public TestCase
+{
+  public:
+    SimulatorEventProfilerTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Test Event.
+     * \param value Event parameter.
+     */
+    void Event(int value);
+    /**
+     * Other test Event, with the same signature.
+     * \param value Event parameter.
+     */
+    void OtherEvent(int value);
+};
+
+SimulatorEventProfilerTestCase::SimulatorEventProfilerTestCase()
+    : TestCase("Check the event profiler")
+{
+}
+
+void
+SimulatorEventProfilerTestCase::Event(int /* value */)
+{
+}
+
+void
+SimulatorEventProfilerTestCase::OtherEvent(int /* value */)
+{
+}
+
+void
+SimulatorEventProfilerTestCase::DoRun()
+{
+    Simulator::Destroy();
+    std::string prefix = CreateTempDirFilename("event-profile");
+    Config::SetGlobal("EventProfile", StringValue(prefix));
+
+    for (int i = 0; i < 3; ++i)
+    {
+        Simulator::ScheduleWithContext(5,
+                                       MicroSeconds(i),
+                                       &SimulatorEventProfilerTestCase::Event,
+                                       this,
+                                       i);
+    }
+    // Each member function and lambda is a different handler
+    Simulator::ScheduleWithContext(5,
+                                   MicroSeconds(1),
+                                   &SimulatorEventProfilerTestCase::OtherEvent,
+                                   this,
+                                   0);
+    Simulator::Schedule(MicroSeconds(1), [] {});
+    Simulator::Schedule(MicroSeconds(2), [] {});
+    Simulator::Run();
+    Simulator::Destroy();
+    Config::SetGlobal("EventProfile", StringValue(""));
+
+    EventImpl* event = MakeEvent(&SimulatorEventProfilerTestCase::Event, this, 0);
+    std::string handler = EventProfiler::GetHandlerName(event->GetHandler());
+    event->Unref();
+    event = MakeEvent(&SimulatorEventProfilerTestCase::OtherEvent, this, 0);
+    std::string other = EventProfiler::GetHandlerName(event->GetHandler());
+    event->Unref();
+    NS_TEST_EXPECT_MSG_NE(handler, other, "Member functions should have different names");
+
+    std::ifstream csv(prefix + ".csv");
+    NS_TEST_ASSERT_MSG_EQ(csv.is_open(), true, "No CSV profile");
+    std::string line;
+    std::getline(csv, line);
+    NS_TEST_EXPECT_MSG_EQ(line,
+                          "handler,context,count,total_ns,mean_ns,max_ns",
+                          "Unexpected CSV header");
+    uint32_t entries = 0;
+    bool memberFound = false;
+    bool otherFound = false;
+    while (std::getline(csv, line))
+    {
+        entries++;
+        if (line.rfind("\"" + handler + "\",5,3,", 0) == 0)
+        {
+            memberFound = true;
+        }
+        if (line.rfind("\"" + other + "\",5,1,", 0) == 0)
+        {
+            otherFound = true;
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(entries, 4, "Expected one entry per handler and context");
+    NS_TEST_EXPECT_MSG_EQ(memberFound, true, "Member function events not profiled");
+    NS_TEST_EXPECT_MSG_EQ(otherFound, true, "Member function events not told apart");
+
+    std::ifstream folded(prefix + ".folded");
+    NS_TEST_ASSERT_MSG_EQ(folded.is_open(), true, "No folded stacks profile");
+    entries = 0;
+    memberFound = false;
+    while (std::getline(folded, line))
+    {
+        entries++;
+        if (line.rfind(handler + ";context 5 ", 0) == 0)
+        {
+            memberFound = true;
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(entries, 4, "Expected one stack per handler and context");
+    NS_TEST_EXPECT_MSG_EQ(memberFound, true, "Member function events not profiled");
+}
+
 /**
  * \ingroup simulator-tests
  *
@@ -719,6 +1042,21 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(LadderScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+
+        for (const auto& type : {MapScheduler::GetTypeId(),
+                                 HeapScheduler::GetTypeId(),
+                                 CalendarScheduler::GetTypeId(),
+                                 PriorityQueueScheduler::GetTypeId(),
+                                 LadderScheduler::GetTypeId()})
+        {
+            factory.SetTypeId(type);
+            AddTestCase(new SchedulerOrderTestCase(factory), TestCase::Duration::QUICK);
+        }
+
+        AddTestCase(new SimulatorEventPoolTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new SimulatorEventProfilerTestCase(), TestCase::Duration::QUICK);
     }
 };
 
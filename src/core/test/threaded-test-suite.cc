@@ -9,19 +9,24 @@
 #include "ns3/config.h"
 #include "ns3/heap-scheduler.h"
 #include "ns3/list-scheduler.h"
+#include "ns3/log.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
 
+#include <atomic>
 #include <chrono> // seconds, milliseconds
 #include <ctime>
 #include <list>
 #include <thread> // sleep_for
 #include <utility>
+#include <vector>
 
 using namespace ns3;
 
+NS_LOG_COMPONENT_DEFINE("ThreadedTestSuite");
+
 /// Maximum number of threads.
 constexpr int MAXTHREADS = 64;
 
@@ -267,6 +272,248 @@ ThreadedSimulatorEventsTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(m_a, m_d, "Bad scheduling");
 }
 
+/**
+ * \ingroup threaded-tests
+ *
+ * \brief Stress the inbox of events scheduled from other threads.
+ *
+ * A number of threads schedule events with ScheduleWithContext() as fast
+ * as they can, while the simulator runs.  The test checks that every event
+ * is executed exactly once and that the events of each thread are executed
+ * in the order they were scheduled, and logs the event throughput.
+ */
+class ThreadedInboxStressTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param simulatorType The simulator type.
+     * \param threads The number of threads.
+     */
+    ThreadedInboxStressTestCase(const std::string& simulatorType, unsigned int threads);
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * Schedule the events of a thread.
+     * \param threadno The thread number.
+     */
+    void SchedulingThread(unsigned int threadno);
+    /**
+     * Event scheduled by the threads.
+     * \param threadno The thread number.
+     * \param seq The event sequence number in the thread.
+     */
+    void Receive(unsigned int threadno, uint32_t seq);
+    /** Keep the simulation running until all the events have been received. */
+    void Poll();
+
+    /// Number of events scheduled by each thread.
+    static constexpr uint32_t EVENTS_PER_THREAD = 20000;
+
+    std::string m_simulatorType;         //!< Simulator type.
+    unsigned int m_threads;              //!< The number of threads.
+    std::vector<uint32_t> m_next;        //!< Next expected sequence number, by thread.
+    uint64_t m_received;                 //!< Number of events received.
+    std::string m_error;                 //!< Error condition.
+    std::list<std::thread> m_threadlist; //!< Thread list.
+};
+
+ThreadedInboxStressTestCase::ThreadedInboxStressTestCase(const std::string& simulatorType,
+                                                         unsigned int threads)
+    : TestCase("Stress the event inbox with " + std::to_string(threads) + " threads in " +
+               simulatorType),
+      m_simulatorType(simulatorType),
+      m_threads(threads)
+{
+}
+
+void
+ThreadedInboxStressTestCase::DoSetup()
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue(m_simulatorType));
+    m_next.assign(m_threads, 0);
+    m_received = 0;
+    m_error = "";
+}
+
+void
+ThreadedInboxStressTestCase::DoTeardown()
+{
+    m_threadlist.clear();
+
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+}
+
+void
+ThreadedInboxStressTestCase::SchedulingThread(unsigned int threadno)
+{
+    for (uint32_t seq = 0; seq < EVENTS_PER_THREAD; ++seq)
+    {
+        Simulator::ScheduleWithContext(threadno,
+                                       Time(0),
+                                       &ThreadedInboxStressTestCase::Receive,
+                                       this,
+                                       threadno,
+                                       seq);
+    }
+}
+
+void
+ThreadedInboxStressTestCase::Receive(unsigned int threadno, uint32_t seq)
+{
+    if (seq != m_next[threadno] && m_error.empty())
+    {
+        m_error = "Events of thread " + std::to_string(threadno) + " out of order";
+    }
+    m_next[threadno] = seq + 1;
+    ++m_received;
+}
+
+void
+ThreadedInboxStressTestCase::Poll()
+{
+    if (m_received == m_threads * EVENTS_PER_THREAD)
+    {
+        Simulator::Stop();
+        return;
+    }
+    // Give up once the events should long have been received
+    if (Simulator::Now() > Seconds(10))
+    {
+        m_error = "Missing events";
+        Simulator::Stop();
+        return;
+    }
+    Simulator::Schedule(MicroSeconds(100), &ThreadedInboxStressTestCase::Poll, this);
+}
+
+void
+ThreadedInboxStressTestCase::DoRun()
+{
+    Simulator::Schedule(MicroSeconds(100), &ThreadedInboxStressTestCase::Poll, this);
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < m_threads; ++i)
+    {
+        m_threadlist.emplace_back(&ThreadedInboxStressTestCase::SchedulingThread, this, i);
+    }
+
+    Simulator::Run();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    for (auto& thread : m_threadlist)
+    {
+        thread.join();
+    }
+    Simulator::Destroy();
+
+    NS_LOG_INFO(GetName() << ": " << m_received << " events in " << elapsed.count() << " s, "
+                          << m_received / elapsed.count() << " events/s");
+    NS_TEST_EXPECT_MSG_EQ(m_error.empty(), true, m_error);
+    NS_TEST_EXPECT_MSG_EQ(m_received, m_threads * EVENTS_PER_THREAD, "Events were lost");
+}
+
+/**
+ * \ingroup threaded-tests
+ *
+ * \brief Check that the realtime simulator wakes up for events of other threads.
+ *
+ * Another thread schedules an event with ScheduleWithContext() as soon as
+ * the previous one has been executed, i.e., while the simulation thread is
+ * draining its inbox and going back to sleep until the next event, which is
+ * far in the future.  An event whose wakeup is lost is only executed when
+ * that sleep ends, so the test fails if the far event runs first.
+ */
+class ThreadedRealtimeWakeupTestCase : public TestCase
+{
+  public:
+    ThreadedRealtimeWakeupTestCase();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /** Schedule each event once the previous one has been executed. */
+    void SchedulingThread();
+    /** Event scheduled by the thread. */
+    void Receive();
+    /** Event far in the future, which must not be reached. */
+    void Timeout();
+
+    /// Number of events scheduled by the thread.
+    static constexpr uint32_t ROUNDS = 1000;
+
+    std::atomic<uint32_t> m_received; //!< Number of events received.
+    std::atomic<bool> m_timeout;      //!< Whether the far event was executed.
+};
+
+ThreadedRealtimeWakeupTestCase::ThreadedRealtimeWakeupTestCase()
+    : TestCase("Check the wakeups of the realtime simulator by other threads")
+{
+}
+
+void
+ThreadedRealtimeWakeupTestCase::DoSetup()
+{
+    Config::SetGlobal("SimulatorImplementationType",
+                      StringValue("ns3::RealtimeSimulatorImpl"));
+    m_received = 0;
+    m_timeout = false;
+}
+
+void
+ThreadedRealtimeWakeupTestCase::DoTeardown()
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+}
+
+void
+ThreadedRealtimeWakeupTestCase::SchedulingThread()
+{
+    for (uint32_t round = 0; round < ROUNDS && !m_timeout; ++round)
+    {
+        while (m_received < round && !m_timeout)
+        {
+            std::this_thread::yield();
+        }
+        Simulator::ScheduleWithContext(0, Time(0), &ThreadedRealtimeWakeupTestCase::Receive, this);
+    }
+}
+
+void
+ThreadedRealtimeWakeupTestCase::Receive()
+{
+    if (++m_received == ROUNDS)
+    {
+        Simulator::Stop();
+    }
+}
+
+void
+ThreadedRealtimeWakeupTestCase::Timeout()
+{
+    m_timeout = true;
+    Simulator::Stop();
+}
+
+void
+ThreadedRealtimeWakeupTestCase::DoRun()
+{
+    Simulator::Schedule(Seconds(10), &ThreadedRealtimeWakeupTestCase::Timeout, this);
+    std::thread thread(&ThreadedRealtimeWakeupTestCase::SchedulingThread, this);
+    Simulator::Run();
+    m_timeout = true;
+    thread.join();
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(m_received, ROUNDS, "A wakeup of the simulation thread was lost");
+}
+
 /**
  * \ingroup threaded-tests
  *
@@ -287,6 +534,7 @@ class ThreadedSimulatorTestSuite : public TestSuite
             "ns3::HeapScheduler",
             "ns3::MapScheduler",
             "ns3::CalendarScheduler",
+            "ns3::LadderScheduler",
         };
         unsigned int threadCounts[] = {0, 2, 10, 20};
         ObjectFactory factory;
@@ -304,6 +552,17 @@ class ThreadedSimulatorTestSuite : public TestSuite
                 }
             }
         }
+
+        for (auto& simulatorType : simulatorTypes)
+        {
+            for (unsigned int threadCount : {1, 4, 16})
+            {
+                AddTestCase(new ThreadedInboxStressTestCase(simulatorType, threadCount),
+                            TestCase::Duration::QUICK);
+            }
+        }
+
+        AddTestCase(new ThreadedRealtimeWakeupTestCase(), TestCase::Duration::QUICK);
     }
 };
 
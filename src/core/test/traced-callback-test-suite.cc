@@ -122,6 +122,95 @@ BasicTracedCallbackTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_two, true, "Callback CbTwo not called");
 }
 
+/**
+ * \ingroup tracedcallback-tests
+ *
+ * TracedCallback Test case, check NS_TRACE() and the sinks connected
+ * or disconnected while the chain is invoked.
+ */
+class GuardedTracedCallbackTestCase : public TestCase
+{
+  public:
+    GuardedTracedCallbackTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+GuardedTracedCallbackTestCase::GuardedTracedCallbackTestCase()
+    : TestCase("Check NS_TRACE and connecting or disconnecting from a sink")
+{
+}
+
+void
+GuardedTracedCallbackTestCase::DoRun()
+{
+    TracedCallback<int> trace;
+    int evaluated = 0;
+    auto argument = [&evaluated]() {
+        evaluated++;
+        return 7;
+    };
+
+    // The arguments are not evaluated without a sink
+    NS_TRACE(trace, argument());
+    NS_TEST_ASSERT_MSG_EQ(evaluated, 0, "Argument evaluated without a sink");
+
+    int sum = 0;
+    trace.ConnectWithoutContext(Callback<void, int>([&sum](int v) { sum += v; }));
+    NS_TRACE(trace, argument());
+    NS_TEST_ASSERT_MSG_EQ(evaluated, 1, "Argument not evaluated once");
+    NS_TEST_ASSERT_MSG_EQ(sum, 7, "Sink not called");
+
+    // A sink connected by another sink, even if the storage grows, is
+    // called during the same invocation
+    int late = 0;
+    trace.ConnectWithoutContext(Callback<void, int>([&trace, &late](int) {
+        for (int i = 0; i < 16; i++)
+        {
+            trace.ConnectWithoutContext(Callback<void, int>([&late](int v) { late += v; }));
+        }
+    }));
+    trace(1);
+    NS_TEST_ASSERT_MSG_EQ(sum, 8, "Sink not called");
+    NS_TEST_ASSERT_MSG_EQ(late, 16, "Sinks connected during the invocation not called");
+
+    // A sink which disconnects itself does not prevent the next one from
+    // being called, and is not called anymore
+    TracedCallback<int> chain;
+    int once = 0;
+    int next = 0;
+    Callback<void, int> self;
+    self = Callback<void, int>([&chain, &self, &once](int v) {
+        once += v;
+        chain.DisconnectWithoutContext(self);
+    });
+    chain.ConnectWithoutContext(self);
+    chain.ConnectWithoutContext(Callback<void, int>([&next](int v) { next += v; }));
+    chain(1);
+    NS_TEST_ASSERT_MSG_EQ(once, 1, "Self-disconnecting sink not called");
+    NS_TEST_ASSERT_MSG_EQ(next, 1, "Sink after a self-disconnecting one skipped");
+    chain(1);
+    NS_TEST_ASSERT_MSG_EQ(once, 1, "Disconnected sink called");
+    NS_TEST_ASSERT_MSG_EQ(next, 2, "Remaining sink not called");
+
+    // A sink which disconnects another one prevents it from being called
+    // during the same invocation
+    TracedCallback<int> other;
+    int first = 0;
+    int second = 0;
+    Callback<void, int> victim([&second](int v) { second += v; });
+    other.ConnectWithoutContext(Callback<void, int>([&other, &victim, &first](int v) {
+        first += v;
+        other.DisconnectWithoutContext(victim);
+    }));
+    other.ConnectWithoutContext(victim);
+    other(1);
+    NS_TEST_ASSERT_MSG_EQ(first, 1, "Sink not called");
+    NS_TEST_ASSERT_MSG_EQ(second, 0, "Sink disconnected during the invocation called");
+    NS_TEST_ASSERT_MSG_EQ(other.IsEmpty(), false, "Remaining sink erased");
+}
+
 /**
  * \ingroup tracedcallback-tests
  *
@@ -137,6 +226,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite()
     : TestSuite("traced-callback", Type::UNIT)
 {
     AddTestCase(new BasicTracedCallbackTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new GuardedTracedCallbackTestCase, TestCase::Duration::QUICK);
 }
 
 static TracedCallbackTestSuite
@@ -1371,7 +1371,7 @@ TcpSocketBase::DoForwardUp(Ptr<Packet> packet, const Address& fromAddress, const
         }
     }
 
-    m_rxTrace(packet, tcpHeader, this);
+    NS_TRACE(m_rxTrace, packet, tcpHeader, this);
 
     if (tcpHeader.GetFlags() & TcpHeader::SYN)
     {
@@ -1487,7 +1487,7 @@ TcpSocketBase::DoForwardUp(Ptr<Packet> packet, const Address& fromAddress, const
             h.SetDestinationPort(tcpHeader.GetSourcePort());
             h.SetWindowSize(AdvertisedWindowSize());
             AddOptions(h);
-            m_txTrace(p, h, this);
+            NS_TRACE(m_txTrace, p, h, this);
             m_tcp->SendPacket(p, h, toAddress, fromAddress, m_boundnetdevice);
         }
         break;
@@ -2901,7 +2901,7 @@ TcpSocketBase::SendEmptyPacket(uint8_t flags)
         NS_LOG_INFO("Sending a pure ACK, acking seq " << m_tcb->m_rxBuffer->NextRxSequence());
     }
 
-    m_txTrace(p, header, this);
+    NS_TRACE(m_txTrace, p, header, this);
 
     if (m_endPoint != nullptr)
     {
@@ -3284,24 +3284,26 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
         m_retxEvent = Simulator::Schedule(m_rto, &TcpSocketBase::ReTxTimeout, this);
     }
 
-    m_txTrace(p, header, this);
+    NS_TRACE(m_txTrace, p, header, this);
     if (isRetransmission)
     {
         if (m_endPoint)
         {
-            m_retransmissionTrace(p,
-                                  header,
-                                  m_endPoint->GetLocalAddress(),
-                                  m_endPoint->GetPeerAddress(),
-                                  this);
+            NS_TRACE(m_retransmissionTrace,
+                     p,
+                     header,
+                     m_endPoint->GetLocalAddress(),
+                     m_endPoint->GetPeerAddress(),
+                     this);
         }
         else
         {
-            m_retransmissionTrace(p,
-                                  header,
-                                  m_endPoint6->GetLocalAddress(),
-                                  m_endPoint6->GetPeerAddress(),
-                                  this);
+            NS_TRACE(m_retransmissionTrace,
+                     p,
+                     header,
+                     m_endPoint6->GetLocalAddress(),
+                     m_endPoint6->GetPeerAddress(),
+                     this);
         }
     }
 
@@ -4057,7 +4059,7 @@ TcpSocketBase::PersistTimeout()
     {
         AddSocketTags(p, IsEct(TcpPacketType_t::WINDOW_PROBE));
     }
-    m_txTrace(p, tcpHeader, this);
+    NS_TRACE(m_txTrace, p, tcpHeader, this);
 
     if (m_endPoint != nullptr)
     {
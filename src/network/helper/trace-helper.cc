@@ -8,6 +8,8 @@
 
 #include "ns3/abort.h"
 #include "ns3/assert.h"
+#include "ns3/boolean.h"
+#include "ns3/global-value.h"
 #include "ns3/log.h"
 #include "ns3/names.h"
 #include "ns3/net-device.h"
@@ -24,6 +26,38 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("TraceHelper");
 
+/**
+ * \relates AsciiTraceHelper
+ * Whether the ascii traces are written as binary traces.
+ */
+static GlobalValue g_asciiTraceBinary =
+    GlobalValue("AsciiTraceBinary",
+                "Write the ascii traces created by the helpers as compressed binary traces, "
+                "in a .bin file, which utils/convert-binary-trace converts back to text",
+                BooleanValue(false),
+                MakeBooleanChecker());
+
+/**
+ * \relates AsciiTraceHelper
+ * Whether the binary traces include a digest of the packets.
+ */
+static GlobalValue g_asciiTraceDigest =
+    GlobalValue("AsciiTraceDigest",
+                "Write a digest of the first bytes of each packet in the binary ascii traces",
+                BooleanValue(false),
+                MakeBooleanChecker());
+
+/**
+ * \relates AsciiTraceHelper
+ * Whether the binary traces include the printed packets.
+ */
+static GlobalValue g_asciiTracePrint =
+    GlobalValue("AsciiTracePrint",
+                "Write the printed packets in the binary ascii traces, so that they are "
+                "converted back to the same text as the ascii traces",
+                BooleanValue(false),
+                MakeBooleanChecker());
+
 PcapHelper::PcapHelper()
 {
     NS_LOG_FUNCTION_NOARGS();
@@ -183,7 +217,24 @@ AsciiTraceHelper::CreateFileStream(std::string filename, std::ios::openmode file
 {
     NS_LOG_FUNCTION(filename << filemode);
 
-    Ptr<OutputStreamWrapper> StreamWrapper = Create<OutputStreamWrapper>(filename, filemode);
+    BooleanValue binary;
+    g_asciiTraceBinary.GetValue(binary);
+    Ptr<OutputStreamWrapper> StreamWrapper;
+    if (binary.Get())
+    {
+        NS_ABORT_MSG_IF(filemode & std::ios::app,
+                        "Binary ascii traces cannot be appended to: " << filename);
+        BooleanValue digest;
+        g_asciiTraceDigest.GetValue(digest);
+        BooleanValue print;
+        g_asciiTracePrint.GetValue(print);
+        StreamWrapper = Create<OutputStreamWrapper>(
+            Create<BinaryTraceWriter>(filename + ".bin", digest.Get(), print.Get()));
+    }
+    else
+    {
+        StreamWrapper = Create<OutputStreamWrapper>(filename, filemode);
+    }
 
     //
     // Note that the ascii trace helper promptly forgets all about the trace file.
@@ -303,6 +354,11 @@ AsciiTraceHelper::DefaultEnqueueSinkWithoutContext(Ptr<OutputStreamWrapper> stre
                                                    Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (auto trace = stream->GetBinaryTrace())
+    {
+        trace->Write('+', Simulator::Now(), p);
+        return;
+    }
     *stream->GetStream() << "+ " << Simulator::Now().GetSeconds() << " " << *p << std::endl;
 }
 
@@ -312,6 +368,11 @@ AsciiTraceHelper::DefaultEnqueueSinkWithContext(Ptr<OutputStreamWrapper> stream,
                                                 Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (auto trace = stream->GetBinaryTrace())
+    {
+        trace->Write('+', Simulator::Now(), context, p);
+        return;
+    }
     *stream->GetStream() << "+ " << Simulator::Now().GetSeconds() << " " << context << " " << *p
                          << std::endl;
 }
@@ -333,6 +394,11 @@ AsciiTraceHelper::DefaultDropSinkWithoutContext(Ptr<OutputStreamWrapper> stream,
                                                 Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (auto trace = stream->GetBinaryTrace())
+    {
+        trace->Write('d', Simulator::Now(), p);
+        return;
+    }
     *stream->GetStream() << "d " << Simulator::Now().GetSeconds() << " " << *p << std::endl;
 }
 
@@ -342,6 +408,11 @@ AsciiTraceHelper::DefaultDropSinkWithContext(Ptr<OutputStreamWrapper> stream,
                                              Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (auto trace = stream->GetBinaryTrace())
+    {
+        trace->Write('d', Simulator::Now(), context, p);
+        return;
+    }
     *stream->GetStream() << "d " << Simulator::Now().GetSeconds() << " " << context << " " << *p
                          << std::endl;
 }
@@ -364,6 +435,11 @@ AsciiTraceHelper::DefaultDequeueSinkWithoutContext(Ptr<OutputStreamWrapper> stre
                                                    Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (auto trace = stream->GetBinaryTrace())
+    {
+        trace->Write('-', Simulator::Now(), p);
+        return;
+    }
     *stream->GetStream() << "- " << Simulator::Now().GetSeconds() << " " << *p << std::endl;
 }
 
@@ -373,6 +449,11 @@ AsciiTraceHelper::DefaultDequeueSinkWithContext(Ptr<OutputStreamWrapper> stream,
                                                 Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (auto trace = stream->GetBinaryTrace())
+    {
+        trace->Write('-', Simulator::Now(), context, p);
+        return;
+    }
     *stream->GetStream() << "- " << Simulator::Now().GetSeconds() << " " << context << " " << *p
                          << std::endl;
 }
@@ -392,6 +473,11 @@ AsciiTraceHelper::DefaultReceiveSinkWithoutContext(Ptr<OutputStreamWrapper> stre
                                                    Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (auto trace = stream->GetBinaryTrace())
+    {
+        trace->Write('r', Simulator::Now(), p);
+        return;
+    }
     *stream->GetStream() << "r " << Simulator::Now().GetSeconds() << " " << *p << std::endl;
 }
 
@@ -401,6 +487,11 @@ AsciiTraceHelper::DefaultReceiveSinkWithContext(Ptr<OutputStreamWrapper> stream,
                                                 Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (auto trace = stream->GetBinaryTrace())
+    {
+        trace->Write('r', Simulator::Now(), context, p);
+        return;
+    }
     *stream->GetStream() << "r " << Simulator::Now().GetSeconds() << " " << context << " " << *p
                          << std::endl;
 }
@@ -220,6 +220,10 @@ class AsciiTraceHelper
      * that can solve the problem so we use one of those to carry the stream
      * around and deal with the lifetime issues.
      *
+     * When the AsciiTraceBinary global value is true, the stream writes a
+     * compressed binary trace, see BinaryTraceWriter, to filename with a
+     * ".bin" suffix, and the default trace sinks write their packet events to it.
+     *
      * @param filename file name
      * @param filemode file mode
      * @returns a smart pointer to the output stream
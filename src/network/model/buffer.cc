@@ -7,9 +7,14 @@
  */
 #include "buffer.h"
 
+#include "packet-allocator.h"
+
 #include "ns3/assert.h"
+#include "ns3/ip-checksum.h"
 #include "ns3/log.h"
 
+#include <algorithm>
+
 #define LOG_INTERNAL_STATE(y)                                                                      \
     NS_LOG_LOGIC(y << "start=" << m_start << ", end=" << m_end                                     \
                    << ", zero start=" << m_zeroAreaStart << ", zero end=" << m_zeroAreaEnd         \
@@ -43,96 +48,17 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Buffer");
 
-uint32_t Buffer::g_recommendedStart = 0;
-#ifdef BUFFER_FREE_LIST
-/* The following macros are pretty evil but they are needed to allow us to
- * keep track of 3 possible states for the g_freeList variable:
- *  - uninitialized means that no one has created a buffer yet
- *    so no one has created the associated free list (it is created
- *    on-demand when the first buffer is created)
- *  - initialized means that the free list exists and is valid
- *  - destroyed means that the static destructors of this compilation unit
- *    have run so, the free list has been cleared from its content
- * The key is that in destroyed state, we are careful not re-create it
- * which is a typical weakness of lazy evaluation schemes which use
- * '0' as a special value to indicate both un-initialized and destroyed.
- * Note that it is important to use '0' as the marker for un-initialized state
- * because the variable holding this state information is initialized to zero
- * which the compiler assigns to zero-memory which is initialized to _zero_
- * before the constructors run so this ensures perfect handling of crazy
- * constructor orderings.
- */
-#define MAGIC_DESTROYED (~(long)0)
-#define IS_UNINITIALIZED(x) (x == (Buffer::FreeList*)0)
-#define IS_DESTROYED(x) (x == (Buffer::FreeList*)MAGIC_DESTROYED)
-#define IS_INITIALIZED(x) (!IS_UNINITIALIZED(x) && !IS_DESTROYED(x))
-#define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
-#define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList* Buffer::g_freeList = nullptr;
-Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
-
-Buffer::LocalStaticDestructor::~LocalStaticDestructor()
-{
-    NS_LOG_FUNCTION(this);
-    if (IS_INITIALIZED(g_freeList))
-    {
-        for (auto i = g_freeList->begin(); i != g_freeList->end(); i++)
-        {
-            Buffer::Deallocate(*i);
-        }
-        delete g_freeList;
-        g_freeList = DESTROYED;
-    }
-}
+std::atomic<uint32_t> Buffer::g_recommendedStart = 0;
 
 void
-Buffer::Recycle(Buffer::Data* data)
+Buffer::RecommendStart(uint32_t start)
 {
-    NS_LOG_FUNCTION(data);
-    NS_ASSERT(data->m_count == 0);
-    NS_ASSERT(!IS_UNINITIALIZED(g_freeList));
-    g_maxSize = std::max(g_maxSize, data->m_size);
-    /* feed into free list */
-    if (data->m_size < g_maxSize || IS_DESTROYED(g_freeList) || g_freeList->size() > 1000)
-    {
-        Buffer::Deallocate(data);
-    }
-    else
+    if (start > g_recommendedStart.load(std::memory_order_relaxed))
     {
-        NS_ASSERT(IS_INITIALIZED(g_freeList));
-        g_freeList->push_back(data);
+        g_recommendedStart.store(start, std::memory_order_relaxed);
     }
 }
 
-Buffer::Data*
-Buffer::Create(uint32_t dataSize)
-{
-    NS_LOG_FUNCTION(dataSize);
-    /* try to find a buffer correctly sized. */
-    if (IS_UNINITIALIZED(g_freeList))
-    {
-        g_freeList = new Buffer::FreeList();
-    }
-    else if (IS_INITIALIZED(g_freeList))
-    {
-        while (!g_freeList->empty())
-        {
-            Buffer::Data* data = g_freeList->back();
-            g_freeList->pop_back();
-            if (data->m_size >= dataSize)
-            {
-                data->m_count = 1;
-                return data;
-            }
-            Buffer::Deallocate(data);
-        }
-    }
-    Buffer::Data* data = Buffer::Allocate(dataSize);
-    NS_ASSERT(data->m_count == 1);
-    return data;
-}
-#else  /* BUFFER_FREE_LIST */
 void
 Buffer::Recycle(Buffer::Data* data)
 {
@@ -147,7 +73,6 @@ Buffer::Create(uint32_t size)
     NS_LOG_FUNCTION(size);
     return Allocate(size);
 }
-#endif /* BUFFER_FREE_LIST */
 
 constexpr uint32_t ALLOC_OVER_PROVISION = 100; //!< Additional bytes to over-provision.
 
@@ -162,9 +87,9 @@ Buffer::Allocate(uint32_t reqSize)
     NS_ASSERT(reqSize >= 1);
     reqSize += ALLOC_OVER_PROVISION;
     uint32_t size = reqSize - 1 + sizeof(Buffer::Data);
-    auto b = new uint8_t[size];
-    auto data = reinterpret_cast<Buffer::Data*>(b);
-    data->m_size = reqSize;
+    auto data = static_cast<Buffer::Data*>(PacketAllocator::Allocate(size));
+    // use the whole block, which may be larger than requested
+    data->m_size = size + 1 - sizeof(Buffer::Data);
     data->m_count = 1;
     return data;
 }
@@ -174,8 +99,7 @@ Buffer::Deallocate(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
-    auto buf = reinterpret_cast<uint8_t*>(data);
-    delete[] buf;
+    PacketAllocator::Deallocate(data, data->m_size - 1 + sizeof(Buffer::Data));
 }
 
 Buffer::Buffer()
@@ -237,8 +161,10 @@ void
 Buffer::Initialize(uint32_t zeroSize)
 {
     NS_LOG_FUNCTION(this << zeroSize);
-    m_data = Buffer::Create(0);
-    m_start = std::min(m_data->m_size, g_recommendedStart);
+    // room for the headers usually added in front of the zero area
+    uint32_t recommendedStart = g_recommendedStart.load(std::memory_order_relaxed);
+    m_data = Buffer::Create(recommendedStart);
+    m_start = std::min(m_data->m_size, recommendedStart);
     m_maxZeroAreaStart = m_start;
     m_zeroAreaStart = m_start;
     m_zeroAreaEnd = m_zeroAreaStart + zeroSize;
@@ -263,7 +189,7 @@ Buffer::operator=(const Buffer& o)
         m_data = o.m_data;
         m_data->m_count++;
     }
-    g_recommendedStart = std::max(g_recommendedStart, m_maxZeroAreaStart);
+    RecommendStart(m_maxZeroAreaStart);
     m_maxZeroAreaStart = o.m_maxZeroAreaStart;
     m_zeroAreaStart = o.m_zeroAreaStart;
     m_zeroAreaEnd = o.m_zeroAreaEnd;
@@ -277,7 +203,7 @@ Buffer::~Buffer()
 {
     NS_LOG_FUNCTION(this);
     NS_ASSERT(CheckInternalState());
-    g_recommendedStart = std::max(g_recommendedStart, m_maxZeroAreaStart);
+    RecommendStart(m_maxZeroAreaStart);
     m_data->m_count--;
     if (m_data->m_count == 0)
     {
@@ -396,9 +322,39 @@ Buffer::AddAtEnd(const Buffer& o)
 {
     NS_LOG_FUNCTION(this << &o);
 
+    uint32_t zeroSize = m_zeroAreaEnd - m_zeroAreaStart;
+    uint32_t oZeroSize = o.m_zeroAreaEnd - o.m_zeroAreaStart;
+    if (m_data == o.m_data && GetInternalEnd() == o.m_start &&
+        (zeroSize == 0 || oZeroSize == 0 ||
+         (m_end == m_zeroAreaEnd && o.m_start == o.m_zeroAreaStart)))
+    {
+        /**
+         * The two buffers are adjacent views of the same data, which is
+         * what happens when fragments created by CreateFragment are put
+         * back together in order: join them without copying any byte.
+         * Their zero areas are merged if they are both in the middle.
+         */
+        if (oZeroSize == 0)
+        {
+            m_end += o.GetSize();
+        }
+        else
+        {
+            if (zeroSize == 0)
+            {
+                m_zeroAreaStart = o.m_zeroAreaStart;
+                m_zeroAreaEnd = o.m_zeroAreaStart;
+            }
+            m_zeroAreaEnd += oZeroSize;
+            m_end = m_zeroAreaEnd + (o.m_end - o.m_zeroAreaEnd);
+        }
+        m_maxZeroAreaStart = std::max(m_maxZeroAreaStart, m_zeroAreaStart);
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+
     if (m_data->m_count == 1 && (m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
-        m_end == m_data->m_dirtyEnd && o.m_start == o.m_zeroAreaStart &&
-        o.m_zeroAreaEnd - o.m_zeroAreaStart > 0)
+        m_end == m_data->m_dirtyEnd && o.m_start == o.m_zeroAreaStart && oZeroSize > 0)
     {
         /**
          * This is an optimization which kicks in when
@@ -409,8 +365,7 @@ Buffer::AddAtEnd(const Buffer& o)
         {
             m_zeroAreaStart = m_end;
         }
-        uint32_t zeroSize = o.m_zeroAreaEnd - o.m_zeroAreaStart;
-        m_zeroAreaEnd = m_end + zeroSize;
+        m_zeroAreaEnd = m_end + oZeroSize;
         m_end = m_zeroAreaEnd;
         m_data->m_dirtyEnd = m_zeroAreaEnd;
         uint32_t endData = o.m_end - o.m_zeroAreaEnd;
@@ -424,7 +379,20 @@ Buffer::AddAtEnd(const Buffer& o)
         return;
     }
 
-    *this = CreateFullCopy();
+    if (oZeroSize > zeroSize)
+    {
+        /**
+         * A buffer keeps a single zero area: keep the larger one,
+         * which is the one of o, and write our bytes in front of it.
+         */
+        Buffer tmp = o;
+        tmp.AddAtStart(GetSize());
+        tmp.Begin().Write(Begin(), End());
+        *this = tmp;
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+
     AddAtEnd(o.GetSize());
     Buffer::Iterator destStart = End();
     destStart.Prev(o.GetSize());
@@ -821,27 +789,35 @@ Buffer::Iterator::Write(Iterator start, Iterator end)
     NS_ASSERT(m_data != start.m_data);
     uint32_t size = end.m_current - start.m_current;
     NS_ASSERT_MSG(CheckNoZero(m_current, m_current + size), GetWriteErrorMessage());
+    uint8_t* to;
+    if (m_current <= m_zeroStart)
+    {
+        to = &m_data[m_current];
+    }
+    else
+    {
+        to = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+    }
+    m_current += size;
     if (start.m_current <= start.m_zeroStart)
     {
         uint32_t toCopy = std::min(size, start.m_zeroStart - start.m_current);
-        memcpy(&m_data[m_current], &start.m_data[start.m_current], toCopy);
+        memcpy(to, &start.m_data[start.m_current], toCopy);
         start.m_current += toCopy;
-        m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     if (start.m_current <= start.m_zeroEnd)
     {
         uint32_t toCopy = std::min(size, start.m_zeroEnd - start.m_current);
-        memset(&m_data[m_current], 0, toCopy);
+        memset(to, 0, toCopy);
         start.m_current += toCopy;
-        m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     uint32_t toCopy = std::min(size, start.m_dataEnd - start.m_current);
     uint8_t* from = &start.m_data[start.m_current - (start.m_zeroEnd - start.m_zeroStart)];
-    uint8_t* to = &m_data[m_current];
     memcpy(to, from, toCopy);
-    m_current += toCopy;
 }
 
 void
@@ -1131,18 +1107,40 @@ uint16_t
 Buffer::Iterator::CalculateIpChecksum(uint16_t size, uint32_t initialChecksum)
 {
     NS_LOG_FUNCTION(this << size << initialChecksum);
+    NS_ASSERT_MSG(m_current >= m_dataStart && m_current + size <= m_dataEnd,
+                  GetReadErrorMessage());
     /* see RFC 1071 to understand this code. */
-    uint32_t sum = initialChecksum;
+    uint64_t sum = initialChecksum;
+    uint32_t end = m_current + size;
+    // number of bytes summed so far: the words of a part starting at an odd
+    // offset are made of the bytes of the part in the other order, whose sum
+    // is the byte-swapped sum of the part.
+    uint32_t offset = 0;
+    auto addPart = [&sum, &offset](const uint8_t* data, uint32_t length) {
+        uint16_t partSum = OnesComplementSum(data, length);
+        if (offset & 1)
+        {
+            partSum = (partSum >> 8) | (partSum << 8);
+        }
+        sum += partSum;
+        offset += length;
+    };
 
-    for (int j = 0; j < size / 2; j++)
+    if (m_current < m_zeroStart)
     {
-        sum += ReadU16();
+        addPart(&m_data[m_current], std::min(end, m_zeroStart) - m_current);
     }
-
-    if (size & 1)
+    if (m_current < m_zeroEnd && end > m_zeroStart)
+    {
+        // the virtual zero bytes add nothing
+        offset += std::min(end, m_zeroEnd) - std::max(m_current, m_zeroStart);
+    }
+    if (end > m_zeroEnd)
     {
-        sum += ReadU8();
+        uint32_t start = std::max(m_current, m_zeroEnd);
+        addPart(&m_data[start - (m_zeroEnd - m_zeroStart)], end - start);
     }
+    m_current = end;
 
     while (sum >> 16)
     {
@@ -10,12 +10,11 @@
 
 #include "ns3/assert.h"
 
+#include <atomic>
 #include <ostream>
 #include <stdint.h>
 #include <vector>
 
-#define BUFFER_FREE_LIST 1
-
 namespace ns3
 {
 
@@ -517,6 +516,10 @@ class Buffer
      * Add bytes at the end of the Buffer.
      * Any call to this method invalidates any Iterator
      * pointing to this Buffer.
+     *
+     * The virtual zero areas of the two buffers are merged when they
+     * are adjacent. Otherwise, the larger one is kept and the other
+     * one is written as real zero bytes.
      */
     void AddAtEnd(const Buffer& o);
     /**
@@ -739,6 +742,11 @@ class Buffer
      * \param data the buffer data storage
      */
     static void Deallocate(Buffer::Data* data);
+    /**
+     * \brief Raise the start recommended for the new buffers
+     * \param start the maximum zero area start of a buffer
+     */
+    static void RecommendStart(uint32_t start);
 
     Data* m_data; //!< the buffer data storage
 
@@ -756,9 +764,10 @@ class Buffer
     /**
      * location in a newly-allocated buffer where you should start
      * writing data. i.e., m_start should be initialized to this
-     * value.
+     * value. It is shared by all the threads, which may lose each other's
+     * updates of this hint.
      */
-    static uint32_t g_recommendedStart;
+    static std::atomic<uint32_t> g_recommendedStart;
 
     /**
      * offset to the start of the virtual zero area from the start
@@ -780,21 +789,6 @@ class Buffer
      * instance from the start of m_data->m_data
      */
     uint32_t m_end;
-
-#ifdef BUFFER_FREE_LIST
-    /// Container for buffer data
-    typedef std::vector<Buffer::Data*> FreeList;
-
-    /// Local static destructor structure
-    struct LocalStaticDestructor
-    {
-        ~LocalStaticDestructor();
-    };
-
-    static uint32_t g_maxSize;                            //!< Max observed data size
-    static FreeList* g_freeList;                          //!< Buffer data container
-    static LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
-#endif
 };
 
 } // namespace ns3
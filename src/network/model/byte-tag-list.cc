@@ -7,14 +7,13 @@
  */
 #include "byte-tag-list.h"
 
+#include "packet-allocator.h"
+
 #include "ns3/log.h"
 
 #include <cstring>
 #include <limits>
-#include <vector>
 
-#define USE_FREE_LIST 1
-#define FREE_LIST_SIZE 1000
 #define OFFSET_MAX (std::numeric_limits<int32_t>::max())
 
 namespace ns3
@@ -37,33 +36,6 @@ struct ByteTagListData
     uint8_t data[4]; //!< data
 };
 
-#ifdef USE_FREE_LIST
-/**
- * \ingroup packet
- *
- * \brief Container class for struct ByteTagListData
- *
- * Internal use only.
- */
-static class ByteTagListDataFreeList : public std::vector<ByteTagListData*>
-{
-  public:
-    ~ByteTagListDataFreeList();
-} g_freeList; //!< Container for struct ByteTagListData
-
-static uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
-
-ByteTagListDataFreeList::~ByteTagListDataFreeList()
-{
-    NS_LOG_FUNCTION(this);
-    for (auto i = begin(); i != end(); i++)
-    {
-        auto buffer = (uint8_t*)(*i);
-        delete[] buffer;
-    }
-}
-#endif /* USE_FREE_LIST */
-
 ByteTagList::Iterator::Item::Item(TagBuffer buf_)
     : buf(buf_)
 {
@@ -338,30 +310,15 @@ ByteTagList::AddAtStart(int32_t prependOffset)
     *this = list;
 }
 
-#ifdef USE_FREE_LIST
-
 ByteTagListData*
 ByteTagList::Allocate(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
-    while (!g_freeList.empty())
-    {
-        ByteTagListData* data = g_freeList.back();
-        g_freeList.pop_back();
-        NS_ASSERT(data != nullptr);
-        if (data->size >= size)
-        {
-            data->count = 1;
-            data->dirty = 0;
-            return data;
-        }
-        auto buffer = (uint8_t*)data;
-        delete[] buffer;
-    }
-    auto buffer = new uint8_t[std::max(size, g_maxSize) + sizeof(ByteTagListData) - 4];
-    auto data = (ByteTagListData*)buffer;
+    uint32_t blockSize = size + sizeof(ByteTagListData) - 4;
+    auto data = static_cast<ByteTagListData*>(PacketAllocator::Allocate(blockSize));
+    // use the whole block, which may be larger than requested
+    data->size = blockSize - sizeof(ByteTagListData) + 4;
     data->count = 1;
-    data->size = size;
     data->dirty = 0;
     return data;
 }
@@ -374,54 +331,13 @@ ByteTagList::Deallocate(ByteTagListData* data)
     {
         return;
     }
-    g_maxSize = std::max(g_maxSize, data->size);
     data->count--;
     if (data->count == 0)
     {
-        if (g_freeList.size() > FREE_LIST_SIZE || data->size < g_maxSize)
-        {
-            auto buffer = (uint8_t*)data;
-            delete[] buffer;
-        }
-        else
-        {
-            g_freeList.push_back(data);
-        }
+        PacketAllocator::Deallocate(data, data->size + sizeof(ByteTagListData) - 4);
     }
 }
 
-#else /* USE_FREE_LIST */
-
-ByteTagListData*
-ByteTagList::Allocate(uint32_t size)
-{
-    NS_LOG_FUNCTION(this << size);
-    uint8_t* buffer = new uint8_t[size + sizeof(ByteTagListData) - 4];
-    ByteTagListData* data = (ByteTagListData*)buffer;
-    data->count = 1;
-    data->size = size;
-    data->dirty = 0;
-    return data;
-}
-
-void
-ByteTagList::Deallocate(ByteTagListData* data)
-{
-    NS_LOG_FUNCTION(this << data);
-    if (data == 0)
-    {
-        return;
-    }
-    data->count--;
-    if (data->count == 0)
-    {
-        uint8_t* buffer = (uint8_t*)data;
-        delete[] buffer;
-    }
-}
-
-#endif /* USE_FREE_LIST */
-
 uint32_t
 ByteTagList::GetSerializedSize() const
 {
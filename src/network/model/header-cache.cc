@@ -0,0 +1,71 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "header-cache.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <iterator>
+
+/**
+ * \file
+ * \ingroup packet
+ * ns3::HeaderCache implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("HeaderCache");
+
+const Header*
+HeaderCache::Lookup(TypeId tid, uint32_t offset) const
+{
+    for (const auto& entry : m_entries)
+    {
+        if (entry.offset == offset && entry.tid == tid)
+        {
+            return entry.header.get();
+        }
+    }
+    return nullptr;
+}
+
+void
+HeaderCache::Insert(TypeId tid, uint32_t offset, std::shared_ptr<const Header> header)
+{
+    NS_LOG_FUNCTION(this << tid << offset);
+    NS_ASSERT(Lookup(tid, offset) == nullptr);
+    m_entries.push_back({tid, offset, std::move(header)});
+}
+
+Ptr<HeaderCache>
+HeaderCache::Trim(uint32_t size)
+{
+    NS_LOG_FUNCTION(this << size);
+    auto beyond = [size](const Entry& entry) { return entry.offset > size; };
+    if (GetReferenceCount() > 1)
+    {
+        // shared with the copies of the packet, which are not modified
+        Ptr<HeaderCache> copy = Create<HeaderCache>();
+        std::remove_copy_if(m_entries.begin(),
+                            m_entries.end(),
+                            std::back_inserter(copy->m_entries),
+                            beyond);
+        if (copy->m_entries.empty())
+        {
+            return nullptr;
+        }
+        return copy;
+    }
+    m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(), beyond), m_entries.end());
+    if (m_entries.empty())
+    {
+        return nullptr;
+    }
+    return Ptr<HeaderCache>(this);
+}
+
+} // namespace ns3
@@ -0,0 +1,85 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef HEADER_CACHE_H
+#define HEADER_CACHE_H
+
+#include "header.h"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/type-id.h"
+
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup packet
+ * ns3::HeaderCache declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup packet
+ *
+ * \brief Headers deserialized from a packet, kept to be returned by
+ * later peeks of the same header.
+ *
+ * A header is identified by its TypeId and by its offset from the end
+ * of the packet, which does not change when headers are added or
+ * removed in front of it.  The cache is shared by the copies of a
+ * packet, as long as none of them is modified: see Packet::PeekHeader().
+ */
+class HeaderCache : public SimpleRefCount<HeaderCache>
+{
+  public:
+    /**
+     * Find a cached header.
+     *
+     * \param [in] tid The type of the header.
+     * \param [in] offset The offset of the start of the header from the
+     *             end of the packet.
+     * \returns The header, or nullptr if it is not cached.
+     */
+    const Header* Lookup(TypeId tid, uint32_t offset) const;
+    /**
+     * Cache a header.
+     *
+     * \param [in] tid The type of the header.
+     * \param [in] offset The offset of the start of the header from the
+     *             end of the packet.
+     * \param [in] header The deserialized header.
+     */
+    void Insert(TypeId tid, uint32_t offset, std::shared_ptr<const Header> header);
+    /**
+     * Prepare the cache of a packet to be modified at its start.
+     *
+     * The headers further than \pname{size} from the end of the packet
+     * are dropped.  If the cache is shared by the copies of the packet,
+     * it is left untouched and the remaining headers are copied.
+     *
+     * \param [in] size The size of the packet left untouched.
+     * \returns The cache of the modified packet, or nullptr if it is empty.
+     */
+    Ptr<HeaderCache> Trim(uint32_t size);
+
+  private:
+    /** A cached header. */
+    struct Entry
+    {
+        TypeId tid;                           //!< Type of the header
+        uint32_t offset;                      //!< Offset of the header from the end
+        std::shared_ptr<const Header> header; //!< The deserialized header
+    };
+
+    std::vector<Entry> m_entries; //!< The cached headers
+};
+
+} // namespace ns3
+
+#endif /* HEADER_CACHE_H */
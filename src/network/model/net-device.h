@@ -25,6 +25,7 @@ namespace ns3
 
 class Node;
 class Channel;
+class PacketBurst;
 
 /**
  * \ingroup network
@@ -236,6 +237,22 @@ class NetDevice : public Object
      * \return whether the Send operation succeeded
      */
     virtual bool Send(Ptr<Packet> packet, const Address& dest, uint16_t protocolNumber) = 0;
+    /**
+     * \param burst packets sent from above down to Network Device
+     * \param dest mac address of the destination (already resolved)
+     * \param protocolNumber identifies the type of payload contained in
+     *        these packets. Used to call the right L3Protocol when the packets
+     *        are received.
+     *
+     *  Called from higher layer to send a train of packets into Network
+     *  Device to the specified destination Address.  Devices which support
+     *  it transmit the packets back-to-back and have the channel deliver
+     *  them to the receivers in a single event.  The default implementation
+     *  calls Send() for each packet.
+     *
+     * \return whether all the packets were accepted
+     */
+    virtual bool SendBurst(Ptr<PacketBurst> burst, const Address& dest, uint16_t protocolNumber);
     /**
      * \param packet packet sent from above down to Network Device
      * \param source source mac address (so called "MAC spoofing")
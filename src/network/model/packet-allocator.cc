@@ -0,0 +1,312 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "packet-allocator.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <new>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup packet
+ * ns3::PacketAllocator implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PacketAllocator");
+
+namespace
+{
+
+/** A block held by a free list. */
+struct FreeBlock
+{
+    FreeBlock* next; //!< Next block of the free list
+};
+
+/**
+ * Statistics counter, written by a single thread and read by any.
+ */
+class Counter
+{
+  public:
+    /** Increment the counter; must be called by the owner thread only. */
+    void Increment()
+    {
+        m_value.store(m_value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /** Decrement the counter; must be called by the owner thread only. */
+    void Decrement()
+    {
+        m_value.store(m_value.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Raise the counter to a value, if lower; must be called by the owner thread only.
+     * \param [in] value The value.
+     */
+    void Raise(uint64_t value)
+    {
+        if (value > m_value.load(std::memory_order_relaxed))
+        {
+            m_value.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    /** \return The counter value. */
+    uint64_t Get() const
+    {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<uint64_t> m_value{0}; //!< The counter value
+};
+
+/** Statistics counters of a size class. */
+struct ClassCounters
+{
+    Counter hits;      //!< Allocations served by the free list
+    Counter misses;    //!< Allocations served by the heap
+    Counter releases;  //!< Blocks returned to the heap
+    Counter cached;    //!< Blocks in the free list
+    Counter maxCached; //!< High-water mark of cached
+
+    /**
+     * Add the counters to some statistics.
+     * \param [in,out] stats The statistics.
+     */
+    void AddTo(PacketAllocator::Stats& stats) const
+    {
+        stats.hits += hits.Get();
+        stats.misses += misses.Get();
+        stats.releases += releases.Get();
+        stats.cached += cached.Get();
+        stats.maxCached += maxCached.Get();
+    }
+};
+
+/** The free lists and the statistics of a thread. */
+struct ThreadCache
+{
+    ThreadCache();
+    ~ThreadCache();
+
+    /** Free lists, by size class. */
+    FreeBlock* free[PacketAllocator::N_CLASSES] = {};
+    /** Statistics, by size class, then for the large requests. */
+    ClassCounters counters[PacketAllocator::N_CLASSES + 1];
+
+    /** Return the blocks held by the free lists to the heap. */
+    void Trim();
+};
+
+/** The caches of the live threads, and the statistics of the exited ones. */
+struct Registry
+{
+    /** Protects the other members. */
+    std::mutex mutex;
+    /** Caches of the live threads. */
+    std::vector<const ThreadCache*> caches;
+    /** Statistics of the exited threads, by size class. */
+    PacketAllocator::Stats exited[PacketAllocator::N_CLASSES + 1];
+};
+
+/**
+ * \return The registry.
+ */
+Registry&
+GetRegistry()
+{
+    // Never destroyed, as threads may exit during the static destruction.
+    static auto registry = new Registry;
+    return *registry;
+}
+
+/** Set once the cache of the thread has been destroyed. */
+thread_local bool t_exited = false;
+
+/**
+ * \return The cache of the calling thread, or \c nullptr if the thread is exiting.
+ */
+ThreadCache*
+GetThreadCache()
+{
+    if (t_exited)
+    {
+        return nullptr;
+    }
+    static thread_local ThreadCache cache;
+    return &cache;
+}
+
+ThreadCache::ThreadCache()
+{
+    Registry& registry = GetRegistry();
+    std::lock_guard lock(registry.mutex);
+    registry.caches.push_back(this);
+}
+
+ThreadCache::~ThreadCache()
+{
+    Trim();
+    t_exited = true;
+    Registry& registry = GetRegistry();
+    std::lock_guard lock(registry.mutex);
+    for (uint32_t i = 0; i <= PacketAllocator::N_CLASSES; ++i)
+    {
+        counters[i].AddTo(registry.exited[i]);
+    }
+    registry.caches.erase(std::find(registry.caches.begin(), registry.caches.end(), this));
+}
+
+void
+ThreadCache::Trim()
+{
+    for (uint32_t i = 0; i < PacketAllocator::N_CLASSES; ++i)
+    {
+        while (free[i] != nullptr)
+        {
+            FreeBlock* block = free[i];
+            free[i] = block->next;
+            counters[i].cached.Decrement();
+            ::operator delete(block);
+        }
+    }
+}
+
+} // namespace
+
+uint32_t
+PacketAllocator::GetSizeClass(uint32_t size)
+{
+    NS_ASSERT(size <= MAX_SIZE);
+    return std::bit_width((std::max(size, 1U) - 1) | (MIN_SIZE - 1)) -
+           std::bit_width(MIN_SIZE - 1);
+}
+
+uint32_t
+PacketAllocator::GetClassSize(uint32_t sizeClass)
+{
+    NS_ASSERT(sizeClass < N_CLASSES);
+    return MIN_SIZE << sizeClass;
+}
+
+void*
+PacketAllocator::Allocate(uint32_t& size)
+{
+    ThreadCache* cache = GetThreadCache();
+    if (size > MAX_SIZE)
+    {
+        if (cache != nullptr)
+        {
+            cache->counters[N_CLASSES].misses.Increment();
+        }
+        return ::operator new(size);
+    }
+
+    uint32_t sizeClass = GetSizeClass(size);
+    size = GetClassSize(sizeClass);
+    if (cache == nullptr)
+    {
+        return ::operator new(size);
+    }
+    ClassCounters& counters = cache->counters[sizeClass];
+    FreeBlock* block = cache->free[sizeClass];
+    if (block == nullptr)
+    {
+        counters.misses.Increment();
+        return ::operator new(size);
+    }
+    cache->free[sizeClass] = block->next;
+    counters.cached.Decrement();
+    counters.hits.Increment();
+    return block;
+}
+
+void
+PacketAllocator::Deallocate(void* p, uint32_t size)
+{
+    if (size > MAX_SIZE)
+    {
+        ::operator delete(p);
+        return;
+    }
+
+    uint32_t sizeClass = GetSizeClass(size);
+    ThreadCache* cache = GetThreadCache();
+    if (cache == nullptr)
+    {
+        ::operator delete(p);
+        return;
+    }
+    ClassCounters& counters = cache->counters[sizeClass];
+    uint64_t cached = counters.cached.Get();
+    if (cached >= std::min(MAX_CACHED_BLOCKS, MAX_CACHED_BYTES / GetClassSize(sizeClass)))
+    {
+        counters.releases.Increment();
+        ::operator delete(p);
+        return;
+    }
+    auto block = static_cast<FreeBlock*>(p);
+    block->next = cache->free[sizeClass];
+    cache->free[sizeClass] = block;
+    counters.cached.Increment();
+    counters.maxCached.Raise(cached + 1);
+}
+
+PacketAllocator::Stats
+PacketAllocator::GetStats(uint32_t sizeClass)
+{
+    NS_LOG_FUNCTION(sizeClass);
+    NS_ASSERT(sizeClass <= N_CLASSES);
+    Registry& registry = GetRegistry();
+    std::lock_guard lock(registry.mutex);
+    Stats stats = registry.exited[sizeClass];
+    for (const ThreadCache* cache : registry.caches)
+    {
+        cache->counters[sizeClass].AddTo(stats);
+    }
+    return stats;
+}
+
+PacketAllocator::Stats
+PacketAllocator::GetStats()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    Stats total;
+    for (uint32_t i = 0; i <= N_CLASSES; ++i)
+    {
+        Stats stats = GetStats(i);
+        total.hits += stats.hits;
+        total.misses += stats.misses;
+        total.releases += stats.releases;
+        total.cached += stats.cached;
+        total.maxCached += stats.maxCached;
+    }
+    return total;
+}
+
+void
+PacketAllocator::Trim()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    ThreadCache* cache = GetThreadCache();
+    if (cache != nullptr)
+    {
+        cache->Trim();
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,119 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PACKET_ALLOCATOR_H
+#define PACKET_ALLOCATOR_H
+
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup packet
+ * ns3::PacketAllocator declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup packet
+ * \brief Size-classed, per-thread pools for the packet memory.
+ *
+ * The data of the Buffer, PacketMetadata, ByteTagList and PacketTagList
+ * instances is allocated through this class.  The requests are rounded
+ * up to a power of two, from \c MIN_SIZE to \c MAX_SIZE bytes, and the
+ * released blocks are kept in a free list per size class and per
+ * thread, from which the next requests of the same class are served
+ * without locking.
+ *
+ * Each free list keeps at most \c MAX_CACHED_BLOCKS blocks and
+ * \c MAX_CACHED_BYTES bytes; the blocks released beyond these limits
+ * are returned to the heap, so that the memory held by the pools stays
+ * bounded whatever the packet sizes.  The requests larger than
+ * \c MAX_SIZE bytes always go to the heap.
+ *
+ * A block may be released by another thread than the one which
+ * allocated it: it then joins the free lists of the releasing thread.
+ * The free lists of a thread are returned to the heap when it exits.
+ */
+class PacketAllocator
+{
+  public:
+    /** Size of the smallest size class, in bytes. */
+    static constexpr uint32_t MIN_SIZE = 64;
+    /** Size of the largest size class, in bytes. */
+    static constexpr uint32_t MAX_SIZE = 64 * 1024;
+    /** Number of size classes. */
+    static constexpr uint32_t N_CLASSES = 11;
+    /** Maximum number of blocks in a free list. */
+    static constexpr uint32_t MAX_CACHED_BLOCKS = 1024;
+    /** Maximum number of bytes in a free list. */
+    static constexpr uint32_t MAX_CACHED_BYTES = 1024 * 1024;
+
+    /** Allocation statistics. */
+    struct Stats
+    {
+        uint64_t hits{0};      //!< Allocations served by a free list
+        uint64_t misses{0};    //!< Allocations served by the heap
+        uint64_t releases{0};  //!< Blocks returned to the heap, the free list being full
+        uint64_t cached{0};    //!< Blocks currently held in the free lists
+        uint64_t maxCached{0}; //!< High-water mark of the number of blocks held
+    };
+
+    /**
+     * Allocate a block.
+     *
+     * \param [in,out] size The requested size, in bytes; on return, the
+     *                 size of the block, which may be larger.
+     * \return The block, aligned like the memory returned by operator new.
+     */
+    static void* Allocate(uint32_t& size);
+    /**
+     * Release a block.
+     *
+     * \param [in] p The block returned by Allocate().
+     * \param [in] size The size requested from Allocate(), or the size
+     *             it returned.
+     */
+    static void Deallocate(void* p, uint32_t size);
+
+    /**
+     * \param [in] sizeClass The size class, lower than \c N_CLASSES.
+     * \return The size of the blocks of this class, in bytes.
+     */
+    static uint32_t GetClassSize(uint32_t sizeClass);
+
+    /**
+     * Get the statistics of a size class, summed over all the threads.
+     *
+     * The high-water mark is the sum of the high-water marks of the
+     * threads, an upper bound of the actual one when several threads
+     * allocate packets.
+     *
+     * \param [in] sizeClass The size class, lower than \c N_CLASSES, or
+     *             \c N_CLASSES for the requests larger than \c MAX_SIZE,
+     *             which are all misses.
+     * \return The statistics.
+     */
+    static Stats GetStats(uint32_t sizeClass);
+    /**
+     * \return The statistics of all the size classes, summed over all
+     *         the threads.
+     */
+    static Stats GetStats();
+
+    /** Return the blocks held by the free lists of the calling thread to the heap. */
+    static void Trim();
+
+  private:
+    /**
+     * \param [in] size A block size, in bytes, not larger than \c MAX_SIZE.
+     * \return The size class of the block.
+     */
+    static uint32_t GetSizeClass(uint32_t size);
+};
+
+} // namespace ns3
+
+#endif /* PACKET_ALLOCATOR_H */
@@ -9,6 +9,7 @@
 
 #include "buffer.h"
 #include "header.h"
+#include "packet-allocator.h"
 #include "trailer.h"
 
 #include "ns3/assert.h"
@@ -25,21 +26,8 @@ NS_LOG_COMPONENT_DEFINE("PacketMetadata");
 
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
-bool PacketMetadata::m_metadataSkipped = false;
-uint32_t PacketMetadata::m_maxSize = 0;
-uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
-
-PacketMetadata::DataFreeList::~DataFreeList()
-{
-    NS_LOG_FUNCTION(this);
-    for (auto i = begin(); i != end(); i++)
-    {
-        PacketMetadata::Deallocate(*i);
-    }
-    PacketMetadata::m_enable = false;
-}
-
+std::atomic<bool> PacketMetadata::m_metadataSkipped = false;
+std::atomic<uint16_t> PacketMetadata::m_chunkUid = 0;
 void
 PacketMetadata::Enable()
 {
@@ -556,47 +544,15 @@ PacketMetadata::Data*
 PacketMetadata::Create(uint32_t size)
 {
     NS_LOG_FUNCTION(size);
-    NS_LOG_LOGIC("create size=" << size << ", max=" << m_maxSize);
-    if (size > m_maxSize)
-    {
-        m_maxSize = size;
-    }
-    while (!m_freeList.empty())
-    {
-        PacketMetadata::Data* data = m_freeList.back();
-        m_freeList.pop_back();
-        if (data->m_size >= size)
-        {
-            NS_LOG_LOGIC("create found size=" << data->m_size);
-            data->m_count = 1;
-            return data;
-        }
-        NS_LOG_LOGIC("create dealloc size=" << data->m_size);
-        PacketMetadata::Deallocate(data);
-    }
-    NS_LOG_LOGIC("create alloc size=" << m_maxSize);
-    return PacketMetadata::Allocate(m_maxSize);
+    return PacketMetadata::Allocate(size);
 }
 
 void
 PacketMetadata::Recycle(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    if (!m_enable)
-    {
-        PacketMetadata::Deallocate(data);
-        return;
-    }
-    NS_LOG_LOGIC("recycle size=" << data->m_size << ", list=" << m_freeList.size());
     NS_ASSERT(data->m_count == 0);
-    if (m_freeList.size() > 1000 || data->m_size < m_maxSize)
-    {
-        PacketMetadata::Deallocate(data);
-    }
-    else
-    {
-        m_freeList.push_back(data);
-    }
+    PacketMetadata::Deallocate(data);
 }
 
 PacketMetadata::Data*
@@ -609,9 +565,9 @@ PacketMetadata::Allocate(uint32_t n)
         n = PACKET_METADATA_DATA_M_DATA_SIZE;
     }
     size += n - PACKET_METADATA_DATA_M_DATA_SIZE;
-    auto buf = new uint8_t[size];
-    auto data = (PacketMetadata::Data*)buf;
-    data->m_size = n;
+    auto data = static_cast<PacketMetadata::Data*>(PacketAllocator::Allocate(size));
+    // use the whole block, which may be larger than requested
+    data->m_size = size - sizeof(Data) + PACKET_METADATA_DATA_M_DATA_SIZE;
     data->m_count = 1;
     data->m_dirtyEnd = 0;
     return data;
@@ -621,8 +577,8 @@ void
 PacketMetadata::Deallocate(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    auto buf = (uint8_t*)data;
-    delete[] buf;
+    PacketAllocator::Deallocate(data,
+                                sizeof(Data) + data->m_size - PACKET_METADATA_DATA_M_DATA_SIZE);
 }
 
 PacketMetadata
@@ -650,7 +606,7 @@ PacketMetadata::DoAddHeader(uint32_t uid, uint32_t size)
     NS_LOG_FUNCTION(this << uid << size);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
 
@@ -659,8 +615,7 @@ PacketMetadata::DoAddHeader(uint32_t uid, uint32_t size)
     item.prev = 0xffff;
     item.typeUid = uid;
     item.size = size;
-    item.chunkUid = m_chunkUid;
-    m_chunkUid++;
+    item.chunkUid = m_chunkUid.fetch_add(1, std::memory_order_relaxed);
     uint16_t written = AddSmall(&item);
     UpdateHead(written);
 }
@@ -672,7 +627,7 @@ PacketMetadata::RemoveHeader(const Header& header, uint32_t size)
     NS_LOG_FUNCTION(this << &header << size);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
     PacketMetadata::SmallItem item;
@@ -717,7 +672,7 @@ PacketMetadata::AddTrailer(const Trailer& trailer, uint32_t size)
     NS_LOG_FUNCTION(this << &trailer << size);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
     PacketMetadata::SmallItem item;
@@ -725,8 +680,7 @@ PacketMetadata::AddTrailer(const Trailer& trailer, uint32_t size)
     item.prev = m_tail;
     item.typeUid = uid;
     item.size = size;
-    item.chunkUid = m_chunkUid;
-    m_chunkUid++;
+    item.chunkUid = m_chunkUid.fetch_add(1, std::memory_order_relaxed);
     uint16_t written = AddSmall(&item);
     UpdateTail(written);
     NS_ASSERT(IsStateOk());
@@ -739,7 +693,7 @@ PacketMetadata::RemoveTrailer(const Trailer& trailer, uint32_t size)
     NS_LOG_FUNCTION(this << &trailer << size);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
     PacketMetadata::SmallItem item;
@@ -783,7 +737,7 @@ PacketMetadata::AddAtEnd(const PacketMetadata& o)
     NS_LOG_FUNCTION(this << &o);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
     if (m_tail == 0xffff)
@@ -859,7 +813,7 @@ PacketMetadata::AddPaddingAtEnd(uint32_t end)
     NS_LOG_FUNCTION(this << end);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
 }
@@ -870,7 +824,7 @@ PacketMetadata::RemoveAtStart(uint32_t start)
     NS_LOG_FUNCTION(this << start);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
     NS_ASSERT(m_data != nullptr);
@@ -931,7 +885,7 @@ PacketMetadata::RemoveAtEnd(uint32_t end)
     NS_LOG_FUNCTION(this << end);
     if (!m_enable)
     {
-        m_metadataSkipped = true;
+        m_metadataSkipped.store(true, std::memory_order_relaxed);
         return;
     }
     NS_ASSERT(m_data != nullptr);
@@ -14,6 +14,7 @@
 #include "ns3/callback.h"
 #include "ns3/type-id.h"
 
+#include <atomic>
 #include <limits>
 #include <stdint.h>
 #include <vector>
@@ -498,16 +499,6 @@ class PacketMetadata
         uint64_t packetUid;
     };
 
-    /**
-     * \brief Class to hold all the metadata
-     */
-    class DataFreeList : public std::vector<Data*>
-    {
-      public:
-        ~DataFreeList();
-    };
-
-    friend DataFreeList::~DataFreeList();
     /// Friend class
     friend class ItemIterator;
 
@@ -664,19 +655,17 @@ class PacketMetadata
      */
     static void Deallocate(PacketMetadata::Data* data);
 
-    static DataFreeList m_freeList; //!< the metadata data storage
-    static bool m_enable;           //!< Enable the packet metadata
-    static bool m_enableChecking;   //!< Enable the packet metadata checking
+    static bool m_enable;         //!< Enable the packet metadata
+    static bool m_enableChecking; //!< Enable the packet metadata checking
 
     /**
      * Set to true when adding metadata to a packet is skipped because
      * m_enable is false; used to detect enabling of metadata in the
      * middle of a simulation, which isn't allowed.
      */
-    static bool m_metadataSkipped;
+    static std::atomic<bool> m_metadataSkipped;
 
-    static uint32_t m_maxSize;  //!< maximum metadata size
-    static uint16_t m_chunkUid; //!< Chunk Uid
+    static std::atomic<uint16_t> m_chunkUid; //!< Chunk Uid
 
     Data* m_data; //!< Metadata storage
     /*
@@ -8,288 +8,313 @@
 
 /**
 \file   packet-tag-list.cc
-\brief  Implements a linked list of Packet tags, including copy-on-write semantics.
+\brief  Implements a set of Packet tags, including copy-on-write semantics.
 */
 
 #include "packet-tag-list.h"
 
+#include "packet-allocator.h"
 #include "tag-buffer.h"
 #include "tag.h"
 
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
 #include <cstring>
+#include <limits>
+#include <mutex>
 
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("PacketTagList");
 
-PacketTagList::TagData*
-PacketTagList::CreateTagData(size_t dataSize)
+namespace
 {
-    NS_ASSERT_MSG(dataSize < std::numeric_limits<decltype(TagData::size)>::max(),
-                  "Requested TagData size " << dataSize << " exceeds maximum "
-                                            << std::numeric_limits<decltype(TagData::size)>::max());
 
-    void* p = std::malloc(sizeof(TagData) + dataSize - 1);
-    // The matching frees are in RemoveAll and RemoveWriter
+/** Number of dense ids located through the TagSet mask. */
+constexpr uint16_t MASK_IDS = 64;
 
-    auto tag = new (p) TagData;
-    tag->size = dataSize;
-    return tag;
-}
-
-bool
-PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
-{
-    TypeId tid = tag.GetInstanceTypeId();
-    NS_LOG_FUNCTION(this << tid);
-    NS_LOG_INFO("looking for " << tid);
-
-    // trivial case when list is empty
-    if (m_next == nullptr)
-    {
-        return false;
-    }
+/** Minimum number of descriptors of a TagSet. */
+constexpr uint32_t MIN_TAGS = 4;
 
-    bool found = false;
+/**
+ * Dense ids of the tag types, plus one, indexed by TypeId uid;
+ * zero until the type is first used.
+ */
+std::atomic<uint16_t> g_tagIds[std::numeric_limits<uint16_t>::max() + 1];
 
-    TagData** prevNext = &m_next; // previous node's next pointer
-    TagData* cur = m_next;        // cursor to current node
-    TagData* it = nullptr;        // utility
+} // namespace
 
-    // Search from the head of the list until we find tid or a merge
-    while (cur != nullptr)
+uint16_t
+PacketTagList::GetTagId(TypeId tid)
+{
+    std::atomic<uint16_t>& slot = g_tagIds[tid.GetUid()];
+    uint16_t id = slot.load(std::memory_order_relaxed);
+    if (id == 0)
     {
-        if (cur->count > 1)
-        {
-            // found merge
-            NS_LOG_INFO("found initial merge before tid");
-            break;
-        }
-        else if (cur->tid == tid)
-        {
-            NS_LOG_INFO("found tid before initial merge, calling writer");
-            found = (this->*Writer)(tag, true, cur, prevNext);
-            break;
-        }
-        else
+        static std::mutex mutex;
+        static uint16_t nIds = 0;
+        std::lock_guard lock(mutex);
+        id = slot.load(std::memory_order_relaxed);
+        if (id == 0)
         {
-            // no merge or tid found yet, move on
-            prevNext = &cur->next;
-            cur = cur->next;
+            id = ++nIds;
+            slot.store(id, std::memory_order_relaxed);
+            NS_LOG_LOGIC("tag " << tid << " has id " << id - 1);
         }
-    } // while !found && !cow
-
-    // did we find it or run out of tags?
-    if (cur == nullptr || found)
-    {
-        NS_LOG_INFO("returning after header with found: " << found);
-        return found;
     }
+    return id - 1;
+}
+
+PacketTagList::TagSet*
+PacketTagList::CreateTagSet(uint32_t maxTags, uint32_t capacity)
+{
+    maxTags = std::max(maxTags, MIN_TAGS);
+    NS_ASSERT_MSG(maxTags <= std::numeric_limits<decltype(TagSet::maxTags)>::max(),
+                  "Requested " << maxTags << " tags exceeds maximum "
+                               << std::numeric_limits<decltype(TagSet::maxTags)>::max());
+
+    uint32_t header = offsetof(TagSet, tags) + maxTags * sizeof(TagData);
+    uint32_t blockSize = header + capacity;
+    void* p = PacketAllocator::Allocate(blockSize);
+    // The matching DestroyTagSet calls are in RemoveAll and Unshare
+
+    auto set = new (p) TagSet;
+    set->count = 1;
+    set->nTags = 0;
+    set->maxTags = maxTags;
+    set->used = 0;
+    // use the whole block, which may be larger than requested
+    set->capacity = blockSize - header;
+    set->mask = 0;
+    return set;
+}
 
-    // From here on out, we have to copy the list
-    // until we find tid, then link past it
+void
+PacketTagList::DestroyTagSet(TagSet* set)
+{
+    uint32_t blockSize = offsetof(TagSet, tags) + set->maxTags * sizeof(TagData) + set->capacity;
+    set->~TagSet();
+    PacketAllocator::Deallocate(set, blockSize);
+}
 
-    // Before we do all that work, let's make sure tid really exists
-    for (it = cur; it != nullptr; it = it->next)
+uint32_t
+PacketTagList::GetPosition(const TagSet* set, uint16_t id)
+{
+    if (id < MASK_IDS)
     {
-        if (it->tid == tid)
-        {
-            break;
-        }
+        return std::popcount(set->mask & ((uint64_t(1) << id) - 1));
     }
-    if (it == nullptr)
+    uint32_t pos = std::popcount(set->mask);
+    while (pos < set->nTags && set->tags[pos].id < id)
     {
-        // got to end of list without finding tid
-        NS_LOG_INFO("tid not found after first merge");
-        return found;
+        pos++;
     }
+    return pos;
+}
 
-    // At this point cur is a merge, but untested for tid
-    NS_ASSERT(cur != nullptr);
-    NS_ASSERT(cur->count > 1);
-
-    /*
-       Walk the remainder of the list, copying, until we find tid
-       As we put a copy of the cur node onto our list,
-       we move the merge point down the list.
-
-       Starting position                  End position
-         T1 is a merge                     T1.count decremented
-                                           T2 is a merge
-                                           T1' is a copy of T1
-
-            other                             other
-                 \                                 \
-        Prev  ->  T1  ->  T2  -> ...                T1  ->  T2  -> ...
-             /   /                                         /|
-        pNext cur                         Prev  ->  T1' --/ |
-                                                       /    |
-                                                  pNext   cur
-
-       When we reach tid, we link past it, decrement count, and we're done.
-    */
-
-    // Should normally check for null cur pointer,
-    // but since we know tid exists, we'll skip this test
-    while (/* cur && */ cur->tid != tid)
+PacketTagList::TagData&
+PacketTagList::InsertTag(TagSet* set, uint32_t pos, TypeId tid, uint16_t id, uint32_t size)
+{
+    NS_ASSERT(set->nTags < set->maxTags);
+    NS_ASSERT(set->used + size <= set->capacity);
+    std::copy_backward(set->tags + pos, set->tags + set->nTags, set->tags + set->nTags + 1);
+    TagData& tag = set->tags[pos];
+    tag.tid = tid;
+    tag.id = id;
+    tag.size = size;
+    tag.offset = set->used;
+    set->used += size;
+    set->nTags++;
+    if (id < MASK_IDS)
     {
-        NS_ASSERT(cur != nullptr);
-        NS_ASSERT(cur->count > 1);
-        cur->count--; // unmerge cur
-        TagData* copy = CreateTagData(cur->size);
-        copy->tid = cur->tid;
-        copy->count = 1;
-        copy->size = cur->size;
-        memcpy(copy->data, cur->data, copy->size);
-        copy->next = cur->next; // merge into tail
-        copy->next->count++;    // mark new merge
-        *prevNext = copy;       // point prior list at copy
-        prevNext = &copy->next; // advance
-        cur = copy->next;
+        set->mask |= uint64_t(1) << id;
     }
-    // Sanity check:
-    NS_ASSERT(cur != nullptr);  // cur should be non-zero
-    NS_ASSERT(cur->tid == tid); // cur->tid should be tid
-    NS_ASSERT(cur->count > 1);  // cur should be a merge
-
-    // link around tid, removing it from our list
-    found = (this->*Writer)(tag, false, cur, prevNext);
-    return found;
+    return tag;
 }
 
-bool
-PacketTagList::Remove(Tag& tag)
+void
+PacketTagList::EraseTag(TagSet* set, uint32_t pos)
 {
-    return COWTraverse(tag, &PacketTagList::RemoveWriter);
+    TagData tag = set->tags[pos];
+    uint8_t* data = set->GetData() + tag.offset;
+    std::memmove(data, data + tag.size, set->used - tag.offset - tag.size);
+    set->used -= tag.size;
+    std::copy(set->tags + pos + 1, set->tags + set->nTags, set->tags + pos);
+    set->nTags--;
+    for (uint32_t i = 0; i < set->nTags; ++i)
+    {
+        if (set->tags[i].offset > tag.offset)
+        {
+            set->tags[i].offset -= tag.size;
+        }
+    }
+    if (tag.id < MASK_IDS)
+    {
+        set->mask &= ~(uint64_t(1) << tag.id);
+    }
 }
 
-// COWWriter implementing Remove
-bool
-PacketTagList::RemoveWriter(Tag& tag,
-                            bool preMerge,
-                            PacketTagList::TagData* cur,
-                            PacketTagList::TagData** prevNext)
+PacketTagList::TagSet*
+PacketTagList::Unshare(uint32_t extraTags, uint32_t extraBytes)
 {
-    NS_LOG_FUNCTION_NOARGS();
-
-    // found tid
-    bool found = true;
-    tag.Deserialize(TagBuffer(cur->data, cur->data + cur->size));
-    *prevNext = cur->next; // link around cur
+    TagSet* set = m_set;
+    if (set != nullptr && set->count == 1 && set->nTags + extraTags <= set->maxTags &&
+        set->used + extraBytes <= set->capacity)
+    {
+        return set;
+    }
 
-    if (preMerge)
+    uint32_t nTags = 0;
+    uint32_t used = 0;
+    uint32_t maxTags = 0;
+    uint32_t capacity = 0;
+    if (set != nullptr)
     {
-        // found tid before first merge, so delete cur
-        cur->~TagData();
-        std::free(cur);
+        nTags = set->nTags;
+        used = set->used;
+        if (set->count == 1)
+        {
+            // grow geometrically a set which is not shared, but too small
+            maxTags = 2 * set->maxTags;
+            capacity = 2 * set->capacity;
+        }
     }
-    else
+    NS_LOG_LOGIC("copy set " << set << " with " << nTags << " tags");
+    // leave room for a few more tags, as the copies of a packet are
+    // usually tagged further
+    TagSet* copy = CreateTagSet(std::max(nTags + extraTags + MIN_TAGS, maxTags),
+                                std::max(used + extraBytes, capacity));
+    if (set != nullptr)
     {
-        // cur is always a merge at this point
-        // unmerge cur, since we linked around it already
-        cur->count--;
-        if (cur->next != nullptr)
+        copy->nTags = nTags;
+        copy->used = used;
+        copy->mask = set->mask;
+        std::copy_n(set->tags, nTags, copy->tags);
+        std::memcpy(copy->GetData(), set->GetData(), used);
+        set->count--;
+        if (set->count == 0)
         {
-            // there's a next, so make it a merge
-            cur->next->count++;
+            DestroyTagSet(set);
         }
     }
-    return found;
+    m_set = copy;
+    return copy;
 }
 
 bool
-PacketTagList::Replace(Tag& tag)
+PacketTagList::Remove(Tag& tag)
 {
-    bool found = COWTraverse(tag, &PacketTagList::ReplaceWriter);
-    if (!found)
+    TypeId tid = tag.GetInstanceTypeId();
+    NS_LOG_FUNCTION(this << tid);
+    if (m_set == nullptr)
     {
-        Add(tag);
+        return false;
     }
-    return found;
+    uint16_t id = GetTagId(tid);
+    uint32_t pos = GetPosition(m_set, id);
+    if (pos == m_set->nTags || m_set->tags[pos].id != id)
+    {
+        NS_LOG_INFO("tid not found");
+        return false;
+    }
+
+    const TagData& data = m_set->tags[pos];
+    uint8_t* start = m_set->GetData() + data.offset;
+    tag.Deserialize(TagBuffer(start, start + data.size));
+    TagSet* set = Unshare(0, 0);
+    EraseTag(set, pos);
+    return true;
 }
 
-// COWWriter implementing Replace
 bool
-PacketTagList::ReplaceWriter(Tag& tag,
-                             bool preMerge,
-                             PacketTagList::TagData* cur,
-                             PacketTagList::TagData** prevNext)
+PacketTagList::Replace(Tag& tag)
 {
-    NS_LOG_FUNCTION_NOARGS();
+    TypeId tid = tag.GetInstanceTypeId();
+    NS_LOG_FUNCTION(this << tid);
+    uint16_t id = GetTagId(tid);
+    uint32_t pos = 0;
+    if (m_set != nullptr)
+    {
+        pos = GetPosition(m_set, id);
+    }
+    if (m_set == nullptr || pos == m_set->nTags || m_set->tags[pos].id != id)
+    {
+        Add(tag);
+        return false;
+    }
 
-    // found tid
-    bool found = true;
-    if (preMerge)
+    uint32_t size = tag.GetSerializedSize();
+    TagSet* set = nullptr;
+    if (size == m_set->tags[pos].size)
     {
-        // found tid before first merge, so just rewrite
-        tag.Serialize(TagBuffer(cur->data, cur->data + cur->size));
+        // same size, so just rewrite
+        set = Unshare(0, 0);
     }
     else
     {
-        // cur is always a merge at this point
-        // need to copy, replace, and link past cur
-        cur->count--; // unmerge cur
-        TagData* copy = CreateTagData(tag.GetSerializedSize());
-        copy->tid = tag.GetInstanceTypeId();
-        copy->count = 1;
-        tag.Serialize(TagBuffer(copy->data, copy->data + copy->size));
-        copy->next = cur->next; // merge into tail
-        if (copy->next != nullptr)
-        {
-            copy->next->count++; // mark new merge
-        }
-        *prevNext = copy; // point prior list at copy
+        set = Unshare(0, size);
+        EraseTag(set, pos);
+        InsertTag(set, pos, tid, id, size);
     }
-    return found;
+    uint8_t* start = set->GetData() + set->tags[pos].offset;
+    tag.Serialize(TagBuffer(start, start + size));
+    return true;
 }
 
 void
 PacketTagList::Add(const Tag& tag) const
 {
-    NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
-    // ensure this id was not yet added
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    TypeId tid = tag.GetInstanceTypeId();
+    NS_LOG_FUNCTION(this << tid);
+    uint16_t id = GetTagId(tid);
+    uint32_t pos = 0;
+    if (m_set != nullptr)
     {
-        NS_ASSERT_MSG(cur->tid != tag.GetInstanceTypeId(),
+        pos = GetPosition(m_set, id);
+        // ensure this id was not yet added
+        NS_ASSERT_MSG(pos == m_set->nTags || m_set->tags[pos].id != id,
                       "Error: cannot add the same kind of tag twice. The tag type is "
-                          << tag.GetInstanceTypeId().GetName());
+                          << tid.GetName());
     }
-    TagData* head = CreateTagData(tag.GetSerializedSize());
-    head->count = 1;
-    head->next = nullptr;
-    head->tid = tag.GetInstanceTypeId();
-    head->next = m_next;
-    tag.Serialize(TagBuffer(head->data, head->data + head->size));
-
-    const_cast<PacketTagList*>(this)->m_next = head;
+
+    uint32_t size = tag.GetSerializedSize();
+    TagSet* set = const_cast<PacketTagList*>(this)->Unshare(1, size);
+    uint8_t* start = set->GetData() + InsertTag(set, pos, tid, id, size).offset;
+    tag.Serialize(TagBuffer(start, start + size));
 }
 
 bool
 PacketTagList::Peek(Tag& tag) const
 {
     NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
-    TypeId tid = tag.GetInstanceTypeId();
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    if (m_set == nullptr)
     {
-        if (cur->tid == tid)
-        {
-            /* found tag */
-            tag.Deserialize(TagBuffer(cur->data, cur->data + cur->size));
-            return true;
-        }
+        return false;
     }
-    /* no tag found */
-    return false;
+    uint16_t id = GetTagId(tag.GetInstanceTypeId());
+    uint32_t pos = GetPosition(m_set, id);
+    if (pos == m_set->nTags || m_set->tags[pos].id != id)
+    {
+        /* no tag found */
+        return false;
+    }
+    /* found tag */
+    const TagData& data = m_set->tags[pos];
+    uint8_t* start = m_set->GetData() + data.offset;
+    tag.Deserialize(TagBuffer(start, start + data.size));
+    return true;
 }
 
-const PacketTagList::TagData*
-PacketTagList::Head() const
+const PacketTagList::TagSet*
+PacketTagList::GetTagSet() const
 {
-    return m_next;
+    return m_set;
 }
 
 uint32_t
@@ -301,7 +326,8 @@ PacketTagList::GetSerializedSize() const
 
     size = 4; // numberOfTags
 
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    uint32_t nTags = (m_set != nullptr) ? m_set->nTags : 0;
+    for (uint32_t i = 0; i < nTags; ++i)
     {
         size += 4; // TagData -> size
 
@@ -310,7 +336,7 @@ PacketTagList::GetSerializedSize() const
         size += hashSize;
 
         // TagData -> data; ensure size is multiple of 4 bytes
-        uint32_t tagWordSize = (cur->size + 3) & (~3);
+        uint32_t tagWordSize = (m_set->tags[i].size + 3) & (~3);
         size += tagWordSize;
     }
 
@@ -335,8 +361,10 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
     uint32_t* numberOfTags = p;
     *p++ = 0;
 
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    uint32_t nTags = (m_set != nullptr) ? m_set->nTags : 0;
+    for (uint32_t i = 0; i < nTags; ++i)
     {
+        const TagData& cur = m_set->tags[i];
         size += 4;
 
         if (size > maxSize)
@@ -344,9 +372,9 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
             return 0;
         }
 
-        *p++ = cur->size;
+        *p++ = cur.size;
 
-        NS_LOG_INFO("Serializing tag id " << cur->tid);
+        NS_LOG_INFO("Serializing tag id " << cur.tid);
 
         // ensure size is multiple of 4 bytes for 4 byte boundaries
         uint32_t hashSize = (sizeof(TypeId::hash_t) + 3) & (~3);
@@ -357,12 +385,12 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
             return 0;
         }
 
-        TypeId::hash_t tid = cur->tid.GetHash();
+        TypeId::hash_t tid = cur.tid.GetHash();
         memcpy(p, &tid, sizeof(TypeId::hash_t));
         p += hashSize / 4;
 
         // ensure size is multiple of 4 bytes for 4 byte boundaries
-        uint32_t tagWordSize = (cur->size + 3) & (~3);
+        uint32_t tagWordSize = (cur.size + 3) & (~3);
         size += tagWordSize;
 
         if (size > maxSize)
@@ -370,7 +398,7 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
             return 0;
         }
 
-        memcpy(p, cur->data, cur->size);
+        memcpy(p, m_set->GetData() + cur.offset, cur.size);
         p += tagWordSize / 4;
 
         (*numberOfTags)++;
@@ -393,7 +421,12 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
 
     NS_LOG_INFO("Deserializing number of tags " << numberOfTags);
 
-    TagData* prevTag = nullptr;
+    RemoveAll();
+    if (numberOfTags > 0)
+    {
+        // the serialized tags are slightly larger than their data
+        m_set = CreateTagSet(numberOfTags, sizeCheck);
+    }
     for (uint32_t i = 0; i < numberOfTags; ++i)
     {
         NS_ASSERT(sizeCheck >= 4);
@@ -411,30 +444,16 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
 
         NS_LOG_INFO("Deserializing tag of type " << tid);
 
-        TagData* newTag = CreateTagData(tagSize);
-        newTag->count = 1;
-        newTag->next = nullptr;
-        newTag->tid = tid;
+        uint16_t id = GetTagId(tid);
+        TagData& newTag = InsertTag(m_set, GetPosition(m_set, id), tid, id, tagSize);
 
         NS_ASSERT(sizeCheck >= tagSize);
-        memcpy(newTag->data, p, tagSize);
+        memcpy(m_set->GetData() + newTag.offset, p, tagSize);
 
         // ensure 4 byte boundary
         uint32_t tagWordSize = (tagSize + 3) & (~3);
         p += tagWordSize / 4;
         sizeCheck -= tagWordSize;
-
-        // Set link list pointers.
-        if (i == 0)
-        {
-            m_next = newTag;
-        }
-        else
-        {
-            prevTag->next = newTag;
-        }
-
-        prevTag = newTag;
     }
 
     NS_ASSERT(sizeCheck == 0);
@@ -10,7 +10,7 @@
 
 /**
 \file   packet-tag-list.h
-\brief  Defines a linked list of Packet tags, including copy-on-write semantics.
+\brief  Defines a set of Packet tags, including copy-on-write semantics.
 */
 
 #include "ns3/type-id.h"
@@ -33,108 +33,77 @@ class Tag;
  *
  * \internal
  *
- * The implementation of this class is a bit tricky.  Refer to this
- * diagram in the discussion that follows.
+ * The tags of a packet are serialized in a single TagSet block:
  *
- * \dot
- *    digraph {
- *        rankdir = "LR";
- *        clusterrank = local;
- *        node [ shape = record, fontname="FreeSans", fontsize="10" ];
- *        oth  [ label="<l> Other branch | <n> next | <c> ..." ];
- *        PTL1 [ label="<l> PacketTagList A | <n> m_next" , shape=Mrecord];
- *        PTL2 [ label="<l> PacketTagList B | <n> m_next" , shape=Mrecord];
- *        oth:n  -> T7:l ;
- *        PTL2:n -> T6:l ;
- *        PTL1:n -> T5:l ;
- *        T1   [ label="<l> T1  | <n> next | <c> count = 1" ];
- *        T2   [ label="<l> T2  | <n> next | <c> count = 1" ];
- *        T3   [ label="<l> T3  | <n> next | <c> count = 2" ];
- *        T4   [ label="<l> T4  | <n> next | <c> count = 1" ];
- *        T5   [ label="<l> T5  | <n> next | <c> count = 2" ];
- *        T6   [ label="<l> T6  | <n> next | <c> count = 1" ];
- *        T7   [ label="<l> T7  | <n> next | <c> count = 1" ];
- *        NULL [ label="0", shape = ellipse ];
- *        subgraph cluster_list {
- *          penwidth = 0;
- *          T6:n -> T5:l ;
- *          T5:n -> T4:l ;
- *          T4:n -> T3:l ;
- *          T7:n -> T3:l ;
- *          T3:n -> T2:l ;
- *          T2:n -> T1:l ;
- *          T1:n -> NULL ;
- *        };
- *      }
- * \enddot
+ *   - Each tag type is given a small dense id, in the order in which
+ *     the tag types are first used (see GetTagId()).
  *
- *   - Tags are stored in serialized form in a tree of TagData
- *     structures. (<tt>T1-T7</tt> in the diagram)
+ *   - The TagSet holds a TagData descriptor per tag, sorted by
+ *     increasing dense id, followed by the data area in which the tags
+ *     are serialized.
  *
- *   - Each TagData points (\c next pointers in the diagram)
- *     toward the root of the tree, which is a null pointer.
+ *   - The TagSet \c mask has bit \c i set if the tag of dense id \c i
+ *     is present, for the ids lower than 64.  The descriptor of such a
+ *     tag is found in constant time: its index is the number of bits
+ *     set below bit \c i.  The tags of higher ids, if any, follow and
+ *     are searched linearly.
  *
- *   - \c count is the number of incoming pointers to this
- *     TagData.  Branch points, where branches merge or join, have
- *     <tt>count \> 1</tt> (\c T3, \c T5); successive links along
- *     a branch have <tt>count = 1</tt> (\c T1, \c T2, \c T4, \c T6, \c T7).
- *
- *   - Each PacketTagList points to a specific TagData,
- *     which is the most recent Tag added to the packet. (<tt>T5-T7</tt>)
- *
- *   - Conceptually, therefore, each Packet has a PacketTagList which
- *     points to a singly-linked list of TagData.
+ *   - \c count is the number of PacketTagList sharing the TagSet.
  *
  * \par <b> Copy-on-write </b> is implemented as follows:
  *
- *   - #Add prepends the new tag to the list (growing that branch of the tree,
- *     as \c T6). This is a constant time operation, and does not affect
- *     any other #PacketTagList's, hence this is a \c const function.
- *
  *   - Copy constructor (PacketTagList(const PacketTagList & o))
  *     and assignment (#operator=(const PacketTagList & o))
- *     simply join the tree at the same place as the original
- *     PacketTagList \c o, incrementing the \c count.
- *     For assignment, the old branch is deleted, up to
- *     the first branch point, which has its \c count decremented.
- *     (PacketTagList \c B started as a copy of PacketTagList \c A,
- *     before \c T6 was added to \c B).
+ *     simply share the TagSet of the original PacketTagList \c o,
+ *     incrementing the \c count.
  *
- *   - #Remove and #Replace are a little tricky, depending on where the
- *     target tag is found relative to the first branch point:
- *     - \e Target before <em> the first branch point: </em> \n
- *       The target is just dealt with in place (linked around and deleted,
- *       in the case of #Remove; rewritten in the case of #Replace).
- *     - \e Target at or after <em> the first branch point: </em> \n
- *       The portion of the list between the first branch and the target is
- *       shared. This portion is copied before the #Remove or #Replace is
- *       performed.
+ *   - #Add, #Remove and #Replace modify the TagSet in place if it is
+ *     not shared and has room for the change.  Otherwise, the TagSet
+ *     is first copied, which is cheap since it is a single block of a
+ *     few small tags.  #Add does not affect any other PacketTagList,
+ *     hence this is a \c const function.
  */
 class PacketTagList
 {
   public:
     /**
-     * Tree node for sharing serialized tags.
+     * Descriptor of a tag stored in a TagSet.
+     */
+    struct TagData
+    {
+        TypeId tid;      //!< Type of the tag
+        uint16_t id;     //!< Dense id of the tag type
+        uint32_t size;   //!< Size of the serialized tag
+        uint32_t offset; //!< Offset of the serialized tag in the data area
+    };
+
+    /**
+     * Block holding the tags, shared by the copies of a PacketTagList.
      *
      * See PacketTagList for a discussion of the data structure.
      *
      * \internal
      * Unfortunately this has to be public, because
-     * PacketTagIterator::Item::GetTag() needs the data and size values.
-     * The Item nested class can't be forward declared, so friending isn't
-     * possible.
+     * PacketTagIterator::Item::GetTag() needs the descriptors and the data.
      *
-     * We use placement new so we can allocate enough room for the Tag
-     * type which will be serialized into data.  See Object::Aggregates
+     * The block is allocated large enough for \c maxTags descriptors,
+     * followed by \c capacity bytes of data.  See Object::Aggregates
      * for a similar construction.
      */
-    struct TagData
+    struct TagSet
     {
-        TagData* next;   //!< Pointer to next in list
-        uint32_t count;  //!< Number of incoming links
-        TypeId tid;      //!< Type of the tag serialized into #data
-        uint32_t size;   //!< Size of the \c data buffer
-        uint8_t data[1]; //!< Serialization buffer
+        uint32_t count;    //!< Number of PacketTagList sharing the set
+        uint16_t nTags;    //!< Number of tags
+        uint16_t maxTags;  //!< Number of descriptors allocated
+        uint32_t used;     //!< Number of bytes used in the data area
+        uint32_t capacity; //!< Size of the data area
+        uint64_t mask;     //!< Bit \c i set if the tag of dense id \c i is present
+        TagData tags[1];   //!< Descriptors, by increasing dense id
+
+        /**
+         * \returns The data area, which follows the descriptors.
+         */
+        inline uint8_t* GetData() const;
     };
 
     /**
@@ -146,8 +115,8 @@ class PacketTagList
      *
      * \param [in] o The PacketTagList to copy.
      *
-     * This makes a light-weight copy by #RemoveAll, then
-     * pointing to the same \ref TagData as \pname{o}.
+     * This makes a light-weight copy, pointing to the same
+     * \ref TagSet as \pname{o}.
      */
     inline PacketTagList(const PacketTagList& o);
     /**
@@ -157,24 +126,24 @@ class PacketTagList
      * \returns the copied object
      *
      * This makes a light-weight copy by #RemoveAll, then
-     * pointing to the same \ref TagData as \pname{o}.
+     * pointing to the same \ref TagSet as \pname{o}.
      */
     inline PacketTagList& operator=(const PacketTagList& o);
     /**
      * Destructor
      *
-     * #RemoveAll's the tags up to the first merge.
+     * #RemoveAll's the tags.
      */
     inline ~PacketTagList();
 
     /**
-     * Add a tag to the head of this branch.
+     * Add a tag to the list.
      *
      * \param [in] tag The tag to add
      */
     void Add(const Tag& tag) const;
     /**
-     * Remove (the first instance of) tag from the list.
+     * Remove tag from the list.
      *
      * \param [in,out] tag The tag type to remove.  If found,
      *          \pname{tag} is set to the value of the tag found.
@@ -200,13 +169,14 @@ class PacketTagList
      */
     bool Peek(Tag& tag) const;
     /**
-     * Remove all tags from this list (up to the first merge).
+     * Remove all tags from this list, releasing the TagSet if it is
+     * not shared.
      */
     inline void RemoveAll();
     /**
-     * \returns pointer to head of tag list
+     * \returns pointer to the set of tags, or nullptr if no tag was ever added
      */
-    const PacketTagList::TagData* Head() const;
+    const PacketTagList::TagSet* GetTagSet() const;
     /**
      * Returns number of bytes required for packet serialization.
      *
@@ -232,68 +202,72 @@ class PacketTagList
      */
     uint32_t Deserialize(const uint32_t* buffer, uint32_t size);
 
-  private:
     /**
-     * Allocate and construct a TagData struct, sizing the data area
-     * large enough to serialize dataSize bytes from a Tag.
+     * Get the dense id of a tag type, assigned when the type is first
+     * used in a PacketTagList.
      *
-     * \param [in] dataSize The serialized size of the Tag.
-     * \returns The newly constructed TagData object.
+     * \param [in] tid The type of the tag.
+     * \returns The dense id of the tag type.
      */
-    static TagData* CreateTagData(size_t dataSize);
+    static uint16_t GetTagId(TypeId tid);
 
+  private:
     /**
-     * Typedef of method function pointer for copy-on-write operations
+     * Allocate a TagSet struct, sizing it large enough for the given
+     * number of tags and bytes of serialized tags.
      *
-     * \param [in] tag The tag type to operate on.
-     * \param [in] preMerge True if \pname{tag} was found before the first merge,
-     *             false otherwise.
-     * \param [in] cur Pointer to the tag.
-     * \param [in] prevNext Pointer to the struct TagData.next pointer
-     *          pointing to \pname{cur}.
-     * \returns True if operation successful, false otherwise
+     * \param [in] maxTags The number of descriptors.
+     * \param [in] capacity The size of the data area.
+     * \returns The newly allocated, empty TagSet, with a count of 1.
      */
-    typedef bool (PacketTagList::*COWWriter)(Tag& tag,
-                                             bool preMerge,
-                                             TagData* cur,
-                                             TagData** prevNext);
+    static TagSet* CreateTagSet(uint32_t maxTags, uint32_t capacity);
     /**
-     * Traverse the list implementing copy-on-write, using \pname{Writer}.
+     * Release a TagSet struct created by CreateTagSet().
      *
-     * \param [in] tag The tag type to operate on.
-     * \param [in] Writer The copy-on-write function to use.
-     * \returns True if \pname{tag} found, false otherwise.
+     * \param [in] set The TagSet.
      */
-    bool COWTraverse(Tag& tag, PacketTagList::COWWriter Writer);
+    static void DestroyTagSet(TagSet* set);
     /**
-     * Copy-on-write implementing Remove.
+     * Find where the descriptor of a tag is, or would be inserted.
      *
-     * \param [in] tag The target tag type to remove.
-     * \param [in] preMerge True if \pname{tag} was found before the first merge,
-     *             false otherwise.
-     * \param [in] cur Pointer to the tag.
-     * \param [in] prevNext Pointer to the struct TagData.next pointer
-     *          pointing to \pname{cur}.
-     * \returns True, since tag will definitely be removed.
+     * \param [in] set The TagSet.
+     * \param [in] id The dense id of the tag type.
+     * \returns The index of the first descriptor whose id is not lower
+     *          than \pname{id}, or the number of tags if there is none.
      */
-    bool RemoveWriter(Tag& tag, bool preMerge, TagData* cur, TagData** prevNext);
+    static uint32_t GetPosition(const TagSet* set, uint16_t id);
     /**
-     * Copy-on-write implementing Replace
+     * Insert the descriptor of a tag, and reserve its data area.
      *
-     * \param [in] tag The target tag type to replace
-     * \param [in] preMerge True if \pname{tag} was found before the first merge,
-     *          false otherwise.
-     * \param [in] cur Pointer to the tag
-     * \param [in] prevNext Pointer to the struct TagData.next pointer
-     *          pointing to \pname{cur}.
-     * \returns True, since tag value will definitely be replaced.
+     * \param [in,out] set The TagSet, which must have room for the tag.
+     * \param [in] pos The position of the descriptor, from GetPosition().
+     * \param [in] tid The type of the tag.
+     * \param [in] id The dense id of the tag type.
+     * \param [in] size The size of the serialized tag.
+     * \returns The descriptor of the tag.
      */
-    bool ReplaceWriter(Tag& tag, bool preMerge, TagData* cur, TagData** prevNext);
+    static TagData& InsertTag(TagSet* set, uint32_t pos, TypeId tid, uint16_t id, uint32_t size);
+    /**
+     * Remove the descriptor and the data of a tag, compacting the data area.
+     *
+     * \param [in,out] set The TagSet.
+     * \param [in] pos The index of the descriptor.
+     */
+    static void EraseTag(TagSet* set, uint32_t pos);
+    /**
+     * Make sure that the TagSet is not shared with another PacketTagList
+     * and has room for some more tags, copying it otherwise.
+     *
+     * \param [in] extraTags The number of tags to be added.
+     * \param [in] extraBytes The number of bytes of serialized tags to be added.
+     * \returns The TagSet of this list, which may be modified in place.
+     */
+    TagSet* Unshare(uint32_t extraTags, uint32_t extraBytes);
 
     /**
-     * Pointer to first \ref TagData on the list
+     * Pointer to the \ref TagSet
      */
-    TagData* m_next;
+    TagSet* m_set;
 };
 
 } // namespace ns3
@@ -305,17 +279,23 @@ class PacketTagList
 namespace ns3
 {
 
+uint8_t*
+PacketTagList::TagSet::GetData() const
+{
+    return reinterpret_cast<uint8_t*>(const_cast<TagData*>(tags + maxTags));
+}
+
 PacketTagList::PacketTagList()
-    : m_next()
+    : m_set()
 {
 }
 
 PacketTagList::PacketTagList(const PacketTagList& o)
-    : m_next(o.m_next)
+    : m_set(o.m_set)
 {
-    if (m_next != nullptr)
+    if (m_set != nullptr)
     {
-        m_next->count++;
+        m_set->count++;
     }
 }
 
@@ -323,15 +303,15 @@ PacketTagList&
 PacketTagList::operator=(const PacketTagList& o)
 {
     // self assignment
-    if (m_next == o.m_next)
+    if (m_set == o.m_set)
     {
         return *this;
     }
     RemoveAll();
-    m_next = o.m_next;
-    if (m_next != nullptr)
+    m_set = o.m_set;
+    if (m_set != nullptr)
     {
-        m_next->count++;
+        m_set->count++;
     }
     return *this;
 }
@@ -344,27 +324,15 @@ PacketTagList::~PacketTagList()
 void
 PacketTagList::RemoveAll()
 {
-    TagData* prev = nullptr;
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    if (m_set != nullptr)
     {
-        cur->count--;
-        if (cur->count > 0)
-        {
-            break;
-        }
-        if (prev != nullptr)
+        m_set->count--;
+        if (m_set->count == 0)
         {
-            prev->~TagData();
-            std::free(prev);
+            DestroyTagSet(m_set);
         }
-        prev = cur;
-    }
-    if (prev != nullptr)
-    {
-        prev->~TagData();
-        std::free(prev);
+        m_set = nullptr;
     }
-    m_next = nullptr;
 }
 
 } // namespace ns3
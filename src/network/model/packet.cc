@@ -13,13 +13,14 @@
 
 #include <cstdarg>
 #include <string>
+#include <vector>
 
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("Packet");
 
-uint32_t Packet::m_globalUid = 0;
+thread_local uint64_t Packet::m_globalUid = 0;
 
 TypeId
 ByteTagIterator::Item::GetTypeId() const
@@ -78,28 +79,29 @@ ByteTagIterator::ByteTagIterator(ByteTagList::Iterator i)
 {
 }
 
-PacketTagIterator::PacketTagIterator(const PacketTagList::TagData* head)
-    : m_current(head)
+PacketTagIterator::PacketTagIterator(const PacketTagList::TagSet* set)
+    : m_set(set),
+      m_current(0)
 {
 }
 
 bool
 PacketTagIterator::HasNext() const
 {
-    return m_current != nullptr;
+    return m_set != nullptr && m_current < m_set->nTags;
 }
 
 PacketTagIterator::Item
 PacketTagIterator::Next()
 {
     NS_ASSERT(HasNext());
-    const PacketTagList::TagData* prev = m_current;
-    m_current = m_current->next;
-    return PacketTagIterator::Item(prev);
+    const PacketTagList::TagData* data = &m_set->tags[m_current++];
+    return PacketTagIterator::Item(data, m_set->GetData() + data->offset);
 }
 
-PacketTagIterator::Item::Item(const PacketTagList::TagData* data)
-    : m_data(data)
+PacketTagIterator::Item::Item(const PacketTagList::TagData* data, uint8_t* start)
+    : m_data(data),
+      m_start(start)
 {
 }
 
@@ -113,7 +115,7 @@ void
 PacketTagIterator::Item::GetTag(Tag& tag) const
 {
     NS_ASSERT(tag.GetInstanceTypeId() == m_data->tid);
-    tag.Deserialize(TagBuffer((uint8_t*)m_data->data, (uint8_t*)m_data->data + m_data->size));
+    tag.Deserialize(TagBuffer(m_start, m_start + m_data->size));
 }
 
 Ptr<Packet>
@@ -125,6 +127,29 @@ Packet::Copy() const
     return Ptr<Packet>(new Packet(*this), false);
 }
 
+Ptr<Packet>
+Packet::DeepCopy() const
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t size = GetSerializedSize();
+    std::vector<uint8_t> buffer(size);
+    uint32_t serialized [[maybe_unused]] = Serialize(buffer.data(), size);
+    NS_ASSERT(serialized);
+    return Ptr<Packet>(new Packet(buffer.data(), size, true), false);
+}
+
+uint64_t
+Packet::GetNextUid()
+{
+    return m_globalUid;
+}
+
+void
+Packet::SetNextUid(uint64_t uid)
+{
+    m_globalUid = uid;
+}
+
 Packet::Packet()
     : m_buffer(),
       m_byteTagList(),
@@ -145,7 +170,8 @@ Packet::Packet(const Packet& o)
     : m_buffer(o.m_buffer),
       m_byteTagList(o.m_byteTagList),
       m_packetTagList(o.m_packetTagList),
-      m_metadata(o.m_metadata)
+      m_metadata(o.m_metadata),
+      m_headerCache(o.m_headerCache)
 {
     o.m_nixVector ? m_nixVector = o.m_nixVector->Copy() : m_nixVector = nullptr;
 }
@@ -162,6 +188,7 @@ Packet::operator=(const Packet& o)
     m_packetTagList = o.m_packetTagList;
     m_metadata = o.m_metadata;
     o.m_nixVector ? m_nixVector = o.m_nixVector->Copy() : m_nixVector = nullptr;
+    m_headerCache = o.m_headerCache;
     return *this;
 }
 
@@ -258,6 +285,7 @@ Packet::AddHeader(const Header& header)
 {
     uint32_t size = header.GetSerializedSize();
     NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << size);
+    TrimHeaderCache(GetSize());
     m_buffer.AddAtStart(size);
     m_byteTagList.Adjust(size);
     m_byteTagList.AddAtStart(size);
@@ -276,6 +304,7 @@ Packet::RemoveHeader(Header& header, uint32_t size)
     m_buffer.RemoveAtStart(deserialized);
     m_byteTagList.Adjust(-deserialized);
     m_metadata.RemoveHeader(header, deserialized);
+    TrimHeaderCache(GetSize());
     return deserialized;
 }
 
@@ -287,6 +316,7 @@ Packet::RemoveHeader(Header& header)
     m_buffer.RemoveAtStart(deserialized);
     m_byteTagList.Adjust(-deserialized);
     m_metadata.RemoveHeader(header, deserialized);
+    TrimHeaderCache(GetSize());
     return deserialized;
 }
 
@@ -309,6 +339,15 @@ Packet::PeekHeader(Header& header, uint32_t size) const
     return deserialized;
 }
 
+void
+Packet::TrimHeaderCache(uint32_t size)
+{
+    if (m_headerCache)
+    {
+        m_headerCache = m_headerCache->Trim(size);
+    }
+}
+
 void
 Packet::AddTrailer(const Trailer& trailer)
 {
@@ -319,6 +358,7 @@ Packet::AddTrailer(const Trailer& trailer)
     Buffer::Iterator end = m_buffer.End();
     trailer.Serialize(end);
     m_metadata.AddTrailer(trailer, size);
+    m_headerCache = nullptr;
 }
 
 uint32_t
@@ -328,6 +368,7 @@ Packet::RemoveTrailer(Trailer& trailer)
     NS_LOG_FUNCTION(this << trailer.GetInstanceTypeId().GetName() << deserialized);
     m_buffer.RemoveAtEnd(deserialized);
     m_metadata.RemoveTrailer(trailer, deserialized);
+    m_headerCache = nullptr;
     return deserialized;
 }
 
@@ -350,6 +391,7 @@ Packet::AddAtEnd(Ptr<const Packet> packet)
     m_byteTagList.Add(copy);
     m_buffer.AddAtEnd(packet->m_buffer);
     m_metadata.AddAtEnd(packet->m_metadata);
+    m_headerCache = nullptr;
 }
 
 void
@@ -359,6 +401,7 @@ Packet::AddPaddingAtEnd(uint32_t size)
     m_byteTagList.AddAtEnd(GetSize());
     m_buffer.AddAtEnd(size);
     m_metadata.AddPaddingAtEnd(size);
+    m_headerCache = nullptr;
 }
 
 void
@@ -367,6 +410,7 @@ Packet::RemoveAtEnd(uint32_t size)
     NS_LOG_FUNCTION(this << size);
     m_buffer.RemoveAtEnd(size);
     m_metadata.RemoveAtEnd(size);
+    m_headerCache = nullptr;
 }
 
 void
@@ -376,6 +420,7 @@ Packet::RemoveAtStart(uint32_t size)
     m_buffer.RemoveAtStart(size);
     m_byteTagList.Adjust(-size);
     m_metadata.RemoveAtStart(size);
+    TrimHeaderCache(GetSize());
 }
 
 void
@@ -1008,7 +1053,7 @@ Packet::PrintPacketTags(std::ostream& os) const
 PacketTagIterator
 Packet::GetPacketTagIterator() const
 {
-    return PacketTagIterator(m_packetTagList.Head());
+    return PacketTagIterator(m_packetTagList.GetTagSet());
 }
 
 std::ostream&
@@ -10,6 +10,7 @@
 
 #include "buffer.h"
 #include "byte-tag-list.h"
+#include "header-cache.h"
 #include "header.h"
 #include "nix-vector.h"
 #include "packet-metadata.h"
@@ -22,6 +23,7 @@
 #include "ns3/mac48-address.h"
 #include "ns3/ptr.h"
 
+#include <memory>
 #include <stdint.h>
 
 namespace ns3
@@ -149,10 +151,12 @@ class PacketTagIterator
         friend class PacketTagIterator;
         /**
          * Constructor
-         * \param data the data to copy.
+         * \param data the tag descriptor.
+         * \param start the serialized tag.
          */
-        Item(const PacketTagList::TagData* data);
-        const PacketTagList::TagData* m_data; //!< the tag data
+        Item(const PacketTagList::TagData* data, uint8_t* start);
+        const PacketTagList::TagData* m_data; //!< the tag descriptor
+        uint8_t* m_start;                     //!< the serialized tag
     };
 
     /**
@@ -169,10 +173,11 @@ class PacketTagIterator
     friend class Packet;
     /**
      * Constructor
-     * \param head head of the items
+     * \param set the set of the items
      */
-    PacketTagIterator(const PacketTagList::TagData* head);
-    const PacketTagList::TagData* m_current; //!< actual position over the set of tags in a packet
+    PacketTagIterator(const PacketTagList::TagSet* set);
+    const PacketTagList::TagSet* m_set; //!< the set of tags in a packet
+    uint32_t m_current;                 //!< actual position over the set of tags in a packet
 };
 
 /**
@@ -351,6 +356,29 @@ class Packet : public SimpleRefCount<Packet>
      * \returns the number of bytes read from the packet.
      */
     uint32_t PeekHeader(Header& header, uint32_t size) const;
+    /**
+     * \brief Deserialize a header of type T at the start of the packet,
+     * or return the header already deserialized by a previous call.
+     *
+     * The headers deserialized by this method are cached in the packet,
+     * keyed by their TypeId and their offset from the end of the packet,
+     * and the cache is shared by the copies of the packet.  Hence the
+     * repeated peeks of a header do not deserialize it again, including
+     * by the layers which receive a copy of the packet, or once the
+     * headers in front of it have been removed.  The cached headers
+     * which may no longer match the packet contents are dropped when the
+     * packet is modified.
+     *
+     * The header is deserialized by a default-constructed T, so this
+     * must not be used when the header needs to be set up before its
+     * deserialization, e.g., to verify its checksum.
+     *
+     * \tparam T \explicit The type of the header.
+     * \returns a reference to the header, valid until the packet is
+     *          modified or destroyed.
+     */
+    template <typename T>
+    const T& PeekHeader() const;
     /**
      * \brief Add trailer to this packet.
      *
@@ -448,6 +476,17 @@ class Packet : public SimpleRefCount<Packet>
      */
     Ptr<Packet> Copy() const;
 
+    /**
+     * \brief Create a copy of the packet which does not share any data with it.
+     *
+     * \returns a deep copy of the packet, with the same Uid.
+     *
+     * Unlike Copy(), the returned packet can be used concurrently with the
+     * original one, e.g., by another partition of ThreadedSimulatorImpl.  The
+     * copy is made by serializing the packet, which is much slower than Copy().
+     */
+    Ptr<Packet> DeepCopy() const;
+
     /**
      * \brief Returns the packet's Uid.
      *
@@ -526,6 +565,26 @@ class Packet : public SimpleRefCount<Packet>
      */
     static void EnableChecking();
 
+    /**
+     * \brief Get the Uid counter of the calling thread.
+     *
+     * The packets created by a thread take their Uid from a counter
+     * specific to that thread.  ThreadedSimulatorImpl swaps this counter
+     * with a counter of each partition, so that the Uids do not depend on the
+     * thread executing the partition.
+     *
+     * \returns the Uid, not including the system id, of the next packet
+     * created by the calling thread.
+     */
+    static uint64_t GetNextUid();
+    /**
+     * \brief Set the Uid counter of the calling thread.
+     *
+     * \param [in] uid the Uid, not including the system id, of the next packet
+     * created by the calling thread.
+     */
+    static void SetNextUid(uint64_t uid);
+
     /**
      * \brief Returns number of bytes required for packet
      * serialization.
@@ -776,6 +835,14 @@ class Packet : public SimpleRefCount<Packet>
      */
     uint32_t Deserialize(const uint8_t* buffer, uint32_t size);
 
+    /**
+     * \brief Drop the cached headers which are not in the part of the
+     * packet left untouched by a modification of its start, and stop
+     * sharing the cache with the copies of the packet.
+     * \param [in] size the size of the end of the packet left untouched.
+     */
+    void TrimHeaderCache(uint32_t size);
+
     Buffer m_buffer;               //!< the packet buffer (it's actual contents)
     ByteTagList m_byteTagList;     //!< the ByteTag list
     PacketTagList m_packetTagList; //!< the packet's Tag list
@@ -783,8 +850,9 @@ class Packet : public SimpleRefCount<Packet>
 
     /* Please see comments above about nix-vector */
     mutable Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
+    mutable Ptr<HeaderCache> m_headerCache; //!< the headers deserialized by PeekHeader<T>()
 
-    static uint32_t m_globalUid; //!< Global counter of packets Uid
+    static thread_local uint64_t m_globalUid; //!< Counter of the packets Uid of the thread
 };
 
 /**
@@ -852,6 +920,26 @@ Packet::GetSize() const
     return m_buffer.GetSize();
 }
 
+template <typename T>
+const T&
+Packet::PeekHeader() const
+{
+    uint32_t offset = m_buffer.GetSize();
+    TypeId tid = T::GetTypeId();
+    if (!m_headerCache)
+    {
+        m_headerCache = Create<HeaderCache>();
+    }
+    else if (const Header* cached = m_headerCache->Lookup(tid, offset))
+    {
+        return static_cast<const T&>(*cached);
+    }
+    auto header = std::make_shared<T>();
+    PeekHeader(*header);
+    m_headerCache->Insert(tid, offset, header);
+    return *header;
+}
+
 } // namespace ns3
 
 #endif /* PACKET_H */
@@ -0,0 +1,244 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/binary-trace.h"
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/hash.h"
+#include "ns3/output-stream-wrapper.h"
+#include "ns3/packet.h"
+#include "ns3/test.h"
+#include "ns3/trace-helper.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that the binary trace entries are read back
+ */
+class BinaryTraceRoundTripTestCase : public TestCase
+{
+  public:
+    BinaryTraceRoundTripTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+BinaryTraceRoundTripTestCase::BinaryTraceRoundTripTestCase()
+    : TestCase("Check to see that the binary trace entries are read back, over several blocks")
+{
+}
+
+void
+BinaryTraceRoundTripTestCase::DoRun()
+{
+    const uint32_t nPackets = 10000; // several blocks
+    std::string filename = CreateTempDirFilename("round-trip.bin");
+    std::vector<Ptr<Packet>> packets;
+    const char* contexts[] = {"/NodeList/3/DeviceList/1/$ns3::Dev/TxQueue/Enqueue",
+                              "/NodeList/12/DeviceList/0/MacRx",
+                              "/Names/Foo"};
+
+    {
+        Ptr<BinaryTraceWriter> writer = Create<BinaryTraceWriter>(filename, true);
+        NS_TEST_ASSERT_MSG_EQ(writer->Fail(), false, "cannot create " << filename);
+        for (uint32_t i = 0; i < nPackets; ++i)
+        {
+            std::vector<uint8_t> data(i % 100 + 1, static_cast<uint8_t>(i));
+            Ptr<Packet> p = Create<Packet>(data.data(), data.size());
+            packets.push_back(p);
+            if (i % 4 == 3)
+            {
+                writer->Write('d', MicroSeconds(i), p);
+            }
+            else
+            {
+                writer->Write("+-r"[i % 4], MicroSeconds(i), contexts[i % 3], p);
+            }
+            if (i % 1000 == 0)
+            {
+                *writer->GetTextStream() << "text " << i << std::endl;
+            }
+        }
+        writer->WriteText("last");
+    }
+
+    BinaryTraceReader reader;
+    NS_TEST_ASSERT_MSG_EQ(reader.Open(filename), true, "cannot open " << filename);
+    NS_TEST_EXPECT_MSG_EQ(reader.HasDigests(), true, "the digests are not written");
+    BinaryTraceEntry entry;
+    for (uint32_t i = 0; i < nPackets; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(reader.Read(entry), true, "missing packet " << i);
+        Ptr<Packet> p = packets[i];
+        NS_TEST_EXPECT_MSG_EQ(entry.event, (i % 4 == 3 ? 'd' : "+-r"[i % 4]), "wrong event");
+        NS_TEST_EXPECT_MSG_EQ(entry.time, MicroSeconds(i), "wrong time");
+        NS_TEST_EXPECT_MSG_EQ(entry.uid, p->GetUid(), "wrong uid");
+        NS_TEST_EXPECT_MSG_EQ(entry.size, p->GetSize(), "wrong size");
+        std::vector<uint8_t> data(std::min(p->GetSize(), BinaryTraceWriter::DIGEST_SIZE));
+        p->CopyData(data.data(), data.size());
+        NS_TEST_EXPECT_MSG_EQ(entry.digest,
+                              Hash32(reinterpret_cast<const char*>(data.data()), data.size()),
+                              "wrong digest");
+        if (i % 4 == 3)
+        {
+            NS_TEST_EXPECT_MSG_EQ(entry.context, "", "wrong context");
+            NS_TEST_EXPECT_MSG_EQ(entry.node, BinaryTraceWriter::UNKNOWN, "wrong node");
+        }
+        else
+        {
+            NS_TEST_EXPECT_MSG_EQ(entry.context, contexts[i % 3], "wrong context");
+            uint32_t node = (i % 3 == 0 ? 3 : i % 3 == 1 ? 12 : BinaryTraceWriter::UNKNOWN);
+            uint32_t device = (i % 3 == 0 ? 1 : i % 3 == 1 ? 0 : BinaryTraceWriter::UNKNOWN);
+            NS_TEST_EXPECT_MSG_EQ(entry.node, node, "wrong node");
+            NS_TEST_EXPECT_MSG_EQ(entry.device, device, "wrong device");
+        }
+        if (i % 1000 == 0)
+        {
+            NS_TEST_ASSERT_MSG_EQ(reader.Read(entry), true, "missing text " << i);
+            NS_TEST_EXPECT_MSG_EQ(entry.event, 't', "wrong event");
+            NS_TEST_EXPECT_MSG_EQ(entry.text, "text " + std::to_string(i), "wrong text");
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(reader.Read(entry), true, "missing last text");
+    NS_TEST_EXPECT_MSG_EQ(entry.text, "last", "wrong text");
+    NS_TEST_EXPECT_MSG_EQ(reader.Read(entry), false, "unexpected entry");
+    NS_TEST_EXPECT_MSG_EQ(reader.Fail(), false, "the file is corrupted");
+
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    // event type and 28 bytes per packet
+    uint64_t rawSize = nPackets * 29;
+#ifdef HAVE_ZLIB
+    NS_TEST_EXPECT_MSG_LT(static_cast<uint64_t>(file.tellg()),
+                          rawSize / 2,
+                          "the blocks are not compressed");
+#else
+    NS_TEST_EXPECT_MSG_GT(static_cast<uint64_t>(file.tellg()), rawSize, "wrong file size");
+#endif
+
+    // a truncated file is corrupted
+    std::string truncated = CreateTempDirFilename("truncated.bin");
+    {
+        std::ifstream in(filename, std::ios::binary);
+        std::ofstream out(truncated, std::ios::binary);
+        std::vector<char> data(static_cast<std::size_t>(file.tellg()) - 10);
+        in.read(data.data(), data.size());
+        out.write(data.data(), data.size());
+    }
+    std::ostringstream oss;
+    NS_TEST_EXPECT_MSG_EQ(BinaryTraceReader::ConvertToText(truncated, oss),
+                          false,
+                          "a truncated file is not detected");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that the ascii trace helper writes binary traces
+ */
+class BinaryAsciiTraceTestCase : public TestCase
+{
+  public:
+    BinaryAsciiTraceTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+BinaryAsciiTraceTestCase::BinaryAsciiTraceTestCase()
+    : TestCase("Check to see that the ascii trace helper writes binary traces, converted to text")
+{
+}
+
+void
+BinaryAsciiTraceTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("ascii.tr");
+    std::string context = "/NodeList/0/DeviceList/2/TxQueue/Enqueue";
+    Ptr<Packet> p = Create<Packet>(100);
+
+    Config::SetGlobal("AsciiTraceBinary", BooleanValue(true));
+    {
+        AsciiTraceHelper helper;
+        Ptr<OutputStreamWrapper> stream = helper.CreateFileStream(filename);
+        NS_TEST_ASSERT_MSG_NE(stream->GetBinaryTrace(), nullptr, "not a binary trace");
+        AsciiTraceHelper::DefaultEnqueueSinkWithContext(stream, context, p);
+        AsciiTraceHelper::DefaultDequeueSinkWithContext(stream, context, p);
+        *stream->GetStream() << "custom sink " << 1.5 << std::endl;
+        AsciiTraceHelper::DefaultDropSinkWithoutContext(stream, p);
+        AsciiTraceHelper::DefaultReceiveSinkWithoutContext(stream, p);
+        *stream->GetStream() << "unterminated";
+    }
+    Config::SetGlobal("AsciiTraceBinary", BooleanValue(false));
+
+    std::ostringstream oss;
+    NS_TEST_ASSERT_MSG_EQ(BinaryTraceReader::ConvertToText(filename + ".bin", oss),
+                          true,
+                          "cannot convert " << filename << ".bin");
+    std::string packet = "Packet (uid=" + std::to_string(p->GetUid()) + " size=100)";
+    NS_TEST_EXPECT_MSG_EQ(oss.str(),
+                          "+ 0 " + context + " " + packet + "\n" + "- 0 " + context + " " +
+                              packet + "\n" + "custom sink 1.5\n" + "d 0 " + packet + "\n" +
+                              "r 0 " + packet + "\n" + "unterminated\n",
+                          "wrong conversion");
+
+    // with the printed packets, the conversion gives the ascii trace
+    std::ostringstream ascii;
+    {
+        Ptr<OutputStreamWrapper> stream = Create<OutputStreamWrapper>(&ascii);
+        AsciiTraceHelper::DefaultEnqueueSinkWithContext(stream, context, p);
+        AsciiTraceHelper::DefaultDropSinkWithoutContext(stream, p);
+    }
+    Config::SetGlobal("AsciiTraceBinary", BooleanValue(true));
+    Config::SetGlobal("AsciiTracePrint", BooleanValue(true));
+    {
+        AsciiTraceHelper helper;
+        Ptr<OutputStreamWrapper> stream = helper.CreateFileStream(filename);
+        AsciiTraceHelper::DefaultEnqueueSinkWithContext(stream, context, p);
+        AsciiTraceHelper::DefaultDropSinkWithoutContext(stream, p);
+    }
+    Config::SetGlobal("AsciiTraceBinary", BooleanValue(false));
+    Config::SetGlobal("AsciiTracePrint", BooleanValue(false));
+
+    oss.str("");
+    NS_TEST_ASSERT_MSG_EQ(BinaryTraceReader::ConvertToText(filename + ".bin", oss),
+                          true,
+                          "cannot convert " << filename << ".bin");
+    NS_TEST_EXPECT_MSG_EQ(oss.str(), ascii.str(), "wrong conversion of the printed packets");
+
+    AsciiTraceHelper helper;
+    Ptr<OutputStreamWrapper> stream = helper.CreateFileStream(filename);
+    NS_TEST_EXPECT_MSG_EQ(stream->GetBinaryTrace(), nullptr, "unexpected binary trace");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Binary trace TestSuite
+ */
+class BinaryTraceTestSuite : public TestSuite
+{
+  public:
+    BinaryTraceTestSuite();
+};
+
+BinaryTraceTestSuite::BinaryTraceTestSuite()
+    : TestSuite("binary-trace", Type::UNIT)
+{
+    AddTestCase(new BinaryTraceRoundTripTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new BinaryAsciiTraceTestCase, TestCase::Duration::QUICK);
+}
+
+static BinaryTraceTestSuite g_binaryTraceTestSuite; //!< Static variable for test initialization
@@ -11,6 +11,8 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/test.h"
 
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -382,6 +384,91 @@ BufferTest::DoRun()
     val2 <<= 8;
     val2 |= i.ReadU8();
     NS_TEST_ASSERT_MSG_EQ(val1, val2, "Bad ReadNtohU16()");
+
+    // Fragments put back together in order share the data of the original buffer
+    buffer = Buffer();
+    buffer.AddAtStart(6);
+    i = buffer.Begin();
+    for (uint8_t k = 1; k <= 6; k++)
+    {
+        i.WriteU8(k);
+    }
+    frag0 = buffer.CreateFragment(0, 2);
+    frag1 = buffer.CreateFragment(2, 2);
+    Buffer frag2 = buffer.CreateFragment(4, 2);
+    frag0.AddAtEnd(frag1);
+    frag0.AddAtEnd(frag2);
+    ENSURE_WRITTEN_BYTES(frag0, 6, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6);
+    NS_TEST_ASSERT_MSG_EQ(frag0.PeekData(), buffer.PeekData(), "Fragments were copied");
+    frag0.AddAtEnd(1);
+    i = frag0.End();
+    i.Prev(1);
+    i.WriteU8(0x7);
+    frag0.AddAtStart(1);
+    frag0.Begin().WriteU8(0x0);
+    ENSURE_WRITTEN_BYTES(frag0, 8, 0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7);
+    ENSURE_WRITTEN_BYTES(buffer, 6, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6);
+    ENSURE_WRITTEN_BYTES(frag2, 2, 0x5, 0x6);
+
+    // Fragments put back together out of order are copied
+    frag0 = buffer.CreateFragment(2, 2);
+    frag0.AddAtEnd(buffer.CreateFragment(0, 2));
+    ENSURE_WRITTEN_BYTES(frag0, 4, 0x3, 0x4, 0x1, 0x2);
+    ENSURE_WRITTEN_BYTES(buffer, 6, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6);
+
+    // Aggregation of many buffers
+    Buffer aggregate;
+    for (uint32_t k = 0; k < 100; k++)
+    {
+        aggregate.AddAtEnd(buffer);
+    }
+    NS_TEST_ASSERT_MSG_EQ(aggregate.GetSize(), 600, "Bad aggregate size");
+    const uint8_t* data = aggregate.PeekData();
+    for (uint32_t k = 0; k < 600; k++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(data[k], k % 6 + 1, "Bad aggregate data");
+    }
+    ENSURE_WRITTEN_BYTES(buffer, 6, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6);
+
+    // Concatenation keeps the zero area of the buffers
+    buffer = Buffer(1000);
+    buffer.AddAtStart(2);
+    i = buffer.Begin();
+    i.WriteU8(0x1);
+    i.WriteU8(0x2);
+    other = Buffer(2000);
+    other.AddAtStart(1);
+    other.Begin().WriteU8(0x3);
+    aggregate = buffer;
+    aggregate.AddAtEnd(other);
+    NS_TEST_ASSERT_MSG_EQ(aggregate.GetSize(), 3003, "Bad aggregate size");
+    NS_TEST_ASSERT_MSG_LT(aggregate.GetSerializedSize(), 1100, "Zero area was not kept");
+    std::vector<uint8_t> expected(3003, 0);
+    expected[0] = 0x1;
+    expected[1] = 0x2;
+    expected[1002] = 0x3;
+    std::vector<uint8_t> got(3003, 0xff);
+    aggregate.CopyData(got.data(), got.size());
+    NS_TEST_ASSERT_MSG_EQ((got == expected), true, "Bad aggregate data");
+
+    aggregate = other;
+    aggregate.AddAtEnd(buffer);
+    NS_TEST_ASSERT_MSG_LT(aggregate.GetSerializedSize(), 1100, "Zero area was not kept");
+    NS_TEST_ASSERT_MSG_EQ(aggregate.GetSize(), 3003, "Bad aggregate size");
+
+    // Fragments of a zero area put back together keep it
+    for (uint32_t start : {0, 1, 2, 500, 1001})
+    {
+        aggregate = buffer.CreateFragment(0, start);
+        aggregate.AddAtEnd(buffer.CreateFragment(start, 1002 - start));
+        NS_TEST_ASSERT_MSG_EQ(aggregate.GetSize(), 1002, "Bad reassembled size");
+        NS_TEST_ASSERT_MSG_LT(aggregate.GetSerializedSize(), 100, "Zero area was not kept");
+        got.assign(1002, 0xff);
+        aggregate.CopyData(got.data(), 1002);
+        NS_TEST_ASSERT_MSG_EQ((got == std::vector<uint8_t>(expected.begin(), expected.begin() + 1002)),
+                              true,
+                              "Bad reassembled data");
+    }
 }
 
 /**
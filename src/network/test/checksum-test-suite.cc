@@ -0,0 +1,211 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/buffer.h"
+#include "ns3/crc32.h"
+#include "ns3/ip-checksum.h"
+#include "ns3/test.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Calculate the Internet checksum one word at a time, as
+ * Buffer::Iterator::CalculateIpChecksum did.
+ *
+ * \param i The iterator from which the bytes are read.
+ * \param size The number of bytes.
+ * \param initialChecksum The initial value.
+ * \returns The checksum.
+ */
+static uint16_t
+ReferenceIpChecksum(Buffer::Iterator i, uint16_t size, uint32_t initialChecksum)
+{
+    uint32_t sum = initialChecksum;
+    for (int j = 0; j < size / 2; j++)
+    {
+        sum += i.ReadU16();
+    }
+    if (size & 1)
+    {
+        sum += i.ReadU8();
+    }
+    while (sum >> 16)
+    {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    return ~sum;
+}
+
+/**
+ * Calculate the CRC-32 one bit at a time.
+ *
+ * \param data The buffer.
+ * \param length The length of the buffer.
+ * \returns The CRC-32.
+ */
+static uint32_t
+ReferenceCrc32(const uint8_t* data, uint32_t length)
+{
+    uint32_t crc = 0xffffffff;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that the Internet checksum is unchanged
+ */
+class IpChecksumTestCase : public TestCase
+{
+  public:
+    IpChecksumTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+IpChecksumTestCase::IpChecksumTestCase()
+    : TestCase("Check the Internet checksum of buffers with a zero area at any offset")
+{
+}
+
+void
+IpChecksumTestCase::DoRun()
+{
+    // RFC 1071 example, read as little endian words
+    uint8_t rfc[] = {0x00, 0x01, 0xf2, 0x03, 0xf4, 0xf5, 0xf6, 0xf7};
+    NS_TEST_EXPECT_MSG_EQ(OnesComplementSum(rfc, sizeof(rfc)), 0xf2dd, "wrong sum");
+    NS_TEST_EXPECT_MSG_EQ(OnesComplementSum(rfc, 0), 0, "wrong sum of no byte");
+    std::vector<uint8_t> ones(1001, 0xff);
+    NS_TEST_EXPECT_MSG_EQ(OnesComplementSum(ones.data(), 1000), 0xffff, "wrong sum");
+    // the odd byte is the least significant byte of the last word
+    NS_TEST_EXPECT_MSG_EQ(OnesComplementSum(ones.data(), 1001), 0x00ff, "wrong sum");
+
+    uint32_t seed = 1;
+    auto next = [&seed]() {
+        seed = seed * 1103515245 + 12345;
+        return static_cast<uint8_t>(seed >> 16);
+    };
+    for (uint32_t start : {0, 1, 2, 7, 64, 101})
+    {
+        for (uint32_t zero : {0, 1, 2, 33, 1000})
+        {
+            for (uint32_t end : {0, 1, 3, 40, 1467})
+            {
+                Buffer buffer(zero);
+                buffer.AddAtStart(start);
+                Buffer::Iterator it = buffer.Begin();
+                for (uint32_t k = 0; k < start; k++)
+                {
+                    it.WriteU8(next());
+                }
+                buffer.AddAtEnd(end);
+                it = buffer.End();
+                it.Prev(end);
+                for (uint32_t k = 0; k < end; k++)
+                {
+                    it.WriteU8(next());
+                }
+                uint32_t size = buffer.GetSize();
+                for (uint32_t offset : {0U, 1U, size / 3})
+                {
+                    if (offset > size)
+                    {
+                        continue;
+                    }
+                    for (uint32_t initial : {0U, 0x1234U, 0xffffU})
+                    {
+                        Buffer::Iterator i = buffer.Begin();
+                        i.Next(offset);
+                        uint16_t length = size - offset;
+                        uint16_t expected = ReferenceIpChecksum(i, length, initial);
+                        NS_TEST_EXPECT_MSG_EQ(i.CalculateIpChecksum(length, initial),
+                                              expected,
+                                              "wrong checksum, start=" << start << " zero="
+                                                                       << zero << " end=" << end
+                                                                       << " offset=" << offset);
+                        NS_TEST_EXPECT_MSG_EQ(i.GetRemainingSize(), 0, "the bytes are not read");
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that the CRC-32 is unchanged
+ */
+class Crc32TestCase : public TestCase
+{
+  public:
+    Crc32TestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Crc32TestCase::Crc32TestCase()
+    : TestCase("Check the CRC-32 of buffers of any length")
+{
+}
+
+void
+Crc32TestCase::DoRun()
+{
+    const char* check = "123456789";
+    NS_TEST_EXPECT_MSG_EQ(CRC32Calculate(reinterpret_cast<const uint8_t*>(check), 9),
+                          0xcbf43926,
+                          "wrong check value");
+
+    std::vector<uint8_t> data(1600);
+    for (uint32_t k = 0; k < data.size(); k++)
+    {
+        data[k] = k * 7 + (k >> 3);
+    }
+    for (uint32_t offset = 0; offset < 8; offset++)
+    {
+        for (uint32_t length = 0; length + offset <= data.size(); length += 1 + length / 8)
+        {
+            NS_TEST_EXPECT_MSG_EQ(CRC32Calculate(data.data() + offset, length),
+                                  ReferenceCrc32(data.data() + offset, length),
+                                  "wrong CRC-32, offset=" << offset << " length=" << length);
+        }
+    }
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Checksum TestSuite
+ */
+class ChecksumTestSuite : public TestSuite
+{
+  public:
+    ChecksumTestSuite();
+};
+
+ChecksumTestSuite::ChecksumTestSuite()
+    : TestSuite("checksum", Type::UNIT)
+{
+    AddTestCase(new IpChecksumTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Crc32TestCase, TestCase::Duration::QUICK);
+}
+
+static ChecksumTestSuite g_checksumTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,120 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/packet-allocator.h"
+#include "ns3/packet.h"
+#include "ns3/test.h"
+
+#include <thread>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Check the size classes, the reuse of the blocks and the statistics
+ * of the PacketAllocator.
+ */
+class PacketAllocatorTestCase : public TestCase
+{
+  public:
+    PacketAllocatorTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PacketAllocatorTestCase::PacketAllocatorTestCase()
+    : TestCase("Check the size classes and the statistics")
+{
+}
+
+void
+PacketAllocatorTestCase::DoRun()
+{
+    PacketAllocator::Trim();
+
+    uint32_t size = 1;
+    void* p = PacketAllocator::Allocate(size);
+    NS_TEST_ASSERT_MSG_EQ(size, PacketAllocator::MIN_SIZE, "Bad smallest class");
+    PacketAllocator::Deallocate(p, 1);
+    size = PacketAllocator::MIN_SIZE + 1;
+    p = PacketAllocator::Allocate(size);
+    NS_TEST_ASSERT_MSG_EQ(size, 2 * PacketAllocator::MIN_SIZE, "Bad size class");
+    PacketAllocator::Deallocate(p, size);
+    size = PacketAllocator::MAX_SIZE + 1;
+    p = PacketAllocator::Allocate(size);
+    NS_TEST_ASSERT_MSG_EQ(size, PacketAllocator::MAX_SIZE + 1, "Large request rounded up");
+    PacketAllocator::Deallocate(p, size);
+
+    // A released block is reused by the next request of its class
+    PacketAllocator::Stats before = PacketAllocator::GetStats(3);
+    size = 300;
+    p = PacketAllocator::Allocate(size);
+    NS_TEST_ASSERT_MSG_EQ(size, PacketAllocator::GetClassSize(3), "Bad size class");
+    PacketAllocator::Deallocate(p, 300);
+    size = 400;
+    void* q = PacketAllocator::Allocate(size);
+    NS_TEST_ASSERT_MSG_EQ(q, p, "Block not reused");
+    PacketAllocator::Deallocate(q, size);
+    PacketAllocator::Stats after = PacketAllocator::GetStats(3);
+    NS_TEST_ASSERT_MSG_EQ(after.misses - before.misses, 1, "Bad miss count");
+    NS_TEST_ASSERT_MSG_EQ(after.hits - before.hits, 1, "Bad hit count");
+    NS_TEST_ASSERT_MSG_EQ(after.cached, 1, "Bad cached count");
+
+    // The free lists are bounded
+    uint32_t sizeClass = PacketAllocator::N_CLASSES - 1;
+    uint32_t classSize = PacketAllocator::GetClassSize(sizeClass);
+    uint32_t maxCached = PacketAllocator::MAX_CACHED_BYTES / classSize;
+    before = PacketAllocator::GetStats(sizeClass);
+    std::vector<void*> blocks;
+    for (uint32_t i = 0; i < maxCached + 3; ++i)
+    {
+        size = classSize;
+        blocks.push_back(PacketAllocator::Allocate(size));
+    }
+    for (auto block : blocks)
+    {
+        PacketAllocator::Deallocate(block, classSize);
+    }
+    after = PacketAllocator::GetStats(sizeClass);
+    NS_TEST_ASSERT_MSG_EQ(after.cached, maxCached, "Free list not bounded");
+    NS_TEST_ASSERT_MSG_EQ(after.releases - before.releases, 3, "Bad release count");
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(after.maxCached, maxCached, "Bad high-water mark");
+
+    // The statistics of the exited threads are kept
+    before = PacketAllocator::GetStats();
+    std::thread thread([]() {
+        Ptr<Packet> packet = Create<Packet>(1000);
+        packet->AddAtEnd(Create<Packet>(100));
+    });
+    thread.join();
+    after = PacketAllocator::GetStats();
+    NS_TEST_ASSERT_MSG_GT(after.misses, before.misses, "Thread statistics lost");
+
+    PacketAllocator::Trim();
+    NS_TEST_ASSERT_MSG_EQ(PacketAllocator::GetStats(3).cached, 0, "Free lists not trimmed");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * PacketAllocator TestSuite
+ */
+class PacketAllocatorTestSuite : public TestSuite
+{
+  public:
+    PacketAllocatorTestSuite();
+};
+
+PacketAllocatorTestSuite::PacketAllocatorTestSuite()
+    : TestSuite("packet-allocator", Type::UNIT)
+{
+    AddTestCase(new PacketAllocatorTestCase, TestCase::Duration::QUICK);
+}
+
+static PacketAllocatorTestSuite g_packetAllocatorTestSuite; //!< Static test instance
@@ -15,6 +15,7 @@
 #include <iostream>
 #include <limits> // std:numeric_limits
 #include <string>
+#include <utility>
 
 using namespace ns3;
 
@@ -1194,6 +1195,40 @@ PacketTagListTest::DoRun()
         ReplaceCheck(7);
     }
 
+    // More tag types than the ids indexed by the mask
+    {
+        std::cout << GetName() << "check many tag types" << std::endl;
+
+        auto checkMany = [this]<int... I>(std::integer_sequence<int, I...>) {
+            PacketTagList ptl;
+            (ptl.Add(ATestTag<20 + I>(I)), ...);
+            PacketTagList copy = ptl;
+            (
+                [&] {
+                    ATestTag<20 + I> t;
+                    if (I % 2 == 0)
+                    {
+                        copy.Remove(t);
+                    }
+                    else
+                    {
+                        t.m_data = 2 * I;
+                        copy.Replace(t);
+                    }
+                }(),
+                ...);
+            (
+                [&] {
+                    ATestTag<20 + I> t(I);
+                    CheckRef(ptl, t, "many tags orig");
+                    t.m_data = 2 * I;
+                    CheckRef(copy, t, "many tags copy", I % 2 == 0);
+                }(),
+                ...);
+        };
+        checkMany(std::make_integer_sequence<int, 80>{});
+    }
+
     // Timing
     {
         std::cout << GetName() << "add+remove timing" << std::endl;
@@ -1257,6 +1292,81 @@ PacketTagListTest::DoRun()
     } // Timing
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Packet header cache unit tests.
+ */
+class PacketHeaderCacheTest : public TestCase
+{
+  public:
+    PacketHeaderCacheTest();
+    void DoRun() override;
+};
+
+PacketHeaderCacheTest::PacketHeaderCacheTest()
+    : TestCase("Packet header cache")
+{
+}
+
+void
+PacketHeaderCacheTest::DoRun()
+{
+    Ptr<Packet> p = Create<Packet>(10);
+    p->AddHeader(ATestHeader<3>());
+    p->AddHeader(ATestHeader<2>());
+
+    const auto& h2 = p->PeekHeader<ATestHeader<2>>();
+    NS_TEST_EXPECT_MSG_EQ(h2.m_error, false, "header not deserialized");
+    NS_TEST_EXPECT_MSG_EQ(&p->PeekHeader<ATestHeader<2>>(), &h2, "header not cached");
+
+    // the copies share the cache
+    Ptr<Packet> copy = p->Copy();
+    NS_TEST_EXPECT_MSG_EQ(&copy->PeekHeader<ATestHeader<2>>(), &h2, "cache not shared");
+
+    // a header of another type at the same offset is deserialized
+    const auto& h3 = p->PeekHeader<ATestHeader<3>>();
+    NS_TEST_EXPECT_MSG_EQ(h3.m_error, true, "header of another type returned");
+
+    // the headers behind a removed header are kept
+    ATestHeader<2> removed;
+    copy->RemoveHeader(removed);
+    const auto& next = copy->PeekHeader<ATestHeader<3>>();
+    NS_TEST_EXPECT_MSG_EQ(next.m_error, false, "header not deserialized");
+    NS_TEST_EXPECT_MSG_EQ(&copy->PeekHeader<ATestHeader<3>>(), &next, "header not cached");
+
+    // a header added in place of a removed header is deserialized again
+    copy->AddHeader(ATestHeader<1>());
+    copy->AddHeader(ATestHeader<1>());
+    NS_TEST_EXPECT_MSG_EQ(copy->PeekHeader<ATestHeader<2>>().m_error,
+                          true,
+                          "stale header returned");
+
+    // the headers behind the added headers are kept
+    ATestHeader<1> added;
+    copy->RemoveHeader(added);
+    copy->RemoveHeader(added);
+    NS_TEST_EXPECT_MSG_EQ(&copy->PeekHeader<ATestHeader<3>>(), &next, "header not kept");
+
+    // modifying the copy does not affect the original packet
+    NS_TEST_EXPECT_MSG_EQ(&p->PeekHeader<ATestHeader<2>>(), &h2, "cache of original modified");
+    NS_TEST_EXPECT_MSG_EQ(h2.m_error, false, "header of original modified");
+
+    // modifying the end of the packet drops the cache
+    Ptr<Packet> q = Create<Packet>();
+    q->AddHeader(ATestHeader<2>());
+    NS_TEST_EXPECT_MSG_EQ(q->PeekHeader<ATestHeader<2>>().m_error,
+                          false,
+                          "header not deserialized");
+    q->RemoveAtEnd(2);
+    Ptr<Packet> end = Create<Packet>();
+    end->AddHeader(ATestHeader<1>());
+    end->AddHeader(ATestHeader<1>());
+    q->AddAtEnd(end);
+    NS_TEST_EXPECT_MSG_EQ(q->PeekHeader<ATestHeader<2>>().m_error, true, "stale header returned");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1274,6 +1384,7 @@ PacketTestSuite::PacketTestSuite()
 {
     AddTestCase(new PacketTest, TestCase::Duration::QUICK);
     AddTestCase(new PacketTagListTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketHeaderCacheTest, TestCase::Duration::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
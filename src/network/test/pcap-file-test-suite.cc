@@ -4,6 +4,7 @@
  * Author:  Craig Dowell (craigdo@ee.washington.edu)
  */
 
+#include "ns3/fatal-impl.h"
 #include "ns3/log.h"
 #include "ns3/pcap-file.h"
 #include "ns3/test.h"
@@ -11,8 +12,15 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <sstream>
+#include <vector>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
 
 using namespace ns3;
 
@@ -1364,6 +1372,204 @@ DiffTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that the packets written through the
+ * write buffer, possibly from a background thread and compressed, are
+ * all written in order.
+ */
+class BufferedWriteTestCase : public TestCase
+{
+  public:
+    BufferedWriteTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Write packets of increasing sizes, truncated to 100 bytes.
+     *
+     * \param filename The name of the file.
+     * \param bufferSize The size of the write buffer.
+     * \param async Whether to write the buffers from a background thread.
+     * \param compress Whether to compress the file.
+     * \param fatal Whether to flush the file as on a fatal error, and check it
+     * before closing it.
+     */
+    void WriteFile(const std::string& filename,
+                   uint32_t bufferSize,
+                   bool async,
+                   bool compress = false,
+                   bool fatal = false);
+    /**
+     * Check the packets written by WriteFile().
+     *
+     * \param filename The name of the file.
+     */
+    void CheckFile(const std::string& filename);
+    /**
+     * Read the contents of a file.
+     *
+     * \param filename The name of the file.
+     * \returns The contents of the file.
+     */
+    std::vector<char> ReadFile(const std::string& filename);
+
+    static const uint32_t N_PACKETS = 1000; //!< Number of packets written
+    std::vector<char> m_unbuffered;         //!< Contents of the unbuffered file
+};
+
+BufferedWriteTestCase::BufferedWriteTestCase()
+    : TestCase("Check to see that PcapFile writes buffered packets correctly")
+{
+}
+
+void
+BufferedWriteTestCase::WriteFile(const std::string& filename,
+                                 uint32_t bufferSize,
+                                 bool async,
+                                 bool compress,
+                                 bool fatal)
+{
+    uint8_t data[N_PACKETS];
+    for (uint32_t i = 0; i < N_PACKETS; ++i)
+    {
+        data[i] = i & 0xff;
+    }
+
+    PcapFile f;
+    f.SetWriteBuffer(bufferSize, async, compress);
+    f.Open(filename, std::ios::out);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Open (" << filename << ") returns error");
+    f.Init(1, 100);
+    for (uint32_t i = 0; i < N_PACKETS; ++i)
+    {
+        f.Write(i, 0, data, i);
+        NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Write returns error");
+        if (i == N_PACKETS / 2)
+        {
+            f.Flush();
+        }
+    }
+    if (fatal)
+    {
+        // the staged packets are written when the streams are flushed on fatal errors
+        FatalImpl::FlushStreams();
+        NS_TEST_EXPECT_MSG_EQ((ReadFile(filename) == m_unbuffered), true, "packets lost");
+    }
+    f.Close();
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Close returns error");
+}
+
+void
+BufferedWriteTestCase::CheckFile(const std::string& filename)
+{
+    PcapFile f;
+    f.Open(filename, std::ios::in);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Open (" << filename << ") returns error");
+    NS_TEST_ASSERT_MSG_EQ(f.GetSnapLen(), 100, "wrong snap length");
+
+    uint8_t data[N_PACKETS];
+    for (uint32_t i = 0; i < N_PACKETS; ++i)
+    {
+        uint32_t tsSec;
+        uint32_t tsUsec;
+        uint32_t inclLen;
+        uint32_t origLen;
+        uint32_t readLen;
+        f.Read(data, N_PACKETS, tsSec, tsUsec, inclLen, origLen, readLen);
+        NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Read returns error");
+        NS_TEST_ASSERT_MSG_EQ(tsSec, i, "packets reordered");
+        NS_TEST_ASSERT_MSG_EQ(origLen, i, "wrong original length");
+        NS_TEST_ASSERT_MSG_EQ(inclLen, std::min(i, 100U), "packet not truncated");
+        NS_TEST_ASSERT_MSG_EQ(readLen, inclLen, "wrong read length");
+        for (uint32_t j = 0; j < readLen; ++j)
+        {
+            NS_TEST_ASSERT_MSG_EQ(static_cast<uint32_t>(data[j]), j, "wrong data");
+        }
+    }
+    f.Close();
+}
+
+std::vector<char>
+BufferedWriteTestCase::ReadFile(const std::string& filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file),
+                             std::istreambuf_iterator<char>());
+}
+
+void
+BufferedWriteTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("buffered.pcap");
+    WriteFile(filename, 0, false);
+    CheckFile(filename);
+    m_unbuffered = ReadFile(filename);
+    const std::vector<char>& unbuffered = m_unbuffered;
+    NS_TEST_ASSERT_MSG_EQ(unbuffered.size(), 24 + N_PACKETS * 16 + 99 * 100 / 2 + 900 * 100,
+                          "wrong file size");
+
+    for (bool async : {false, true})
+    {
+        WriteFile(filename, 1000, async);
+        CheckFile(filename);
+        NS_TEST_EXPECT_MSG_EQ((ReadFile(filename) == unbuffered), true, "files differ");
+        WriteFile(filename, 1000000, async, false, true);
+    }
+    std::remove(filename.c_str());
+
+    // files written at the same time by the shared background thread
+    uint8_t payload[N_PACKETS];
+    for (uint32_t i = 0; i < N_PACKETS; ++i)
+    {
+        payload[i] = i & 0xff;
+    }
+    std::vector<PcapFile> files(8);
+    for (std::size_t k = 0; k < files.size(); ++k)
+    {
+        files[k].SetWriteBuffer(1000, true);
+        files[k].Open(filename + std::to_string(k), std::ios::out);
+        files[k].Init(1, 100);
+    }
+    for (uint32_t i = 0; i < N_PACKETS; ++i)
+    {
+        for (auto& file : files)
+        {
+            file.Write(i, 0, payload, i);
+        }
+    }
+    for (std::size_t k = 0; k < files.size(); ++k)
+    {
+        files[k].Close();
+        NS_TEST_ASSERT_MSG_EQ(files[k].Fail(), false, "Close returns error");
+        std::string name = filename + std::to_string(k);
+        NS_TEST_EXPECT_MSG_EQ((ReadFile(name) == unbuffered), true, "files differ");
+        std::remove(name.c_str());
+    }
+
+#ifdef HAVE_ZLIB
+    std::string compressed = filename + ".gz";
+    WriteFile(compressed, 1000, true, true);
+    gzFile file = gzopen(compressed.c_str(), "rb");
+    NS_TEST_ASSERT_MSG_NE(file, nullptr, "cannot open " << compressed);
+    std::vector<char> data(unbuffered.size() + 1);
+    int size = gzread(file, data.data(), data.size());
+    gzclose(file);
+    data.resize(std::max(size, 0));
+    NS_TEST_EXPECT_MSG_EQ((data == unbuffered), true, "compressed file differs");
+    std::remove(compressed.c_str());
+#endif
+
+    // the name of the file does not turn compression on
+    std::string named = filename + ".gz";
+    WriteFile(named, 1000, false);
+    CheckFile(named);
+    std::remove(named.c_str());
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1387,6 +1593,7 @@ PcapFileTestSuite::PcapFileTestSuite()
     AddTestCase(new RecordHeaderTestCase, TestCase::Duration::QUICK);
     AddTestCase(new ReadFileTestCase, TestCase::Duration::QUICK);
     AddTestCase(new DiffTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new BufferedWriteTestCase, TestCase::Duration::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,331 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/header.h"
+#include "ns3/packet.h"
+#include "ns3/pcap-file-wrapper.h"
+#include "ns3/pcapng-file.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Block read from a pcapng file
+ */
+struct PcapNgTestBlock
+{
+    uint32_t type;             //!< Block type
+    std::vector<uint8_t> body; //!< Block body
+
+    /**
+     * \param offset The offset of the value in the body.
+     * \returns The 32-bit value at the given offset.
+     */
+    uint32_t Get32(uint32_t offset) const
+    {
+        uint32_t value = 0;
+        std::memcpy(&value, body.data() + offset, 4);
+        return value;
+    }
+
+    /**
+     * \param offset The offset of the options in the body.
+     * \param code The option code.
+     * \returns The value of the option, or an empty string if it is missing.
+     */
+    std::string GetOption(uint32_t offset, uint16_t code) const
+    {
+        while (offset + 4 <= body.size())
+        {
+            uint16_t optionCode;
+            uint16_t length;
+            std::memcpy(&optionCode, body.data() + offset, 2);
+            std::memcpy(&length, body.data() + offset + 2, 2);
+            if (optionCode == 0)
+            {
+                break;
+            }
+            if (optionCode == code)
+            {
+                return std::string(body.begin() + offset + 4, body.begin() + offset + 4 + length);
+            }
+            offset += 4 + ((length + 3) & ~3U);
+        }
+        return "";
+    }
+};
+
+/**
+ * Read the blocks of a pcapng file.
+ *
+ * \param filename The name of the file.
+ * \returns The blocks, or no block if the file is invalid.
+ */
+static std::vector<PcapNgTestBlock>
+ReadBlocks(const std::string& filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)),
+                              std::istreambuf_iterator<char>());
+    std::vector<PcapNgTestBlock> blocks;
+    uint32_t offset = 0;
+    while (offset + 12 <= data.size())
+    {
+        uint32_t type;
+        uint32_t length;
+        uint32_t trailer;
+        std::memcpy(&type, data.data() + offset, 4);
+        std::memcpy(&length, data.data() + offset + 4, 4);
+        if (length % 4 != 0 || length < 12 || offset + length > data.size())
+        {
+            return {};
+        }
+        std::memcpy(&trailer, data.data() + offset + length - 4, 4);
+        if (trailer != length)
+        {
+            return {};
+        }
+        std::vector<uint8_t> body(data.begin() + offset + 8, data.begin() + offset + length - 4);
+        blocks.push_back({type, body});
+        offset += length;
+    }
+    if (offset != data.size())
+    {
+        return {};
+    }
+    return blocks;
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Header of a known size, filled with a byte value
+ */
+class PcapNgTestHeader : public Header
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::PcapNgTestHeader").SetParent<Header>();
+        return tid;
+    }
+
+    TypeId GetInstanceTypeId() const override
+    {
+        return GetTypeId();
+    }
+
+    void Print(std::ostream& os) const override
+    {
+    }
+
+    uint32_t GetSerializedSize() const override
+    {
+        return 10;
+    }
+
+    void Serialize(Buffer::Iterator start) const override
+    {
+        start.WriteU8(0xaa, 10);
+    }
+
+    uint32_t Deserialize(Buffer::Iterator start) override
+    {
+        start.Next(10);
+        return 10;
+    }
+};
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that PcapNgFile writes valid blocks.
+ */
+class PcapNgFileWriteTestCase : public TestCase
+{
+  public:
+    PcapNgFileWriteTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PcapNgFileWriteTestCase::PcapNgFileWriteTestCase()
+    : TestCase("Check to see that PcapNgFile writes the interfaces and packets")
+{
+}
+
+void
+PcapNgFileWriteTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("write.pcapng");
+    Ptr<Packet> small = Create<Packet>(51);
+    Ptr<Packet> large = Create<Packet>(300);
+    uint8_t data[3] = {1, 2, 3};
+
+    {
+        PcapNgFile f;
+        f.Open(filename, 100, true);
+        NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Open (" << filename << ") returns error");
+        NS_TEST_ASSERT_MSG_EQ(f.AddInterface("node-0-eth0", 1, 65535), 0, "wrong interface id");
+        NS_TEST_ASSERT_MSG_EQ(f.AddInterface("n1", 101, 100), 1, "wrong interface id");
+        NS_TEST_ASSERT_MSG_EQ(f.GetNInterfaces(), 2, "wrong number of interfaces");
+        f.Write(0, NanoSeconds(1500000001), small);
+        f.Write(1, Seconds(5000), large);
+        f.Write(1, Seconds(6000), PcapNgTestHeader(), small);
+        f.Write(0, MilliSeconds(7), data, 3, 42);
+        f.Write(0, MilliSeconds(8), data, 3);
+        f.Close();
+        NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Close returns error");
+    }
+
+    std::vector<PcapNgTestBlock> blocks = ReadBlocks(filename);
+    std::remove(filename.c_str());
+    NS_TEST_ASSERT_MSG_EQ(blocks.size(), 8, "invalid file, or wrong number of blocks");
+
+    NS_TEST_EXPECT_MSG_EQ(blocks[0].type, PcapNgFile::SECTION_HEADER_BLOCK, "no section header");
+    NS_TEST_EXPECT_MSG_EQ(blocks[0].Get32(0), PcapNgFile::BYTE_ORDER_MAGIC, "wrong magic");
+    NS_TEST_EXPECT_MSG_EQ(blocks[0].Get32(4), 1, "wrong version");
+    NS_TEST_EXPECT_MSG_EQ(blocks[0].GetOption(16, 4), "ns-3", "wrong application");
+
+    const char* names[] = {"node-0-eth0", "n1"};
+    uint32_t linkTypes[] = {1, 101};
+    uint32_t snapLens[] = {65535, 100};
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        const auto& block = blocks[1 + i];
+        NS_TEST_EXPECT_MSG_EQ(block.type, PcapNgFile::INTERFACE_DESCRIPTION_BLOCK, "no interface");
+        NS_TEST_EXPECT_MSG_EQ(block.Get32(0), linkTypes[i], "wrong data link type");
+        NS_TEST_EXPECT_MSG_EQ(block.Get32(4), snapLens[i], "wrong snapshot length");
+        NS_TEST_EXPECT_MSG_EQ(block.GetOption(8, 2), names[i], "wrong interface name");
+        NS_TEST_EXPECT_MSG_EQ(block.GetOption(8, 9), std::string(1, 9), "wrong resolution");
+    }
+
+    uint32_t interfaces[] = {0, 1, 1, 0};
+    uint64_t timestamps[] = {1500000001, 5000000000000, 6000000000000, 7000000};
+    uint32_t inclLens[] = {51, 100, 61, 3};
+    uint32_t origLens[] = {51, 300, 61, 3};
+    std::string comments[] = {"uid " + std::to_string(small->GetUid()),
+                              "uid " + std::to_string(large->GetUid()),
+                              "uid " + std::to_string(small->GetUid()),
+                              "uid 42"};
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        const auto& block = blocks[3 + i];
+        NS_TEST_EXPECT_MSG_EQ(block.type, PcapNgFile::ENHANCED_PACKET_BLOCK, "no packet");
+        NS_TEST_EXPECT_MSG_EQ(block.Get32(0), interfaces[i], "wrong interface");
+        uint64_t timestamp = (static_cast<uint64_t>(block.Get32(4)) << 32) | block.Get32(8);
+        NS_TEST_EXPECT_MSG_EQ(timestamp, timestamps[i], "wrong timestamp");
+        NS_TEST_EXPECT_MSG_EQ(block.Get32(12), inclLens[i], "wrong captured length");
+        NS_TEST_EXPECT_MSG_EQ(block.Get32(16), origLens[i], "wrong original length");
+        uint32_t options = 20 + ((inclLens[i] + 3) & ~3U);
+        NS_TEST_EXPECT_MSG_EQ(block.GetOption(options, 1), comments[i], "wrong comment");
+    }
+    NS_TEST_EXPECT_MSG_EQ(static_cast<uint32_t>(blocks[5].body[20]), 0xaa, "header not written");
+    NS_TEST_EXPECT_MSG_EQ(static_cast<uint32_t>(blocks[6].body[22]), 3, "data not written");
+    // a buffer without uid has no comment
+    NS_TEST_EXPECT_MSG_EQ(blocks[7].body.size(), 24, "unexpected options");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that PcapFileWrapper objects share the
+ * pcapng files.
+ */
+class PcapNgWrapperTestCase : public TestCase
+{
+  public:
+    PcapNgWrapperTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PcapNgWrapperTestCase::PcapNgWrapperTestCase()
+    : TestCase("Check to see that PcapFileWrapper objects share the pcapng files")
+{
+}
+
+void
+PcapNgWrapperTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("shared.pcapng");
+    std::string shards[] = {CreateTempDirFilename("shared-0.pcapng"),
+                            CreateTempDirFilename("shared-1.pcapng")};
+
+    std::vector<Ptr<PcapFileWrapper>> files;
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        Ptr<PcapFileWrapper> file = CreateObject<PcapFileWrapper>();
+        file->SetAttribute("PcapNgFile", StringValue(filename));
+        file->SetAttribute("PcapNgFiles", UintegerValue(2));
+        file->Open(CreateTempDirFilename("trace-" + std::to_string(i) + "-1.pcap"),
+                   std::ios::out);
+        NS_TEST_ASSERT_MSG_EQ(file->Fail(), false, "Open returns error");
+        file->Init(1);
+        file->Write(Seconds(i), Create<Packet>(100));
+        NS_TEST_ASSERT_MSG_EQ(file->Fail(), false, "Write returns error");
+        files.push_back(file);
+    }
+    NS_TEST_EXPECT_MSG_EQ(std::ifstream(CreateTempDirFilename("trace-0-1.pcap")).is_open(),
+                          false,
+                          "pcap file created");
+    files.clear();
+
+    std::vector<PcapNgTestBlock> blocks[2] = {ReadBlocks(shards[0]), ReadBlocks(shards[1])};
+    std::remove(shards[0].c_str());
+    std::remove(shards[1].c_str());
+
+    // the interfaces are spread over the two files
+    NS_TEST_ASSERT_MSG_EQ(blocks[0].size(), 5, "wrong number of blocks");
+    NS_TEST_ASSERT_MSG_EQ(blocks[1].size(), 3, "wrong number of blocks");
+    NS_TEST_EXPECT_MSG_EQ(blocks[0][1].GetOption(8, 2), "trace-0-1", "wrong interface name");
+    NS_TEST_EXPECT_MSG_EQ(blocks[1][1].GetOption(8, 2), "trace-1-1", "wrong interface name");
+    NS_TEST_EXPECT_MSG_EQ(blocks[0][3].GetOption(8, 2), "trace-2-1", "wrong interface name");
+    NS_TEST_EXPECT_MSG_EQ(blocks[0][2].Get32(0), 0, "wrong interface");
+    NS_TEST_EXPECT_MSG_EQ(blocks[0][4].Get32(0), 1, "wrong interface");
+    NS_TEST_EXPECT_MSG_EQ(blocks[0][4].Get32(8), 2000000000, "wrong timestamp");
+    NS_TEST_EXPECT_MSG_EQ(blocks[1][2].Get32(12), 100, "wrong captured length");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief pcapng file TestSuite
+ */
+class PcapNgFileTestSuite : public TestSuite
+{
+  public:
+    PcapNgFileTestSuite();
+};
+
+PcapNgFileTestSuite::PcapNgFileTestSuite()
+    : TestSuite("pcapng-file", Type::UNIT)
+{
+    AddTestCase(new PcapNgFileWriteTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new PcapNgWrapperTestCase, TestCase::Duration::QUICK);
+}
+
+static PcapNgFileTestSuite g_pcapNgFileTestSuite; //!< Static variable for test initialization
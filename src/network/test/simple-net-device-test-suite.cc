@@ -0,0 +1,211 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/data-rate.h"
+#include "ns3/mac48-address.h"
+#include "ns3/node.h"
+#include "ns3/packet-burst.h"
+#include "ns3/packet.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <initializer_list>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief SimpleNetDevice packet trains test
+ *
+ * Sends packets with and without packet trains, and checks when they are
+ * received and how many events were needed.
+ */
+class SimpleNetDeviceBurstTest : public TestCase
+{
+  public:
+    SimpleNetDeviceBurstTest();
+    void DoRun() override;
+
+  private:
+    /**
+     * Send packets over a link at 8 Mb/s with a 1 ms delay.
+     *
+     * \param maxBurstSize the MaxBurstSize of the sender
+     * \param maxBurstDuration the MaxBurstDuration of the sender
+     * \param nPackets the number of packets of about 1000 bytes to send
+     * \param asBurst whether to send the packets with SendBurst()
+     * \return the number of events executed
+     */
+    uint64_t Send(uint32_t maxBurstSize, Time maxBurstDuration, uint32_t nPackets, bool asBurst);
+
+    /**
+     * Receive a packet.
+     *
+     * \param device the receiving device
+     * \param packet the packet
+     * \param protocol the protocol number
+     * \param from the sender address
+     * \return true
+     */
+    bool Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& from);
+
+    std::vector<Time> m_rxTimes;       //!< the time at which each packet was received
+    std::vector<uint32_t> m_rxPackets; //!< the order in which the packets were received
+    uint32_t m_rxProtocol;             //!< the protocol number of the last packet received
+};
+
+SimpleNetDeviceBurstTest::SimpleNetDeviceBurstTest()
+    : TestCase("SimpleNetDevice packet trains")
+{
+}
+
+bool
+SimpleNetDeviceBurstTest::Receive(Ptr<NetDevice> device,
+                                  Ptr<const Packet> packet,
+                                  uint16_t protocol,
+                                  const Address& from)
+{
+    m_rxTimes.push_back(Simulator::Now());
+    m_rxPackets.push_back(packet->GetSize());
+    m_rxProtocol = protocol;
+    return true;
+}
+
+uint64_t
+SimpleNetDeviceBurstTest::Send(uint32_t maxBurstSize,
+                               Time maxBurstDuration,
+                               uint32_t nPackets,
+                               bool asBurst)
+{
+    m_rxTimes.clear();
+    m_rxPackets.clear();
+    m_rxProtocol = 0;
+
+    Ptr<Node> a = CreateObject<Node>();
+    Ptr<Node> b = CreateObject<Node>();
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    channel->SetAttribute("Delay", TimeValue(MilliSeconds(1)));
+    Ptr<SimpleNetDevice> tx = CreateObject<SimpleNetDevice>();
+    Ptr<SimpleNetDevice> rx = CreateObject<SimpleNetDevice>();
+    a->AddDevice(tx);
+    b->AddDevice(rx);
+    for (auto device : {tx, rx})
+    {
+        device->SetAttribute("DataRate", DataRateValue(DataRate("8Mb/s")));
+        device->SetAddress(Mac48Address::Allocate());
+        device->SetChannel(channel);
+    }
+    tx->SetAttribute("MaxBurstSize", UintegerValue(maxBurstSize));
+    tx->SetAttribute("MaxBurstDuration", TimeValue(maxBurstDuration));
+    rx->SetReceiveCallback(MakeCallback(&SimpleNetDeviceBurstTest::Receive, this));
+    // initialize the nodes and devices, so that only the transmission events are counted
+    Simulator::Run();
+
+    // packets of increasing sizes, to check their order
+    Ptr<PacketBurst> burst = CreateObject<PacketBurst>();
+    for (uint32_t i = 0; i < nPackets; i++)
+    {
+        burst->AddPacket(Create<Packet>(1000 + i));
+    }
+    if (asBurst)
+    {
+        tx->SendBurst(burst, rx->GetAddress(), 0x86dd);
+    }
+    else
+    {
+        for (auto i = burst->Begin(); i != burst->End(); ++i)
+        {
+            tx->Send(*i, rx->GetAddress(), 0x86dd);
+        }
+    }
+
+    uint64_t events = Simulator::GetEventCount();
+    Simulator::Run();
+    events = Simulator::GetEventCount() - events;
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(m_rxPackets.size(), nPackets, "packets lost");
+    for (uint32_t i = 0; i < m_rxPackets.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_rxPackets[i], 1000 + i, "packets reordered");
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_rxProtocol, 0x86dd, "wrong protocol number");
+    return events;
+}
+
+void
+SimpleNetDeviceBurstTest::DoRun()
+{
+    // one packet at a time: one transmission event and one reception event per packet
+    uint64_t events = Send(1, Seconds(1), 10, true);
+    NS_TEST_EXPECT_MSG_EQ(events, 20, "wrong number of events");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes.front(), MicroSeconds(2000), "wrong reception time");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes.back(), MicroSeconds(11045), "wrong reception time");
+    const std::vector<Time> arrivals = m_rxTimes;
+
+    // a single train, received once its last packet has been transmitted
+    events = Send(10, Seconds(1), 10, true);
+    NS_TEST_EXPECT_MSG_EQ(events, 2, "wrong number of events");
+    for (const auto& rxTime : m_rxTimes)
+    {
+        NS_TEST_EXPECT_MSG_EQ(rxTime, MicroSeconds(11045), "wrong reception time");
+    }
+
+    // trains limited to the maximum burst size
+    events = Send(4, Seconds(1), 10, true);
+    NS_TEST_EXPECT_MSG_EQ(events, 6, "wrong number of events");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[3], MicroSeconds(5006), "wrong reception time");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[7], MicroSeconds(9028), "wrong reception time");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[9], MicroSeconds(11045), "wrong reception time");
+
+    // trains limited to the maximum burst duration: no packet is received
+    // more than 3.5 ms after it arrives
+    events = Send(10, MicroSeconds(3500), 10, true);
+    NS_TEST_EXPECT_MSG_EQ(events, 6, "wrong number of events");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[3], MicroSeconds(5006), "wrong reception time");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[7], MicroSeconds(9028), "wrong reception time");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[9], MicroSeconds(11045), "wrong reception time");
+    for (uint32_t i = 0; i < m_rxTimes.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(m_rxTimes[i], arrivals[i], "received before arrival");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(m_rxTimes[i] - arrivals[i],
+                                    MicroSeconds(3500),
+                                    "received too late");
+    }
+
+    // the packets queued one by one are not gathered into trains
+    events = Send(10, Seconds(1), 10, false);
+    NS_TEST_EXPECT_MSG_EQ(events, 20, "wrong number of events");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes.front(), MicroSeconds(2000), "wrong reception time");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes.back(), MicroSeconds(11045), "wrong reception time");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief SimpleNetDevice TestSuite
+ */
+class SimpleNetDeviceTestSuite : public TestSuite
+{
+  public:
+    SimpleNetDeviceTestSuite();
+};
+
+SimpleNetDeviceTestSuite::SimpleNetDeviceTestSuite()
+    : TestSuite("simple-net-device", Type::UNIT)
+{
+    AddTestCase(new SimpleNetDeviceBurstTest, TestCase::Duration::QUICK);
+}
+
+static SimpleNetDeviceTestSuite g_simpleNetDeviceTest; //!< Static variable for test initialization
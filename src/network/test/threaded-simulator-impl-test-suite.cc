@@ -0,0 +1,621 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/config.h"
+#include "ns3/mac48-address.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/threaded-simulator-impl.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Connect two nodes with a SimpleChannel.
+ *
+ * \param a The first node.
+ * \param b The second node.
+ * \param delay The channel delay.
+ */
+static void
+Connect(Ptr<Node> a, Ptr<Node> b, Time delay)
+{
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    channel->SetAttribute("Delay", TimeValue(delay));
+    for (auto node : {a, b})
+    {
+        Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+        device->SetChannel(channel);
+        node->AddDevice(device);
+    }
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Check that the partitions and the lookahead are derived from the channels.
+ */
+class ThreadedSimulatorImplPartitionTestCase : public TestCase
+{
+  public:
+    ThreadedSimulatorImplPartitionTestCase();
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+};
+
+ThreadedSimulatorImplPartitionTestCase::ThreadedSimulatorImplPartitionTestCase()
+    : TestCase("Check the partitioning of the nodes and the lookahead")
+{
+}
+
+void
+ThreadedSimulatorImplPartitionTestCase::DoRun()
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::ThreadedSimulatorImpl"));
+    Config::SetDefault("ns3::ThreadedSimulatorImpl::MinLookAhead", TimeValue(MicroSeconds(1)));
+
+    // 0 --0-- 1 --2ms-- 2 --5ms-- 3 --1ns-- 4    5
+    std::vector<Ptr<Node>> nodes;
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        nodes.push_back(CreateObject<Node>());
+    }
+    Connect(nodes[0], nodes[1], Seconds(0));
+    Connect(nodes[1], nodes[2], MilliSeconds(2));
+    Connect(nodes[2], nodes[3], MilliSeconds(5));
+    Connect(nodes[3], nodes[4], NanoSeconds(1));
+
+    Simulator::Run();
+
+    Ptr<ThreadedSimulatorImpl> impl =
+        DynamicCast<ThreadedSimulatorImpl>(Simulator::GetImplementation());
+    NS_TEST_ASSERT_MSG_NE(impl, nullptr, "Wrong simulator implementation");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetPartitionCount(), 4, "Wrong number of partitions");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetLookAhead(), MilliSeconds(2), "Wrong lookahead");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetPartition(nodes[0]->GetId()),
+                          impl->GetPartition(nodes[1]->GetId()),
+                          "Nodes connected without delay must share a partition");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetPartition(nodes[3]->GetId()),
+                          impl->GetPartition(nodes[4]->GetId()),
+                          "Nodes connected with a delay below MinLookAhead must share a partition");
+    NS_TEST_EXPECT_MSG_NE(impl->GetPartition(nodes[1]->GetId()),
+                          impl->GetPartition(nodes[2]->GetId()),
+                          "Nodes connected with a delay must be in different partitions");
+    NS_TEST_EXPECT_MSG_NE(impl->GetPartition(nodes[5]->GetId()),
+                          0,
+                          "Isolated nodes must have their own partition");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetPartition(Simulator::NO_CONTEXT),
+                          0,
+                          "Events without context must run in the global partition");
+
+    Simulator::Destroy();
+}
+
+void
+ThreadedSimulatorImplPartitionTestCase::DoTeardown()
+{
+    Config::Reset();
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Exchange events between the nodes of a ring and check that every node
+ * observes the same sequence of events as with the DefaultSimulatorImpl.
+ */
+class ThreadedSimulatorImplRingTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * \param threads The number of threads.
+     */
+    ThreadedSimulatorImplRingTestCase(uint32_t threads);
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /** An event as observed by a node. */
+    struct Record
+    {
+        int64_t ts;       //!< Execution time, in time steps
+        uint32_t context; //!< Execution context
+        uint32_t token;   //!< Token carried by the event
+
+        /**
+         * \param o The other record
+         * \return Whether the records are equal
+         */
+        bool operator==(const Record& o) const
+        {
+            return ts == o.ts && context == o.context && token == o.token;
+        }
+
+        /**
+         * \param o The other record
+         * \return Whether this record sorts before the other one
+         */
+        bool operator<(const Record& o) const
+        {
+            return std::tie(ts, token) < std::tie(o.ts, o.token);
+        }
+    };
+
+    /**
+     * Build the ring, run it with a simulator implementation and return the
+     * events observed by each node.
+     * \param simulatorType The simulator implementation.
+     * \return The events observed by each node.
+     */
+    std::vector<std::vector<Record>> RunRing(const std::string& simulatorType);
+    /**
+     * Receive a token and forward it to the next node.
+     * \param node The receiving node index.
+     * \param token The token.
+     * \param hops The number of hops left.
+     */
+    void Receive(uint32_t node, uint32_t token, uint32_t hops);
+    /**
+     * Local timer, rescheduling itself and cancelling a timer.
+     * \param node The node index.
+     * \param count The number of timers left.
+     */
+    void Timer(uint32_t node, uint32_t count);
+    /**
+     * Global event, injecting a token in each node.
+     * \param token The token.
+     */
+    void Inject(uint32_t token);
+
+    uint32_t m_threads;                          //!< Number of threads
+    std::vector<Ptr<Node>> m_nodes;              //!< The ring nodes
+    std::vector<std::vector<Record>> m_observed; //!< The events observed by each node
+    std::vector<EventId> m_cancelled;            //!< Per-node event to cancel
+
+    static constexpr uint32_t N_NODES = 16;       //!< Number of nodes in the ring
+    static constexpr uint32_t HOPS = 50;          //!< Hops traveled by each token
+    static constexpr int64_t LINK_DELAY_US = 100; //!< Delay of the links
+};
+
+ThreadedSimulatorImplRingTestCase::ThreadedSimulatorImplRingTestCase(uint32_t threads)
+    : TestCase("Check a ring of nodes exchanging events with " + std::to_string(threads) +
+               " threads"),
+      m_threads(threads)
+{
+}
+
+void
+ThreadedSimulatorImplRingTestCase::Receive(uint32_t node, uint32_t token, uint32_t hops)
+{
+    m_observed[node].push_back({Simulator::Now().GetTimeStep(), Simulator::GetContext(), token});
+    if (hops == 0)
+    {
+        return;
+    }
+    uint32_t next = (node + 1) % N_NODES;
+    // Vary the delay, staying above the lookahead; tokens are received at
+    // whole microseconds, timers expire half-way between them
+    Time delay = MicroSeconds(LINK_DELAY_US + (token * 7 + hops) % 13);
+    Simulator::ScheduleWithContext(m_nodes[next]->GetId(),
+                                   delay,
+                                   &ThreadedSimulatorImplRingTestCase::Receive,
+                                   this,
+                                   next,
+                                   token,
+                                   hops - 1);
+}
+
+void
+ThreadedSimulatorImplRingTestCase::Timer(uint32_t node, uint32_t count)
+{
+    m_observed[node].push_back({Simulator::Now().GetTimeStep(), Simulator::GetContext(), count});
+    Simulator::Remove(m_cancelled[node]);
+    if (count > 0)
+    {
+        m_cancelled[node] = Simulator::Schedule(MicroSeconds(10),
+                                                &ThreadedSimulatorImplRingTestCase::Timer,
+                                                this,
+                                                node,
+                                                1000);
+        Simulator::Schedule(MicroSeconds(3 + node),
+                            &ThreadedSimulatorImplRingTestCase::Timer,
+                            this,
+                            node,
+                            count - 1);
+    }
+}
+
+void
+ThreadedSimulatorImplRingTestCase::Inject(uint32_t token)
+{
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        Simulator::ScheduleWithContext(m_nodes[i]->GetId(),
+                                       MicroSeconds(i),
+                                       &ThreadedSimulatorImplRingTestCase::Receive,
+                                       this,
+                                       i,
+                                       token + i,
+                                       HOPS);
+    }
+}
+
+std::vector<std::vector<ThreadedSimulatorImplRingTestCase::Record>>
+ThreadedSimulatorImplRingTestCase::RunRing(const std::string& simulatorType)
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue(simulatorType));
+    Config::SetDefault("ns3::ThreadedSimulatorImpl::ThreadCount", UintegerValue(m_threads));
+
+    m_nodes.clear();
+    m_observed.assign(N_NODES, {});
+    m_cancelled.assign(N_NODES, EventId());
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        m_nodes.push_back(CreateObject<Node>());
+    }
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        Connect(m_nodes[i], m_nodes[(i + 1) % N_NODES], MicroSeconds(LINK_DELAY_US));
+    }
+
+    Simulator::Schedule(MicroSeconds(5), &ThreadedSimulatorImplRingTestCase::Inject, this, 0);
+    Simulator::Schedule(MilliSeconds(1), &ThreadedSimulatorImplRingTestCase::Inject, this, 100);
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        Simulator::ScheduleWithContext(m_nodes[i]->GetId(),
+                                       MicroSeconds(50) + NanoSeconds(500),
+                                       &ThreadedSimulatorImplRingTestCase::Timer,
+                                       this,
+                                       i,
+                                       200);
+    }
+    Simulator::Stop(MilliSeconds(4));
+    Simulator::Run();
+
+    if (simulatorType == "ns3::ThreadedSimulatorImpl")
+    {
+        Ptr<ThreadedSimulatorImpl> impl =
+            DynamicCast<ThreadedSimulatorImpl>(Simulator::GetImplementation());
+        NS_TEST_EXPECT_MSG_EQ(impl->GetPartitionCount(), N_NODES, "Wrong number of partitions");
+        NS_TEST_EXPECT_MSG_EQ(impl->GetLookAhead(),
+                              MicroSeconds(LINK_DELAY_US),
+                              "Wrong lookahead");
+    }
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), MilliSeconds(4), "Wrong stop time");
+
+    Simulator::Destroy();
+    m_nodes.clear();
+    return m_observed;
+}
+
+void
+ThreadedSimulatorImplRingTestCase::DoRun()
+{
+    auto expected = RunRing("ns3::DefaultSimulatorImpl");
+    auto observed = RunRing("ns3::ThreadedSimulatorImpl");
+
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        // The order of simultaneous events sent by different nodes is arbitrary
+        std::sort(expected[i].begin(), expected[i].end());
+        std::sort(observed[i].begin(), observed[i].end());
+        NS_TEST_ASSERT_MSG_GT(expected[i].size(), HOPS, "Too few events observed");
+        NS_TEST_ASSERT_MSG_EQ(observed[i].size(),
+                              expected[i].size(),
+                              "Wrong number of events in node " << i);
+        for (std::size_t j = 0; j < expected[i].size(); ++j)
+        {
+            NS_TEST_ASSERT_MSG_EQ((observed[i][j] == expected[i][j]),
+                                  true,
+                                  "Event " << j << " of node " << i << " differs");
+        }
+    }
+}
+
+void
+ThreadedSimulatorImplRingTestCase::DoTeardown()
+{
+    Config::Reset();
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Forward packets around a ring of nodes, each in its own partition, and
+ * check their payload and their Uid.  The nodes modify the packets they
+ * send and receive, which would corrupt the packets of the other
+ * partitions if they shared their data.
+ */
+class ThreadedSimulatorImplPacketTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * \param threads The number of threads.
+     */
+    ThreadedSimulatorImplPacketTestCase(uint32_t threads);
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /** A packet as received by a node. */
+    struct Record
+    {
+        int64_t ts;                   //!< Reception time, in time steps
+        uint64_t uid;                 //!< Packet uid
+        std::vector<uint8_t> payload; //!< Packet payload
+
+        /**
+         * \param o The other record
+         * \return Whether the records are equal
+         */
+        bool operator==(const Record& o) const
+        {
+            return ts == o.ts && uid == o.uid && payload == o.payload;
+        }
+    };
+
+    /**
+     * Build the ring, run it and return the packets received by each node.
+     * \param threads The number of threads.
+     * \return The packets received by each node.
+     */
+    std::vector<std::vector<Record>> RunRing(uint32_t threads);
+    /**
+     * Create a packet and send it to the next node.
+     * \param node The sending node index.
+     * \param seq The packet sequence number.
+     */
+    void Send(uint32_t node, uint8_t seq);
+    /**
+     * Receive a packet, mark it and forward it to the next node.
+     * \param device The receiving device.
+     * \param packet The packet.
+     * \param protocol The protocol number.
+     * \param from The sender address.
+     * \return true
+     */
+    bool Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& from);
+    /**
+     * Get the byte at an offset of the initial payload of a packet.
+     * \param node The sending node index.
+     * \param seq The packet sequence number.
+     * \param offset The offset in the payload.
+     * \return The payload byte.
+     */
+    static uint8_t GetByte(uint32_t node, uint8_t seq, uint32_t offset);
+
+    uint32_t m_threads;                          //!< Number of threads
+    std::vector<Ptr<Node>> m_nodes;              //!< The ring nodes
+    std::vector<Ptr<NetDevice>> m_next;          //!< The device of each node to the next one
+    std::vector<std::vector<Ptr<Packet>>> m_kept; //!< Copies of the packets sent by each node
+    std::vector<std::vector<uint64_t>> m_uids;   //!< Uids of the packets sent by each node
+    std::vector<std::vector<Record>> m_received; //!< The packets received by each node
+
+    static constexpr uint32_t N_NODES = 8;        //!< Number of nodes in the ring
+    static constexpr uint8_t N_PACKETS = 20;      //!< Packets sent by each node
+    static constexpr uint32_t HOPS = 12;          //!< Hops traveled by each packet
+    static constexpr uint32_t SIZE = 100;         //!< Initial payload size
+    static constexpr int64_t LINK_DELAY_US = 100; //!< Delay of the links
+};
+
+ThreadedSimulatorImplPacketTestCase::ThreadedSimulatorImplPacketTestCase(uint32_t threads)
+    : TestCase("Check the packets exchanged by partitions with " + std::to_string(threads) +
+               " threads"),
+      m_threads(threads)
+{
+}
+
+uint8_t
+ThreadedSimulatorImplPacketTestCase::GetByte(uint32_t node, uint8_t seq, uint32_t offset)
+{
+    switch (offset)
+    {
+    case 0:
+        return node;
+    case 1:
+        return seq;
+    default:
+        return (node * 31 + seq * 7 + offset) & 0xff;
+    }
+}
+
+void
+ThreadedSimulatorImplPacketTestCase::Send(uint32_t node, uint8_t seq)
+{
+    std::vector<uint8_t> payload(SIZE);
+    for (uint32_t i = 0; i < SIZE; ++i)
+    {
+        payload[i] = GetByte(node, seq, i);
+    }
+    Ptr<Packet> packet = Create<Packet>(payload.data(), SIZE);
+    m_uids[node].push_back(packet->GetUid());
+
+    // Append to a copy of the packet sent, in the space following the data
+    // shared with it
+    Ptr<Packet> kept = packet->Copy();
+    m_next[node]->Send(packet, Mac48Address::GetBroadcast(), 0);
+    uint8_t marker = 0xff;
+    kept->AddAtEnd(Create<Packet>(&marker, 1));
+    m_kept[node].push_back(kept);
+}
+
+bool
+ThreadedSimulatorImplPacketTestCase::Receive(Ptr<NetDevice> device,
+                                             Ptr<const Packet> packet,
+                                             uint16_t protocol,
+                                             const Address& from)
+{
+    uint32_t node = device->GetNode()->GetId() - m_nodes[0]->GetId();
+    Record record{Simulator::Now().GetTimeStep(), packet->GetUid(), {}};
+    record.payload.resize(packet->GetSize());
+    packet->CopyData(record.payload.data(), record.payload.size());
+    m_received[node].push_back(record);
+
+    if (record.payload.size() < SIZE + HOPS - 1)
+    {
+        Ptr<Packet> forwarded = packet->Copy();
+        auto marker = static_cast<uint8_t>(node);
+        forwarded->AddAtEnd(Create<Packet>(&marker, 1));
+        m_next[node]->Send(forwarded, Mac48Address::GetBroadcast(), 0);
+    }
+    return true;
+}
+
+std::vector<std::vector<ThreadedSimulatorImplPacketTestCase::Record>>
+ThreadedSimulatorImplPacketTestCase::RunRing(uint32_t threads)
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::ThreadedSimulatorImpl"));
+    Config::SetDefault("ns3::ThreadedSimulatorImpl::ThreadCount", UintegerValue(threads));
+
+    m_nodes.clear();
+    m_next.clear();
+    m_kept.assign(N_NODES, {});
+    m_uids.assign(N_NODES, {});
+    m_received.assign(N_NODES, {});
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        m_nodes.push_back(CreateObject<Node>());
+    }
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        Connect(m_nodes[i], m_nodes[(i + 1) % N_NODES], MicroSeconds(LINK_DELAY_US));
+        m_next.push_back(m_nodes[i]->GetDevice(m_nodes[i]->GetNDevices() - 1));
+    }
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        for (uint32_t j = 0; j < m_nodes[i]->GetNDevices(); ++j)
+        {
+            m_nodes[i]->GetDevice(j)->SetReceiveCallback(
+                MakeCallback(&ThreadedSimulatorImplPacketTestCase::Receive, this));
+        }
+        for (uint8_t seq = 0; seq < N_PACKETS; ++seq)
+        {
+            Simulator::ScheduleWithContext(m_nodes[i]->GetId(),
+                                           MicroSeconds(seq * 10 + i),
+                                           &ThreadedSimulatorImplPacketTestCase::Send,
+                                           this,
+                                           i,
+                                           seq);
+        }
+    }
+    Simulator::Run();
+
+    Ptr<ThreadedSimulatorImpl> impl =
+        DynamicCast<ThreadedSimulatorImpl>(Simulator::GetImplementation());
+    NS_TEST_EXPECT_MSG_EQ(impl->GetPartitionCount(), N_NODES, "Wrong number of partitions");
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        for (auto uid : m_uids[i])
+        {
+            NS_TEST_EXPECT_MSG_EQ((uid >> 32),
+                                  impl->GetPartition(m_nodes[i]->GetId()),
+                                  "Uid not taken from the partition counter");
+        }
+        for (const auto& kept : m_kept[i])
+        {
+            NS_TEST_EXPECT_MSG_EQ(kept->GetSize(), SIZE + 1, "Wrong size of a sent packet");
+        }
+    }
+
+    Simulator::Destroy();
+    m_nodes.clear();
+    m_next.clear();
+    m_kept.clear();
+    return m_received;
+}
+
+void
+ThreadedSimulatorImplPacketTestCase::DoRun()
+{
+    auto expected = RunRing(1);
+    auto uids = m_uids;
+    auto observed = RunRing(m_threads);
+    NS_TEST_ASSERT_MSG_EQ((m_uids == uids), true, "The packet uids depend on the thread count");
+
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(observed[i].size(),
+                              N_PACKETS * HOPS,
+                              "Wrong number of packets received by node " << i);
+        for (std::size_t j = 0; j < observed[i].size(); ++j)
+        {
+            const auto& record = observed[i][j];
+            NS_TEST_ASSERT_MSG_EQ((record == expected[i][j]),
+                                  true,
+                                  "Packet " << j << " of node " << i << " differs");
+
+            // The payload is the initial one, followed by one byte per hop
+            NS_TEST_ASSERT_MSG_GT_OR_EQ(record.payload.size(), SIZE, "Payload too short");
+            uint32_t origin = record.payload[0];
+            uint8_t seq = record.payload[1];
+            NS_TEST_ASSERT_MSG_LT(origin, N_NODES, "Corrupted payload");
+            NS_TEST_ASSERT_MSG_LT(seq, N_PACKETS, "Corrupted payload");
+            NS_TEST_EXPECT_MSG_EQ(record.uid, m_uids[origin][seq], "Wrong packet uid");
+            for (uint32_t k = 0; k < record.payload.size(); ++k)
+            {
+                uint8_t byte = k < SIZE ? GetByte(origin, seq, k) : (origin + 1 + k - SIZE) % N_NODES;
+                NS_TEST_ASSERT_MSG_EQ(+record.payload[k],
+                                      +byte,
+                                      "Byte " << k << " of packet " << j << " of node " << i);
+            }
+        }
+    }
+}
+
+void
+ThreadedSimulatorImplPacketTestCase::DoTeardown()
+{
+    Config::Reset();
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief ThreadedSimulatorImpl TestSuite
+ */
+class ThreadedSimulatorImplTestSuite : public TestSuite
+{
+  public:
+    ThreadedSimulatorImplTestSuite()
+        : TestSuite("threaded-simulator-impl", Type::UNIT)
+    {
+        AddTestCase(new ThreadedSimulatorImplPartitionTestCase(), TestCase::Duration::QUICK);
+        for (uint32_t threads : {1, 2, 4})
+        {
+            AddTestCase(new ThreadedSimulatorImplRingTestCase(threads), TestCase::Duration::QUICK);
+            AddTestCase(new ThreadedSimulatorImplPacketTestCase(threads),
+                        TestCase::Duration::QUICK);
+        }
+    }
+};
+
+static ThreadedSimulatorImplTestSuite
+    g_threadedSimulatorImplTestSuite; //!< Static variable for test initialization
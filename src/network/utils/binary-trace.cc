@@ -0,0 +1,558 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "binary-trace.h"
+
+#include "ns3/assert.h"
+#include "ns3/fatal-impl.h"
+#include "ns3/hash.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <streambuf>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("BinaryTrace");
+
+/// Size of a packet event, after its type
+static const uint32_t PACKET_ENTRY_SIZE = 28;
+
+/**
+ * \brief Stream buffer writing its lines to a BinaryTraceWriter
+ */
+class BinaryTraceWriter::TextBuffer : public std::streambuf
+{
+  public:
+    /**
+     * Constructor
+     * \param writer the writer
+     */
+    TextBuffer(BinaryTraceWriter* writer)
+        : m_writer(writer)
+    {
+    }
+
+    /**
+     * Write the last line, if it is not terminated.
+     */
+    void FlushLine()
+    {
+        if (!m_line.empty())
+        {
+            m_writer->WriteText(m_line);
+            m_line.clear();
+        }
+    }
+
+  protected:
+    int_type overflow(int_type c) override
+    {
+        if (c != traits_type::eof())
+        {
+            Put(traits_type::to_char_type(c));
+        }
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override
+    {
+        for (std::streamsize i = 0; i < n; ++i)
+        {
+            Put(s[i]);
+        }
+        return n;
+    }
+
+  private:
+    /**
+     * Add a character to the current line.
+     * \param c the character
+     */
+    void Put(char c)
+    {
+        if (c == '\n')
+        {
+            m_writer->WriteText(m_line);
+            m_line.clear();
+        }
+        else
+        {
+            m_line.push_back(c);
+        }
+    }
+
+    BinaryTraceWriter* m_writer; //!< the writer
+    std::string m_line;          //!< the current line
+};
+
+BinaryTraceWriter::BinaryTraceWriter(const std::string& filename, bool digest, bool print)
+    : m_digest(digest),
+      m_print(print)
+{
+    NS_LOG_FUNCTION(this << filename << digest << print);
+    FatalImpl::RegisterStream(&m_file);
+    m_file.open(filename, std::ios::out | std::ios::binary);
+    uint32_t magic = MAGIC;
+    uint16_t version = VERSION;
+    uint16_t flags = (digest ? FLAG_DIGEST : 0) | (print ? FLAG_PRINT : 0);
+    m_file.write(reinterpret_cast<const char*>(&magic), 4);
+    m_file.write(reinterpret_cast<const char*>(&version), 2);
+    m_file.write(reinterpret_cast<const char*>(&flags), 2);
+    m_block.reserve(BLOCK_SIZE + PACKET_ENTRY_SIZE + 1);
+}
+
+BinaryTraceWriter::~BinaryTraceWriter()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_textBuffer)
+    {
+        m_textStream->flush();
+        m_textBuffer->FlushLine();
+    }
+    WriteBlock();
+    FatalImpl::UnregisterStream(&m_file);
+}
+
+bool
+BinaryTraceWriter::Fail() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_file.fail();
+}
+
+uint8_t*
+BinaryTraceWriter::AddEntry(char type, uint32_t size)
+{
+    NS_LOG_FUNCTION(this << type << size);
+    std::size_t start = m_block.size();
+    m_block.resize(start + 1 + size);
+    m_block[start] = type;
+    return m_block.data() + start + 1;
+}
+
+void
+BinaryTraceWriter::EndEntry()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_block.size() >= BLOCK_SIZE)
+    {
+        WriteBlock();
+    }
+}
+
+uint32_t
+BinaryTraceWriter::GetContextId(const std::string& context)
+{
+    NS_LOG_FUNCTION(this << context);
+    auto [it, inserted] = m_contexts.emplace(context, m_contexts.size());
+    if (inserted)
+    {
+        // find the node and device, as in /NodeList/<node>/DeviceList/<device>/...
+        uint32_t node = UNKNOWN;
+        uint32_t device = UNKNOWN;
+        const char nodeList[] = "/NodeList/";
+        const char deviceList[] = "/DeviceList/";
+        if (context.compare(0, sizeof(nodeList) - 1, nodeList) == 0)
+        {
+            char* end;
+            const char* start = context.c_str() + sizeof(nodeList) - 1;
+            node = std::strtoul(start, &end, 10);
+            if (end == start)
+            {
+                node = UNKNOWN;
+            }
+            else if (std::strncmp(end, deviceList, sizeof(deviceList) - 1) == 0)
+            {
+                start = end + sizeof(deviceList) - 1;
+                device = std::strtoul(start, &end, 10);
+                if (end == start)
+                {
+                    device = UNKNOWN;
+                }
+            }
+        }
+
+        uint32_t id = it->second;
+        uint32_t length = context.size();
+        uint8_t* data = AddEntry('c', 16 + length);
+        std::memcpy(data, &id, 4);
+        std::memcpy(data + 4, &node, 4);
+        std::memcpy(data + 8, &device, 4);
+        std::memcpy(data + 12, &length, 4);
+        std::memcpy(data + 16, context.data(), length);
+    }
+    return it->second;
+}
+
+void
+BinaryTraceWriter::Write(char event, Time t, Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(this << event << t << p);
+    WritePacket(event, t, UNKNOWN, p);
+}
+
+void
+BinaryTraceWriter::Write(char event, Time t, const std::string& context, Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(this << event << t << context << p);
+    WritePacket(event, t, GetContextId(context), p);
+}
+
+void
+BinaryTraceWriter::WritePacket(char event, Time t, uint32_t context, Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(this << event << t << context << p);
+    NS_ASSERT(event == '+' || event == '-' || event == 'd' || event == 'r');
+    int64_t time = t.GetNanoSeconds();
+    uint64_t uid = p->GetUid();
+    uint32_t size = p->GetSize();
+    uint32_t digest = 0;
+    if (m_digest)
+    {
+        uint8_t bytes[DIGEST_SIZE];
+        uint32_t n = p->CopyData(bytes, DIGEST_SIZE);
+        digest = Hash32(reinterpret_cast<const char*>(bytes), n);
+    }
+
+    std::string printed;
+    if (m_print)
+    {
+        std::ostringstream os;
+        os << *p;
+        printed = os.str();
+    }
+
+    uint32_t length = printed.size();
+    uint8_t* data = AddEntry(event, PACKET_ENTRY_SIZE + (m_print ? 4 + length : 0));
+    std::memcpy(data, &time, 8);
+    std::memcpy(data + 8, &uid, 8);
+    std::memcpy(data + 16, &context, 4);
+    std::memcpy(data + 20, &size, 4);
+    std::memcpy(data + 24, &digest, 4);
+    if (m_print)
+    {
+        std::memcpy(data + PACKET_ENTRY_SIZE, &length, 4);
+        std::memcpy(data + PACKET_ENTRY_SIZE + 4, printed.data(), length);
+    }
+    EndEntry();
+}
+
+void
+BinaryTraceWriter::WriteText(const std::string& text)
+{
+    NS_LOG_FUNCTION(this << text);
+    uint32_t length = text.size();
+    uint8_t* data = AddEntry('t', 4 + length);
+    std::memcpy(data, &length, 4);
+    std::memcpy(data + 4, text.data(), length);
+    EndEntry();
+}
+
+std::ostream*
+BinaryTraceWriter::GetTextStream()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_textBuffer)
+    {
+        m_textBuffer = std::make_unique<TextBuffer>(this);
+        m_textStream = std::make_unique<std::ostream>(m_textBuffer.get());
+    }
+    return m_textStream.get();
+}
+
+void
+BinaryTraceWriter::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    WriteBlock();
+    m_file.flush();
+}
+
+void
+BinaryTraceWriter::WriteBlock()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_block.empty())
+    {
+        return;
+    }
+    uint32_t size = m_block.size();
+    const uint8_t* stored = m_block.data();
+    uint32_t storedSize = size;
+#ifdef HAVE_ZLIB
+    uLongf compressedSize = compressBound(size);
+    m_compressed.resize(compressedSize);
+    if (compress2(m_compressed.data(), &compressedSize, m_block.data(), size, Z_BEST_SPEED) ==
+            Z_OK &&
+        compressedSize < size)
+    {
+        stored = m_compressed.data();
+        storedSize = compressedSize;
+    }
+#endif
+    m_file.write(reinterpret_cast<const char*>(&size), 4);
+    m_file.write(reinterpret_cast<const char*>(&storedSize), 4);
+    m_file.write(reinterpret_cast<const char*>(stored), storedSize);
+    m_block.clear();
+}
+
+BinaryTraceReader::BinaryTraceReader()
+    : m_fail(false),
+      m_flags(0),
+      m_offset(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+bool
+BinaryTraceReader::Open(const std::string& filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    m_file.open(filename, std::ios::in | std::ios::binary);
+    uint32_t magic = 0;
+    uint16_t version = 0;
+    m_file.read(reinterpret_cast<char*>(&magic), 4);
+    m_file.read(reinterpret_cast<char*>(&version), 2);
+    m_file.read(reinterpret_cast<char*>(&m_flags), 2);
+    m_fail = !m_file || magic != BinaryTraceWriter::MAGIC || version != BinaryTraceWriter::VERSION;
+    m_block.clear();
+    m_offset = 0;
+    m_contexts.clear();
+    return !m_fail;
+}
+
+bool
+BinaryTraceReader::Fail() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_fail;
+}
+
+bool
+BinaryTraceReader::HasDigests() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_flags & BinaryTraceWriter::FLAG_DIGEST;
+}
+
+bool
+BinaryTraceReader::HasPrintedPackets() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_flags & BinaryTraceWriter::FLAG_PRINT;
+}
+
+bool
+BinaryTraceReader::ReadBlock()
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t size;
+    uint32_t storedSize;
+    if (!m_file.read(reinterpret_cast<char*>(&size), 4))
+    {
+        // end of the file
+        return false;
+    }
+    m_file.read(reinterpret_cast<char*>(&storedSize), 4);
+    if (!m_file || storedSize > size)
+    {
+        m_fail = true;
+        return false;
+    }
+    m_block.resize(size);
+    m_offset = 0;
+    if (storedSize == size)
+    {
+        m_file.read(reinterpret_cast<char*>(m_block.data()), size);
+        m_fail = !m_file;
+        return !m_fail;
+    }
+#ifdef HAVE_ZLIB
+    m_stored.resize(storedSize);
+    m_file.read(reinterpret_cast<char*>(m_stored.data()), storedSize);
+    uLongf uncompressedSize = size;
+    m_fail = !m_file ||
+             uncompress(m_block.data(), &uncompressedSize, m_stored.data(), storedSize) != Z_OK ||
+             uncompressedSize != size;
+#else
+    NS_LOG_WARN("Cannot read a compressed binary trace, ns-3 was built without zlib");
+    m_fail = true;
+#endif
+    return !m_fail;
+}
+
+bool
+BinaryTraceReader::Read(BinaryTraceEntry& entry)
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_fail)
+    {
+        if (m_offset == m_block.size() && !ReadBlock())
+        {
+            return false;
+        }
+        if (m_offset == m_block.size())
+        {
+            continue;
+        }
+        const uint8_t* data = m_block.data() + m_offset + 1;
+        uint32_t left = m_block.size() - m_offset - 1;
+        char type = m_block[m_offset];
+        if (type == '+' || type == '-' || type == 'd' || type == 'r')
+        {
+            bool printed = HasPrintedPackets();
+            uint32_t length = 0;
+            if (printed && left >= PACKET_ENTRY_SIZE + 4)
+            {
+                std::memcpy(&length, data + PACKET_ENTRY_SIZE, 4);
+            }
+            if (left < PACKET_ENTRY_SIZE + (printed ? 4 : 0) ||
+                left - PACKET_ENTRY_SIZE - (printed ? 4 : 0) < length)
+            {
+                break;
+            }
+            int64_t time;
+            uint32_t context;
+            std::memcpy(&time, data, 8);
+            std::memcpy(&entry.uid, data + 8, 8);
+            std::memcpy(&context, data + 16, 4);
+            std::memcpy(&entry.size, data + 20, 4);
+            std::memcpy(&entry.digest, data + 24, 4);
+            entry.event = type;
+            entry.time = NanoSeconds(time);
+            entry.text.clear();
+            if (printed)
+            {
+                entry.text.assign(reinterpret_cast<const char*>(data + PACKET_ENTRY_SIZE + 4),
+                                  length);
+            }
+            entry.printed = printed;
+            if (context == BinaryTraceWriter::UNKNOWN)
+            {
+                entry.node = BinaryTraceWriter::UNKNOWN;
+                entry.device = BinaryTraceWriter::UNKNOWN;
+                entry.context.clear();
+            }
+            else if (context < m_contexts.size())
+            {
+                entry.node = m_contexts[context].node;
+                entry.device = m_contexts[context].device;
+                entry.context = m_contexts[context].str;
+            }
+            else
+            {
+                break;
+            }
+            m_offset += 1 + PACKET_ENTRY_SIZE + (printed ? 4 + length : 0);
+            return true;
+        }
+        else if (type == 't')
+        {
+            uint32_t length = 0;
+            if (left >= 4)
+            {
+                std::memcpy(&length, data, 4);
+            }
+            if (left < 4 || left - 4 < length)
+            {
+                break;
+            }
+            entry = BinaryTraceEntry();
+            entry.event = type;
+            entry.node = BinaryTraceWriter::UNKNOWN;
+            entry.device = BinaryTraceWriter::UNKNOWN;
+            entry.text.assign(reinterpret_cast<const char*>(data + 4), length);
+            m_offset += 5 + length;
+            return true;
+        }
+        else if (type == 'c')
+        {
+            uint32_t id = 0;
+            uint32_t length = 0;
+            if (left >= 16)
+            {
+                std::memcpy(&id, data, 4);
+                std::memcpy(&length, data + 12, 4);
+            }
+            if (left < 16 || left - 16 < length)
+            {
+                break;
+            }
+            if (id != m_contexts.size())
+            {
+                break;
+            }
+            Context context;
+            std::memcpy(&context.node, data + 4, 4);
+            std::memcpy(&context.device, data + 8, 4);
+            context.str.assign(reinterpret_cast<const char*>(data + 16), length);
+            m_contexts.push_back(context);
+            m_offset += 17 + length;
+        }
+        else
+        {
+            break;
+        }
+    }
+    m_fail = true;
+    return false;
+}
+
+void
+BinaryTraceReader::Print(const BinaryTraceEntry& entry, std::ostream& os)
+{
+    if (entry.event == 't')
+    {
+        os << entry.text << std::endl;
+        return;
+    }
+    os << entry.event << " " << entry.time.GetSeconds() << " ";
+    if (!entry.context.empty())
+    {
+        os << entry.context << " ";
+    }
+    if (entry.printed)
+    {
+        os << entry.text << std::endl;
+        return;
+    }
+    os << "Packet (uid=" << entry.uid << " size=" << entry.size;
+    if (entry.digest != 0)
+    {
+        std::ios::fmtflags flags = os.flags();
+        os << " digest=0x" << std::hex << std::setw(8) << std::setfill('0') << entry.digest;
+        os.flags(flags);
+        os << std::setfill(' ');
+    }
+    os << ")" << std::endl;
+}
+
+bool
+BinaryTraceReader::ConvertToText(const std::string& filename, std::ostream& os)
+{
+    BinaryTraceReader reader;
+    if (!reader.Open(filename))
+    {
+        return false;
+    }
+    BinaryTraceEntry entry;
+    while (reader.Read(entry))
+    {
+        Print(entry, os);
+    }
+    return !reader.Fail();
+}
+
+} // namespace ns3
@@ -0,0 +1,268 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef BINARY_TRACE_H
+#define BINARY_TRACE_H
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+class Packet;
+
+/**
+ * \brief Entry of a binary trace: a packet event, or a line of text.
+ */
+struct BinaryTraceEntry
+{
+    char event;          //!< '+', '-', 'd' or 'r' for a packet event, 't' for a line of text
+    Time time;           //!< Time of the packet event
+    uint64_t uid;        //!< Uid of the packet
+    uint32_t size;       //!< Size of the packet
+    uint32_t digest;     //!< Hash of the first bytes of the packet, or 0
+    uint32_t node;       //!< Node id, from the context, or BinaryTraceWriter::UNKNOWN
+    uint32_t device;     //!< Device index, from the context, or BinaryTraceWriter::UNKNOWN
+    std::string context; //!< Context of the packet event, if any
+    std::string text;    //!< Line of text, or printed packet of a packet event
+    bool printed;        //!< Whether the text of a packet event is the printed packet
+};
+
+/**
+ * \brief Writer of a binary trace, a compact replacement of the ascii traces.
+ *
+ * The packet events written by the AsciiTraceHelper default sinks are stored
+ * as fixed records giving the event type, time, uid and size of the packet,
+ * the context of the trace source, if any, and optionally a digest of the
+ * first bytes of the packet.  The packets are only printed when requested,
+ * so that BinaryTraceReader reproduces the ascii traces.  The contexts are
+ * stored once, along with the node id and device index found in them.  The
+ * lines of text written to GetTextStream() by the other trace sinks, e.g.
+ * the internet and wifi ascii trace sinks, are stored as they are.
+ *
+ * The entries are written in blocks of about BLOCK_SIZE bytes, compressed
+ * with zlib when available.  BinaryTraceReader reads them back, and converts
+ * them to the ascii trace format.
+ *
+ * The file starts with a 8-byte header: the 32-bit MAGIC, a 16-bit version and
+ * 16-bit flags (FLAG_DIGEST, FLAG_PRINT).  Each block is made of its 32-bit uncompressed
+ * size, its 32-bit stored size, which is the same when it is not compressed,
+ * and the stored bytes.  The entries in a block start with their type:
+ *
+ *   - a packet event ('+', '-', 'd' or 'r'), followed by the 64-bit time in
+ *     nanoseconds, the 64-bit uid, and the 32-bit context id, size and digest,
+ *     followed by the 32-bit length and the text of the printed packet if
+ *     FLAG_PRINT is set;
+ *   - a context definition ('c'), followed by the 32-bit context id, node id,
+ *     device index and length, and the context;
+ *   - a line of text ('t'), followed by its 32-bit length and the text.
+ *
+ * All the values are written in the native byte order.
+ */
+class BinaryTraceWriter : public SimpleRefCount<BinaryTraceWriter>
+{
+  public:
+    static constexpr uint32_t MAGIC = 0x6e337462;   //!< Magic number of the file
+    static constexpr uint16_t VERSION = 1;          //!< Version of the format
+    static constexpr uint16_t FLAG_DIGEST = 1;      //!< The packet digests are written
+    static constexpr uint16_t FLAG_PRINT = 2;       //!< The printed packets are written
+    static constexpr uint32_t BLOCK_SIZE = 65536;   //!< Size from which a block is written
+    static constexpr uint32_t DIGEST_SIZE = 64;     //!< Number of packet bytes in a digest
+    static constexpr uint32_t UNKNOWN = 0xffffffff; //!< No context, node or device
+
+    /**
+     * Create a binary trace file.
+     *
+     * \param filename The name of the file.
+     * \param digest Whether to write a digest of the first bytes of the packets.
+     * \param print Whether to write the printed packets.
+     */
+    BinaryTraceWriter(const std::string& filename, bool digest, bool print = false);
+    ~BinaryTraceWriter();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    BinaryTraceWriter(const BinaryTraceWriter&) = delete;
+    BinaryTraceWriter& operator=(const BinaryTraceWriter&) = delete;
+
+    /**
+     * \return true if the 'fail' bit is set in the underlying file stream, false otherwise.
+     */
+    bool Fail() const;
+
+    /**
+     * Write a packet event without context.
+     *
+     * \param event The event type: '+', '-', 'd' or 'r'.
+     * \param t The time of the event.
+     * \param p The packet.
+     */
+    void Write(char event, Time t, Ptr<const Packet> p);
+
+    /**
+     * Write a packet event.
+     *
+     * \param event The event type: '+', '-', 'd' or 'r'.
+     * \param t The time of the event.
+     * \param context The context of the trace source.
+     * \param p The packet.
+     */
+    void Write(char event, Time t, const std::string& context, Ptr<const Packet> p);
+
+    /**
+     * Write a line of text.
+     *
+     * \param text The text, without end of line.
+     */
+    void WriteText(const std::string& text);
+
+    /**
+     * \returns A stream whose lines are written as lines of text.
+     */
+    std::ostream* GetTextStream();
+
+    /**
+     * Write the current block, and flush the file.
+     */
+    void Flush();
+
+  private:
+    class TextBuffer;
+
+    /**
+     * \brief Reserve room for an entry at the end of the current block
+     * \param type the entry type
+     * \param size the size of the entry, after its type
+     * \returns where to write the entry
+     */
+    uint8_t* AddEntry(char type, uint32_t size);
+    /**
+     * \brief Write the current block to the file if it is full
+     */
+    void EndEntry();
+    /**
+     * \brief Write the current block to the file
+     */
+    void WriteBlock();
+    /**
+     * \brief Write a packet event
+     * \param event the event type
+     * \param t the time of the event
+     * \param context the id of the context, or UNKNOWN
+     * \param p the packet
+     */
+    void WritePacket(char event, Time t, uint32_t context, Ptr<const Packet> p);
+    /**
+     * \brief Get the id of a context, defining it if it is new
+     * \param context the context
+     * \returns the id of the context
+     */
+    uint32_t GetContextId(const std::string& context);
+
+    std::ofstream m_file;                                 //!< file stream
+    bool m_digest;                                        //!< whether the digests are written
+    bool m_print;                                         //!< whether the packets are printed
+    std::vector<uint8_t> m_block;                         //!< current block
+    std::vector<uint8_t> m_compressed;                    //!< compressed block
+    std::unordered_map<std::string, uint32_t> m_contexts; //!< id of each context
+    std::unique_ptr<TextBuffer> m_textBuffer;             //!< buffer of the text stream
+    std::unique_ptr<std::ostream> m_textStream;           //!< text stream
+};
+
+/**
+ * \brief Streaming reader of a binary trace written by BinaryTraceWriter.
+ *
+ * The entries are read one at a time, decompressing one block at a time.
+ */
+class BinaryTraceReader
+{
+  public:
+    BinaryTraceReader();
+
+    /**
+     * Open a binary trace file.
+     *
+     * \param filename The name of the file.
+     * \returns true if the file is a binary trace.
+     */
+    bool Open(const std::string& filename);
+
+    /**
+     * Read the next entry.
+     *
+     * \param [out] entry The entry.
+     * \returns false at the end of the file, or if it is corrupted.
+     */
+    bool Read(BinaryTraceEntry& entry);
+
+    /**
+     * \returns true if the file could not be read, or is corrupted.
+     */
+    bool Fail() const;
+
+    /**
+     * \returns true if the file has the digests of the packets.
+     */
+    bool HasDigests() const;
+
+    /**
+     * \returns true if the file has the printed packets.
+     */
+    bool HasPrintedPackets() const;
+
+    /**
+     * Print an entry in the ascii trace format.  The packets are printed as
+     * they were when written, if the file has the printed packets, and
+     * otherwise as their uid, size and digest, if any.
+     *
+     * \param entry The entry.
+     * \param os The output stream.
+     */
+    static void Print(const BinaryTraceEntry& entry, std::ostream& os);
+
+    /**
+     * Convert a binary trace to the ascii trace format.
+     *
+     * \param filename The name of the binary trace file.
+     * \param os The output stream.
+     * \returns false if the file could not be read, or is corrupted.
+     */
+    static bool ConvertToText(const std::string& filename, std::ostream& os);
+
+  private:
+    /**
+     * \brief Read the next block of the file
+     * \returns false at the end of the file, or if it is corrupted
+     */
+    bool ReadBlock();
+
+    /// Context definition
+    struct Context
+    {
+        uint32_t node;   //!< node id
+        uint32_t device; //!< device index
+        std::string str; //!< context
+    };
+
+    std::ifstream m_file;            //!< file stream
+    bool m_fail;                     //!< whether the file is corrupted
+    uint16_t m_flags;                //!< flags of the file
+    std::vector<uint8_t> m_block;    //!< current block
+    std::vector<uint8_t> m_stored;   //!< current block, as stored
+    uint32_t m_offset;               //!< offset of the next entry in the block
+    std::vector<Context> m_contexts; //!< contexts, by id
+};
+
+} // namespace ns3
+
+#endif /* BINARY_TRACE_H */
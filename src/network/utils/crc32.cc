@@ -56,12 +56,48 @@ static uint32_t crc32table[256] = {
     0xB3667A2E, 0xC4614AB8, 0x5D681B02, 0x2A6F2B94, 0xB40BBE37, 0xC30C8EA1, 0x5A05DF1B, 0x2D02EF8D,
 };
 
+/**
+ * Tables of CRC-32 values for slicing-by-8: entry i of table k is the CRC of
+ * the byte i followed by k zero bytes.
+ */
+struct Crc32SlicingTables
+{
+    Crc32SlicingTables()
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            table[0][i] = crc32table[i];
+        }
+        for (uint32_t k = 1; k < 8; k++)
+        {
+            for (uint32_t i = 0; i < 256; i++)
+            {
+                uint32_t previous = table[k - 1][i];
+                table[k][i] = (previous >> 8) ^ crc32table[previous & 0xFF];
+            }
+        }
+    }
+
+    uint32_t table[8][256]; //!< the tables
+};
+
 uint32_t
 CRC32Calculate(const uint8_t* data, int length)
 {
+    static const Crc32SlicingTables tables;
+    const auto& t = tables.table;
     uint32_t crc = 0xffffffff;
 
-    while (length--)
+    // process 8 bytes at a time, the first 4 bytes being combined with the crc
+    while (length >= 8)
+    {
+        crc ^= data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+        crc = t[7][crc & 0xFF] ^ t[6][(crc >> 8) & 0xFF] ^ t[5][(crc >> 16) & 0xFF] ^
+              t[4][crc >> 24] ^ t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]];
+        data += 8;
+        length -= 8;
+    }
+    while (length-- > 0)
     {
         crc = (crc >> 8) ^ crc32table[(crc & 0xFF) ^ *data++];
     }
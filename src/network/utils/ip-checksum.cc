@@ -0,0 +1,144 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ip-checksum.h"
+
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define NS3_IP_CHECKSUM_AVX2
+#include <immintrin.h>
+#endif
+
+namespace ns3
+{
+
+namespace
+{
+
+/**
+ * \param sum a sum of 16-bit words
+ * \returns the sum folded to 16 bits
+ */
+uint16_t
+Fold(uint64_t sum)
+{
+    while (sum >> 16)
+    {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    return sum;
+}
+
+/**
+ * Add the 32-bit words of a buffer, then its last 16-bit word and odd byte.
+ *
+ * Since 2^16 = 1 modulo 2^16 - 1, the sum of the 32-bit words is equal to
+ * the one's complement sum of their 16-bit halves once folded.
+ *
+ * \param data the buffer
+ * \param length the length of the buffer
+ * \returns the sum of the words, in host order
+ */
+uint64_t
+SumScalar(const uint8_t* data, uint32_t length)
+{
+    uint64_t sum = 0;
+    uint32_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        uint32_t word[2];
+        std::memcpy(word, data + i, 8);
+        sum += word[0];
+        sum += word[1];
+    }
+    for (; i + 2 <= length; i += 2)
+    {
+        uint16_t word;
+        std::memcpy(&word, data + i, 2);
+        sum += word;
+    }
+    if (i < length)
+    {
+        // the odd byte is the first byte of a word padded with zero
+        sum += std::endian::native == std::endian::little ? data[i] : data[i] << 8;
+    }
+    return sum;
+}
+
+#ifdef NS3_IP_CHECKSUM_AVX2
+/**
+ * Add the 32-bit words of a buffer, 32 bytes at a time, in four 64-bit lanes.
+ *
+ * \param data the buffer
+ * \param length the length of the buffer
+ * \returns the sum of the words
+ */
+__attribute__((target("avx2"))) uint64_t
+SumAvx2(const uint8_t* data, uint32_t length)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = zero;
+    uint32_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        acc = _mm256_add_epi64(acc, _mm256_unpacklo_epi32(v, zero));
+        acc = _mm256_add_epi64(acc, _mm256_unpackhi_epi32(v, zero));
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + SumScalar(data + i, length - i);
+}
+
+/**
+ * \returns true if the processor supports AVX2
+ */
+bool
+HasAvx2()
+{
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    return hasAvx2;
+}
+#endif
+
+} // namespace
+
+uint16_t
+OnesComplementSum(const uint8_t* data, uint32_t length)
+{
+    uint64_t sum;
+#ifdef NS3_IP_CHECKSUM_AVX2
+    if (length >= 64 && HasAvx2())
+    {
+        sum = SumAvx2(data, length);
+    }
+    else
+#endif
+    {
+        sum = SumScalar(data, length);
+    }
+    uint16_t folded = Fold(sum);
+    if constexpr (std::endian::native == std::endian::big)
+    {
+        // the words were read with their first byte as most significant one
+        folded = (folded >> 8) | (folded << 8);
+    }
+    return folded;
+}
+
+std::string
+GetOnesComplementSumImplementation()
+{
+#ifdef NS3_IP_CHECKSUM_AVX2
+    if (HasAvx2())
+    {
+        return "avx2";
+    }
+#endif
+    return "scalar";
+}
+
+} // namespace ns3
@@ -0,0 +1,37 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef IP_CHECKSUM_H
+#define IP_CHECKSUM_H
+
+#include <stdint.h>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * Calculates the one's complement sum of the 16-bit words of a buffer, on
+ * which the Internet checksum is based (RFC 1071).
+ *
+ * The words are read in the order of Buffer::Iterator::ReadU16, the first
+ * byte being the least significant one, and a trailing odd byte is the least
+ * significant byte of the last word.  The sum is computed with AVX2 when the
+ * processor supports it, and 32 bits at a time otherwise.
+ *
+ * \param data buffer to calculate the sum for
+ * \param length the length of the buffer (bytes)
+ * \returns the sum, folded to 16 bits; 0 only if all the bytes are 0.
+ */
+uint16_t OnesComplementSum(const uint8_t* data, uint32_t length);
+
+/**
+ * \returns the name of the implementation used by OnesComplementSum:
+ * "avx2" or "scalar".
+ */
+std::string GetOnesComplementSumImplementation();
+
+} // namespace ns3
+
+#endif /* IP_CHECKSUM_H */
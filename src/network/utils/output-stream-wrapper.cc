@@ -39,6 +39,16 @@ OutputStreamWrapper::OutputStreamWrapper(std::ostream* os)
     NS_ABORT_MSG_UNLESS(m_ostream->good(), "Output stream is not valid for writing.");
 }
 
+OutputStreamWrapper::OutputStreamWrapper(Ptr<BinaryTraceWriter> trace)
+    : m_ostream(trace->GetTextStream()),
+      m_destroyable(false),
+      m_binaryTrace(trace)
+{
+    NS_LOG_FUNCTION(this << trace);
+    FatalImpl::RegisterStream(m_ostream);
+    NS_ABORT_MSG_IF(trace->Fail(), "Binary trace is not valid for writing.");
+}
+
 OutputStreamWrapper::~OutputStreamWrapper()
 {
     NS_LOG_FUNCTION(this);
@@ -57,4 +67,11 @@ OutputStreamWrapper::GetStream()
     return m_ostream;
 }
 
+Ptr<BinaryTraceWriter>
+OutputStreamWrapper::GetBinaryTrace() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_binaryTrace;
+}
+
 } // namespace ns3
@@ -7,6 +7,8 @@
 #ifndef OUTPUT_STREAM_WRAPPER_H
 #define OUTPUT_STREAM_WRAPPER_H
 
+#include "binary-trace.h"
+
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
@@ -71,6 +73,16 @@ class OutputStreamWrapper : public SimpleRefCount<OutputStreamWrapper>
      * \param os output stream
      */
     OutputStreamWrapper(std::ostream* os);
+    /**
+     * Constructor
+     *
+     * The default ascii trace sinks write their packet events to the binary
+     * trace, and the text written to GetStream() is written to the binary
+     * trace as lines of text.
+     *
+     * \param trace binary trace
+     */
+    OutputStreamWrapper(Ptr<BinaryTraceWriter> trace);
     ~OutputStreamWrapper();
 
     /**
@@ -82,9 +94,15 @@ class OutputStreamWrapper : public SimpleRefCount<OutputStreamWrapper>
      */
     std::ostream* GetStream();
 
+    /**
+     * \returns the binary trace to which the stream writes, if any
+     */
+    Ptr<BinaryTraceWriter> GetBinaryTrace() const;
+
   private:
-    std::ostream* m_ostream; //!< The output stream
-    bool m_destroyable;      //!< Can be destroyed
+    std::ostream* m_ostream;              //!< The output stream
+    bool m_destroyable;                   //!< Can be destroyed
+    Ptr<BinaryTraceWriter> m_binaryTrace; //!< The binary trace, if any
 };
 
 } // namespace ns3
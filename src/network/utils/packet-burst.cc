@@ -66,6 +66,19 @@ PacketBurst::Copy() const
     return burst;
 }
 
+Ptr<PacketBurst>
+PacketBurst::DeepCopy() const
+{
+    NS_LOG_FUNCTION(this);
+    Ptr<PacketBurst> burst = Create<PacketBurst>();
+
+    for (const auto& packet : m_packets)
+    {
+        burst->AddPacket(packet->DeepCopy());
+    }
+    return burst;
+}
+
 void
 PacketBurst::AddPacket(Ptr<Packet> packet)
 {
@@ -36,6 +36,11 @@ class PacketBurst : public Object
      * \return a copy the packetBurst
      */
     Ptr<PacketBurst> Copy() const;
+    /**
+     * \return a copy the packetBurst made of deep copies of its packets
+     * \see Packet::DeepCopy
+     */
+    Ptr<PacketBurst> DeepCopy() const;
     /**
      * \brief add a packet to the list of packet
      * \param packet the packet to add
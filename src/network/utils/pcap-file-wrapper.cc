@@ -10,8 +10,11 @@
 #include "ns3/buffer.h"
 #include "ns3/header.h"
 #include "ns3/log.h"
+#include "ns3/string.h"
 #include "ns3/uinteger.h"
 
+#include <map>
+
 namespace ns3
 {
 
@@ -19,6 +22,44 @@ NS_LOG_COMPONENT_DEFINE("PcapFileWrapper");
 
 NS_OBJECT_ENSURE_REGISTERED(PcapFileWrapper);
 
+namespace
+{
+
+/**
+ * \returns The open pcapng files shared by the PcapFileWrapper objects, by name.
+ */
+std::map<std::string, Ptr<PcapNgFile>>&
+GetPcapNgFiles()
+{
+    static std::map<std::string, Ptr<PcapNgFile>> files;
+    return files;
+}
+
+/**
+ * \param filename The name of the pcapng file.
+ * \param index The index of the file.
+ * \param n The number of files.
+ * \returns The name of a file, when the interfaces are spread over several files.
+ */
+std::string
+GetPcapNgFilename(const std::string& filename, uint32_t index, uint32_t n)
+{
+    if (n == 1)
+    {
+        return filename;
+    }
+    std::string extension = ".pcapng";
+    if (filename.size() > extension.size() &&
+        filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0)
+    {
+        return filename.substr(0, filename.size() - extension.size()) + "-" +
+               std::to_string(index) + extension;
+    }
+    return filename + "-" + std::to_string(index);
+}
+
+} // namespace
+
 TypeId
 PcapFileWrapper::GetTypeId()
 {
@@ -37,11 +78,50 @@ PcapFileWrapper::GetTypeId()
                           "microseconds(default).",
                           BooleanValue(false),
                           MakeBooleanAccessor(&PcapFileWrapper::m_nanosecMode),
+                          MakeBooleanChecker())
+            .AddAttribute("BufferSize",
+                          "The number of bytes of packets buffered before being written "
+                          "to the file; 0 writes every packet at once.",
+                          UintegerValue(PcapFile::BUFFER_SIZE_DEFAULT),
+                          MakeUintegerAccessor(&PcapFileWrapper::m_bufferSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("AsyncWrite",
+                          "Whether the buffered packets are written to the file, and "
+                          "compressed, by a background thread.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PcapFileWrapper::m_asyncWrite),
+                          MakeBooleanChecker())
+            .AddAttribute("Compress",
+                          "Whether the file is compressed with gzip, in which case "
+                          "\".gz\" is appended to its name.  This requires zlib.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PcapFileWrapper::m_compress),
+                          MakeBooleanChecker())
+            .AddAttribute("PcapNgFile",
+                          "If not empty, the name of the pcapng file to which the packets "
+                          "are written, with those of the other PcapFileWrapper objects "
+                          "sharing this value, instead of the file opened for writing.",
+                          StringValue(""),
+                          MakeStringAccessor(&PcapFileWrapper::m_pcapNgFilename),
+                          MakeStringChecker())
+            .AddAttribute("PcapNgFiles",
+                          "The number of pcapng files over which the interfaces are spread; "
+                          "when greater than one, \"-<index>\" is inserted before the "
+                          "\".pcapng\" extension of PcapNgFile.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&PcapFileWrapper::m_pcapNgFiles),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("PacketUid",
+                          "Whether the uid of each packet is written as a comment in the "
+                          "pcapng file.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PcapFileWrapper::m_packetUid),
                           MakeBooleanChecker());
     return tid;
 }
 
 PcapFileWrapper::PcapFileWrapper()
+    : m_interface(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -56,6 +136,10 @@ bool
 PcapFileWrapper::Fail() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_pcapNg)
+    {
+        return m_pcapNg->Fail();
+    }
     return m_file.Fail();
 }
 
@@ -77,6 +161,18 @@ void
 PcapFileWrapper::Close()
 {
     NS_LOG_FUNCTION(this);
+    if (m_pcapNg)
+    {
+        // close the pcapng file once its last interface is closed
+        std::string filename = m_pcapNg->GetFilename();
+        m_pcapNg = nullptr;
+        auto& files = GetPcapNgFiles();
+        auto it = files.find(filename);
+        if (it != files.end() && it->second->GetReferenceCount() == 1)
+        {
+            files.erase(it);
+        }
+    }
     m_file.Close();
 }
 
@@ -84,7 +180,58 @@ void
 PcapFileWrapper::Open(const std::string& filename, std::ios::openmode mode)
 {
     NS_LOG_FUNCTION(this << filename << mode);
-    m_file.Open(filename, mode);
+    if (!m_pcapNgFilename.empty() && (mode & std::ios::out))
+    {
+        // add the interface to the pcapng file which has the fewest
+        auto& files = GetPcapNgFiles();
+        std::string pcapNgFilename;
+        uint32_t fewest = std::numeric_limits<uint32_t>::max();
+        for (uint32_t i = 0; i < m_pcapNgFiles; ++i)
+        {
+            std::string name = GetPcapNgFilename(m_pcapNgFilename, i, m_pcapNgFiles);
+            auto it = files.find(name);
+            uint32_t nInterfaces = it == files.end() ? 0 : it->second->GetNInterfaces();
+            if (nInterfaces < fewest)
+            {
+                pcapNgFilename = name;
+                fewest = nInterfaces;
+            }
+        }
+        Ptr<PcapNgFile>& file = files[pcapNgFilename];
+        if (!file)
+        {
+            file = Create<PcapNgFile>();
+            file->Open(pcapNgFilename, m_bufferSize, m_packetUid);
+        }
+        m_pcapNg = file;
+
+        std::string::size_type start = filename.find_last_of('/');
+        start = start == std::string::npos ? 0 : start + 1;
+        std::string::size_type end = filename.find_last_of('.');
+        end = end == std::string::npos || end < start ? filename.size() : end;
+        m_interfaceName = filename.substr(start, end - start);
+        return;
+    }
+    std::string name = filename;
+    if (m_compress && (mode & std::ios::out) &&
+        (name.size() < 3 || name.compare(name.size() - 3, 3, ".gz") != 0))
+    {
+        name += ".gz";
+    }
+    m_file.SetWriteBuffer(m_bufferSize, m_asyncWrite, m_compress);
+    m_file.Open(name, mode);
+}
+
+void
+PcapFileWrapper::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_pcapNg)
+    {
+        m_pcapNg->Flush();
+        return;
+    }
+    m_file.Flush();
 }
 
 void
@@ -96,6 +243,15 @@ PcapFileWrapper::Init(uint32_t dataLinkType, uint32_t snapLen, int32_t tzCorrect
     // a snaplen, we use the one provided.
     //
     NS_LOG_FUNCTION(this << dataLinkType << snapLen << tzCorrection);
+    if (m_pcapNg)
+    {
+        if (snapLen == std::numeric_limits<uint32_t>::max())
+        {
+            snapLen = m_snapLen;
+        }
+        m_interface = m_pcapNg->AddInterface(m_interfaceName, dataLinkType, snapLen);
+        return;
+    }
     if (snapLen != std::numeric_limits<uint32_t>::max())
     {
         m_file.Init(dataLinkType, snapLen, tzCorrection, false, m_nanosecMode);
@@ -110,6 +266,11 @@ void
 PcapFileWrapper::Write(Time t, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << t << p);
+    if (m_pcapNg)
+    {
+        m_pcapNg->Write(m_interface, t, p);
+        return;
+    }
     if (m_file.IsNanoSecMode())
     {
         uint64_t current = t.GetNanoSeconds();
@@ -130,6 +291,11 @@ void
 PcapFileWrapper::Write(Time t, const Header& header, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << t << &header << p);
+    if (m_pcapNg)
+    {
+        m_pcapNg->Write(m_interface, t, header, p);
+        return;
+    }
     if (m_file.IsNanoSecMode())
     {
         uint64_t current = t.GetNanoSeconds();
@@ -150,6 +316,11 @@ void
 PcapFileWrapper::Write(Time t, const uint8_t* buffer, uint32_t length)
 {
     NS_LOG_FUNCTION(this << t << &buffer << length);
+    if (m_pcapNg)
+    {
+        m_pcapNg->Write(m_interface, t, buffer, length);
+        return;
+    }
     if (m_file.IsNanoSecMode())
     {
         uint64_t current = t.GetNanoSeconds();
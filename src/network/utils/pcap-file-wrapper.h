@@ -8,6 +8,7 @@
 #define PCAP_FILE_WRAPPER_H
 
 #include "pcap-file.h"
+#include "pcapng-file.h"
 
 #include "ns3/nstime.h"
 #include "ns3/object.h"
@@ -26,6 +27,14 @@ namespace ns3
  * ns-3 interface to the low-level public methods of PcapFile.  Users are
  * encouraged to use this object instead of class ns3::PcapFile in ns-3
  * public APIs.
+ *
+ * If the PcapNgFile attribute is set, the files opened for writing are not
+ * created: their packets are written, with those of the other wrappers
+ * sharing the attribute value, to a single pcapng file, or to the number of
+ * pcapng files given by the PcapNgFiles attribute.  Each wrapper is described
+ * in the pcapng file as an interface named after the file it was asked to
+ * open, without its directory and extension.  This keeps the number of open
+ * files constant when many devices are traced.
  */
 class PcapFileWrapper : public Object
 {
@@ -60,6 +69,13 @@ class PcapFileWrapper : public Object
      * selected as a binary file (fstream::binary is automatically ored with the mode
      * field).
      *
+     * If the Compress attribute is true and the file is opened for writing,
+     * ".gz" is appended to the file name if it does not already end with it,
+     * and the file is compressed in the gzip format.
+     *
+     * If the PcapNgFile attribute is set and the file is opened for writing,
+     * the packets are written to a shared pcapng file instead; see PcapFileWrapper.
+     *
      * \param filename String containing the name of the file.
      *
      * \param mode String containing the access mode for the file.
@@ -72,6 +88,11 @@ class PcapFileWrapper : public Object
      */
     void Close();
 
+    /**
+     * Write the packets buffered so far to the underlying pcap file.
+     */
+    void Flush();
+
     /**
      * Initialize the pcap file associated with this wrapper.  This file must have
      * been previously opened with write permissions.
@@ -211,9 +232,18 @@ class PcapFileWrapper : public Object
     uint32_t GetDataLinkType();
 
   private:
-    PcapFile m_file;    //!< Pcap file
-    uint32_t m_snapLen; //!< max length of saved packets
-    bool m_nanosecMode; //!< Timestamps in nanosecond mode
+    PcapFile m_file;              //!< Pcap file
+    uint32_t m_snapLen;           //!< max length of saved packets
+    bool m_nanosecMode;           //!< Timestamps in nanosecond mode
+    uint32_t m_bufferSize;        //!< Size of the write buffer
+    bool m_asyncWrite;            //!< Write the buffers from a background thread
+    bool m_compress;              //!< Compress the file with gzip
+    std::string m_pcapNgFilename; //!< Name of the shared pcapng file, if any
+    uint32_t m_pcapNgFiles;       //!< Number of shared pcapng files
+    bool m_packetUid;             //!< Write the packet uids in the pcapng file
+    Ptr<PcapNgFile> m_pcapNg;     //!< Shared pcapng file, if open
+    std::string m_interfaceName;  //!< Name of the interface in the pcapng file
+    uint32_t m_interface;         //!< Id of the interface in the pcapng file
 };
 
 } // namespace ns3
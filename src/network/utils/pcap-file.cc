@@ -8,17 +8,28 @@
 
 #include "pcap-file.h"
 
+#include "ns3/abort.h"
 #include "ns3/assert.h"
 #include "ns3/buffer.h"
-#include "ns3/build-profile.h"
 #include "ns3/fatal-error.h"
 #include "ns3/fatal-impl.h"
 #include "ns3/header.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <iostream>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
 
 //
 // This file is used as part of the ns-3 test framework, so please refrain from
@@ -40,19 +51,399 @@ const uint32_t NS_SWAPPED_MAGIC = 0x4d3cb2a1; /**< Looks this way if byte swappi
 const uint16_t VERSION_MAJOR = 2; /**< Major version of supported pcap file format */
 const uint16_t VERSION_MINOR = 4; /**< Minor version of supported pcap file format */
 
+/**
+ * \brief Writer of the buffers of a PcapFile to its file stream
+ *
+ * The buffers are written as they are, or compressed in the gzip format.  In
+ * asynchronous mode, they are queued to a background thread, which writes
+ * them and hands them back for reuse.  A single thread, started with the
+ * first asynchronous writer and stopped with the last one, serves all the
+ * files through a single queue, so the buffers of a file are written in
+ * order.  The file stream is not touched by the PcapFile while the thread
+ * has buffers of the file to write.
+ */
+class PcapFile::Writer
+{
+  public:
+    /**
+     * Constructor
+     * \param file the file stream, opened for writing
+     * \param compress whether to compress the data
+     * \param async whether to write the data from a background thread
+     */
+    Writer(std::fstream& file, bool compress, bool async);
+    ~Writer();
+
+    /**
+     * Write a buffer.  In asynchronous mode, the buffer is queued and
+     * replaced by an empty buffer.
+     * \param [in,out] buffer the buffer
+     * \param size the number of bytes to write from the buffer
+     */
+    void Write(std::vector<uint8_t>& buffer, uint32_t size);
+    /**
+     * Wait for the background thread to write the queued buffers of the file.
+     */
+    void Wait();
+    /**
+     * Write the queued buffers, and flush the compressor and the file.
+     */
+    void Flush();
+    /**
+     * Write the queued buffers, stop the background thread, and terminate
+     * the compressed stream.
+     */
+    void Close();
+    /**
+     * \returns true if the file stream failed
+     */
+    bool Fail() const;
+    /**
+     * Clear the failure state.
+     */
+    void Clear();
+
+  private:
+    /// Maximum number of buffers queued to the background thread, by all the files
+    static const std::size_t MAX_QUEUED = 16;
+
+    /**
+     * \brief Buffer queued to the background thread
+     */
+    struct Job
+    {
+        Writer* writer;              //!< writer of the file
+        std::vector<uint8_t> buffer; //!< the buffer
+        uint32_t size;               //!< number of bytes to write from the buffer
+    };
+
+    /**
+     * \brief Background thread shared by the asynchronous writers
+     */
+    struct Thread
+    {
+        std::thread thread;         //!< background thread
+        std::mutex mutex;           //!< protects the queue, and the buffers of the writers
+        std::condition_variable cv; //!< signals the queue
+        std::deque<Job> queue;      //!< buffers to write
+        std::size_t writers{0};     //!< number of open asynchronous writers
+        uint64_t generation{0};     //!< incremented when the thread is started or stopped
+    };
+
+    /**
+     * \returns the state of the background thread
+     */
+    static Thread& GetThread();
+    /**
+     * The background thread.
+     * \param generation the generation of the thread, which stops when it changes
+     */
+    static void Run(uint64_t generation);
+    /**
+     * Write data to the file stream, compressing them if needed.
+     * \param data the data
+     * \param size the number of bytes
+     */
+    void Output(const uint8_t* data, uint32_t size);
+#ifdef HAVE_ZLIB
+    /**
+     * Compress data and write them to the file stream.
+     * \param data the data
+     * \param size the number of bytes
+     * \param flush the zlib flush mode
+     */
+    void Deflate(const uint8_t* data, uint32_t size, int flush);
+
+    z_stream m_stream;                 //!< compressor state
+    std::vector<uint8_t> m_compressed; //!< compressed data
+#endif
+
+    std::fstream& m_file;                     //!< file stream
+    bool m_compress;                          //!< whether to compress the data
+    bool m_async;                             //!< whether the data are written by the thread
+    bool m_closed;                            //!< whether Close() was called
+    std::size_t m_pending;                    //!< number of buffers queued or being written
+    std::vector<std::vector<uint8_t>> m_free; //!< buffers written
+    std::atomic<bool> m_failed;               //!< whether the file stream failed
+};
+
+PcapFile::Writer::Writer(std::fstream& file, bool compress, bool async)
+    : m_file(file),
+      m_compress(compress),
+      m_async(async),
+      m_closed(false),
+      m_pending(0),
+      m_failed(file.fail())
+{
+#ifdef HAVE_ZLIB
+    if (m_compress)
+    {
+        // favor speed, and write a gzip header
+        m_stream.zalloc = Z_NULL;
+        m_stream.zfree = Z_NULL;
+        m_stream.opaque = Z_NULL;
+        int ret = deflateInit2(&m_stream, Z_BEST_SPEED, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+        NS_ABORT_MSG_IF(ret != Z_OK, "PcapFile::Writer(): cannot initialize zlib");
+        m_compressed.resize(BUFFER_SIZE_DEFAULT);
+    }
+#else
+    NS_ABORT_MSG_IF(m_compress, "PcapFile::Writer(): ns-3 was built without zlib");
+#endif
+    if (m_async)
+    {
+        Thread& thread = GetThread();
+        std::unique_lock<std::mutex> lock(thread.mutex);
+        if (thread.writers++ == 0)
+        {
+            // a thread being stopped exits when it sees the new generation
+            thread.thread = std::thread(&Writer::Run, ++thread.generation);
+        }
+    }
+}
+
+PcapFile::Writer::~Writer()
+{
+    Close();
+}
+
+void
+PcapFile::Writer::Write(std::vector<uint8_t>& buffer, uint32_t size)
+{
+    if (!m_async)
+    {
+        Output(buffer.data(), size);
+        return;
+    }
+    Thread& thread = GetThread();
+    std::unique_lock<std::mutex> lock(thread.mutex);
+    thread.cv.wait(lock, [&thread] { return thread.queue.size() < MAX_QUEUED; });
+    thread.queue.push_back({this, std::move(buffer), size});
+    m_pending++;
+    if (m_free.empty())
+    {
+        buffer = std::vector<uint8_t>();
+    }
+    else
+    {
+        buffer = std::move(m_free.back());
+        m_free.pop_back();
+    }
+    thread.cv.notify_all();
+}
+
+PcapFile::Writer::Thread&
+PcapFile::Writer::GetThread()
+{
+    // never destroyed, so that files left open at exit do not stop the program
+    static Thread* thread = new Thread;
+    return *thread;
+}
+
+void
+PcapFile::Writer::Run(uint64_t generation)
+{
+    Thread& thread = GetThread();
+    std::unique_lock<std::mutex> lock(thread.mutex);
+    while (true)
+    {
+        thread.cv.wait(lock, [&thread, generation] {
+            return !thread.queue.empty() || thread.generation != generation;
+        });
+        if (thread.generation != generation)
+        {
+            // the writers which queued buffers to this thread are closed
+            break;
+        }
+        Job job = std::move(thread.queue.front());
+        thread.queue.pop_front();
+        lock.unlock();
+        job.writer->Output(job.buffer.data(), job.size);
+        lock.lock();
+        job.writer->m_pending--;
+        job.writer->m_free.push_back(std::move(job.buffer));
+        thread.cv.notify_all();
+    }
+}
+
+void
+PcapFile::Writer::Wait()
+{
+    if (m_async)
+    {
+        Thread& thread = GetThread();
+        std::unique_lock<std::mutex> lock(thread.mutex);
+        thread.cv.wait(lock, [this] { return m_pending == 0; });
+    }
+}
+
+void
+PcapFile::Writer::Flush()
+{
+    Wait();
+#ifdef HAVE_ZLIB
+    if (m_compress)
+    {
+        Deflate(nullptr, 0, Z_SYNC_FLUSH);
+    }
+#endif
+    m_file.flush();
+    m_failed = m_file.fail();
+}
+
+void
+PcapFile::Writer::Close()
+{
+    if (m_closed)
+    {
+        return;
+    }
+    m_closed = true;
+    if (m_async)
+    {
+        Wait();
+        Thread& thread = GetThread();
+        std::unique_lock<std::mutex> lock(thread.mutex);
+        if (--thread.writers == 0)
+        {
+            // the queue is empty, since every writer waited for its buffers
+            thread.generation++;
+            thread.cv.notify_all();
+            std::thread stopped = std::move(thread.thread);
+            lock.unlock();
+            stopped.join();
+        }
+    }
+#ifdef HAVE_ZLIB
+    if (m_compress)
+    {
+        Deflate(nullptr, 0, Z_FINISH);
+        deflateEnd(&m_stream);
+    }
+#endif
+    m_file.flush();
+    m_failed = m_file.fail();
+}
+
+bool
+PcapFile::Writer::Fail() const
+{
+    return m_failed;
+}
+
+void
+PcapFile::Writer::Clear()
+{
+    Wait();
+    m_file.clear();
+    m_failed = false;
+}
+
+void
+PcapFile::Writer::Output(const uint8_t* data, uint32_t size)
+{
+#ifdef HAVE_ZLIB
+    if (m_compress)
+    {
+        Deflate(data, size, Z_NO_FLUSH);
+        return;
+    }
+#endif
+    m_file.write(reinterpret_cast<const char*>(data), size);
+    if (m_file.fail())
+    {
+        m_failed = true;
+    }
+}
+
+#ifdef HAVE_ZLIB
+void
+PcapFile::Writer::Deflate(const uint8_t* data, uint32_t size, int flush)
+{
+    m_stream.next_in = const_cast<Bytef*>(data);
+    m_stream.avail_in = size;
+    do
+    {
+        m_stream.next_out = m_compressed.data();
+        m_stream.avail_out = m_compressed.size();
+        deflate(&m_stream, flush);
+        m_file.write(reinterpret_cast<const char*>(m_compressed.data()),
+                     m_compressed.size() - m_stream.avail_out);
+    } while (m_stream.avail_out == 0);
+    if (m_file.fail())
+    {
+        m_failed = true;
+    }
+}
+#endif
+
+/**
+ * \brief Stream registered with FatalImpl on behalf of a PcapFile
+ *
+ * Flushing this stream flushes the PcapFile, so that the data staged in its
+ * buffer are written on fatal errors, and that the file stream is only
+ * flushed once the background thread, if any, has written its buffers.
+ */
+class PcapFile::FatalStream : public std::ostream
+{
+  public:
+    /**
+     * Constructor
+     * \param file the PcapFile to flush
+     */
+    FatalStream(PcapFile& file)
+        : std::ostream(&m_buf),
+          m_buf(file)
+    {
+    }
+
+  private:
+    /**
+     * \brief Stream buffer which flushes a PcapFile when synchronized
+     */
+    class FlushBuf : public std::streambuf
+    {
+      public:
+        /**
+         * Constructor
+         * \param file the PcapFile to flush
+         */
+        FlushBuf(PcapFile& file)
+            : m_pcapFile(file)
+        {
+        }
+
+      protected:
+        int sync() override
+        {
+            m_pcapFile.Flush();
+            return 0;
+        }
+
+      private:
+        PcapFile& m_pcapFile; //!< the PcapFile to flush
+    };
+
+    FlushBuf m_buf; //!< the stream buffer
+};
+
 PcapFile::PcapFile()
     : m_file(),
       m_swapMode(false),
-      m_nanosecMode(false)
+      m_nanosecMode(false),
+      m_staged(0),
+      m_bufferSize(BUFFER_SIZE_DEFAULT),
+      m_async(false),
+      m_compress(false),
+      m_fatalStream(std::make_unique<FatalStream>(*this))
 {
     NS_LOG_FUNCTION(this);
-    FatalImpl::RegisterStream(&m_file);
+    FatalImpl::RegisterStream(m_fatalStream.get());
 }
 
 PcapFile::~PcapFile()
 {
     NS_LOG_FUNCTION(this);
-    FatalImpl::UnregisterStream(&m_file);
+    FatalImpl::UnregisterStream(m_fatalStream.get());
     Close();
 }
 
@@ -60,6 +451,10 @@ bool
 PcapFile::Fail() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_writer)
+    {
+        return m_writer->Fail();
+    }
     return m_file.fail();
 }
 
@@ -74,6 +469,10 @@ void
 PcapFile::Clear()
 {
     NS_LOG_FUNCTION(this);
+    if (m_writer)
+    {
+        m_writer->Clear();
+    }
     m_file.clear();
 }
 
@@ -81,9 +480,84 @@ void
 PcapFile::Close()
 {
     NS_LOG_FUNCTION(this);
+    if (m_writer)
+    {
+        FlushBuffer();
+        m_writer->Close();
+        m_writer = nullptr;
+    }
+    m_staged = 0;
     m_file.close();
 }
 
+void
+PcapFile::SetWriteBuffer(uint32_t size, bool async, bool compress)
+{
+    NS_LOG_FUNCTION(this << size << async << compress);
+    NS_ASSERT_MSG(!m_file.is_open(), "The write buffer must be set before opening the file");
+    m_bufferSize = size;
+    m_async = async;
+    m_compress = compress;
+}
+
+void
+PcapFile::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_writer)
+    {
+        FlushBuffer();
+        m_writer->Flush();
+    }
+    else
+    {
+        m_file.flush();
+    }
+}
+
+uint8_t*
+PcapFile::Stage(uint32_t size)
+{
+    NS_LOG_FUNCTION(this << size);
+    if (m_buffer.size() < m_staged + size)
+    {
+        m_buffer.resize(std::max(m_staged + size, m_bufferSize));
+    }
+    uint8_t* data = m_buffer.data() + m_staged;
+    m_staged += size;
+    return data;
+}
+
+void
+PcapFile::EndRecord()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_staged >= m_bufferSize || !m_writer)
+    {
+        FlushBuffer();
+    }
+}
+
+void
+PcapFile::FlushBuffer()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_staged == 0)
+    {
+        return;
+    }
+    if (m_writer)
+    {
+        m_writer->Write(m_buffer, m_staged);
+    }
+    else
+    {
+        // not open for writing
+        m_file.setstate(std::ios::badbit);
+    }
+    m_staged = 0;
+}
+
 uint32_t
 PcapFile::GetMagic()
 {
@@ -200,6 +674,11 @@ PcapFile::WriteFileHeader()
     // If we're initializing the file, we need to write the pcap file header
     // at the start of the file.
     //
+    if (m_writer)
+    {
+        FlushBuffer();
+        m_writer->Wait();
+    }
     m_file.seekp(0, std::ios::beg);
 
     //
@@ -228,13 +707,15 @@ PcapFile::WriteFileHeader()
     // Watch out for memory alignment differences between machines, so write
     // them all individually.
     //
-    m_file.write((const char*)&headerOut->m_magicNumber, sizeof(headerOut->m_magicNumber));
-    m_file.write((const char*)&headerOut->m_versionMajor, sizeof(headerOut->m_versionMajor));
-    m_file.write((const char*)&headerOut->m_versionMinor, sizeof(headerOut->m_versionMinor));
-    m_file.write((const char*)&headerOut->m_zone, sizeof(headerOut->m_zone));
-    m_file.write((const char*)&headerOut->m_sigFigs, sizeof(headerOut->m_sigFigs));
-    m_file.write((const char*)&headerOut->m_snapLen, sizeof(headerOut->m_snapLen));
-    m_file.write((const char*)&headerOut->m_type, sizeof(headerOut->m_type));
+    uint8_t* data = Stage(24);
+    std::memcpy(data, &headerOut->m_magicNumber, 4);
+    std::memcpy(data + 4, &headerOut->m_versionMajor, 2);
+    std::memcpy(data + 6, &headerOut->m_versionMinor, 2);
+    std::memcpy(data + 8, &headerOut->m_zone, 4);
+    std::memcpy(data + 12, &headerOut->m_sigFigs, 4);
+    std::memcpy(data + 16, &headerOut->m_snapLen, 4);
+    std::memcpy(data + 20, &headerOut->m_type, 4);
+    EndRecord();
 }
 
 void
@@ -329,6 +810,15 @@ PcapFile::Open(const std::string& filename, std::ios::openmode mode)
 
     m_filename = filename;
     m_file.open(filename, mode);
+    if (mode & std::ios::out)
+    {
+#ifndef HAVE_ZLIB
+        NS_ABORT_MSG_IF(m_compress,
+                        "PcapFile::Open(): cannot compress " << filename
+                                                             << ", ns-3 was built without zlib");
+#endif
+        m_writer = std::make_unique<Writer>(m_file, m_compress, m_async);
+    }
     if (mode & std::ios::in)
     {
         // will set the fail bit if file header is invalid.
@@ -402,7 +892,7 @@ uint32_t
 PcapFile::WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << totalLen);
-    NS_ASSERT(m_file.good());
+    NS_ASSERT(m_writer ? !m_writer->Fail() : m_file.good());
 
     uint32_t inclLen = totalLen > m_fileHeader.m_snapLen ? m_fileHeader.m_snapLen : totalLen;
 
@@ -421,11 +911,11 @@ PcapFile::WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
     // Watch out for memory alignment differences between machines, so write
     // them all individually.
     //
-    m_file.write((const char*)&header.m_tsSec, sizeof(header.m_tsSec));
-    m_file.write((const char*)&header.m_tsUsec, sizeof(header.m_tsUsec));
-    m_file.write((const char*)&header.m_inclLen, sizeof(header.m_inclLen));
-    m_file.write((const char*)&header.m_origLen, sizeof(header.m_origLen));
-    NS_BUILD_DEBUG(m_file.flush());
+    uint8_t* data = Stage(16);
+    std::memcpy(data, &header.m_tsSec, 4);
+    std::memcpy(data + 4, &header.m_tsUsec, 4);
+    std::memcpy(data + 8, &header.m_inclLen, 4);
+    std::memcpy(data + 12, &header.m_origLen, 4);
     return inclLen;
 }
 
@@ -434,8 +924,8 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, const uint8_t* const data, uint
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << &data << totalLen);
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, totalLen);
-    m_file.write((const char*)data, inclLen);
-    NS_BUILD_DEBUG(m_file.flush());
+    std::memcpy(Stage(inclLen), data, inclLen);
+    EndRecord();
 }
 
 void
@@ -443,8 +933,9 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << p);
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, p->GetSize());
-    p->CopyData(&m_file, inclLen);
-    NS_BUILD_DEBUG(m_file.flush());
+    // only the captured bytes are copied
+    p->CopyData(Stage(inclLen), inclLen);
+    EndRecord();
 }
 
 void
@@ -455,13 +946,14 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, const Header& header, Ptr<const
     uint32_t totalSize = headerSize + p->GetSize();
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, totalSize);
 
+    uint8_t* data = Stage(inclLen);
     Buffer headerBuffer;
     headerBuffer.AddAtStart(headerSize);
     header.Serialize(headerBuffer.Begin());
     uint32_t toCopy = std::min(headerSize, inclLen);
-    headerBuffer.CopyData(&m_file, toCopy);
-    inclLen -= toCopy;
-    p->CopyData(&m_file, inclLen);
+    headerBuffer.CopyData(data, toCopy);
+    p->CopyData(data + toCopy, inclLen - toCopy);
+    EndRecord();
 }
 
 void
@@ -474,6 +966,12 @@ PcapFile::Read(uint8_t* const data,
                uint32_t& readLen)
 {
     NS_LOG_FUNCTION(this << &data << maxBytes << tsSec << tsUsec << inclLen << origLen << readLen);
+    if (m_writer)
+    {
+        // read what was written
+        FlushBuffer();
+        m_writer->Wait();
+    }
     NS_ASSERT(m_file.good());
 
     PcapRecordHeader header;
@@ -12,8 +12,10 @@
 #include "ns3/ptr.h"
 
 #include <fstream>
+#include <memory>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -27,6 +29,13 @@ class Header;
  * A class representing a pcap file.  This allows easy creation, writing and
  * reading of files composed of stored packets; which may be viewed using
  * standard tools.
+ *
+ * The file header and packet records written to the file are staged in a
+ * memory buffer, which is written to the file once it is full, and when the
+ * file is flushed or closed.  The full buffers can be written from a
+ * background thread, and compressed in the gzip format; see SetWriteBuffer().
+ * The staged data are also written on fatal errors, when FatalImpl flushes
+ * the registered streams.
  */
 class PcapFile
 {
@@ -34,6 +43,8 @@ class PcapFile
     static const int32_t ZONE_DEFAULT = 0; //!< Time zone offset for current location
     static const uint32_t SNAPLEN_DEFAULT =
         65535; //!< Default value for maximum octets to save per packet
+    static const uint32_t BUFFER_SIZE_DEFAULT =
+        65536; //!< Default size of the buffer in which the written data are staged
 
   public:
     PcapFile();
@@ -41,6 +52,9 @@ class PcapFile
 
     /**
      * \return true if the 'fail' bit is set in the underlying iostream, false otherwise.
+     *
+     * When the buffers are written from a background thread, a write error is
+     * reported once the thread has hit it.
      */
     bool Fail() const;
     /**
@@ -71,10 +85,36 @@ class PcapFile
     void Open(const std::string& filename, std::ios::openmode mode);
 
     /**
-     * Close the underlying file.
+     * Close the underlying file, after writing the data staged in the buffer.
      */
     void Close();
 
+    /**
+     * Set how the data written to the file are buffered.  This must be called
+     * before the file is opened.
+     *
+     * The data are staged in a buffer which is written to the file when it
+     * holds at least \p size bytes.  If \p async is true, the full buffers are
+     * handed to a background thread which writes them, compressing them if
+     * needed, while the next packets are staged in another buffer.  A single
+     * thread serves all the files opened in this mode.
+     *
+     * If \p compress is true, the file is compressed in the gzip format,
+     * whatever its name.  This requires ns-3 to be built with zlib, and such
+     * a file cannot be read back by PcapFile.
+     *
+     * \param size The size of the buffer; 0 to write every packet at once.
+     * \param async Whether to write the buffers from a background thread.
+     * \param compress Whether to compress the file.
+     */
+    void SetWriteBuffer(uint32_t size, bool async, bool compress = false);
+
+    /**
+     * Write the data staged in the buffer, wait for the background thread, if
+     * any, to write them, and flush the underlying file.
+     */
+    void Flush();
+
     /**
      * Initialize the pcap file associated with this object.  This file must have
      * been previously opened with write permissions.
@@ -282,6 +322,9 @@ class PcapFile
                      uint32_t snapLen = SNAPLEN_DEFAULT);
 
   private:
+    class Writer;
+    class FatalStream;
+
     /**
      * \brief Pcap file header
      */
@@ -362,11 +405,33 @@ class PcapFile
      */
     void ReadAndVerifyFileHeader();
 
-    std::string m_filename;      //!< file name
-    std::fstream m_file;         //!< file stream
-    PcapFileHeader m_fileHeader; //!< file header
-    bool m_swapMode;             //!< swap mode
-    bool m_nanosecMode;          //!< nanosecond timestamp mode
+    /**
+     * \brief Reserve room at the end of the staging buffer
+     * \param size the number of bytes to reserve
+     * \returns the start of the reserved bytes
+     */
+    uint8_t* Stage(uint32_t size);
+    /**
+     * \brief Write the staging buffer to the file if it is full
+     */
+    void EndRecord();
+    /**
+     * \brief Hand the staging buffer to the writer
+     */
+    void FlushBuffer();
+
+    std::string m_filename;                     //!< file name
+    std::fstream m_file;                        //!< file stream
+    PcapFileHeader m_fileHeader;                //!< file header
+    bool m_swapMode;                            //!< swap mode
+    bool m_nanosecMode;                         //!< nanosecond timestamp mode
+    std::vector<uint8_t> m_buffer;              //!< buffer in which the written data are staged
+    uint32_t m_staged;                          //!< number of bytes staged in the buffer
+    uint32_t m_bufferSize;                      //!< size from which the buffer is written
+    bool m_async;                               //!< whether the buffers are written by a thread
+    bool m_compress;                            //!< whether the file is compressed
+    std::unique_ptr<Writer> m_writer;           //!< writer of the buffers, if open for writing
+    std::unique_ptr<FatalStream> m_fatalStream; //!< stream flushed on fatal errors
 };
 
 } // namespace ns3
@@ -0,0 +1,293 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "pcapng-file.h"
+
+#include "ns3/assert.h"
+#include "ns3/buffer.h"
+#include "ns3/fatal-impl.h"
+#include "ns3/header.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PcapNgFile");
+
+namespace
+{
+
+const uint16_t OPT_ENDOFOPT = 0;     //!< End of the options
+const uint16_t OPT_COMMENT = 1;      //!< Comment option
+const uint16_t SHB_USERAPPL = 4;     //!< Name of the application which wrote the section
+const uint16_t IF_NAME = 2;          //!< Name of an interface
+const uint16_t IF_TSRESOL = 9;       //!< Timestamp resolution of an interface
+const uint8_t TSRESOL_NANOSEC = 9;   //!< Timestamps in units of 10^-9 s
+const char USER_APPLICATION[] = "ns-3"; //!< Value of the shb_userappl option
+
+/**
+ * \param length a length in bytes
+ * \returns the length padded to 32 bits
+ */
+uint32_t
+Pad(uint32_t length)
+{
+    return (length + 3) & ~3U;
+}
+
+/**
+ * \param length the length of an option value
+ * \returns the size of the option
+ */
+uint32_t
+OptionSize(uint32_t length)
+{
+    return 4 + Pad(length);
+}
+
+} // namespace
+
+PcapNgFile::PcapNgFile()
+    : m_staged(0),
+      m_bufferSize(0),
+      m_packetUid(false)
+{
+    NS_LOG_FUNCTION(this);
+    FatalImpl::RegisterStream(&m_file);
+}
+
+PcapNgFile::~PcapNgFile()
+{
+    NS_LOG_FUNCTION(this);
+    FatalImpl::UnregisterStream(&m_file);
+    Close();
+}
+
+bool
+PcapNgFile::Fail() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_file.fail();
+}
+
+void
+PcapNgFile::Open(const std::string& filename, uint32_t bufferSize, bool packetUid)
+{
+    NS_LOG_FUNCTION(this << filename << bufferSize << packetUid);
+    m_filename = filename;
+    m_bufferSize = bufferSize;
+    m_packetUid = packetUid;
+    m_snapLens.clear();
+    m_file.open(filename, std::ios::out | std::ios::binary);
+
+    uint32_t bodyLen = 16 + OptionSize(sizeof(USER_APPLICATION) - 1) + OptionSize(0);
+    uint8_t* data = StartBlock(SECTION_HEADER_BLOCK, bodyLen);
+    uint32_t magic = BYTE_ORDER_MAGIC;
+    uint16_t majorVersion = 1;
+    uint16_t minorVersion = 0;
+    int64_t sectionLength = -1; // unknown
+    std::memcpy(data, &magic, 4);
+    std::memcpy(data + 4, &majorVersion, 2);
+    std::memcpy(data + 6, &minorVersion, 2);
+    std::memcpy(data + 8, &sectionLength, 8);
+    data = WriteOption(data + 16, SHB_USERAPPL, USER_APPLICATION, sizeof(USER_APPLICATION) - 1);
+    WriteOption(data, OPT_ENDOFOPT, nullptr, 0);
+    EndBlock();
+}
+
+void
+PcapNgFile::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_file.is_open())
+    {
+        FlushBuffer();
+        m_file.close();
+    }
+    m_staged = 0;
+}
+
+void
+PcapNgFile::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    FlushBuffer();
+    m_file.flush();
+}
+
+std::string
+PcapNgFile::GetFilename() const
+{
+    return m_filename;
+}
+
+uint32_t
+PcapNgFile::AddInterface(const std::string& name, uint16_t dataLinkType, uint32_t snapLen)
+{
+    NS_LOG_FUNCTION(this << name << dataLinkType << snapLen);
+    NS_ASSERT_MSG(name.size() < 0xffff, "Interface name too long: " << name);
+
+    uint32_t bodyLen = 8 + OptionSize(name.size()) + OptionSize(1) + OptionSize(0);
+    uint8_t* data = StartBlock(INTERFACE_DESCRIPTION_BLOCK, bodyLen);
+    uint16_t reserved = 0;
+    std::memcpy(data, &dataLinkType, 2);
+    std::memcpy(data + 2, &reserved, 2);
+    std::memcpy(data + 4, &snapLen, 4);
+    data = WriteOption(data + 8, IF_NAME, name.data(), name.size());
+    data = WriteOption(data, IF_TSRESOL, &TSRESOL_NANOSEC, 1);
+    WriteOption(data, OPT_ENDOFOPT, nullptr, 0);
+    EndBlock();
+
+    m_snapLens.push_back(snapLen);
+    return m_snapLens.size() - 1;
+}
+
+uint32_t
+PcapNgFile::GetNInterfaces() const
+{
+    return m_snapLens.size();
+}
+
+uint8_t*
+PcapNgFile::StartBlock(uint32_t type, uint32_t bodyLen)
+{
+    NS_LOG_FUNCTION(this << type << bodyLen);
+    NS_ASSERT(bodyLen % 4 == 0);
+    // block type and length, body, and length again
+    uint32_t totalLen = 12 + bodyLen;
+    if (m_buffer.size() < m_staged + totalLen)
+    {
+        m_buffer.resize(std::max(m_staged + totalLen, m_bufferSize));
+    }
+    uint8_t* block = m_buffer.data() + m_staged;
+    m_staged += totalLen;
+    std::memcpy(block, &type, 4);
+    std::memcpy(block + 4, &totalLen, 4);
+    std::memcpy(block + 8 + bodyLen, &totalLen, 4);
+    return block + 8;
+}
+
+void
+PcapNgFile::EndBlock()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_staged >= m_bufferSize)
+    {
+        FlushBuffer();
+    }
+}
+
+uint8_t*
+PcapNgFile::WriteOption(uint8_t* data, uint16_t code, const void* value, uint16_t length)
+{
+    std::memcpy(data, &code, 2);
+    std::memcpy(data + 2, &length, 2);
+    if (length > 0)
+    {
+        std::memcpy(data + 4, value, length);
+    }
+    std::memset(data + 4 + length, 0, Pad(length) - length);
+    return data + OptionSize(length);
+}
+
+uint8_t*
+PcapNgFile::StartPacket(uint32_t interface,
+                        Time t,
+                        uint32_t totalLen,
+                        std::optional<uint64_t> uid,
+                        uint32_t& inclLen)
+{
+    NS_LOG_FUNCTION(this << interface << t << totalLen << uid.value_or(0));
+    NS_ASSERT_MSG(interface < m_snapLens.size(), "Unknown interface " << interface);
+
+    inclLen = std::min(totalLen, m_snapLens[interface]);
+    std::string comment;
+    uint32_t optionsLen = 0;
+    // no comment for the buffers that do not come from a packet
+    bool writeUid = m_packetUid && uid.has_value();
+    if (writeUid)
+    {
+        comment = "uid " + std::to_string(*uid);
+        optionsLen = OptionSize(comment.size()) + OptionSize(0);
+    }
+
+    uint8_t* data = StartBlock(ENHANCED_PACKET_BLOCK, 20 + Pad(inclLen) + optionsLen);
+    uint64_t timestamp = t.GetNanoSeconds();
+    uint32_t timestampHigh = timestamp >> 32;
+    uint32_t timestampLow = timestamp & 0xffffffff;
+    std::memcpy(data, &interface, 4);
+    std::memcpy(data + 4, &timestampHigh, 4);
+    std::memcpy(data + 8, &timestampLow, 4);
+    std::memcpy(data + 12, &inclLen, 4);
+    std::memcpy(data + 16, &totalLen, 4);
+    std::memset(data + 20 + inclLen, 0, Pad(inclLen) - inclLen);
+    if (writeUid)
+    {
+        uint8_t* options = data + 20 + Pad(inclLen);
+        options = WriteOption(options, OPT_COMMENT, comment.data(), comment.size());
+        WriteOption(options, OPT_ENDOFOPT, nullptr, 0);
+    }
+    return data + 20;
+}
+
+void
+PcapNgFile::Write(uint32_t interface,
+                  Time t,
+                  const uint8_t* data,
+                  uint32_t totalLen,
+                  std::optional<uint64_t> uid)
+{
+    NS_LOG_FUNCTION(this << interface << t << &data << totalLen << uid.value_or(0));
+    uint32_t inclLen;
+    uint8_t* packetData = StartPacket(interface, t, totalLen, uid, inclLen);
+    std::memcpy(packetData, data, inclLen);
+    EndBlock();
+}
+
+void
+PcapNgFile::Write(uint32_t interface, Time t, Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(this << interface << t << p);
+    uint32_t inclLen;
+    uint8_t* data = StartPacket(interface, t, p->GetSize(), p->GetUid(), inclLen);
+    // only the captured bytes are copied
+    p->CopyData(data, inclLen);
+    EndBlock();
+}
+
+void
+PcapNgFile::Write(uint32_t interface, Time t, const Header& header, Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(this << interface << t << &header << p);
+    uint32_t headerSize = header.GetSerializedSize();
+    uint32_t inclLen;
+    uint8_t* data =
+        StartPacket(interface, t, headerSize + p->GetSize(), p->GetUid(), inclLen);
+
+    Buffer headerBuffer;
+    headerBuffer.AddAtStart(headerSize);
+    header.Serialize(headerBuffer.Begin());
+    uint32_t toCopy = std::min(headerSize, inclLen);
+    headerBuffer.CopyData(data, toCopy);
+    p->CopyData(data + toCopy, inclLen - toCopy);
+    EndBlock();
+}
+
+void
+PcapNgFile::FlushBuffer()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_staged == 0)
+    {
+        return;
+    }
+    m_file.write(reinterpret_cast<const char*>(m_buffer.data()), m_staged);
+    m_staged = 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,192 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PCAPNG_FILE_H
+#define PCAPNG_FILE_H
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <fstream>
+#include <optional>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+class Packet;
+class Header;
+
+/**
+ * \brief A pcapng file, in which several interfaces write their packets.
+ *
+ * Each interface is described by an Interface Description Block, which
+ * gives its name, data link type and snapshot length, and its packets are
+ * written in Enhanced Packet Blocks with nanosecond timestamps, and
+ * optionally a comment giving the ns-3 packet uid.  The file is only
+ * written, in the native byte order, through a memory buffer.
+ *
+ * A PcapNgFile is shared by the PcapFileWrapper objects writing to it; see
+ * the PcapNgFile attribute of PcapFileWrapper.
+ *
+ * See https://wiki.wireshark.org/Development/PcapNg
+ */
+class PcapNgFile : public SimpleRefCount<PcapNgFile>
+{
+  public:
+    PcapNgFile();
+    ~PcapNgFile();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    PcapNgFile(const PcapNgFile&) = delete;
+    PcapNgFile& operator=(const PcapNgFile&) = delete;
+
+    /**
+     * \return true if the 'fail' bit is set in the underlying file stream, false otherwise.
+     */
+    bool Fail() const;
+
+    /**
+     * Create the file, and write its Section Header Block.
+     *
+     * \param filename The name of the file.
+     * \param bufferSize The number of bytes buffered before being written to
+     *        the file; 0 to write every block at once.
+     * \param packetUid Whether to add a comment with the uid of the packets.
+     */
+    void Open(const std::string& filename, uint32_t bufferSize, bool packetUid);
+
+    /**
+     * Write the buffered blocks and close the file.
+     */
+    void Close();
+
+    /**
+     * Write the buffered blocks and flush the file.
+     */
+    void Flush();
+
+    /**
+     * \returns The name of the file.
+     */
+    std::string GetFilename() const;
+
+    /**
+     * Describe a new interface.
+     *
+     * \param name The name of the interface.
+     * \param dataLinkType The data link type of the interface, see
+     *        PcapHelper::DataLinkType.
+     * \param snapLen The maximum number of bytes saved per packet.
+     * \returns The id of the interface in the file.
+     */
+    uint32_t AddInterface(const std::string& name, uint16_t dataLinkType, uint32_t snapLen);
+
+    /**
+     * \returns The number of interfaces in the file.
+     */
+    uint32_t GetNInterfaces() const;
+
+    /**
+     * \brief Write a packet given as a buffer.
+     *
+     * \param interface The id of the interface.
+     * \param t The time of the packet.
+     * \param data The packet data.
+     * \param totalLen The size of the packet.
+     * \param uid The packet uid, if the uids are written and the buffer comes from a packet.
+     */
+    void Write(uint32_t interface,
+               Time t,
+               const uint8_t* data,
+               uint32_t totalLen,
+               std::optional<uint64_t> uid = std::nullopt);
+
+    /**
+     * \brief Write a packet.
+     *
+     * \param interface The id of the interface.
+     * \param t The time of the packet.
+     * \param p The packet.
+     */
+    void Write(uint32_t interface, Time t, Ptr<const Packet> p);
+
+    /**
+     * \brief Write a packet, preceded by a header.
+     *
+     * \param interface The id of the interface.
+     * \param t The time of the packet.
+     * \param header The header.
+     * \param p The packet.
+     */
+    void Write(uint32_t interface, Time t, const Header& header, Ptr<const Packet> p);
+
+    /// Block type of the Section Header Block
+    static const uint32_t SECTION_HEADER_BLOCK = 0x0a0d0d0a;
+    /// Block type of the Interface Description Block
+    static const uint32_t INTERFACE_DESCRIPTION_BLOCK = 0x00000001;
+    /// Block type of the Enhanced Packet Block
+    static const uint32_t ENHANCED_PACKET_BLOCK = 0x00000006;
+    /// Byte order magic of the Section Header Block
+    static const uint32_t BYTE_ORDER_MAGIC = 0x1a2b3c4d;
+
+  private:
+    /**
+     * \brief Reserve room for a block at the end of the buffer, and write
+     * its type and length
+     * \param type the block type
+     * \param bodyLen the length of the block body, a multiple of 4
+     * \returns the start of the block body
+     */
+    uint8_t* StartBlock(uint32_t type, uint32_t bodyLen);
+    /**
+     * \brief Write the buffer to the file if it is full
+     */
+    void EndBlock();
+    /**
+     * \brief Write an option
+     * \param data where to write the option
+     * \param code the option code
+     * \param value the option value
+     * \param length the length of the value
+     * \returns the end of the option
+     */
+    static uint8_t* WriteOption(uint8_t* data,
+                                uint16_t code,
+                                const void* value,
+                                uint16_t length);
+    /**
+     * \brief Start an Enhanced Packet Block
+     * \param interface the id of the interface
+     * \param t the time of the packet
+     * \param totalLen the size of the packet
+     * \param uid the packet uid, if any
+     * \param [out] inclLen the number of bytes of the packet to write
+     * \returns where to write the packet data
+     */
+    uint8_t* StartPacket(uint32_t interface,
+                         Time t,
+                         uint32_t totalLen,
+                         std::optional<uint64_t> uid,
+                         uint32_t& inclLen);
+    /**
+     * \brief Write the buffer to the file
+     */
+    void FlushBuffer();
+
+    std::string m_filename;           //!< file name
+    std::ofstream m_file;             //!< file stream
+    std::vector<uint32_t> m_snapLens; //!< snapshot length of each interface
+    std::vector<uint8_t> m_buffer;    //!< buffer in which the blocks are staged
+    uint32_t m_staged;                //!< number of bytes staged in the buffer
+    uint32_t m_bufferSize;            //!< size from which the buffer is written
+    bool m_packetUid;                 //!< whether the packet uids are written
+};
+
+} // namespace ns3
+
+#endif /* PCAPNG_FILE_H */
@@ -7,7 +7,9 @@
  */
 #include "simple-channel.h"
 
+#include "packet-burst.h"
 #include "simple-net-device.h"
+#include "threaded-simulator-impl.h"
 
 #include "ns3/log.h"
 #include "ns3/node.h"
@@ -66,17 +68,62 @@ SimpleChannel::Send(Ptr<Packet> p,
                 continue;
             }
         }
-        Simulator::ScheduleWithContext(tmp->GetNode()->GetId(),
+        // A packet received by another partition must not share its data
+        // with the packet of the sender
+        uint32_t context = tmp->GetNode()->GetId();
+        Simulator::ScheduleWithContext(context,
                                        m_delay,
                                        &SimpleNetDevice::Receive,
                                        tmp,
-                                       p->Copy(),
+                                       ThreadedSimulatorImpl::IsRemote(context) ? p->DeepCopy()
+                                                                                : p->Copy(),
                                        protocol,
                                        to,
                                        from);
     }
 }
 
+void
+SimpleChannel::SendBurst(Ptr<PacketBurst> burst,
+                         const std::vector<Time>& txEnds,
+                         Ptr<SimpleNetDevice> sender)
+{
+    NS_LOG_FUNCTION(this << burst << sender);
+    NS_ASSERT(burst->GetNPackets() == txEnds.size());
+
+    std::vector<Time> rxTimes;
+    rxTimes.reserve(txEnds.size());
+    for (const auto& txEnd : txEnds)
+    {
+        rxTimes.push_back(txEnd + m_delay);
+    }
+
+    for (auto i = m_devices.begin(); i != m_devices.end(); ++i)
+    {
+        Ptr<SimpleNetDevice> tmp = *i;
+        if (tmp == sender)
+        {
+            continue;
+        }
+        if (m_blackListedDevices.find(tmp) != m_blackListedDevices.end())
+        {
+            if (find(m_blackListedDevices[tmp].begin(), m_blackListedDevices[tmp].end(), sender) !=
+                m_blackListedDevices[tmp].end())
+            {
+                continue;
+            }
+        }
+        uint32_t context = tmp->GetNode()->GetId();
+        Simulator::ScheduleWithContext(context,
+                                       m_delay,
+                                       &SimpleNetDevice::ReceiveBurst,
+                                       tmp,
+                                       ThreadedSimulatorImpl::IsRemote(context) ? burst->DeepCopy()
+                                                                                : burst->Copy(),
+                                       rxTimes);
+    }
+}
+
 void
 SimpleChannel::Add(Ptr<SimpleNetDevice> device)
 {
@@ -21,6 +21,7 @@ namespace ns3
 
 class SimpleNetDevice;
 class Packet;
+class PacketBurst;
 
 /**
  * \ingroup channel
@@ -62,6 +63,23 @@ class SimpleChannel : public Channel
                       Mac48Address from,
                       Ptr<SimpleNetDevice> sender);
 
+    /**
+     * A train of packets is sent by a net device.  A single receive event
+     * will be scheduled for each net device connected to the channel other
+     * than the net device who sent the packets, after the end of the
+     * transmission of the last packet.
+     *
+     * The packets must carry the tag with their protocol number and
+     * addresses added by the SimpleNetDevice.
+     *
+     * \param burst packets to be sent
+     * \param txEnds time at which the transmission of each packet ended
+     * \param sender netdevice who sent the packets
+     */
+    virtual void SendBurst(Ptr<PacketBurst> burst,
+                           const std::vector<Time>& txEnds,
+                           Ptr<SimpleNetDevice> sender);
+
     /**
      * Attached a net device to the channel.
      *
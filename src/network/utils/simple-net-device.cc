@@ -8,6 +8,7 @@
 #include "simple-net-device.h"
 
 #include "error-model.h"
+#include "packet-burst.h"
 #include "queue.h"
 #include "simple-channel.h"
 
@@ -20,6 +21,7 @@
 #include "ns3/string.h"
 #include "ns3/tag.h"
 #include "ns3/trace-source-accessor.h"
+#include "ns3/uinteger.h"
 
 namespace ns3
 {
@@ -202,6 +204,20 @@ SimpleNetDevice::GetTypeId()
                           DataRateValue(DataRate("0b/s")),
                           MakeDataRateAccessor(&SimpleNetDevice::m_bps),
                           MakeDataRateChecker())
+            .AddAttribute("MaxBurstSize",
+                          "The maximum number of packets handed together to SendBurst() "
+                          "which are sent back-to-back as a single train, and received "
+                          "in a single event once the last packet has been transmitted.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&SimpleNetDevice::m_maxBurstSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("MaxBurstDuration",
+                          "The maximum time between the end of the transmission of the "
+                          "first and of the last packet of a train.  No packet of a train "
+                          "is received later than this after its own arrival time.",
+                          TimeValue(MicroSeconds(100)),
+                          MakeTimeAccessor(&SimpleNetDevice::m_maxBurstDuration),
+                          MakeTimeChecker(Time(0)))
             .AddTraceSource("PhyRxDrop",
                             "Trace source indicating a packet has been dropped "
                             "by the device during reception",
@@ -215,7 +231,10 @@ SimpleNetDevice::SimpleNetDevice()
       m_node(nullptr),
       m_mtu(0xffff),
       m_ifIndex(0),
-      m_linkUp(false)
+      m_linkUp(false),
+      m_maxBurstSize(1),
+      m_maxBurstDuration(MicroSeconds(100)),
+      m_burstLeft(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -260,6 +279,26 @@ SimpleNetDevice::Receive(Ptr<Packet> packet, uint16_t protocol, Mac48Address to,
     }
 }
 
+void
+SimpleNetDevice::ReceiveBurst(Ptr<PacketBurst> burst, const std::vector<Time>& rxTimes)
+{
+    NS_LOG_FUNCTION(this << burst);
+    NS_ASSERT(burst->GetNPackets() == rxTimes.size());
+
+    auto rxTime = rxTimes.begin();
+    for (auto i = burst->Begin(); i != burst->End(); ++i, ++rxTime)
+    {
+        Ptr<Packet> packet = *i;
+        NS_ASSERT(*rxTime <= Simulator::Now());
+        NS_LOG_LOGIC("packet " << packet->GetUid() << " arrived at " << rxTime->As(Time::S)
+                               << ", delivered " << (Simulator::Now() - *rxTime).As(Time::S)
+                               << " later");
+        SimpleTag tag;
+        packet->RemovePacketTag(tag);
+        Receive(packet, tag.GetProto(), tag.GetDst(), tag.GetSrc());
+    }
+}
+
 void
 SimpleNetDevice::SetChannel(Ptr<SimpleChannel> channel)
 {
@@ -422,6 +461,56 @@ SimpleNetDevice::SendFrom(Ptr<Packet> p,
                           uint16_t protocolNumber)
 {
     NS_LOG_FUNCTION(this << p << source << dest << protocolNumber);
+
+    if (Enqueue(p, source, dest, protocolNumber))
+    {
+        if (m_queue->GetNPackets() == 1 && !FinishTransmissionEvent.IsPending())
+        {
+            StartTransmission();
+        }
+        return true;
+    }
+
+    return false;
+}
+
+bool
+SimpleNetDevice::SendBurst(Ptr<PacketBurst> burst, const Address& dest, uint16_t protocolNumber)
+{
+    NS_LOG_FUNCTION(this << burst << dest << protocolNumber);
+
+    // Enqueue all the packets first, so that they can be sent as trains
+    bool ret = true;
+    uint32_t enqueued = 0;
+    for (auto i = burst->Begin(); i != burst->End(); ++i)
+    {
+        if (Enqueue(*i, m_address, dest, protocolNumber))
+        {
+            enqueued++;
+        }
+        else
+        {
+            ret = false;
+        }
+    }
+
+    // The queue is empty unless a transmission is in progress, in which case
+    // the packets are sent one by one after the queued ones
+    if (!FinishTransmissionEvent.IsPending())
+    {
+        m_burstLeft = enqueued;
+        StartBurstTransmission();
+    }
+    return ret;
+}
+
+bool
+SimpleNetDevice::Enqueue(Ptr<Packet> p,
+                         const Address& source,
+                         const Address& dest,
+                         uint16_t protocolNumber)
+{
+    NS_LOG_FUNCTION(this << p << source << dest << protocolNumber);
     if (p->GetSize() > GetMtu())
     {
         return false;
@@ -437,16 +526,7 @@ SimpleNetDevice::SendFrom(Ptr<Packet> p,
 
     p->AddPacketTag(tag);
 
-    if (m_queue->Enqueue(p))
-    {
-        if (m_queue->GetNPackets() == 1 && !FinishTransmissionEvent.IsPending())
-        {
-            StartTransmission();
-        }
-        return true;
-    }
-
-    return false;
+    return m_queue->Enqueue(p);
 }
 
 void
@@ -458,6 +538,11 @@ SimpleNetDevice::StartTransmission()
     }
     NS_ASSERT_MSG(!FinishTransmissionEvent.IsPending(),
                   "Tried to transmit a packet while another transmission was in progress");
+    if (m_burstLeft > 0)
+    {
+        StartBurstTransmission();
+        return;
+    }
     Ptr<Packet> packet = m_queue->Dequeue();
 
     /**
@@ -480,6 +565,65 @@ SimpleNetDevice::StartTransmission()
         Simulator::Schedule(txTime, &SimpleNetDevice::FinishTransmission, this, packet);
 }
 
+void
+SimpleNetDevice::StartBurstTransmission()
+{
+    NS_ASSERT_MSG(!FinishTransmissionEvent.IsPending(),
+                  "Tried to transmit a packet while another transmission was in progress");
+
+    /**
+     * Take the packets of the burst at the head of the queue which end their
+     * transmission within MaxBurstDuration of the first one, and hand them to
+     * the channel together once the last one is transmitted.  The next ones
+     * form the next trains.
+     */
+    Ptr<PacketBurst> burst = CreateObject<PacketBurst>();
+    std::vector<Time> txEnds;
+    Time txEnd = Simulator::Now();
+    while (m_burstLeft > 0 && burst->GetNPackets() < m_maxBurstSize)
+    {
+        Ptr<const Packet> next = m_queue->Peek();
+        if (!next)
+        {
+            m_burstLeft = 0;
+            break;
+        }
+        Time end = txEnd;
+        if (m_bps > DataRate(0))
+        {
+            end += m_bps.CalculateBytesTxTime(next->GetSize());
+        }
+        if (!txEnds.empty() && end - txEnds.front() > m_maxBurstDuration)
+        {
+            break;
+        }
+        burst->AddPacket(m_queue->Dequeue());
+        txEnds.push_back(end);
+        txEnd = end;
+        m_burstLeft--;
+    }
+
+    if (burst->GetNPackets() == 0)
+    {
+        return;
+    }
+    if (burst->GetNPackets() == 1)
+    {
+        // a single packet is sent as by StartTransmission()
+        FinishTransmissionEvent = Simulator::Schedule(txEnd - Simulator::Now(),
+                                                      &SimpleNetDevice::FinishTransmission,
+                                                      this,
+                                                      burst->GetPackets().front());
+        return;
+    }
+
+    FinishTransmissionEvent = Simulator::Schedule(txEnd - Simulator::Now(),
+                                                  &SimpleNetDevice::FinishBurstTransmission,
+                                                  this,
+                                                  burst,
+                                                  txEnds);
+}
+
 void
 SimpleNetDevice::FinishTransmission(Ptr<Packet> packet)
 {
@@ -497,6 +641,17 @@ SimpleNetDevice::FinishTransmission(Ptr<Packet> packet)
     StartTransmission();
 }
 
+void
+SimpleNetDevice::FinishBurstTransmission(Ptr<PacketBurst> burst, const std::vector<Time>& txEnds)
+{
+    NS_LOG_FUNCTION(this << burst);
+
+    // the tags are removed by the receivers
+    m_channel->SendBurst(burst, txEnds, this);
+
+    StartTransmission();
+}
+
 Ptr<Node>
 SimpleNetDevice::GetNode() const
 {
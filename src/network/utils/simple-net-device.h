@@ -18,6 +18,7 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -25,6 +26,7 @@ namespace ns3
 class SimpleChannel;
 class Node;
 class ErrorModel;
+class PacketBurst;
 
 /**
  * \ingroup netdevice
@@ -38,6 +40,15 @@ class ErrorModel;
  *
  * By default the device is in Broadcast mode, with infinite bandwidth.
  *
+ * When the MaxBurstSize attribute is greater than one, the packets handed
+ * together to SendBurst() while the device is idle are sent back-to-back as
+ * trains of up to MaxBurstSize packets, which the receivers get in a single
+ * event once the last packet has been transmitted.  A train ends before a
+ * packet which would end its transmission more than MaxBurstDuration after
+ * the first one, so that no packet is received more than MaxBurstDuration
+ * after its arrival time.  The packets sent while the device is busy, and
+ * those sent with Send(), are sent one at a time.
+ *
  * \brief simple net device for simple things and testing
  */
 class SimpleNetDevice : public NetDevice
@@ -62,6 +73,16 @@ class SimpleNetDevice : public NetDevice
      */
     void Receive(Ptr<Packet> packet, uint16_t protocol, Mac48Address to, Mac48Address from);
 
+    /**
+     * Receive a train of packets from a connected SimpleChannel.  The
+     * packets are processed in order, as by Receive(), when the last one
+     * is received.
+     *
+     * \param burst Packets received on the channel
+     * \param rxTimes Time at which each packet arrived
+     */
+    void ReceiveBurst(Ptr<PacketBurst> burst, const std::vector<Time>& rxTimes);
+
     /**
      * Attach a channel to this net device.  This will be the
      * channel the net device sends on
@@ -113,6 +134,7 @@ class SimpleNetDevice : public NetDevice
     bool IsPointToPoint() const override;
     bool IsBridge() const override;
     bool Send(Ptr<Packet> packet, const Address& dest, uint16_t protocolNumber) override;
+    bool SendBurst(Ptr<PacketBurst> burst, const Address& dest, uint16_t protocolNumber) override;
     bool SendFrom(Ptr<Packet> packet,
                   const Address& source,
                   const Address& dest,
@@ -150,6 +172,20 @@ class SimpleNetDevice : public NetDevice
      */
     TracedCallback<Ptr<const Packet>> m_phyRxDropTrace;
 
+    /**
+     * Tag a packet with its addresses and protocol number, and enqueue it.
+     *
+     * \param p the packet
+     * \param source source mac address
+     * \param dest mac address of the destination
+     * \param protocolNumber protocol number
+     * \return whether the packet was enqueued
+     */
+    bool Enqueue(Ptr<Packet> p,
+                 const Address& source,
+                 const Address& dest,
+                 uint16_t protocolNumber);
+
     /**
      * The StartTransmission method is used internally to start the process
      * of sending a packet out on the channel, by scheduling the
@@ -158,6 +194,13 @@ class SimpleNetDevice : public NetDevice
      */
     void StartTransmission();
 
+    /**
+     * The StartBurstTransmission method is used internally to start the
+     * process of sending the packets of a burst at the head of the queue as
+     * a single train, as many as MaxBurstSize and MaxBurstDuration allow.
+     */
+    void StartBurstTransmission();
+
     /**
      * The FinishTransmission method is used internally to finish the process
      * of sending a packet out on the channel.
@@ -165,6 +208,14 @@ class SimpleNetDevice : public NetDevice
      */
     void FinishTransmission(Ptr<Packet> packet);
 
+    /**
+     * The FinishBurstTransmission method is used internally to finish the
+     * process of sending a train of packets out on the channel.
+     * \param burst The packets to send on the channel
+     * \param txEnds Time at which the transmission of each packet ended
+     */
+    void FinishBurstTransmission(Ptr<PacketBurst> burst, const std::vector<Time>& txEnds);
+
     bool m_linkUp; //!< Flag indicating whether or not the link is up
 
     /**
@@ -175,6 +226,9 @@ class SimpleNetDevice : public NetDevice
 
     Ptr<Queue<Packet>> m_queue;      //!< The Queue for outgoing packets.
     DataRate m_bps;                  //!< The device nominal Data rate. Zero means infinite
+    uint32_t m_maxBurstSize;         //!< The maximum number of packets sent as a train
+    Time m_maxBurstDuration;         //!< The maximum duration of a train
+    uint32_t m_burstLeft; //!< Number of packets of a burst left at the head of the queue
     EventId FinishTransmissionEvent; //!< the Tx Complete event
 
     /**
@@ -0,0 +1,802 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "threaded-simulator-impl.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/channel-list.h"
+#include "ns3/channel.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/scheduler.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::ThreadedSimulatorImpl implementation.
+ */
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE("ThreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(ThreadedSimulatorImpl);
+
+thread_local ThreadedSimulatorImpl::Partition* ThreadedSimulatorImpl::m_current = nullptr;
+
+TypeId
+ThreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::ThreadedSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Network")
+            .AddConstructor<ThreadedSimulatorImpl>()
+            .AddAttribute("ThreadCount",
+                          "The number of threads executing the partitions, including the "
+                          "main thread. The value 0 selects the number of hardware threads.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreadedSimulatorImpl::m_threadCount),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("MinLookAhead",
+                          "Channels with a delay smaller than this value do not provide "
+                          "lookahead: the nodes they connect are placed in the same partition.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&ThreadedSimulatorImpl::m_minLookAhead),
+                          MakeTimeChecker(Seconds(0)));
+    return tid;
+}
+
+ThreadedSimulatorImpl::ThreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+    m_global = AddPartition();
+    m_partitioned = false;
+    m_lookAhead = Time::Max();
+    m_exit = false;
+    m_parallel = false;
+    m_windowEnd = 0;
+    m_safeTs = 0;
+    m_nextActive = 0;
+    m_stop = false;
+    m_mainThreadId = std::this_thread::get_id();
+}
+
+ThreadedSimulatorImpl::~ThreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+    // Release the events scheduled from other threads since DoDispose()
+    m_eventsWithContext.Drain([](const EventWithContext& event) { event.event->Unref(); });
+}
+
+void
+ThreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    ProcessInboxes();
+    ProcessEventsWithContext();
+
+    for (auto& partition : m_partitions)
+    {
+        while (!partition->events->IsEmpty())
+        {
+            Scheduler::Event next = partition->events->RemoveNext();
+            next.impl->Unref();
+        }
+        partition->events = nullptr;
+    }
+    m_partitions.clear();
+    m_global = nullptr;
+    SimulatorImpl::DoDispose();
+}
+
+void
+ThreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_destroyEvents.empty())
+    {
+        Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
+        m_destroyEvents.pop_front();
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+void
+ThreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    m_schedulerFactory = schedulerFactory;
+
+    for (auto& partition : m_partitions)
+    {
+        Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler>();
+        if (partition->events)
+        {
+            while (!partition->events->IsEmpty())
+            {
+                Scheduler::Event next = partition->events->RemoveNext();
+                scheduler->Insert(next);
+            }
+        }
+        partition->events = scheduler;
+    }
+}
+
+ThreadedSimulatorImpl::Partition*
+ThreadedSimulatorImpl::AddPartition()
+{
+    auto partition = std::make_unique<Partition>();
+    partition->simulator = this;
+    partition->index = m_partitions.size();
+    if (m_schedulerFactory.IsTypeIdSet())
+    {
+        partition->events = m_schedulerFactory.Create<Scheduler>();
+    }
+    partition->uid = EventId::UID::VALID;
+    partition->currentUid = EventId::UID::INVALID;
+    partition->currentTs = 0;
+    partition->currentContext = Simulator::NO_CONTEXT;
+    partition->sent = 0;
+    partition->packetUid = static_cast<uint64_t>(partition->index) << 32;
+    partition->eventCount = 0;
+    partition->unscheduledEvents = 0;
+    m_partitions.push_back(std::move(partition));
+    return m_partitions.back().get();
+}
+
+void
+ThreadedSimulatorImpl::BuildPartitions()
+{
+    NS_LOG_FUNCTION(this);
+
+    // Union-find over the node ids
+    uint32_t nNodes = NodeList::GetNNodes();
+    std::vector<uint32_t> parent(nNodes);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](uint32_t i) {
+        while (parent[i] != i)
+        {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+
+    // Channels which can not provide lookahead merge the nodes they connect;
+    // the others are kept, together with their delay, to compute the lookahead
+    std::vector<std::pair<Time, std::vector<uint32_t>>> links;
+    for (auto it = ChannelList::Begin(); it != ChannelList::End(); ++it)
+    {
+        Ptr<Channel> channel = *it;
+        std::vector<uint32_t> nodes;
+        for (std::size_t i = 0; i < channel->GetNDevices(); ++i)
+        {
+            Ptr<NetDevice> device = channel->GetDevice(i);
+            if (device && device->GetNode())
+            {
+                nodes.push_back(device->GetNode()->GetId());
+            }
+        }
+        if (nodes.size() < 2)
+        {
+            continue;
+        }
+
+        TimeValue delay;
+        if (channel->GetAttributeFailSafe("Delay", delay) && delay.Get().IsStrictlyPositive() &&
+            delay.Get() >= m_minLookAhead)
+        {
+            links.emplace_back(delay.Get(), std::move(nodes));
+            continue;
+        }
+        NS_LOG_LOGIC("channel " << channel->GetId() << " merges " << nodes.size() << " nodes");
+        for (auto node : nodes)
+        {
+            parent[find(node)] = find(nodes.front());
+        }
+    }
+
+    // Number the partitions in node order, so that the partitioning does not
+    // depend on the channel creation order
+    std::map<uint32_t, uint32_t> rootPartition;
+    m_contextPartition.resize(nNodes);
+    for (uint32_t node = 0; node < nNodes; ++node)
+    {
+        uint32_t root = find(node);
+        auto [it, inserted] = rootPartition.emplace(root, m_partitions.size());
+        if (inserted)
+        {
+            AddPartition();
+        }
+        m_contextPartition[node] = it->second;
+    }
+
+    for (const auto& [delay, nodes] : links)
+    {
+        for (auto node : nodes)
+        {
+            if (m_contextPartition[node] != m_contextPartition[nodes.front()])
+            {
+                m_lookAhead = Min(m_lookAhead, delay);
+                break;
+            }
+        }
+    }
+
+    // Move the events scheduled so far for a node to the node partition.
+    // The new partitions start numbering events after the global ones, so
+    // that unique ids are not reused within a partition.
+    std::vector<Scheduler::Event> global;
+    while (!m_global->events->IsEmpty())
+    {
+        Scheduler::Event ev = m_global->events->RemoveNext();
+        Partition* partition = GetPartitionOf(ev.key.m_context);
+        if (partition == m_global)
+        {
+            global.push_back(ev);
+            continue;
+        }
+        partition->events->Insert(ev);
+        partition->unscheduledEvents++;
+        m_global->unscheduledEvents--;
+    }
+    for (const auto& ev : global)
+    {
+        m_global->events->Insert(ev);
+    }
+    for (auto& partition : m_partitions)
+    {
+        partition->uid = m_global->uid;
+    }
+
+    m_partitioned = true;
+    NS_LOG_INFO("built " << GetPartitionCount() << " partitions with lookahead " << m_lookAhead);
+}
+
+ThreadedSimulatorImpl::Partition*
+ThreadedSimulatorImpl::GetCurrentPartition() const
+{
+    return m_current ? m_current : m_global;
+}
+
+ThreadedSimulatorImpl::Partition*
+ThreadedSimulatorImpl::GetPartitionOf(uint32_t context) const
+{
+    if (context < m_contextPartition.size())
+    {
+        return m_partitions[m_contextPartition[context]].get();
+    }
+    return m_global;
+}
+
+uint32_t
+ThreadedSimulatorImpl::Insert(Partition* partition, uint64_t ts, uint32_t context, EventImpl* event)
+{
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = ts;
+    ev.key.m_context = context;
+    ev.key.m_uid = partition->uid;
+    partition->uid++;
+    partition->unscheduledEvents++;
+    partition->events->Insert(ev);
+    return ev.key.m_uid;
+}
+
+// System ID for non-distributed simulation is always zero
+uint32_t
+ThreadedSimulatorImpl::GetSystemId() const
+{
+    return 0;
+}
+
+void
+ThreadedSimulatorImpl::ProcessOneEvent(Partition* partition)
+{
+    Scheduler::Event next = partition->events->RemoveNext();
+
+    PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
+
+    NS_ASSERT(next.key.m_ts >= partition->currentTs);
+    partition->unscheduledEvents--;
+    partition->eventCount.fetch_add(1, std::memory_order_relaxed);
+
+    partition->currentTs = next.key.m_ts;
+    partition->currentContext = next.key.m_context;
+    partition->currentUid = next.key.m_uid;
+    next.impl->Invoke();
+    next.impl->Unref();
+}
+
+bool
+ThreadedSimulatorImpl::IsFinished() const
+{
+    if (m_stop)
+    {
+        return true;
+    }
+    return std::all_of(m_partitions.begin(), m_partitions.end(), [](const auto& partition) {
+        return partition->events->IsEmpty() && partition->inbox.empty();
+    });
+}
+
+void
+ThreadedSimulatorImpl::ProcessInboxes()
+{
+    for (auto& partition : m_partitions)
+    {
+        // Assign unique ids in an order which only depends on the senders,
+        // not on the thread interleaving
+        std::sort(partition->inbox.begin(),
+                  partition->inbox.end(),
+                  [](const InboxEvent& a, const InboxEvent& b) {
+                      return std::tie(a.timestamp, a.source, a.sequence) <
+                             std::tie(b.timestamp, b.source, b.sequence);
+                  });
+        for (const auto& ev : partition->inbox)
+        {
+            Insert(partition.get(), ev.timestamp, ev.context, ev.event);
+        }
+        partition->inbox.clear();
+
+        // Cancelling an event twice, or cancelling and removing it, has the
+        // same effect in any order
+        for (const auto& cancel : partition->cancels)
+        {
+            cancel.remove ? Remove(cancel.id) : Cancel(cancel.id);
+        }
+        partition->cancels.clear();
+    }
+}
+
+void
+ThreadedSimulatorImpl::ProcessEventsWithContext()
+{
+    if (m_eventsWithContext.IsEmpty())
+    {
+        return;
+    }
+
+    m_eventsWithContext.Drain([this](const EventWithContext& event) {
+        Insert(GetPartitionOf(event.context),
+               m_safeTs + event.timestamp,
+               event.context,
+               event.event);
+    });
+}
+
+void
+ThreadedSimulatorImpl::ProcessWindow()
+{
+    while (true)
+    {
+        uint32_t i = m_nextActive.fetch_add(1, std::memory_order_relaxed);
+        if (i >= m_active.size())
+        {
+            break;
+        }
+        Partition* partition = m_active[i];
+        m_current = partition;
+        uint64_t packetUid = Packet::GetNextUid();
+        Packet::SetNextUid(partition->packetUid);
+        while (!partition->events->IsEmpty() &&
+               partition->events->PeekNext().key.m_ts < m_windowEnd)
+        {
+            ProcessOneEvent(partition);
+        }
+        partition->packetUid = Packet::GetNextUid();
+        Packet::SetNextUid(packetUid);
+        m_current = nullptr;
+    }
+}
+
+void
+ThreadedSimulatorImpl::DoWorker()
+{
+    while (true)
+    {
+        m_barrier->arrive_and_wait();
+        if (m_exit)
+        {
+            break;
+        }
+        ProcessWindow();
+        m_barrier->arrive_and_wait();
+    }
+}
+
+void
+ThreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    // Set the current threadId as the main threadId
+    m_mainThreadId = std::this_thread::get_id();
+    if (!m_partitioned)
+    {
+        BuildPartitions();
+    }
+    m_stop = false;
+
+    uint32_t threads = m_threadCount ? m_threadCount : std::thread::hardware_concurrency();
+    threads = std::clamp<uint32_t>(threads, 1, std::max<uint32_t>(GetPartitionCount(), 1));
+    NS_LOG_INFO("running with " << threads << " threads");
+    m_exit = false;
+    m_barrier = std::make_unique<std::barrier<>>(threads);
+    for (uint32_t i = 1; i < threads; ++i)
+    {
+        m_workers.emplace_back(&ThreadedSimulatorImpl::DoWorker, this);
+    }
+
+    const uint64_t maxTs = GetMaximumSimulationTime().GetTimeStep();
+    const uint64_t lookAhead = m_lookAhead.GetTimeStep();
+    while (!m_stop)
+    {
+        ProcessInboxes();
+        ProcessEventsWithContext();
+
+        uint64_t nextTs = maxTs;
+        for (std::size_t i = 1; i < m_partitions.size(); ++i)
+        {
+            if (!m_partitions[i]->events->IsEmpty())
+            {
+                nextTs = std::min(nextTs, m_partitions[i]->events->PeekNext().key.m_ts);
+            }
+        }
+        uint64_t globalTs = m_global->events->IsEmpty() ? maxTs
+                                                        : m_global->events->PeekNext().key.m_ts;
+        if (nextTs == maxTs && globalTs == maxTs)
+        {
+            break;
+        }
+
+        if (globalTs <= nextTs)
+        {
+            // Global events run alone, and may touch any partition
+            m_current = m_global;
+            ProcessOneEvent(m_global);
+            m_current = nullptr;
+            m_safeTs = globalTs;
+            continue;
+        }
+
+        m_windowEnd = std::min(globalTs, nextTs > maxTs - lookAhead ? maxTs : nextTs + lookAhead);
+        m_active.clear();
+        for (std::size_t i = 1; i < m_partitions.size(); ++i)
+        {
+            if (!m_partitions[i]->events->IsEmpty() &&
+                m_partitions[i]->events->PeekNext().key.m_ts < m_windowEnd)
+            {
+                m_active.push_back(m_partitions[i].get());
+            }
+        }
+        m_global->currentTs = std::max(m_global->currentTs, nextTs);
+        m_nextActive = 0;
+        m_parallel = true;
+        m_barrier->arrive_and_wait();
+        ProcessWindow();
+        m_barrier->arrive_and_wait();
+        m_parallel = false;
+        m_safeTs = m_windowEnd;
+    }
+
+    m_exit = true;
+    m_barrier->arrive_and_wait();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+    m_workers.clear();
+    m_barrier.reset();
+
+    // Deliver the events exchanged in the last window, so that they are
+    // found by a later call to Run()
+    ProcessInboxes();
+
+    int unscheduledEvents = 0;
+    for (const auto& partition : m_partitions)
+    {
+        m_global->currentTs = std::max(m_global->currentTs, partition->currentTs);
+        unscheduledEvents += partition->unscheduledEvents;
+    }
+    // If the simulator stopped naturally by lack of events, make a
+    // consistency test to check that we didn't lose any events along the way.
+    NS_ASSERT(!IsFinished() || m_stop || unscheduledEvents == 0);
+}
+
+void
+ThreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    m_stop = true;
+}
+
+EventId
+ThreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    return Simulator::Schedule(delay, &Simulator::Stop);
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+ThreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_ASSERT_MSG(m_current || m_mainThreadId == std::this_thread::get_id(),
+                  "Simulator::Schedule Thread-unsafe invocation!");
+    NS_ASSERT_MSG(delay.IsPositive(), "ThreadedSimulatorImpl::Schedule(): Negative delay");
+
+    Partition* partition = GetCurrentPartition();
+    Time tAbsolute = delay + TimeStep(partition->currentTs);
+    uint64_t ts = tAbsolute.GetTimeStep();
+    uint32_t uid = Insert(partition, ts, partition->currentContext, event);
+    return EventId(event, ts, partition->currentContext, uid);
+}
+
+void
+ThreadedSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event)
+{
+    if (!m_current && m_mainThreadId != std::this_thread::get_id())
+    {
+        EventWithContext ev;
+        ev.context = context;
+        // Current time added in ProcessEventsWithContext()
+        ev.timestamp = delay.GetTimeStep();
+        ev.event = event;
+        m_eventsWithContext.Push(ev);
+        return;
+    }
+
+    Partition* source = GetCurrentPartition();
+    Partition* destination = GetPartitionOf(context);
+    Time tAbsolute = delay + TimeStep(source->currentTs);
+    uint64_t ts = tAbsolute.GetTimeStep();
+
+    if (!m_parallel || source == destination)
+    {
+        Insert(destination, ts, context, event);
+        return;
+    }
+
+    NS_ABORT_MSG_IF(ts < m_windowEnd,
+                    "Event for context " << context << " scheduled with delay " << delay
+                                         << ", smaller than the lookahead " << m_lookAhead);
+    InboxEvent ev;
+    ev.timestamp = ts;
+    ev.context = context;
+    ev.source = source->index;
+    ev.sequence = source->sent++;
+    ev.event = event;
+    {
+        std::unique_lock lock{destination->inboxMutex};
+        destination->inbox.push_back(ev);
+    }
+}
+
+EventId
+ThreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return Schedule(Time(0), event);
+}
+
+EventId
+ThreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    NS_ASSERT_MSG(m_mainThreadId == std::this_thread::get_id() && !m_parallel,
+                  "Simulator::ScheduleDestroy Thread-unsafe invocation!");
+
+    EventId id(Ptr<EventImpl>(event, false), m_global->currentTs, 0xffffffff, 2);
+    m_destroyEvents.push_back(id);
+    return id;
+}
+
+Time
+ThreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    return TimeStep(GetCurrentPartition()->currentTs);
+}
+
+Time
+ThreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    else
+    {
+        return TimeStep(id.GetTs() - GetCurrentPartition()->currentTs);
+    }
+}
+
+bool
+ThreadedSimulatorImpl::CancelRemote(const EventId& id, bool remove)
+{
+    if (!m_parallel)
+    {
+        return false;
+    }
+    Partition* owner =
+        id.GetUid() == EventId::UID::DESTROY ? m_global : GetPartitionOf(id.GetContext());
+    if (owner == m_current)
+    {
+        return false;
+    }
+    // The event belongs to another thread: let the main thread cancel it at
+    // the end of the window
+    std::unique_lock lock{owner->inboxMutex};
+    owner->cancels.push_back({id, remove});
+    return true;
+}
+
+void
+ThreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (CancelRemote(id, true))
+    {
+        return;
+    }
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                m_destroyEvents.erase(i);
+                break;
+            }
+        }
+        return;
+    }
+    if (IsExpired(id))
+    {
+        return;
+    }
+    Partition* partition = GetPartitionOf(id.GetContext());
+    Scheduler::Event event;
+    event.impl = id.PeekEventImpl();
+    event.key.m_ts = id.GetTs();
+    event.key.m_context = id.GetContext();
+    event.key.m_uid = id.GetUid();
+    partition->events->Remove(event);
+    event.impl->Cancel();
+    // whenever we remove an event from the event list, we have to unref it.
+    event.impl->Unref();
+
+    partition->unscheduledEvents--;
+}
+
+void
+ThreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (CancelRemote(id, false))
+    {
+        return;
+    }
+    if (!IsExpired(id))
+    {
+        id.PeekEventImpl()->Cancel();
+    }
+}
+
+bool
+ThreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+        {
+            return true;
+        }
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    Partition* partition = GetPartitionOf(id.GetContext());
+    if (m_parallel && partition != m_current)
+    {
+        // The clock of the other partition is moving, and its events may be
+        // cancelled concurrently: only the events before the current window
+        // are known to have expired.
+        return id.PeekEventImpl() == nullptr || id.GetTs() < m_safeTs;
+    }
+    if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+    {
+        return true;
+    }
+    return id.GetTs() < partition->currentTs ||
+           (id.GetTs() == partition->currentTs && id.GetUid() <= partition->currentUid);
+}
+
+Time
+ThreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(0x7fffffffffffffffLL);
+}
+
+uint32_t
+ThreadedSimulatorImpl::GetContext() const
+{
+    return GetCurrentPartition()->currentContext;
+}
+
+uint64_t
+ThreadedSimulatorImpl::GetEventCount() const
+{
+    uint64_t count = 0;
+    for (const auto& partition : m_partitions)
+    {
+        count += partition->eventCount.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+void
+ThreadedSimulatorImpl::BoundLookAhead(const Time lookAhead)
+{
+    if (lookAhead.IsStrictlyPositive())
+    {
+        NS_LOG_FUNCTION(this << lookAhead);
+        m_lookAhead = Min(m_lookAhead, lookAhead);
+    }
+    else
+    {
+        NS_LOG_WARN("attempted to set lookahead to a non-positive time: " << lookAhead);
+    }
+}
+
+Time
+ThreadedSimulatorImpl::GetLookAhead() const
+{
+    return m_lookAhead;
+}
+
+uint32_t
+ThreadedSimulatorImpl::GetPartitionCount() const
+{
+    return m_partitions.size() - 1;
+}
+
+uint32_t
+ThreadedSimulatorImpl::GetPartition(uint32_t context) const
+{
+    return GetPartitionOf(context)->index;
+}
+
+bool
+ThreadedSimulatorImpl::IsRemote(uint32_t context)
+{
+    return m_current && m_current->simulator->GetPartitionOf(context) != m_current;
+}
+
+} // namespace ns3
@@ -0,0 +1,341 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef THREADED_SIMULATOR_IMPL_H
+#define THREADED_SIMULATOR_IMPL_H
+
+#include "ns3/mpsc-queue.h"
+#include "ns3/simulator-impl.h"
+
+#include <atomic>
+#include <barrier>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::ThreadedSimulatorImpl declaration.
+ */
+
+namespace ns3
+{
+
+class Scheduler;
+
+/**
+ * \ingroup simulator
+ *
+ * \brief Shared-memory parallel simulator engine.
+ *
+ * This engine runs a single simulation on a pool of threads inside one
+ * process.  When Run() is first called, the nodes in the NodeList are
+ * grouped into partitions: every Channel that either has no \c Delay
+ * attribute or whose delay is smaller than the \c MinLookAhead attribute
+ * places all the nodes attached to it in the same partition.  The
+ * lookahead is the smallest \c Delay of the remaining channels, i.e. of
+ * the channels linking two different partitions, further bounded by
+ * BoundLookAhead().
+ *
+ * Each partition owns an event queue, and events are assigned to a
+ * partition by their context (the node id passed to
+ * Simulator::ScheduleWithContext).  Events without a context, or with a
+ * context that is not a node id, belong to a global partition that is
+ * always executed by the main thread while all the other partitions are
+ * idle.
+ *
+ * Execution proceeds in conservative time windows \f$[t, t + L)\f$, where
+ * \f$t\f$ is the timestamp of the earliest pending event and \f$L\f$ is
+ * the lookahead; the window is also closed before the next global event.
+ * Within a window, the partitions are processed concurrently by the
+ * worker threads.  An event scheduled for another partition must not fall
+ * inside the current window, which holds as long as the models only
+ * exchange events between nodes through channels with a delay of at least
+ * the lookahead.  Events exchanged between partitions are delivered at
+ * the end of the window in a deterministic order, so the results do not
+ * depend on the number of threads.
+ *
+ * Models executing in different partitions run concurrently, so any state
+ * they share must be thread-safe.  In particular, the copies of a packet
+ * share its data, hence the channels deliver a Packet::DeepCopy() of the
+ * packets sent to another partition (see IsRemote()).  Each partition
+ * numbers the packets it creates from its own counter, starting at the
+ * partition index times \f$2^{32}\f$, so that the packet Uids do not depend
+ * on the number of threads either.
+ *
+ * Simulator::Stop() called from within a partition takes effect at the end
+ * of the current window, and so do Simulator::Cancel() and
+ * Simulator::Remove() of an event of another partition: the events of the
+ * current window can not be cancelled from another partition.
+ */
+class ThreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    ThreadedSimulatorImpl();
+    /** Destructor. */
+    ~ThreadedSimulatorImpl() override;
+
+    // Inherited
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    EventId Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+
+    /**
+     * Add an upper bound to the lookahead.
+     *
+     * The lookahead used by the engine is the minimum of the bounds
+     * provided through this method and of the lookahead derived from the
+     * channel delays.
+     *
+     * \param [in] lookAhead The maximum lookahead; must be positive.
+     */
+    void BoundLookAhead(const Time lookAhead);
+
+    /**
+     * Get the lookahead used to build the time windows.
+     *
+     * The value is only meaningful once Run() has been called.
+     *
+     * \return The lookahead.
+     */
+    Time GetLookAhead() const;
+
+    /**
+     * Get the number of node partitions, not counting the global partition.
+     *
+     * The value is only meaningful once Run() has been called.
+     *
+     * \return The number of partitions.
+     */
+    uint32_t GetPartitionCount() const;
+
+    /**
+     * Get the partition an event context is executed in.
+     *
+     * \param [in] context The event context.
+     * \return The partition index, starting from 1; 0 is the global partition.
+     */
+    uint32_t GetPartition(uint32_t context) const;
+
+    /**
+     * Check whether the events of a context are executed by another
+     * partition than the calling event.
+     *
+     * The models use this to avoid sharing objects which are not
+     * thread-safe, such as packets, with another partition.  This is
+     * always false when the simulator implementation is not a
+     * ThreadedSimulatorImpl.
+     *
+     * \param [in] context The event context.
+     * \return Whether the events of the context are executed by another partition.
+     */
+    static bool IsRemote(uint32_t context);
+
+  private:
+    void DoDispose() override;
+
+    /** An event sent to a partition by another partition. */
+    struct InboxEvent
+    {
+        /** Absolute event timestamp. */
+        uint64_t timestamp;
+        /** The event context. */
+        uint32_t context;
+        /** The index of the sending partition. */
+        uint32_t source;
+        /** Sequence number of the event in the sending partition. */
+        uint64_t sequence;
+        /** The event implementation. */
+        EventImpl* event;
+    };
+
+    /** A request to cancel an event, sent to a partition by another partition. */
+    struct InboxCancel
+    {
+        /** The event. */
+        EventId id;
+        /** Whether to remove the event rather than only cancel it. */
+        bool remove;
+    };
+
+    /** A partition of the simulation, with its own event queue and clock. */
+    struct Partition
+    {
+        /** The simulator the partition belongs to. */
+        const ThreadedSimulatorImpl* simulator;
+        /** The partition index. */
+        uint32_t index;
+        /** The event priority queue. */
+        Ptr<Scheduler> events;
+        /** Next event unique id. */
+        uint32_t uid;
+        /** Unique id of the current event. */
+        uint32_t currentUid;
+        /** Timestamp of the current event. */
+        uint64_t currentTs;
+        /** Execution context of the current event. */
+        uint32_t currentContext;
+        /** Number of events sent to other partitions. */
+        uint64_t sent;
+        /** Uid of the next packet created by the partition. */
+        uint64_t packetUid;
+        /** The event count. */
+        std::atomic<uint64_t> eventCount;
+        /** Number of events that have been inserted but not yet executed. */
+        int unscheduledEvents;
+        /** Mutex protecting the inbox. */
+        std::mutex inboxMutex;
+        /** Events received from other partitions during the current window. */
+        std::vector<InboxEvent> inbox;
+        /** Cancellations received from other partitions during the current window. */
+        std::vector<InboxCancel> cancels;
+    };
+
+    /** Wrap an event scheduled from a foreign thread with its execution context. */
+    struct EventWithContext
+    {
+        /** The event context. */
+        uint32_t context;
+        /** Event timestamp, relative to the time the event is collected. */
+        uint64_t timestamp;
+        /** The event implementation. */
+        EventImpl* event;
+    };
+
+    /**
+     * Create a new, empty partition.
+     * \return The new partition.
+     */
+    Partition* AddPartition();
+    /**
+     * Build the node partitions from the channel topology, compute the
+     * lookahead and move the pending events to their partitions.
+     */
+    void BuildPartitions();
+    /**
+     * Get the partition the calling thread is executing events for.
+     * \return The current partition.
+     */
+    Partition* GetCurrentPartition() const;
+    /**
+     * Get the partition executing the events of a context.
+     * \param [in] context The event context.
+     * \return The partition.
+     */
+    Partition* GetPartitionOf(uint32_t context) const;
+    /**
+     * Insert an event in the queue of a partition.
+     * \param [in] partition The partition.
+     * \param [in] ts The absolute event timestamp.
+     * \param [in] context The event context.
+     * \param [in] event The event implementation.
+     * \return The event unique id.
+     */
+    uint32_t Insert(Partition* partition, uint64_t ts, uint32_t context, EventImpl* event);
+    /**
+     * Process the next event of a partition.
+     * \param [in] partition The partition.
+     */
+    void ProcessOneEvent(Partition* partition);
+    /**
+     * Send the cancellation of an event to the partition owning it, if this
+     * partition executes concurrently with the calling one.
+     * \param [in] id The event.
+     * \param [in] remove Whether to remove the event rather than only cancel it.
+     * \return Whether the cancellation was sent to another partition.
+     */
+    bool CancelRemote(const EventId& id, bool remove);
+    /**
+     * Move the events exchanged during the last window to their event
+     * queues, and apply the cancellations.
+     */
+    void ProcessInboxes();
+    /** Move events scheduled from foreign threads to their event queues. */
+    void ProcessEventsWithContext();
+    /** Process the partitions of the current window, until none is left. */
+    void ProcessWindow();
+    /** Body of the worker threads. */
+    void DoWorker();
+
+    /** The partition the calling thread is executing events for, if any. */
+    static thread_local Partition* m_current;
+
+    /** The partitions; the first one is the global partition. */
+    std::vector<std::unique_ptr<Partition>> m_partitions;
+    /** The global partition. */
+    Partition* m_global;
+    /** Partition index of each context, indexed by context. */
+    std::vector<uint32_t> m_contextPartition;
+    /** Whether the partitions have been built. */
+    bool m_partitioned;
+    /** The scheduler factory, used to create the partition event queues. */
+    ObjectFactory m_schedulerFactory;
+
+    /** The lookahead. */
+    Time m_lookAhead;
+    /** Channels with a smaller delay are not used for lookahead. */
+    Time m_minLookAhead;
+    /** The requested number of threads. */
+    uint32_t m_threadCount;
+
+    /** The worker threads. */
+    std::vector<std::thread> m_workers;
+    /** Barrier used to start and end each window. */
+    std::unique_ptr<std::barrier<>> m_barrier;
+    /** Flag telling the workers to exit. */
+    bool m_exit;
+    /** Flag \c true while a window is being processed concurrently. */
+    bool m_parallel;
+    /** End of the current window, exclusive. */
+    uint64_t m_windowEnd;
+    /** Time up to which all the partitions have been processed. */
+    uint64_t m_safeTs;
+    /** The partitions with events in the current window. */
+    std::vector<Partition*> m_active;
+    /** Index of the next partition of m_active to be processed. */
+    std::atomic<uint32_t> m_nextActive;
+
+    /** The lock-free inbox of events scheduled from foreign threads. */
+    MpscQueue<EventWithContext> m_eventsWithContext;
+
+    /** Container type for the events to run at Simulator::Destroy() */
+    typedef std::list<EventId> DestroyEvents;
+    /** The container of events to run at Destroy. */
+    DestroyEvents m_destroyEvents;
+    /** Flag calling for the end of the simulation. */
+    std::atomic<bool> m_stop;
+
+    /** Main execution thread. */
+    std::thread::id m_mainThreadId;
+};
+
+} // namespace ns3
+
+#endif /* THREADED_SIMULATOR_IMPL_H */
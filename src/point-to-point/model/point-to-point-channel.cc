@@ -9,8 +9,10 @@
 #include "point-to-point-net-device.h"
 
 #include "ns3/log.h"
+#include "ns3/packet-burst.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
+#include "ns3/threaded-simulator-impl.h"
 #include "ns3/trace-source-accessor.h"
 
 namespace ns3
@@ -85,17 +87,58 @@ PointToPointChannel::TransmitStart(Ptr<const Packet> p, Ptr<PointToPointNetDevic
 
     uint32_t wire = src == m_link[0].m_src ? 0 : 1;
 
-    Simulator::ScheduleWithContext(m_link[wire].m_dst->GetNode()->GetId(),
+    // A packet received by another partition must not share its data with
+    // the packet of the sender
+    uint32_t context = m_link[wire].m_dst->GetNode()->GetId();
+    Simulator::ScheduleWithContext(context,
                                    txTime + m_delay,
                                    &PointToPointNetDevice::Receive,
                                    m_link[wire].m_dst,
-                                   p->Copy());
+                                   ThreadedSimulatorImpl::IsRemote(context) ? p->DeepCopy()
+                                                                            : p->Copy());
 
     // Call the tx anim callback on the net device
     m_txrxPointToPoint(p, src, m_link[wire].m_dst, txTime, txTime + m_delay);
     return true;
 }
 
+bool
+PointToPointChannel::TransmitBurst(Ptr<const PacketBurst> burst,
+                                   Ptr<PointToPointNetDevice> src,
+                                   const std::vector<Time>& txEnds)
+{
+    NS_LOG_FUNCTION(this << burst << src);
+    NS_ASSERT(burst->GetNPackets() == txEnds.size() && !txEnds.empty());
+
+    NS_ASSERT(m_link[0].m_state != INITIALIZING);
+    NS_ASSERT(m_link[1].m_state != INITIALIZING);
+
+    uint32_t wire = src == m_link[0].m_src ? 0 : 1;
+
+    std::vector<Time> rxTimes;
+    rxTimes.reserve(txEnds.size());
+    Time txStart;
+    auto txEnd = txEnds.begin();
+    for (auto p = burst->Begin(); p != burst->End(); ++p, ++txEnd)
+    {
+        NS_LOG_LOGIC("UID is " << (*p)->GetUid() << ")");
+        rxTimes.push_back(Simulator::Now() + *txEnd + m_delay);
+        // Call the tx anim callback on the net device
+        m_txrxPointToPoint(*p, src, m_link[wire].m_dst, *txEnd - txStart, *txEnd + m_delay);
+        txStart = *txEnd;
+    }
+
+    uint32_t context = m_link[wire].m_dst->GetNode()->GetId();
+    Simulator::ScheduleWithContext(context,
+                                   txEnds.back() + m_delay,
+                                   &PointToPointNetDevice::ReceiveBurst,
+                                   m_link[wire].m_dst,
+                                   ThreadedSimulatorImpl::IsRemote(context) ? burst->DeepCopy()
+                                                                            : burst->Copy(),
+                                   rxTimes);
+    return true;
+}
+
 std::size_t
 PointToPointChannel::GetNDevices() const
 {
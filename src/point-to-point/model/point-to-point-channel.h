@@ -14,12 +14,14 @@
 #include "ns3/traced-callback.h"
 
 #include <list>
+#include <vector>
 
 namespace ns3
 {
 
 class PointToPointNetDevice;
 class Packet;
+class PacketBurst;
 
 /**
  * \ingroup point-to-point
@@ -70,6 +72,23 @@ class PointToPointChannel : public Channel
      */
     virtual bool TransmitStart(Ptr<const Packet> p, Ptr<PointToPointNetDevice> src, Time txTime);
 
+    /**
+     * \brief Transmit a train of back-to-back packets over this channel
+     *
+     * The destination receives the whole train in a single event, when
+     * the last bit of the last packet arrives, along with the time at
+     * which the last bit of each packet arrived.
+     *
+     * \param burst Packets to transmit
+     * \param src Source PointToPointNetDevice
+     * \param txEnds Time at which the transmission of each packet ends,
+     *        relative to now
+     * \returns true if successful (currently always true)
+     */
+    virtual bool TransmitBurst(Ptr<const PacketBurst> burst,
+                               Ptr<PointToPointNetDevice> src,
+                               const std::vector<Time>& txEnds);
+
     /**
      * \brief Get number of devices on this channel
      * \returns number of devices on this channel
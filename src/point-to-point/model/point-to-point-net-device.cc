@@ -13,6 +13,7 @@
 #include "ns3/llc-snap-header.h"
 #include "ns3/log.h"
 #include "ns3/mac48-address.h"
+#include "ns3/packet-burst.h"
 #include "ns3/pointer.h"
 #include "ns3/queue.h"
 #include "ns3/simulator.h"
@@ -70,6 +71,22 @@ PointToPointNetDevice::GetTypeId()
                           PointerValue(),
                           MakePointerAccessor(&PointToPointNetDevice::m_queue),
                           MakePointerChecker<Queue<Packet>>())
+            .AddAttribute("MaxBurstSize",
+                          "The maximum number of packets handed together to SendBurst() "
+                          "which are sent back-to-back as a single train, and received "
+                          "in a single event by the remote device when the last packet "
+                          "arrives.  The device traces of the packets of a train are "
+                          "fired when the train starts or ends.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&PointToPointNetDevice::m_maxBurstSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("MaxBurstDuration",
+                          "The maximum time between the end of the transmission of the "
+                          "first and of the last packet of a train.  No packet of a train "
+                          "is received later than this after its own arrival time.",
+                          TimeValue(MicroSeconds(100)),
+                          MakeTimeAccessor(&PointToPointNetDevice::m_maxBurstDuration),
+                          MakeTimeChecker(Time(0)))
 
             //
             // Trace sources at the "top" of the net device, where packets transition
@@ -166,8 +183,10 @@ PointToPointNetDevice::GetTypeId()
 PointToPointNetDevice::PointToPointNetDevice()
     : m_txMachineState(READY),
       m_channel(nullptr),
+      m_burstLeft(0),
       m_linkUp(false),
-      m_currentPkt(nullptr)
+      m_currentPkt(nullptr),
+      m_currentBurst(nullptr)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -204,6 +223,7 @@ PointToPointNetDevice::DoDispose()
     m_channel = nullptr;
     m_receiveErrorModel = nullptr;
     m_currentPkt = nullptr;
+    m_currentBurst = nullptr;
     m_queue = nullptr;
     NetDevice::DoDispose();
 }
@@ -252,6 +272,95 @@ PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
     return result;
 }
 
+bool
+PointToPointNetDevice::TransmitBurstStart(Ptr<PacketBurst> burst)
+{
+    NS_LOG_FUNCTION(this << burst);
+
+    NS_ASSERT_MSG(m_txMachineState == READY, "Must be READY to transmit");
+    m_txMachineState = BUSY;
+    m_currentBurst = burst;
+
+    //
+    // The packets follow each other on the wire, separated by the interframe
+    // gap.  We tell the channel when the transmission of each packet ends and
+    // schedule a single event for the end of the train.
+    //
+    std::vector<Time> txEnds;
+    txEnds.reserve(burst->GetNPackets());
+    Time txStart;
+    for (auto p = burst->Begin(); p != burst->End(); ++p)
+    {
+        NS_LOG_LOGIC("UID is " << (*p)->GetUid() << ")");
+        m_phyTxBeginTrace(*p);
+        Time txEnd = txStart + m_bps.CalculateBytesTxTime((*p)->GetSize());
+        txEnds.push_back(txEnd);
+        txStart = txEnd + m_tInterframeGap;
+    }
+
+    NS_LOG_LOGIC("Schedule TransmitCompleteEvent in " << txStart.As(Time::S));
+    Simulator::Schedule(txStart, &PointToPointNetDevice::TransmitComplete, this);
+
+    bool result = m_channel->TransmitBurst(burst, this, txEnds);
+    if (!result)
+    {
+        for (auto p = burst->Begin(); p != burst->End(); ++p)
+        {
+            m_phyTxDropTrace(*p);
+        }
+    }
+    return result;
+}
+
+bool
+PointToPointNetDevice::TransmitQueuedBurst()
+{
+    NS_LOG_FUNCTION(this);
+
+    //
+    // Take the packets of the burst at the head of the queue which end their
+    // transmission within MaxBurstDuration of the first one.  The next ones
+    // form the next trains.
+    //
+    Ptr<PacketBurst> burst = CreateObject<PacketBurst>();
+    Time txStart;
+    Time firstTxEnd;
+    while (m_burstLeft > 0 && burst->GetNPackets() < m_maxBurstSize)
+    {
+        Ptr<const Packet> next = m_queue->Peek();
+        if (!next)
+        {
+            m_burstLeft = 0;
+            break;
+        }
+        Time txEnd = txStart + m_bps.CalculateBytesTxTime(next->GetSize());
+        if (burst->GetNPackets() == 0)
+        {
+            firstTxEnd = txEnd;
+        }
+        else if (txEnd - firstTxEnd > m_maxBurstDuration)
+        {
+            break;
+        }
+        Ptr<Packet> p = m_queue->Dequeue();
+        m_snifferTrace(p);
+        m_promiscSnifferTrace(p);
+        burst->AddPacket(p);
+        m_burstLeft--;
+        txStart = txEnd + m_tInterframeGap;
+    }
+
+    if (burst->GetNPackets() == 0)
+    {
+        return true;
+    }
+    if (burst->GetNPackets() == 1)
+    {
+        return TransmitStart(burst->GetPackets().front());
+    }
+    return TransmitBurstStart(burst);
+}
+
 void
 PointToPointNetDevice::TransmitComplete()
 {
@@ -266,10 +375,28 @@ PointToPointNetDevice::TransmitComplete()
     NS_ASSERT_MSG(m_txMachineState == BUSY, "Must be BUSY if transmitting");
     m_txMachineState = READY;
 
-    NS_ASSERT_MSG(m_currentPkt, "PointToPointNetDevice::TransmitComplete(): m_currentPkt zero");
+    if (m_currentBurst)
+    {
+        for (auto p = m_currentBurst->Begin(); p != m_currentBurst->End(); ++p)
+        {
+            m_phyTxEndTrace(*p);
+        }
+        m_currentBurst = nullptr;
+    }
+    else
+    {
+        NS_ASSERT_MSG(m_currentPkt,
+                      "PointToPointNetDevice::TransmitComplete(): m_currentPkt zero");
 
-    m_phyTxEndTrace(m_currentPkt);
-    m_currentPkt = nullptr;
+        m_phyTxEndTrace(m_currentPkt);
+        m_currentPkt = nullptr;
+    }
+
+    if (m_burstLeft > 0)
+    {
+        TransmitQueuedBurst();
+        return;
+    }
 
     Ptr<Packet> p = m_queue->Dequeue();
     if (!p)
@@ -373,6 +500,23 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
     }
 }
 
+void
+PointToPointNetDevice::ReceiveBurst(Ptr<PacketBurst> burst, const std::vector<Time>& rxTimes)
+{
+    NS_LOG_FUNCTION(this << burst);
+    NS_ASSERT(burst->GetNPackets() == rxTimes.size());
+
+    auto rxTime = rxTimes.begin();
+    for (auto p = burst->Begin(); p != burst->End(); ++p, ++rxTime)
+    {
+        NS_ASSERT(*rxTime <= Simulator::Now());
+        NS_LOG_LOGIC("UID " << (*p)->GetUid() << " arrived at " << rxTime->As(Time::S)
+                            << ", delivered " << (Simulator::Now() - *rxTime).As(Time::S)
+                            << " later");
+        Receive(*p);
+    }
+}
+
 Ptr<Queue<Packet>>
 PointToPointNetDevice::GetQueue() const
 {
@@ -548,6 +692,53 @@ PointToPointNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t pr
     return false;
 }
 
+bool
+PointToPointNetDevice::SendBurst(Ptr<PacketBurst> burst,
+                                 const Address& dest,
+                                 uint16_t protocolNumber)
+{
+    NS_LOG_FUNCTION(this << burst << dest << protocolNumber);
+
+    if (!IsLinkUp())
+    {
+        for (auto i = burst->Begin(); i != burst->End(); ++i)
+        {
+            m_macTxDropTrace(*i);
+        }
+        return false;
+    }
+
+    //
+    // Enqueue all the packets first, so that they can be transmitted as a
+    // single train.  The queue is empty unless a transmission is in progress,
+    // in which case the packets are sent one by one after the queued ones.
+    //
+    bool ret = true;
+    uint32_t enqueued = 0;
+    for (auto i = burst->Begin(); i != burst->End(); ++i)
+    {
+        Ptr<Packet> packet = *i;
+        AddHeader(packet, protocolNumber);
+        m_macTxTrace(packet);
+        if (m_queue->Enqueue(packet))
+        {
+            enqueued++;
+        }
+        else
+        {
+            m_macTxDropTrace(packet);
+            ret = false;
+        }
+    }
+
+    if (m_txMachineState == READY)
+    {
+        m_burstLeft = enqueued;
+        ret = TransmitQueuedBurst() && ret;
+    }
+    return ret;
+}
+
 bool
 PointToPointNetDevice::SendFrom(Ptr<Packet> packet,
                                 const Address& source,
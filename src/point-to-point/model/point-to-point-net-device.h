@@ -26,6 +26,7 @@ namespace ns3
 
 class PointToPointChannel;
 class ErrorModel;
+class PacketBurst;
 
 /**
  * \defgroup point-to-point Point-To-Point Network Device
@@ -143,6 +144,21 @@ class PointToPointNetDevice : public NetDevice
      */
     void Receive(Ptr<Packet> p);
 
+    /**
+     * Receive a train of back-to-back packets from a connected
+     * PointToPointChannel.
+     *
+     * This is the public method used by the channel to indicate that the
+     * last bit of the last packet of a train has arrived at the device.
+     * The packets are processed in order, as by Receive(), all at that
+     * time, which is at most MaxBurstDuration of the sender after the
+     * arrival time of each packet.
+     *
+     * \param burst the received packets.
+     * \param rxTimes the time at which the last bit of each packet arrived.
+     */
+    void ReceiveBurst(Ptr<PacketBurst> burst, const std::vector<Time>& rxTimes);
+
     // The remaining methods are documented in ns3::NetDevice*
 
     void SetIfIndex(const uint32_t index) override;
@@ -170,6 +186,7 @@ class PointToPointNetDevice : public NetDevice
     bool IsBridge() const override;
 
     bool Send(Ptr<Packet> packet, const Address& dest, uint16_t protocolNumber) override;
+    bool SendBurst(Ptr<PacketBurst> burst, const Address& dest, uint16_t protocolNumber) override;
     bool SendFrom(Ptr<Packet> packet,
                   const Address& source,
                   const Address& dest,
@@ -242,6 +259,30 @@ class PointToPointNetDevice : public NetDevice
      */
     bool TransmitStart(Ptr<Packet> p);
 
+    /**
+     * Start Sending a Train of Back-to-Back Packets Down the Wire.
+     *
+     * The packets are transmitted one after the other, separated by the
+     * interframe gap, and the channel delivers them in a single event.  A
+     * single event is scheduled for the time at which the train has been
+     * completely transmitted.
+     *
+     * \see PointToPointChannel::TransmitBurst ()
+     * \see TransmitComplete()
+     * \param burst the packets to send
+     * \returns true if success, false on failure
+     */
+    bool TransmitBurstStart(Ptr<PacketBurst> burst);
+
+    /**
+     * Start sending the packets of a burst at the head of the transmit
+     * queue as a single train, as many as MaxBurstSize and MaxBurstDuration
+     * allow.
+     *
+     * \returns true if success, false on failure
+     */
+    bool TransmitQueuedBurst();
+
     /**
      * Stop Sending a Packet Down the Wire and Begin the Interframe Gap.
      *
@@ -297,6 +338,24 @@ class PointToPointNetDevice : public NetDevice
      */
     Ptr<Queue<Packet>> m_queue;
 
+    /**
+     * The maximum number of packets handed to SendBurst() which are
+     * transmitted back-to-back as a single train.
+     */
+    uint32_t m_maxBurstSize;
+
+    /**
+     * The maximum time between the end of the transmission of the first
+     * and of the last packet of a train.
+     */
+    Time m_maxBurstDuration;
+
+    /**
+     * The number of packets handed to SendBurst() left at the head of the
+     * transmit queue.
+     */
+    uint32_t m_burstLeft;
+
     /**
      * Error model for receive packet events
      */
@@ -431,7 +490,8 @@ class PointToPointNetDevice : public NetDevice
      */
     uint32_t m_mtu;
 
-    Ptr<Packet> m_currentPkt; //!< Current packet processed
+    Ptr<Packet> m_currentPkt;         //!< Current packet processed
+    Ptr<PacketBurst> m_currentBurst; //!< Current train of packets processed
 
     /**
      * \brief PPP to Ethernet protocol number mapping
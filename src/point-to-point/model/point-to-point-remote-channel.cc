@@ -12,6 +12,7 @@
 
 #include "ns3/log.h"
 #include "ns3/mpi-interface.h"
+#include "ns3/packet-burst.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
@@ -62,4 +63,21 @@ PointToPointRemoteChannel::TransmitStart(Ptr<const Packet> p,
     return true;
 }
 
+bool
+PointToPointRemoteChannel::TransmitBurst(Ptr<const PacketBurst> burst,
+                                         Ptr<PointToPointNetDevice> src,
+                                         const std::vector<Time>& txEnds)
+{
+    NS_LOG_FUNCTION(this << burst << src);
+    NS_ASSERT(burst->GetNPackets() == txEnds.size());
+
+    // The remote system schedules the reception of each packet
+    auto txEnd = txEnds.begin();
+    for (auto p = burst->Begin(); p != burst->End(); ++p, ++txEnd)
+    {
+        TransmitStart(*p, src, *txEnd);
+    }
+    return true;
+}
+
 } // namespace ns3
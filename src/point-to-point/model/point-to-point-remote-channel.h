@@ -56,6 +56,20 @@ class PointToPointRemoteChannel : public PointToPointChannel
      * \returns true if successful (currently always true)
      */
     bool TransmitStart(Ptr<const Packet> p, Ptr<PointToPointNetDevice> src, Time txTime) override;
+
+    /**
+     * \brief Transmit a train of packets, each packet being sent to the
+     * remote system as by TransmitStart()
+     *
+     * \param burst Packets to transmit
+     * \param src Source PointToPointNetDevice
+     * \param txEnds Time at which the transmission of each packet ends,
+     *        relative to now
+     * \returns true if successful (currently always true)
+     */
+    bool TransmitBurst(Ptr<const PacketBurst> burst,
+                       Ptr<PointToPointNetDevice> src,
+                       const std::vector<Time>& txEnds) override;
 };
 
 } // namespace ns3
@@ -8,12 +8,15 @@
 
 #include "ns3/drop-tail-queue.h"
 #include "ns3/net-device-queue-interface.h"
+#include "ns3/packet-burst.h"
 #include "ns3/point-to-point-channel.h"
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
 
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -128,6 +131,139 @@ PointToPointTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \brief Test class for the packet trains of the PointToPoint model
+ *
+ * It sends packets from one NetDevice to another, with and without packet
+ * trains, and checks when they are received and how many events were needed.
+ */
+class PointToPointBurstTest : public TestCase
+{
+  public:
+    /**
+     * \brief Create the test
+     */
+    PointToPointBurstTest();
+
+    /**
+     * \brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    std::vector<Time> m_rxTimes; //!< time at which each packet was received
+
+    /**
+     * \brief Send packets of 1000 bytes, including the PPP header, over a
+     * link at 8 Mb/s with a 1 ms delay
+     *
+     * \param maxBurstSize The MaxBurstSize of the sender.
+     * \param maxBurstDuration The MaxBurstDuration of the sender.
+     * \param nPackets The number of packets.
+     * \return The number of events executed.
+     */
+    uint64_t SendPackets(uint32_t maxBurstSize, Time maxBurstDuration, uint32_t nPackets);
+    /**
+     * \brief Callback function which records the time of reception
+     *
+     * \param dev The receiving device.
+     * \param pkt The received packet.
+     * \param mode The protocol mode used.
+     * \param sender The sender address.
+     *
+     * \return A boolean indicating packet handled properly.
+     */
+    bool RxPacket(Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address& sender);
+};
+
+PointToPointBurstTest::PointToPointBurstTest()
+    : TestCase("PointToPoint packet trains")
+{
+}
+
+bool
+PointToPointBurstTest::RxPacket(Ptr<NetDevice> dev,
+                                Ptr<const Packet> pkt,
+                                uint16_t mode,
+                                const Address& sender)
+{
+    m_rxTimes.push_back(Simulator::Now());
+    return true;
+}
+
+uint64_t
+PointToPointBurstTest::SendPackets(uint32_t maxBurstSize,
+                                   Time maxBurstDuration,
+                                   uint32_t nPackets)
+{
+    m_rxTimes.clear();
+
+    Ptr<Node> a = CreateObject<Node>();
+    Ptr<Node> b = CreateObject<Node>();
+    Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel>();
+    channel->SetAttribute("Delay", TimeValue(MilliSeconds(1)));
+
+    devA->Attach(channel);
+    devA->SetAddress(Mac48Address::Allocate());
+    devA->SetQueue(CreateObject<DropTailQueue<Packet>>());
+    devA->SetDataRate(DataRate("8Mb/s"));
+    devA->SetAttribute("MaxBurstSize", UintegerValue(maxBurstSize));
+    devA->SetAttribute("MaxBurstDuration", TimeValue(maxBurstDuration));
+    devB->Attach(channel);
+    devB->SetAddress(Mac48Address::Allocate());
+    devB->SetQueue(CreateObject<DropTailQueue<Packet>>());
+
+    a->AddDevice(devA);
+    b->AddDevice(devB);
+
+    devB->SetReceiveCallback(MakeCallback(&PointToPointBurstTest::RxPacket, this));
+    // initialize the nodes and devices, so that only the transmission events are counted
+    Simulator::Run();
+
+    Ptr<PacketBurst> burst = CreateObject<PacketBurst>();
+    for (uint32_t i = 0; i < nPackets; i++)
+    {
+        burst->AddPacket(Create<Packet>(998));
+    }
+    devA->SendBurst(burst, devA->GetBroadcast(), 0x800);
+
+    uint64_t events = Simulator::GetEventCount();
+    Simulator::Run();
+    events = Simulator::GetEventCount() - events;
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes.size(), nPackets, "packets lost");
+    return events;
+}
+
+void
+PointToPointBurstTest::DoRun()
+{
+    // one packet at a time
+    uint64_t events = SendPackets(1, Seconds(1), 5);
+    NS_TEST_EXPECT_MSG_EQ(events, 10, "one transmission and one reception event per packet");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes.front(), MilliSeconds(2), "wrong reception time");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes.back(), MilliSeconds(6), "wrong reception time");
+
+    // a single train, received when the last bit of its last packet arrives
+    events = SendPackets(5, Seconds(1), 5);
+    NS_TEST_EXPECT_MSG_EQ(events, 2, "one transmission and one reception event per train");
+    for (const auto& rxTime : m_rxTimes)
+    {
+        NS_TEST_EXPECT_MSG_EQ(rxTime, MilliSeconds(6), "wrong reception time");
+    }
+
+    // trains limited to 2.5 ms: three packets, then two
+    events = SendPackets(5, MicroSeconds(2500), 5);
+    NS_TEST_EXPECT_MSG_EQ(events, 4, "one transmission and one reception event per train");
+    for (uint32_t i = 0; i < m_rxTimes.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_rxTimes[i], MilliSeconds(i < 3 ? 4 : 6), "wrong reception time");
+    }
+}
+
 /**
  * \brief TestSuite for PointToPoint module
  */
@@ -144,6 +280,7 @@ PointToPointTestSuite::PointToPointTestSuite()
     : TestSuite("devices-point-to-point", Type::UNIT)
 {
     AddTestCase(new PointToPointTest, TestCase::Duration::QUICK);
+    AddTestCase(new PointToPointBurstTest, TestCase::Duration::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
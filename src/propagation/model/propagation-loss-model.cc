@@ -18,7 +18,9 @@
 #include "ns3/pointer.h"
 #include "ns3/string.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace ns3
 {
@@ -71,6 +73,30 @@ PropagationLossModel::CalcRxPower(double txPowerDbm,
     return self;
 }
 
+double
+PropagationLossModel::GetMaxRange(double txPowerDbm, double rxThresholdDbm) const
+{
+    double range = DoGetMaxRange(txPowerDbm, rxThresholdDbm);
+    if (m_next)
+    {
+        // the models do not amplify the signal, so it is below the threshold
+        // beyond the range of any of them
+        double nextRange = m_next->GetMaxRange(txPowerDbm, rxThresholdDbm);
+        if (std::isinf(range) || std::isinf(nextRange))
+        {
+            return std::numeric_limits<double>::infinity();
+        }
+        range = std::min(range, nextRange);
+    }
+    return range;
+}
+
+double
+PropagationLossModel::DoGetMaxRange(double txPowerDbm, double rxThresholdDbm) const
+{
+    return std::numeric_limits<double>::infinity();
+}
+
 int64_t
 PropagationLossModel::AssignStreams(int64_t stream)
 {
@@ -278,6 +304,23 @@ FriisPropagationLossModel::DoAssignStreams(int64_t stream)
     return 0;
 }
 
+double
+FriisPropagationLossModel::DoGetMaxRange(double txPowerDbm, double rxThresholdDbm) const
+{
+    if (m_minLoss < 0 || m_systemLoss < 1)
+    {
+        // the signal may be amplified
+        return std::numeric_limits<double>::infinity();
+    }
+    double maxLossDb = txPowerDbm - rxThresholdDbm;
+    if (m_minLoss > maxLossDb)
+    {
+        return 0;
+    }
+    // distance at which the loss computed by DoCalcRxPower is maxLossDb
+    return m_lambda / (4 * M_PI) * std::sqrt(std::pow(10, maxLossDb / 10) / m_systemLoss);
+}
+
 // ------------------------------------------------------------------------- //
 // -- Two-Ray Ground Model ported from NS-2 -- tomhewer@mac.com -- Nov09 //
 
@@ -555,6 +598,22 @@ LogDistancePropagationLossModel::DoAssignStreams(int64_t stream)
     return 0;
 }
 
+double
+LogDistancePropagationLossModel::DoGetMaxRange(double txPowerDbm, double rxThresholdDbm) const
+{
+    if (m_referenceLoss < 0 || m_exponent <= 0)
+    {
+        // the signal may be amplified, or not decrease with the distance
+        return std::numeric_limits<double>::infinity();
+    }
+    double maxPathLossDb = txPowerDbm - rxThresholdDbm - m_referenceLoss;
+    if (maxPathLossDb < 0)
+    {
+        return 0;
+    }
+    return m_referenceDistance * std::pow(10, maxPathLossDb / (10 * m_exponent));
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED(ThreeLogDistancePropagationLossModel);
@@ -949,6 +1008,12 @@ RangePropagationLossModel::DoAssignStreams(int64_t stream)
     return 0;
 }
 
+double
+RangePropagationLossModel::DoGetMaxRange(double txPowerDbm, double rxThresholdDbm) const
+{
+    return m_range;
+}
+
 // ------------------------------------------------------------------------- //
 
 } // namespace ns3
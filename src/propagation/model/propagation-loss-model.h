@@ -90,6 +90,20 @@ class PropagationLossModel : public Object
      */
     double CalcRxPower(double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
 
+    /**
+     * Returns a distance beyond which the Rx power, taking into account all
+     * the PropagationLossModel(s) chained to the current one, is below a
+     * threshold.
+     *
+     * The distance is only known if every model in the chain bounds it and
+     * never amplifies the signal; otherwise, infinity is returned.
+     *
+     * \param txPowerDbm the highest transmission power (in dBm)
+     * \param rxThresholdDbm the threshold (in dBm)
+     * \returns the distance (in m), or infinity
+     */
+    double GetMaxRange(double txPowerDbm, double rxThresholdDbm) const;
+
     /**
      * If this loss model uses objects of type RandomVariableStream,
      * set the stream numbers to the integers starting with the offset
@@ -128,6 +142,18 @@ class PropagationLossModel : public Object
                                  Ptr<MobilityModel> a,
                                  Ptr<MobilityModel> b) const = 0;
 
+    /**
+     * Subclasses whose Rx power is never above the Tx power, and decreases
+     * with the distance, can implement this to bound their range.  The
+     * default implementation returns infinity.
+     *
+     * \param txPowerDbm the highest transmission power (in dBm)
+     * \param rxThresholdDbm the threshold (in dBm)
+     * \returns the distance (in m) beyond which the Rx power is below the
+     *          threshold, or infinity
+     */
+    virtual double DoGetMaxRange(double txPowerDbm, double rxThresholdDbm) const;
+
     Ptr<PropagationLossModel> m_next; //!< Next propagation loss model in the list
 };
 
@@ -295,6 +321,7 @@ class FriisPropagationLossModel : public PropagationLossModel
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
     int64_t DoAssignStreams(int64_t stream) override;
+    double DoGetMaxRange(double txPowerDbm, double rxThresholdDbm) const override;
 
     /**
      * Transforms a Dbm value to Watt
@@ -487,6 +514,8 @@ class LogDistancePropagationLossModel : public PropagationLossModel
 
     int64_t DoAssignStreams(int64_t stream) override;
 
+    double DoGetMaxRange(double txPowerDbm, double rxThresholdDbm) const override;
+
     /**
      *  Creates a default reference loss model
      * \return a default reference loss model
@@ -792,6 +821,8 @@ class RangePropagationLossModel : public PropagationLossModel
 
     int64_t DoAssignStreams(int64_t stream) override;
 
+    double DoGetMaxRange(double txPowerDbm, double rxThresholdDbm) const override;
+
     double m_range; //!< Maximum Transmission Range (meters)
 };
 
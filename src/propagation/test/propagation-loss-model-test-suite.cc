@@ -13,6 +13,8 @@
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 
+#include <cmath>
+
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE("PropagationLossModelsTest");
@@ -478,6 +480,95 @@ RangePropagationLossModelTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief PropagationLossModel::GetMaxRange Test
+ */
+class MaxRangePropagationLossModelTestCase : public TestCase
+{
+  public:
+    MaxRangePropagationLossModelTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check that the Rx power is at least the threshold at the max range,
+     * and below it further.
+     *
+     * \param model the loss model
+     * \param txPowerDbm the Tx power
+     * \param rxThresholdDbm the threshold
+     */
+    void CheckMaxRange(Ptr<PropagationLossModel> model, double txPowerDbm, double rxThresholdDbm);
+};
+
+MaxRangePropagationLossModelTestCase::MaxRangePropagationLossModelTestCase()
+    : TestCase("Test PropagationLossModel::GetMaxRange")
+{
+}
+
+void
+MaxRangePropagationLossModelTestCase::CheckMaxRange(Ptr<PropagationLossModel> model,
+                                                    double txPowerDbm,
+                                                    double rxThresholdDbm)
+{
+    double range = model->GetMaxRange(txPowerDbm, rxThresholdDbm);
+    NS_TEST_ASSERT_MSG_EQ(std::isfinite(range), true, "The range should be known");
+    Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+    b->SetPosition(Vector(range * (1 - 1e-9), 0, 0));
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(model->CalcRxPower(txPowerDbm, a, b) + 1e-6,
+                                rxThresholdDbm,
+                                "The Rx power should reach the threshold at " << range << " m");
+    b->SetPosition(Vector(range * (1 + 1e-6) + 1e-6, 0, 0));
+    NS_TEST_EXPECT_MSG_LT(model->CalcRxPower(txPowerDbm, a, b),
+                          rxThresholdDbm,
+                          "The Rx power should be below the threshold beyond " << range << " m");
+}
+
+void
+MaxRangePropagationLossModelTestCase::DoRun()
+{
+    Ptr<FriisPropagationLossModel> friis = CreateObject<FriisPropagationLossModel>();
+    friis->SetFrequency(5.15e9);
+    CheckMaxRange(friis, 16.0206, -101.0);
+    CheckMaxRange(friis, 20.0, -62.0);
+
+    Ptr<LogDistancePropagationLossModel> logDistance =
+        CreateObject<LogDistancePropagationLossModel>();
+    CheckMaxRange(logDistance, 16.0206, -101.0);
+    logDistance->SetPathLossExponent(3.5);
+    CheckMaxRange(logDistance, 16.0206, -82.0);
+    NS_TEST_EXPECT_MSG_EQ(logDistance->GetMaxRange(0.0, 0.0),
+                          0.0,
+                          "The threshold is not reached at any distance");
+
+    Ptr<RangePropagationLossModel> range = CreateObject<RangePropagationLossModel>();
+    range->SetAttribute("MaxRange", DoubleValue(127.2));
+    CheckMaxRange(range, -80.0, -82.0);
+
+    // the range of a chain is the smallest one
+    logDistance->SetPathLossExponent(3);
+    logDistance->SetNext(range);
+    NS_TEST_EXPECT_MSG_EQ(logDistance->GetMaxRange(16.0206, -101.0),
+                          127.2,
+                          "The range of the chain should be the range of the last model");
+    CheckMaxRange(logDistance, 16.0206, -101.0);
+
+    // the range of random models is not known
+    Ptr<NakagamiPropagationLossModel> nakagami = CreateObject<NakagamiPropagationLossModel>();
+    NS_TEST_EXPECT_MSG_EQ(std::isinf(nakagami->GetMaxRange(16.0206, -101.0)),
+                          true,
+                          "The range of the Nakagami model should not be known");
+    friis->SetNext(nakagami);
+    NS_TEST_EXPECT_MSG_EQ(std::isinf(friis->GetMaxRange(16.0206, -101.0)),
+                          true,
+                          "The range of a chain with a Nakagami model should not be known");
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup propagation-tests
  *
@@ -489,6 +580,7 @@ RangePropagationLossModelTestCase::DoRun()
  *   - LogDistancePropagationLossModel
  *   - MatrixPropagationLossModel
  *   - RangePropagationLossModel
+ *   - PropagationLossModel::GetMaxRange
  */
 class PropagationLossModelsTestSuite : public TestSuite
 {
@@ -504,6 +596,7 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite()
     AddTestCase(new LogDistancePropagationLossModelTestCase, TestCase::Duration::QUICK);
     AddTestCase(new MatrixPropagationLossModelTestCase, TestCase::Duration::QUICK);
     AddTestCase(new RangePropagationLossModelTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new MaxRangePropagationLossModelTestCase, TestCase::Duration::QUICK);
 }
 
 /// Static variable for test initialization
@@ -15,6 +15,7 @@
 
 #include <ns3/angles.h>
 #include <ns3/antenna-model.h>
+#include <ns3/boolean.h>
 #include <ns3/double.h>
 #include <ns3/log.h>
 #include <ns3/mobility-model.h>
@@ -70,7 +71,8 @@ RxSpectrumModelInfo::RxSpectrumModelInfo(Ptr<const SpectrumModel> rxSpectrumMode
 }
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel()
-    : m_numDevices{0}
+    : m_numDevices{0},
+      m_skipOrthogonalReceivers{false}
 {
     NS_LOG_FUNCTION(this);
 }
@@ -87,12 +89,20 @@ MultiModelSpectrumChannel::DoDispose()
 TypeId
 MultiModelSpectrumChannel::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::MultiModelSpectrumChannel")
-                            .SetParent<SpectrumChannel>()
-                            .SetGroupName("Spectrum")
-                            .AddConstructor<MultiModelSpectrumChannel>()
-
-        ;
+    static TypeId tid =
+        TypeId("ns3::MultiModelSpectrumChannel")
+            .SetParent<SpectrumChannel>()
+            .SetGroupName("Spectrum")
+            .AddConstructor<MultiModelSpectrumChannel>()
+            .AddAttribute(
+                "SkipOrthogonalReceivers",
+                "If true, the signals are not copied to the receivers whose RX "
+                "SpectrumModel is orthogonal to the TX SpectrumModel, which discard "
+                "them anyway. The propagation models are not called, and the Gain "
+                "and PathLoss traces are not fired, for these receivers.",
+                BooleanValue(false),
+                MakeBooleanAccessor(&MultiModelSpectrumChannel::m_skipOrthogonalReceivers),
+                MakeBooleanChecker());
     return tid;
 }
 
@@ -229,6 +239,15 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     auto txSpectrumModelUid = txParams->psd->GetSpectrumModelUid();
     NS_LOG_LOGIC("txSpectrumModelUid " << txSpectrumModelUid);
 
+    // the converters of the TX SpectrumModel, which exist for the RX
+    // SpectrumModels which are not orthogonal to it
+    const SpectrumConverterMap_t* converters = nullptr;
+    if (m_skipOrthogonalReceivers)
+    {
+        converters = &FindAndEventuallyAddTxSpectrumModel(txParams->psd->GetSpectrumModel())
+                          ->second.m_spectrumConverterMap;
+    }
+
     for (auto rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
          rxInfoIterator != m_rxSpectrumModelInfoMap.end();
          ++rxInfoIterator)
@@ -236,6 +255,13 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
         SpectrumModelUid_t rxSpectrumModelUid = rxInfoIterator->second.m_rxSpectrumModel->GetUid();
         NS_LOG_LOGIC("rxSpectrumModelUids " << rxSpectrumModelUid);
 
+        if (converters && rxSpectrumModelUid != txSpectrumModelUid &&
+            converters->find(rxSpectrumModelUid) == converters->end())
+        {
+            NS_LOG_LOGIC("Skipping the receivers with an orthogonal SpectrumModel");
+            continue;
+        }
+
         for (auto rxPhyIterator = rxInfoIterator->second.m_rxPhys.begin();
              rxPhyIterator != rxInfoIterator->second.m_rxPhys.end();
              ++rxPhyIterator)
@@ -88,6 +88,12 @@ typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap
  * for this to work is that, after the SpectrumPhy switched its
  * SpectrumModel,  MultiModelSpectrumChannel::AddRx () is
  * called again passing the pointer to that SpectrumPhy.
+ *
+ * The receiving SpectrumPhy instances are grouped by RX SpectrumModel.
+ * When the SkipOrthogonalReceivers attribute is true, a signal is not
+ * copied to the groups whose SpectrumModel is orthogonal to the TX
+ * SpectrumModel, which would discard it, e.g. the PHYs operating on
+ * distant frequency channels.
  */
 class MultiModelSpectrumChannel : public SpectrumChannel
 {
@@ -152,6 +158,12 @@ class MultiModelSpectrumChannel : public SpectrumChannel
      * Number of devices connected to the channel.
      */
     std::size_t m_numDevices;
+
+    /**
+     * Whether the receivers using a SpectrumModel orthogonal to the TX
+     * SpectrumModel are skipped.
+     */
+    bool m_skipOrthogonalReceivers;
 };
 
 } // namespace ns3
@@ -0,0 +1,226 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include <ns3/boolean.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/log.h>
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/net-device.h>
+#include <ns3/simulator.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/test.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("MultiModelSpectrumChannelTest");
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief SpectrumPhy counting the signals it receives.
+ */
+class CountingSpectrumPhy : public SpectrumPhy
+{
+  public:
+    /**
+     * Constructor
+     * \param rxSpectrumModel the RX spectrum model
+     * \param position the position of the PHY
+     */
+    CountingSpectrumPhy(Ptr<const SpectrumModel> rxSpectrumModel, const Vector& position);
+
+    void SetDevice(Ptr<NetDevice> d) override;
+    Ptr<NetDevice> GetDevice() const override;
+    void SetMobility(Ptr<MobilityModel> m) override;
+    Ptr<MobilityModel> GetMobility() const override;
+    void SetChannel(Ptr<SpectrumChannel> c) override;
+    Ptr<const SpectrumModel> GetRxSpectrumModel() const override;
+    Ptr<Object> GetAntenna() const override;
+    void StartRx(Ptr<SpectrumSignalParameters> params) override;
+
+    std::size_t m_nRx; //!< number of signals received
+
+  private:
+    Ptr<const SpectrumModel> m_rxSpectrumModel; //!< RX spectrum model
+    Ptr<MobilityModel> m_mobility;              //!< mobility model
+};
+
+CountingSpectrumPhy::CountingSpectrumPhy(Ptr<const SpectrumModel> rxSpectrumModel,
+                                         const Vector& position)
+    : m_nRx(0),
+      m_rxSpectrumModel(rxSpectrumModel),
+      m_mobility(CreateObject<ConstantPositionMobilityModel>())
+{
+    m_mobility->SetPosition(position);
+}
+
+void
+CountingSpectrumPhy::SetDevice(Ptr<NetDevice> d)
+{
+}
+
+Ptr<NetDevice>
+CountingSpectrumPhy::GetDevice() const
+{
+    return nullptr;
+}
+
+void
+CountingSpectrumPhy::SetMobility(Ptr<MobilityModel> m)
+{
+    m_mobility = m;
+}
+
+Ptr<MobilityModel>
+CountingSpectrumPhy::GetMobility() const
+{
+    return m_mobility;
+}
+
+void
+CountingSpectrumPhy::SetChannel(Ptr<SpectrumChannel> c)
+{
+}
+
+Ptr<const SpectrumModel>
+CountingSpectrumPhy::GetRxSpectrumModel() const
+{
+    return m_rxSpectrumModel;
+}
+
+Ptr<Object>
+CountingSpectrumPhy::GetAntenna() const
+{
+    return nullptr;
+}
+
+void
+CountingSpectrumPhy::StartRx(Ptr<SpectrumSignalParameters> params)
+{
+    ++m_nRx;
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Check that the receivers whose spectrum model is orthogonal to the
+ * TX spectrum model are skipped when the SkipOrthogonalReceivers attribute
+ * of MultiModelSpectrumChannel is true, and that the other receivers get the
+ * same signals.
+ */
+class MultiModelSpectrumChannelSkipTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * \param skip the value of the SkipOrthogonalReceivers attribute
+     */
+    MultiModelSpectrumChannelSkipTestCase(bool skip);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Callback of the PathLoss trace of the channel.
+     *
+     * \param txPhy the transmitter
+     * \param rxPhy the receiver
+     * \param lossDb the path loss
+     */
+    void PathLoss(Ptr<const SpectrumPhy> txPhy, Ptr<const SpectrumPhy> rxPhy, double lossDb);
+
+    bool m_skip;           //!< the value of the SkipOrthogonalReceivers attribute
+    std::size_t m_nLosses; //!< number of path losses computed
+};
+
+MultiModelSpectrumChannelSkipTestCase::MultiModelSpectrumChannelSkipTestCase(bool skip)
+    : TestCase(std::string("Check the receivers visited by MultiModelSpectrumChannel, ") +
+               (skip ? "skipping" : "not skipping") + " the orthogonal ones"),
+      m_skip(skip),
+      m_nLosses(0)
+{
+}
+
+void
+MultiModelSpectrumChannelSkipTestCase::PathLoss(Ptr<const SpectrumPhy> txPhy,
+                                                Ptr<const SpectrumPhy> rxPhy,
+                                                double lossDb)
+{
+    ++m_nLosses;
+}
+
+void
+MultiModelSpectrumChannelSkipTestCase::DoRun()
+{
+    // two bands at 1 GHz, the same bands with a third one, overlapping the
+    // first model, and two bands at 2 GHz, orthogonal to it
+    auto model = Create<SpectrumModel>(Bands{{995e6, 1000e6, 1005e6}, {1005e6, 1010e6, 1015e6}});
+    auto overlapping = Create<SpectrumModel>(
+        Bands{{995e6, 1000e6, 1005e6}, {1005e6, 1010e6, 1015e6}, {1015e6, 1020e6, 1025e6}});
+    auto orthogonal =
+        Create<SpectrumModel>(Bands{{1995e6, 2000e6, 2005e6}, {2005e6, 2010e6, 2015e6}});
+
+    auto channel = CreateObject<MultiModelSpectrumChannel>();
+    channel->SetAttribute("SkipOrthogonalReceivers", BooleanValue(m_skip));
+    channel->TraceConnectWithoutContext(
+        "PathLoss",
+        MakeCallback(&MultiModelSpectrumChannelSkipTestCase::PathLoss, this));
+
+    auto tx = CreateObject<CountingSpectrumPhy>(model, Vector(0, 0, 0));
+    std::vector<Ptr<CountingSpectrumPhy>> rxs{
+        CreateObject<CountingSpectrumPhy>(model, Vector(10, 0, 0)),
+        CreateObject<CountingSpectrumPhy>(overlapping, Vector(20, 0, 0)),
+        CreateObject<CountingSpectrumPhy>(orthogonal, Vector(30, 0, 0)),
+        CreateObject<CountingSpectrumPhy>(orthogonal, Vector(40, 0, 0)),
+    };
+    channel->AddRx(tx);
+    for (const auto& rx : rxs)
+    {
+        channel->AddRx(rx);
+    }
+
+    auto params = Create<SpectrumSignalParameters>();
+    params->txPhy = tx;
+    params->duration = MilliSeconds(1);
+    params->psd = Create<SpectrumValue>(model);
+    *params->psd = 1e-9;
+    for (int i = 0; i < 3; ++i)
+    {
+        Simulator::Schedule(MilliSeconds(10 * i), &SpectrumChannel::StartTx, channel, params);
+    }
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(rxs[0]->m_nRx, 3, "The PHY on the same model should receive");
+    NS_TEST_EXPECT_MSG_EQ(rxs[1]->m_nRx, 3, "The PHY on an overlapping model should receive");
+    NS_TEST_EXPECT_MSG_EQ(rxs[2]->m_nRx, 0, "The PHY on an orthogonal model should not receive");
+    NS_TEST_EXPECT_MSG_EQ(rxs[3]->m_nRx, 0, "The PHY on an orthogonal model should not receive");
+    NS_TEST_EXPECT_MSG_EQ(m_nLosses,
+                          (m_skip ? 2 : 4) * 3,
+                          "Unexpected number of path losses computed");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief MultiModelSpectrumChannel Test Suite
+ */
+class MultiModelSpectrumChannelTestSuite : public TestSuite
+{
+  public:
+    MultiModelSpectrumChannelTestSuite();
+};
+
+MultiModelSpectrumChannelTestSuite::MultiModelSpectrumChannelTestSuite()
+    : TestSuite("multi-model-spectrum-channel", Type::UNIT)
+{
+    AddTestCase(new MultiModelSpectrumChannelSkipTestCase(false), TestCase::Duration::QUICK);
+    AddTestCase(new MultiModelSpectrumChannelSkipTestCase(true), TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static MultiModelSpectrumChannelTestSuite g_multiModelSpectrumChannelTestSuite;
@@ -0,0 +1,245 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This example measures the wall clock time taken to simulate a growing
+// number of BSSs sharing a single channel object, each BSS operating on
+// its own 20 MHz channel in the 5 GHz band (the channels are reused beyond
+// 25 BSSs). Each BSS is made of an AP and its stations, which send packets
+// to the AP. The BSSs are laid out on a square grid.
+//
+// The number of BSSs is doubled from 1 to maxBss, and each scenario is
+// simulated with a YansWifiChannel, without and with its SpatialCulling
+// attribute set, and with a MultiModelSpectrumChannel, without and with its
+// SkipOrthogonalReceivers attribute set. For each run, the example prints
+// the wall clock time spent in Simulator::Run() and the number of packets
+// received by the APs.
+//
+// Example usage:
+//   ./ns3 run "wifi-bss-scaling --maxBss=64 --nStas=4 --simulationTime=2s"
+
+#include "ns3/boolean.h"
+#include "ns3/command-line.h"
+#include "ns3/log.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/node-container.h"
+#include "ns3/packet-socket-client.h"
+#include "ns3/packet-socket-helper.h"
+#include "ns3/packet-socket-server.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-wifi-helper.h"
+#include "ns3/ssid.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/yans-wifi-channel.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("WifiBssScaling");
+
+/// The 20 MHz channels of the 5 GHz band
+const uint8_t CHANNELS[] = {36,  40,  44,  48,  52,  56,  60,  64,  100, 104, 108, 112, 116,
+                            120, 124, 128, 132, 136, 140, 144, 149, 153, 157, 161, 165};
+
+/**
+ * Count a packet received by an AP.
+ *
+ * \param nRx the number of packets received
+ * \param packet the packet
+ * \param from the address of the sender
+ */
+void
+CountRx(uint64_t* nRx, Ptr<const Packet> packet, const Address& from)
+{
+    ++(*nRx);
+}
+
+/**
+ * Simulate a scenario.
+ *
+ * \param spectrum whether to use a MultiModelSpectrumChannel rather than a YansWifiChannel
+ * \param optimized whether to set the SpatialCulling attribute of the YansWifiChannel or the
+ *        SkipOrthogonalReceivers attribute of the MultiModelSpectrumChannel
+ * \param nBss the number of BSSs
+ * \param nStas the number of stations per BSS
+ * \param distance the distance between neighboring APs
+ * \param interval the interval between the packets sent by each station
+ * \param simulationTime the duration of the traffic
+ * \param [out] nRx the number of packets received by the APs
+ * \returns the wall clock time spent in Simulator::Run(), in seconds
+ */
+double
+Run(bool spectrum,
+    bool optimized,
+    uint32_t nBss,
+    uint32_t nStas,
+    double distance,
+    Time interval,
+    Time simulationTime,
+    uint64_t& nRx)
+{
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("OfdmRate24Mbps"),
+                                 "ControlMode",
+                                 StringValue("OfdmRate6Mbps"));
+
+    YansWifiPhyHelper yansPhy;
+    SpectrumWifiPhyHelper spectrumPhy;
+    if (spectrum)
+    {
+        auto channel = CreateObject<MultiModelSpectrumChannel>();
+        channel->SetAttribute("SkipOrthogonalReceivers", BooleanValue(optimized));
+        channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+        channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+        spectrumPhy.SetChannel(channel);
+    }
+    else
+    {
+        auto channel = YansWifiChannelHelper::Default().Create();
+        channel->SetAttribute("SpatialCulling", BooleanValue(optimized));
+        yansPhy.SetChannel(channel);
+    }
+    WifiPhyHelper& phy = spectrum ? static_cast<WifiPhyHelper&>(spectrumPhy) : yansPhy;
+
+    WifiMacHelper mac;
+    MobilityHelper mobility;
+    PacketSocketHelper packetSocket;
+    NetDeviceContainer devices;
+    nRx = 0;
+    const auto side = static_cast<uint32_t>(std::ceil(std::sqrt(nBss)));
+
+    for (uint32_t bss = 0; bss < nBss; ++bss)
+    {
+        NodeContainer apNode(1);
+        NodeContainer staNodes(nStas);
+        const auto channelNumber = CHANNELS[bss % std::size(CHANNELS)];
+        phy.Set("ChannelSettings",
+                StringValue("{" + std::to_string(channelNumber) + ", 20, BAND_5GHZ, 0}"));
+
+        Ssid ssid("bss-" + std::to_string(bss));
+        mac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
+        auto apDevice = wifi.Install(phy, mac, apNode).Get(0);
+        mac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid));
+        auto staDevices = wifi.Install(phy, mac, staNodes);
+        devices.Add(apDevice);
+        devices.Add(staDevices);
+
+        // the stations are on a circle of radius 5 m around the AP
+        auto positions = CreateObject<ListPositionAllocator>();
+        const Vector ap((bss % side) * distance, (bss / side) * distance, 1.5);
+        positions->Add(ap);
+        for (uint32_t i = 0; i < nStas; ++i)
+        {
+            const double angle = 2 * M_PI * i / nStas;
+            positions->Add(Vector(ap.x + 5 * std::cos(angle), ap.y + 5 * std::sin(angle), 1.5));
+        }
+        mobility.SetPositionAllocator(positions);
+        mobility.Install(apNode);
+        mobility.Install(staNodes);
+
+        packetSocket.Install(apNode);
+        packetSocket.Install(staNodes);
+
+        PacketSocketAddress local;
+        local.SetSingleDevice(apDevice->GetIfIndex());
+        local.SetProtocol(1);
+        auto server = CreateObject<PacketSocketServer>();
+        server->SetLocal(local);
+        server->TraceConnectWithoutContext("Rx", MakeBoundCallback(&CountRx, &nRx));
+        apNode.Get(0)->AddApplication(server);
+
+        for (uint32_t i = 0; i < nStas; ++i)
+        {
+            PacketSocketAddress remote;
+            remote.SetSingleDevice(staDevices.Get(i)->GetIfIndex());
+            remote.SetPhysicalAddress(apDevice->GetAddress());
+            remote.SetProtocol(1);
+            auto client = CreateObject<PacketSocketClient>();
+            client->SetAttribute("PacketSize", UintegerValue(500));
+            client->SetAttribute("MaxPackets", UintegerValue(0));
+            client->SetAttribute("Interval", TimeValue(interval));
+            client->SetRemote(remote);
+            staNodes.Get(i)->AddApplication(client);
+            // the stations start sending once associated, at different times
+            client->SetStartTime(Seconds(1) + interval * (bss * nStas + i) / (nBss * nStas));
+        }
+    }
+
+    // the runs draw the same random numbers
+    wifi.AssignStreams(devices, 0);
+
+    Simulator::Stop(Seconds(1) + simulationTime);
+    const auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    Simulator::Destroy();
+    return elapsed.count();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t maxBss{32};
+    uint32_t nStas{4};
+    double distance{50};
+    Time interval{MilliSeconds(10)};
+    Time simulationTime{Seconds(1)};
+    bool yans{true};
+    bool spectrum{true};
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("maxBss", "The largest number of BSSs", maxBss);
+    cmd.AddValue("nStas", "The number of stations per BSS", nStas);
+    cmd.AddValue("distance", "The distance between neighboring APs (m)", distance);
+    cmd.AddValue("interval", "The interval between the packets sent by a station", interval);
+    cmd.AddValue("simulationTime", "The duration of the traffic", simulationTime);
+    cmd.AddValue("yans", "Whether to simulate the scenarios with a YansWifiChannel", yans);
+    cmd.AddValue("spectrum",
+                 "Whether to simulate the scenarios with a MultiModelSpectrumChannel",
+                 spectrum);
+    cmd.Parse(argc, argv);
+
+    std::cout << std::setw(10) << "channel" << std::setw(11) << "optimized" << std::setw(7)
+              << "nBss" << std::setw(8) << "nNodes" << std::setw(12) << "wall (s)" << std::setw(12)
+              << "rx packets" << std::endl;
+    for (uint32_t nBss = 1; nBss <= maxBss; nBss *= 2)
+    {
+        for (bool useSpectrum : {false, true})
+        {
+            if ((useSpectrum && !spectrum) || (!useSpectrum && !yans))
+            {
+                continue;
+            }
+            for (bool optimized : {false, true})
+            {
+                uint64_t nRx;
+                const auto wall = Run(useSpectrum,
+                                      optimized,
+                                      nBss,
+                                      nStas,
+                                      distance,
+                                      interval,
+                                      simulationTime,
+                                      nRx);
+                std::cout << std::setw(10) << (useSpectrum ? "spectrum" : "yans") << std::setw(11)
+                          << (optimized ? "yes" : "no") << std::setw(7) << nBss << std::setw(8)
+                          << nBss * (nStas + 1) << std::setw(12) << std::fixed
+                          << std::setprecision(3) << wall << std::setw(12) << nRx << std::endl;
+            }
+        }
+    }
+    return 0;
+}
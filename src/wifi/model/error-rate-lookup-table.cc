@@ -0,0 +1,48 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "error-rate-lookup-table.h"
+
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ErrorRateLookupTable");
+
+ErrorRateLookupTable::ErrorRateLookupTable(const std::function<double(double)>& pe)
+    : m_first(0)
+{
+    NS_LOG_FUNCTION(this);
+    for (int exponent = MIN_EXPONENT; exponent < MAX_EXPONENT; ++exponent)
+    {
+        for (int i = 0; i < RESOLUTION; ++i)
+        {
+            const auto value = pe(std::ldexp(1.0 + static_cast<double>(i) / RESOLUTION, exponent));
+            if (value >= MAX_PE)
+            {
+                // the table starts after the last point at which pe is too large
+                m_first += m_logSuccess.size() + 1;
+                m_logSuccess.clear();
+                continue;
+            }
+            if (1.0 - value == 1.0)
+            {
+                m_logSuccess.push_back(0);
+                NS_LOG_DEBUG("Table of " << m_logSuccess.size() << " points");
+                return;
+            }
+            m_logSuccess.push_back(std::log1p(-value));
+        }
+    }
+    NS_LOG_DEBUG("Table of " << m_logSuccess.size() << " points");
+}
+
+std::size_t
+ErrorRateLookupTable::GetSize() const
+{
+    return m_logSuccess.size();
+}
+
+} // namespace ns3
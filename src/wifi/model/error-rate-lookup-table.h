@@ -0,0 +1,95 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef ERROR_RATE_LOOKUP_TABLE_H
+#define ERROR_RATE_LOOKUP_TABLE_H
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup wifi
+ * \brief Lookup table of the success probability of a coded bit as a function of the SNR.
+ *
+ * The NIST and YANS error rate models compute the success rate of a chunk of n bits as
+ * (1 - pe)^n, where pe is the error probability of a coded bit, obtained from erfc and long
+ * polynomial or binomial series of the uncoded BER. This table stores log(1 - pe) at
+ * RESOLUTION points per octave of SNR, and linearly interpolates between them. The success
+ * rate of a chunk is then exp(n * log(1 - pe)) whatever its size, and the success rate of
+ * several chunks is the exponential of the sum of their terms.
+ *
+ * The table covers the SNRs between the largest one at which pe is at least MAX_PE (below,
+ * the chunk is almost certainly lost and the caller falls back to the exact computation) and
+ * the smallest one at which 1 - pe rounds to 1 (above, the chunk is always received, as with
+ * the exact computation). pe is assumed to decrease with the SNR.
+ *
+ * With RESOLUTION points per octave, the absolute error on the success rate of a chunk of
+ * any size, or of several chunks, is below 1e-4 for all the NIST and YANS modes.
+ */
+class ErrorRateLookupTable
+{
+  public:
+    static constexpr int RESOLUTION = 1024;  //!< Number of points per octave of SNR
+    static constexpr double MAX_PE = 0.5;    //!< Largest error probability in the table
+    static constexpr int MIN_EXPONENT = -20; //!< Log2 of the SNR of the first point considered
+    static constexpr int MAX_EXPONENT = 40;  //!< Log2 of the SNR above which pe is taken as 0
+
+    /**
+     * Build the table.
+     *
+     * \param pe the error probability of a coded bit, as a function of the SNR (linear scale)
+     */
+    explicit ErrorRateLookupTable(const std::function<double(double)>& pe);
+
+    /**
+     * Get the logarithm of the success probability of a coded bit.
+     *
+     * \param snr the SNR (linear scale)
+     * \param [out] logSuccess log(1 - pe) at the given SNR
+     * \return false if the SNR is below the table, in which case logSuccess is not set
+     */
+    bool GetLogSuccessRate(double snr, double& logSuccess) const;
+
+    /**
+     * \return the number of points in the table
+     */
+    std::size_t GetSize() const;
+
+  private:
+    std::vector<double> m_logSuccess; //!< log(1 - pe) at each point of the table
+    int64_t m_first;                  //!< index of the first point, in the grid from 2^MIN_EXPONENT
+};
+
+inline bool
+ErrorRateLookupTable::GetLogSuccessRate(double snr, double& logSuccess) const
+{
+    // snr = mantissa * 2^exponent, with mantissa in [0.5, 1), and the points of the octave
+    // [2^(exponent - 1), 2^exponent) are evenly spaced
+    int exponent;
+    const double position = (2 * std::frexp(snr, &exponent) - 1) * RESOLUTION;
+    const auto offset = static_cast<int64_t>(position);
+    const auto index =
+        static_cast<int64_t>(exponent - 1 - MIN_EXPONENT) * RESOLUTION + offset - m_first;
+    if (!(snr > 0) || index < 0)
+    {
+        return false;
+    }
+    if (index + 1 >= static_cast<int64_t>(m_logSuccess.size()))
+    {
+        logSuccess = 0;
+        return true;
+    }
+    const auto low = m_logSuccess[index];
+    logSuccess = low + (position - offset) * (m_logSuccess[index + 1] - low);
+    return true;
+}
+
+} // namespace ns3
+
+#endif /* ERROR_RATE_LOOKUP_TABLE_H */
@@ -13,6 +13,8 @@
 
 #include "ns3/object.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -24,6 +26,15 @@ namespace ns3
 class ErrorRateModel : public Object
 {
   public:
+    /**
+     * A chunk of a packet, received with a constant SNR.
+     */
+    struct Chunk
+    {
+        double snr;     //!< the SNR of the chunk
+        uint64_t nbits; //!< the number of bits in the chunk
+    };
+
     /**
      * \brief Get the type ID.
      * \return the object TypeId
@@ -81,6 +92,31 @@ class ErrorRateModel : public Object
                                WifiPpduField field = WIFI_PPDU_FIELD_DATA,
                                uint16_t staId = SU_STA_ID) const;
 
+    /**
+     * This method returns the probability that all the given chunks of the
+     * packet will be successfully received by the PHY, i.e. the product of
+     * the success rates of the chunks, which use the same mode.
+     *
+     * Models that can evaluate many chunks faster than one at a time (e.g.
+     * from a lookup table) override DoGetChunksSuccessRate.
+     *
+     * \param mode the Wi-Fi mode applicable to the chunks
+     * \param txVector TXVECTOR of the overall transmission
+     * \param chunks the SNR and the number of bits of each chunk
+     * \param numRxAntennas the number of active RX antennas (1 if not provided)
+     * \param field the PPDU field to which the chunks belong to (assumes this is for the payload
+     * part if not provided)
+     * \param staId the station ID for MU
+     *
+     * \return probability of successfully receiving all the chunks
+     */
+    double GetChunksSuccessRate(WifiMode mode,
+                                const WifiTxVector& txVector,
+                                const std::vector<Chunk>& chunks,
+                                uint8_t numRxAntennas = 1,
+                                WifiPpduField field = WIFI_PPDU_FIELD_DATA,
+                                uint16_t staId = SU_STA_ID) const;
+
     /**
      * Assign a fixed random variable stream number to the random variables
      * used by this model. Return the number of streams (possibly zero) that
@@ -91,6 +127,28 @@ class ErrorRateModel : public Object
      */
     virtual int64_t AssignStreams(int64_t stream);
 
+  protected:
+    /**
+     * Return the probability of successfully receiving all the given chunks.
+     * The default implementation multiplies the success rates returned by
+     * DoGetChunkSuccessRate for each chunk.
+     *
+     * \param mode the Wi-Fi mode applicable to the chunks
+     * \param txVector TXVECTOR of the overall transmission
+     * \param chunks the SNR and the number of bits of each chunk
+     * \param numRxAntennas the number of active RX antennas
+     * \param field the PPDU field to which the chunks belong to
+     * \param staId the station ID for MU
+     *
+     * \return probability of successfully receiving all the chunks
+     */
+    virtual double DoGetChunksSuccessRate(WifiMode mode,
+                                          const WifiTxVector& txVector,
+                                          const std::vector<Chunk>& chunks,
+                                          uint8_t numRxAntennas,
+                                          WifiPpduField field,
+                                          uint16_t staId) const;
+
   private:
     /**
      * A pure virtual method that must be implemented in the subclass.
@@ -134,11 +134,6 @@ InterferenceHelper::NiChange::NiChange(Watt_u power, Ptr<Event> event)
 {
 }
 
-InterferenceHelper::NiChange::~NiChange()
-{
-    m_event = nullptr;
-}
-
 Watt_u
 InterferenceHelper::NiChange::GetPower() const
 {
@@ -350,31 +345,43 @@ InterferenceHelper::AppendEvent(Ptr<Event> event,
                                 bool isStartHePortionRxing)
 {
     NS_LOG_FUNCTION(this << event << freqRange << isStartHePortionRxing);
+    const auto rxing = (m_rxing.contains(freqRange) && m_rxing.at(freqRange));
+    // The bands of the event are sorted like the tracked bands, and the first powers are
+    // tracked for the same bands, hence the three maps are walked together.
+    auto niIt = m_niChanges.begin();
+    auto firstPowerIt = m_firstPowers.begin();
     for (const auto& [band, power] : event->GetRxPowerPerBand())
     {
-        auto niIt = m_niChanges.find(band);
-        NS_ABORT_IF(niIt == m_niChanges.end());
-        Watt_u previousPowerStart = 0;
-        Watt_u previousPowerEnd = 0;
+        while (niIt != m_niChanges.end() && niIt->first < band)
+        {
+            ++niIt;
+            ++firstPowerIt;
+        }
+        NS_ABORT_IF(niIt == m_niChanges.end() || band < niIt->first);
+        NS_ASSERT(!(firstPowerIt->first < band) && !(band < firstPowerIt->first));
         auto previousPowerPosition = GetPreviousPosition(event->GetStartTime(), niIt);
-        previousPowerStart = previousPowerPosition->second.GetPower();
-        previousPowerEnd = GetPreviousPosition(event->GetEndTime(), niIt)->second.GetPower();
-        if (const auto rxing = (m_rxing.contains(freqRange) && m_rxing.at(freqRange)); !rxing)
+        const auto previousPowerStart = previousPowerPosition->second.GetPower();
+        const auto previousPowerEnd =
+            GetPreviousPosition(event->GetEndTime(), niIt)->second.GetPower();
+        if (!rxing)
         {
-            m_firstPowers.find(band)->second = previousPowerStart;
+            firstPowerIt->second = previousPowerStart;
             // Always leave the first zero power noise event in the list
-            niIt->second.erase(++(niIt->second.begin()), ++previousPowerPosition);
+            niIt->second.erase(niIt->second.begin() + 1, ++previousPowerPosition);
         }
         else if (isStartHePortionRxing)
         {
             // When the first HE portion is received, we need to set m_firstPowerPerBand
             // so that it takes into account interferences that arrived between the start of the
             // HE TB PPDU transmission and the start of HE TB payload.
-            m_firstPowers.find(band)->second = previousPowerStart;
+            firstPowerIt->second = previousPowerStart;
         }
         auto first =
             AddNiChangeEvent(event->GetStartTime(), NiChange(previousPowerStart, event), niIt);
+        // adding the last change invalidates the iterators, not the index of the first change
+        const auto firstIndex = first - niIt->second.begin();
         auto last = AddNiChangeEvent(event->GetEndTime(), NiChange(previousPowerEnd, event), niIt);
+        first = niIt->second.begin() + firstIndex;
         for (auto i = first; i != last; ++i)
         {
             i->second.AddPower(power);
@@ -445,7 +452,13 @@ InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
     auto niIt = m_niChanges.find(band);
     NS_ABORT_IF(niIt == m_niChanges.end());
     const auto now = Simulator::Now();
-    auto it = niIt->second.find(event->GetStartTime());
+    const auto start = std::lower_bound(niIt->second.cbegin(),
+                                        niIt->second.cend(),
+                                        event->GetStartTime(),
+                                        [](const auto& change, Time time) {
+                                            return change.first < time;
+                                        });
+    auto it = start;
     const auto muMimoPower = (event->GetPpdu()->GetType() == WIFI_PPDU_TYPE_UL_MU)
                                  ? CalculateMuMimoPowerW(event, band)
                                  : 0.0;
@@ -465,20 +478,20 @@ InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
             noiseInterference = 0.0;
         }
     }
-    it = niIt->second.find(event->GetStartTime());
-    NS_ABORT_IF(it == niIt->second.end());
+    it = start;
+    NS_ABORT_IF(it == niIt->second.end() || it->first != event->GetStartTime());
     for (; it != niIt->second.end() && it->second.GetEvent() != event; ++it)
     {
         ;
     }
     NiChanges ni;
-    ni.emplace(event->GetStartTime(), NiChange(0, event));
+    ni.emplace_back(event->GetStartTime(), NiChange(0, event));
     while (++it != niIt->second.end() && it->second.GetEvent() != event)
     {
-        ni.insert(*it);
+        ni.push_back(*it);
     }
-    ni.emplace(event->GetEndTime(), NiChange(0, event));
-    nis.insert({band, ni});
+    ni.emplace_back(event->GetEndTime(), NiChange(0, event));
+    nis.insert({band, std::move(ni)});
     NS_ASSERT_MSG(noiseInterference >= 0.0,
                   "CalculateNoiseInterferenceW returns negative value " << noiseInterference);
     return noiseInterference;
@@ -539,6 +552,18 @@ InterferenceHelper::CalculateChunkSuccessRate(double snir,
     return csr;
 }
 
+uint64_t
+InterferenceHelper::GetPayloadChunkBits(Time duration,
+                                        const WifiTxVector& txVector,
+                                        uint16_t staId) const
+{
+    const auto rate = txVector.GetMode(staId).GetDataRate(txVector, staId);
+    auto nbits = static_cast<uint64_t>(rate * duration.GetSeconds());
+    nbits /= txVector.GetNss(staId); // divide effective number of bits by NSS to achieve same chunk
+                                     // error rate as SISO for AWGN
+    return nbits;
+}
+
 double
 InterferenceHelper::CalculatePayloadChunkSuccessRate(double snir,
                                                      Time duration,
@@ -550,10 +575,7 @@ InterferenceHelper::CalculatePayloadChunkSuccessRate(double snir,
         return 1.0;
     }
     const auto mode = txVector.GetMode(staId);
-    const auto rate = mode.GetDataRate(txVector, staId);
-    auto nbits = static_cast<uint64_t>(rate * duration.GetSeconds());
-    nbits /= txVector.GetNss(staId); // divide effective number of bits by NSS to achieve same chunk
-                                     // error rate as SISO for AWGN
+    const auto nbits = GetPayloadChunkBits(duration, txVector, staId);
     double csr = m_errorRateModel->GetChunkSuccessRate(mode,
                                                        txVector,
                                                        snir,
@@ -573,7 +595,9 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
                                         std::pair<Time, Time> window) const
 {
     NS_LOG_FUNCTION(this << channelWidth << band << staId << window.first << window.second);
-    double psr = 1.0; /* Packet Success Rate */
+    // the chunks are collected, and their success rates are computed at once
+    std::vector<ErrorRateModel::Chunk> chunks;
+    const auto& txVector = event->GetPpdu()->GetTxVector();
     const auto& niIt = nis->find(band)->second;
     auto j = niIt.cbegin();
     auto previous = j->first;
@@ -608,23 +632,25 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
         // Case 1: Both previous and current point to the windowed payload
         if (previous >= windowStart)
         {
-            psr *= CalculatePayloadChunkSuccessRate(snr,
-                                                    Min(windowEnd, current) - previous,
-                                                    event->GetPpdu()->GetTxVector(),
-                                                    staId);
+            const auto duration = Min(windowEnd, current) - previous;
+            if (!duration.IsZero())
+            {
+                chunks.push_back({snr, GetPayloadChunkBits(duration, txVector, staId)});
+            }
             NS_LOG_DEBUG("Both previous and current point to the windowed payload: mode="
-                         << payloadMode << ", psr=" << psr);
+                         << payloadMode << ", snr=" << snr << ", duration=" << duration);
         }
         // Case 2: previous is before windowed payload and current is in the windowed payload
         else if (current >= windowStart)
         {
-            psr *= CalculatePayloadChunkSuccessRate(snr,
-                                                    Min(windowEnd, current) - windowStart,
-                                                    event->GetPpdu()->GetTxVector(),
-                                                    staId);
+            const auto duration = Min(windowEnd, current) - windowStart;
+            if (!duration.IsZero())
+            {
+                chunks.push_back({snr, GetPayloadChunkBits(duration, txVector, staId)});
+            }
             NS_LOG_DEBUG(
                 "previous is before windowed payload and current is in the windowed payload: mode="
-                << payloadMode << ", psr=" << psr);
+                << payloadMode << ", snr=" << snr << ", duration=" << duration);
         }
         noiseInterference = j->second.GetPower() - power;
         if (IsSameMuMimoTransmission(event, j->second.GetEvent()))
@@ -641,6 +667,13 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
             break;
         }
     }
+    const auto psr = m_errorRateModel->GetChunksSuccessRate(payloadMode,
+                                                            txVector,
+                                                            chunks,
+                                                            m_numRxAntennas,
+                                                            WIFI_PPDU_FIELD_DATA,
+                                                            staId);
+    NS_LOG_DEBUG("mode=" << payloadMode << ", psr=" << psr);
     const auto per = 1.0 - psr;
     return per;
 }
@@ -655,7 +688,7 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(
 {
     NS_LOG_FUNCTION(this << band);
     double psr = 1.0; /* Packet Success Rate */
-    auto niIt = nis->find(band)->second;
+    const auto& niIt = nis->find(band)->second;
     auto j = niIt.begin();
 
     NS_ASSERT(!phyHeaderSections.empty());
@@ -717,7 +750,7 @@ InterferenceHelper::CalculatePhyHeaderPer(Ptr<const Event> event,
                                           WifiPpduField header) const
 {
     NS_LOG_FUNCTION(this << band << header);
-    auto niIt = nis->find(band)->second;
+    const auto& niIt = nis->find(band)->second;
     auto phyEntity =
         WifiPhy::GetStaticPhyEntity(event->GetPpdu()->GetTxVector().GetModulationClass());
 
@@ -797,7 +830,10 @@ InterferenceHelper::CalculatePhyHeaderSnrPer(Ptr<Event> event,
 InterferenceHelper::NiChanges::iterator
 InterferenceHelper::GetNextPosition(Time moment, NiChangesPerBand::iterator niIt)
 {
-    return niIt->second.upper_bound(moment);
+    return std::upper_bound(niIt->second.begin(),
+                            niIt->second.end(),
+                            moment,
+                            [](Time time, const auto& change) { return time < change.first; });
 }
 
 InterferenceHelper::NiChanges::iterator
@@ -813,7 +849,7 @@ InterferenceHelper::GetPreviousPosition(Time moment, NiChangesPerBand::iterator
 InterferenceHelper::NiChanges::iterator
 InterferenceHelper::AddNiChangeEvent(Time moment, NiChange change, NiChangesPerBand::iterator niIt)
 {
-    return niIt->second.insert(GetNextPosition(moment, niIt), {moment, change});
+    return niIt->second.emplace(GetNextPosition(moment, niIt), moment, std::move(change));
 }
 
 void
@@ -13,6 +13,9 @@
 
 #include "ns3/object.h"
 
+#include <utility>
+#include <vector>
+
 namespace ns3
 {
 
@@ -331,6 +334,18 @@ class InterferenceHelper : public Object
                                      WifiMode mode,
                                      const WifiTxVector& txVector,
                                      WifiPpduField field) const;
+    /**
+     * Calculate the number of bits in a payload chunk given its duration and the TXVECTOR.
+     *
+     * \param duration the duration of the chunk
+     * \param txVector the TXVECTOR
+     * \param staId the station ID of the PSDU (only used for MU)
+     *
+     * \return the number of bits in the chunk
+     */
+    uint64_t GetPayloadChunkBits(Time duration,
+                                 const WifiTxVector& txVector,
+                                 uint16_t staId = SU_STA_ID) const;
     /**
      * Calculate the success rate of the payload chunk given the SINR, duration, and TXVECTOR.
      * The duration and TXVECTOR are used to calculate how many bits are present in the payload
@@ -365,7 +380,6 @@ class InterferenceHelper : public Object
          * \param event causes this NI change
          */
         NiChange(Watt_u power, Ptr<Event> event);
-        ~NiChange();
         /**
          * Return the power
          *
@@ -391,9 +405,11 @@ class InterferenceHelper : public Object
     };
 
     /**
-     * typedef for a multimap of NiChange
+     * Vector of NiChange, sorted by time. The changes at the same time are in
+     * the order in which they were added. Each change gives the total power
+     * from its time until the time of the next change.
      */
-    using NiChanges = std::multimap<Time, NiChange>;
+    using NiChanges = std::vector<std::pair<Time, NiChange>>;
 
     /**
      * Map of NiChanges per band
@@ -9,12 +9,16 @@
 
 #include "nist-error-rate-model.h"
 
+#include "error-rate-lookup-table.h"
 #include "wifi-tx-vector.h"
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 
 #include <bitset>
 #include <cmath>
+#include <map>
+#include <mutex>
 
 namespace ns3
 {
@@ -29,11 +33,20 @@ NistErrorRateModel::GetTypeId()
     static TypeId tid = TypeId("ns3::NistErrorRateModel")
                             .SetParent<ErrorRateModel>()
                             .SetGroupName("Wifi")
-                            .AddConstructor<NistErrorRateModel>();
+                            .AddConstructor<NistErrorRateModel>()
+                            .AddAttribute("LookupTable",
+                                          "Whether to compute the success rate of the OFDM "
+                                          "chunks from lookup tables rather than from the "
+                                          "closed-form expressions (see ErrorRateLookupTable "
+                                          "for the accuracy).",
+                                          BooleanValue(false),
+                                          MakeBooleanAccessor(&NistErrorRateModel::m_lookupTable),
+                                          MakeBooleanChecker());
     return tid;
 }
 
 NistErrorRateModel::NistErrorRateModel()
+    : m_lookupTable(false)
 {
 }
 
@@ -169,6 +182,59 @@ NistErrorRateModel::GetFecQamBer(uint16_t constellationSize,
     return pms;
 }
 
+double
+NistErrorRateModel::GetCodedBer(uint16_t constellationSize, double snr, uint8_t bValue) const
+{
+    NS_LOG_FUNCTION(this << constellationSize << snr << +bValue);
+    double ber;
+    if (constellationSize == 2)
+    {
+        ber = GetBpskBer(snr);
+    }
+    else if (constellationSize == 4)
+    {
+        ber = GetQpskBer(snr);
+    }
+    else
+    {
+        ber = GetQamBer(constellationSize, snr);
+    }
+    if (ber == 0.0)
+    {
+        return 0.0;
+    }
+    return std::min(CalculatePe(ber, bValue), 1.0);
+}
+
+const ErrorRateLookupTable&
+NistErrorRateModel::GetLookupTable(uint16_t constellationSize, uint8_t bValue) const
+{
+    const auto key = std::make_pair(constellationSize, bValue);
+    if (auto cached = m_tables.find(key); cached != m_tables.end())
+    {
+        return *cached->second;
+    }
+    // the tables only depend on the mode, they are shared by all the models,
+    // which may run in different threads: the lock is only taken the first
+    // time a model uses a mode, the tables are never erased nor moved
+    static std::map<std::pair<uint16_t, uint8_t>, ErrorRateLookupTable> tables;
+    static std::mutex mutex;
+    std::lock_guard lock{mutex};
+    auto it = tables.find(key);
+    if (it == tables.end())
+    {
+        NS_LOG_DEBUG("Building the table of " << constellationSize << "-QAM with b=" << +bValue);
+        it = tables
+                 .emplace(key,
+                          ErrorRateLookupTable([this, constellationSize, bValue](double snr) {
+                              return GetCodedBer(constellationSize, snr, bValue);
+                          }))
+                 .first;
+    }
+    m_tables.emplace(key, &it->second);
+    return it->second;
+}
+
 uint8_t
 NistErrorRateModel::GetBValue(WifiCodeRate codeRate) const
 {
@@ -202,6 +268,13 @@ NistErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
     NS_LOG_FUNCTION(this << mode << snr << nbits << +numRxAntennas << field << staId);
     if (mode.GetModulationClass() >= WIFI_MOD_CLASS_ERP_OFDM)
     {
+        double logSuccess;
+        if (m_lookupTable &&
+            GetLookupTable(mode.GetConstellationSize(), GetBValue(mode.GetCodeRate()))
+                .GetLogSuccessRate(snr, logSuccess))
+        {
+            return std::exp(nbits * logSuccess);
+        }
         if (mode.GetConstellationSize() == 2)
         {
             return GetFecBpskBer(snr, nbits, GetBValue(mode.GetCodeRate()));
@@ -221,4 +294,48 @@ NistErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
     return 0;
 }
 
+double
+NistErrorRateModel::DoGetChunksSuccessRate(WifiMode mode,
+                                           const WifiTxVector& txVector,
+                                           const std::vector<Chunk>& chunks,
+                                           uint8_t numRxAntennas,
+                                           WifiPpduField field,
+                                           uint16_t staId) const
+{
+    NS_LOG_FUNCTION(this << mode << chunks.size() << +numRxAntennas << field << staId);
+    if (!m_lookupTable || mode.GetModulationClass() < WIFI_MOD_CLASS_ERP_OFDM)
+    {
+        return ErrorRateModel::DoGetChunksSuccessRate(mode,
+                                                      txVector,
+                                                      chunks,
+                                                      numRxAntennas,
+                                                      field,
+                                                      staId);
+    }
+    const auto& table =
+        GetLookupTable(mode.GetConstellationSize(), GetBValue(mode.GetCodeRate()));
+    // the success rates of the chunks in the table are multiplied by adding their logarithms
+    double psr = 1.0;
+    double logPsr = 0.0;
+    for (const auto& chunk : chunks)
+    {
+        double logSuccess;
+        if (table.GetLogSuccessRate(chunk.snr, logSuccess))
+        {
+            logPsr += chunk.nbits * logSuccess;
+        }
+        else
+        {
+            psr *= DoGetChunkSuccessRate(mode,
+                                         txVector,
+                                         chunk.snr,
+                                         chunk.nbits,
+                                         numRxAntennas,
+                                         field,
+                                         staId);
+        }
+    }
+    return psr * std::exp(logPsr);
+}
+
 } // namespace ns3
@@ -12,9 +12,14 @@
 #include "error-rate-model.h"
 #include "wifi-mode.h"
 
+#include <map>
+#include <utility>
+
 namespace ns3
 {
 
+class ErrorRateLookupTable;
+
 /**
  * \ingroup wifi
  *
@@ -22,6 +27,11 @@ namespace ns3
  * the model description and validation can be found in
  * http://www.nsnam.org/~pei/80211ofdm.pdf.  For DSSS modulations (802.11b),
  * the model uses the DsssErrorRateModel.
+ *
+ * If the LookupTable attribute is set, the success rate of the OFDM chunks
+ * is interpolated from a table of the coded BER of their mode (see
+ * ErrorRateLookupTable), built the first time the mode is used, and the
+ * success rate of the chunks of a payload is computed at once.
  */
 class NistErrorRateModel : public ErrorRateModel
 {
@@ -42,6 +52,32 @@ class NistErrorRateModel : public ErrorRateModel
                                  uint8_t numRxAntennas,
                                  WifiPpduField field,
                                  uint16_t staId) const override;
+    double DoGetChunksSuccessRate(WifiMode mode,
+                                  const WifiTxVector& txVector,
+                                  const std::vector<Chunk>& chunks,
+                                  uint8_t numRxAntennas,
+                                  WifiPpduField field,
+                                  uint16_t staId) const override;
+    /**
+     * Return the coded BER for the given constellation size, SNR and bValue.
+     *
+     * \param constellationSize the constellation size (M)
+     * \param snr SNR ratio (in linear scale)
+     * \param bValue the bValue such that coding rate = bValue / (bValue + 1)
+     *
+     * \return the coded BER
+     */
+    double GetCodedBer(uint16_t constellationSize, double snr, uint8_t bValue) const;
+    /**
+     * Return the lookup table of the coded BER for the given constellation size and bValue,
+     * building it if needed.
+     *
+     * \param constellationSize the constellation size (M)
+     * \param bValue the bValue such that coding rate = bValue / (bValue + 1)
+     *
+     * \return the lookup table
+     */
+    const ErrorRateLookupTable& GetLookupTable(uint16_t constellationSize, uint8_t bValue) const;
     /**
      * Return the bValue such that coding rate = bValue / (bValue + 1).
      *
@@ -117,6 +153,10 @@ class NistErrorRateModel : public ErrorRateModel
                         double snr,
                         uint64_t nbits,
                         uint8_t bValue) const;
+
+    bool m_lookupTable; //!< whether the success rates are computed from lookup tables
+    /// the shared lookup tables already used by this model, by constellation size and bValue
+    mutable std::map<std::pair<uint16_t, uint8_t>, const ErrorRateLookupTable*> m_tables;
 };
 
 } // namespace ns3
@@ -325,10 +325,9 @@ PhyEntity::EndReceiveField(WifiPpduField field, Ptr<Event> event)
             if (status.reason == FILTERED)
             {
                 // PHY-RXSTART is immediately followed by PHY-RXEND (Filtered)
-                m_wifiPhy->m_phyRxPayloadBeginTrace(
-                    txVector,
-                    NanoSeconds(0)); // this callback (equivalent to PHY-RXSTART primitive) is also
-                                     // triggered for filtered PPDUs
+                // this callback (equivalent to PHY-RXSTART primitive) is also triggered for
+                // filtered PPDUs
+                NS_TRACE(m_wifiPhy->m_phyRxPayloadBeginTrace, txVector, NanoSeconds(0));
             }
             m_wifiPhy->NotifyRxPpduDrop(ppdu, status.reason);
             m_wifiPhy->NotifyCcaBusy(ppdu, GetRemainingDurationAfterField(ppdu, field));
@@ -571,11 +570,9 @@ PhyEntity::DoStartReceivePayload(Ptr<Event> event)
     ScheduleEndOfMpdus(event);
     const auto& txVector = event->GetPpdu()->GetTxVector();
     Time payloadDuration = ppdu->GetTxDuration() - CalculatePhyPreambleAndHeaderDuration(txVector);
-    m_wifiPhy->m_phyRxPayloadBeginTrace(
-        txVector,
-        payloadDuration); // this callback (equivalent to PHY-RXSTART primitive) is triggered only
-                          // if headers have been correctly decoded and that the mode within is
-                          // supported
+    // this callback (equivalent to PHY-RXSTART primitive) is triggered only if headers have been
+    // correctly decoded and that the mode within is supported
+    NS_TRACE(m_wifiPhy->m_phyRxPayloadBeginTrace, txVector, payloadDuration);
     m_endRxPayloadEvents.push_back(
         Simulator::Schedule(payloadDuration, &PhyEntity::EndReceivePayload, this, event));
     return payloadDuration;
@@ -1338,7 +1335,7 @@ PhyEntity::GetMaxDelayPpduSameUid(const WifiTxVector& /*txVector*/)
 void
 PhyEntity::NotifyPayloadBegin(const WifiTxVector& txVector, const Time& payloadDuration)
 {
-    m_wifiPhy->m_phyRxPayloadBeginTrace(txVector, payloadDuration);
+    NS_TRACE(m_wifiPhy->m_phyRxPayloadBeginTrace, txVector, payloadDuration);
 }
 
 void
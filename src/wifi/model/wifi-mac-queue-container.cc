@@ -14,6 +14,9 @@
 #include "ns3/mac48-address.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
+#include <array>
+#include <string_view>
 #include <vector>
 
 namespace ns3
@@ -23,23 +26,37 @@ void
 WifiMacQueueContainer::clear()
 {
     m_queues.clear();
+    m_queueInfos.clear();
     m_expiredQueue.clear();
-    m_nBytesPerQueue.clear();
+    m_expiryIndex.clear();
 }
 
 WifiMacQueueContainer::iterator
 WifiMacQueueContainer::insert(const_iterator pos, Ptr<WifiMpdu> item)
 {
-    WifiContainerQueueId queueId = GetQueueId(item);
+    auto& info = GetQueueInfo(GetQueueId(item));
 
-    NS_ABORT_MSG_UNLESS(pos == m_queues[queueId].cend() || GetQueueId(pos->mpdu) == queueId,
+    NS_ABORT_MSG_UNLESS(pos == info.queue.cend() ||
+                            (!pos->expired && pos->queueIndex == info.index),
                         "pos iterator does not point to the correct container queue");
     NS_ABORT_MSG_IF(!item->IsOriginal(), "Only the original copy of an MPDU can be inserted");
 
-    auto [it, ret] = m_nBytesPerQueue.insert({queueId, 0});
-    it->second += item->GetSize();
+    info.nBytes += item->GetSize();
 
-    return m_queues[queueId].emplace(pos, item);
+    // the expiry time of the item is not known yet, hence the queue must be visited by
+    // the next extraction of all the MPDUs with expired lifetime
+    if (const auto now = Simulator::Now(); !info.check || (*info.check)->first > now)
+    {
+        if (info.check)
+        {
+            m_expiryIndex.erase(*info.check);
+        }
+        info.check = m_expiryIndex.emplace(now, info.index);
+    }
+
+    auto it = info.queue.emplace(pos, item);
+    it->queueIndex = info.index;
+    return it;
 }
 
 WifiMacQueueContainer::iterator
@@ -50,13 +67,11 @@ WifiMacQueueContainer::erase(const_iterator pos)
         return m_expiredQueue.erase(pos);
     }
 
-    WifiContainerQueueId queueId = GetQueueId(pos->mpdu);
-    auto it = m_nBytesPerQueue.find(queueId);
-    NS_ASSERT(it != m_nBytesPerQueue.end());
-    NS_ASSERT(it->second >= pos->mpdu->GetSize());
-    it->second -= pos->mpdu->GetSize();
+    auto& info = *m_queueInfos[pos->queueIndex];
+    NS_ASSERT(info.nBytes >= pos->mpdu->GetSize());
+    info.nBytes -= pos->mpdu->GetSize();
 
-    return m_queues[queueId].erase(pos);
+    return info.queue.erase(pos);
 }
 
 Ptr<WifiMpdu>
@@ -88,31 +103,45 @@ WifiMacQueueContainer::GetQueueId(Ptr<const WifiMpdu> mpdu)
     return {WIFI_DATA_QUEUE, addrType, address, std::nullopt};
 }
 
+WifiMacQueueContainer::QueueInfo&
+WifiMacQueueContainer::GetQueueInfo(const WifiContainerQueueId& queueId) const
+{
+    auto [it, inserted] = m_queues.try_emplace(queueId);
+    if (inserted)
+    {
+        it->second.index = m_queueInfos.size();
+        m_queueInfos.push_back(&it->second);
+    }
+    return it->second;
+}
+
 const WifiMacQueueContainer::ContainerQueue&
 WifiMacQueueContainer::GetQueue(const WifiContainerQueueId& queueId) const
 {
-    return m_queues[queueId];
+    return GetQueueInfo(queueId).queue;
 }
 
 uint32_t
 WifiMacQueueContainer::GetNBytes(const WifiContainerQueueId& queueId) const
 {
-    if (auto it = m_queues.find(queueId); it == m_queues.end() || it->second.empty())
+    auto it = m_queues.find(queueId);
+    if (it == m_queues.end() || it->second.queue.empty())
     {
         return 0;
     }
-    return m_nBytesPerQueue.at(queueId);
+    return it->second.nBytes;
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
 WifiMacQueueContainer::ExtractExpiredMpdus(const WifiContainerQueueId& queueId) const
 {
-    return DoExtractExpiredMpdus(m_queues[queueId]);
+    return DoExtractExpiredMpdus(GetQueueInfo(queueId));
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
-WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
+WifiMacQueueContainer::DoExtractExpiredMpdus(QueueInfo& info) const
 {
+    auto& queue = info.queue;
     std::optional<std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>> ret;
     auto firstExpiredIt = queue.begin();
     auto lastExpiredIt = firstExpiredIt;
@@ -142,11 +171,8 @@ WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
             lastExpiredIt->ac = AC_UNDEF;
             lastExpiredIt->deleter(lastExpiredIt->mpdu);
 
-            WifiContainerQueueId queueId = GetQueueId(lastExpiredIt->mpdu);
-            auto it = m_nBytesPerQueue.find(queueId);
-            NS_ASSERT(it != m_nBytesPerQueue.end());
-            NS_ASSERT(it->second >= lastExpiredIt->mpdu->GetSize());
-            it->second -= lastExpiredIt->mpdu->GetSize();
+            NS_ASSERT(info.nBytes >= lastExpiredIt->mpdu->GetSize());
+            info.nBytes -= lastExpiredIt->mpdu->GetSize();
 
             ++lastExpiredIt;
         }
@@ -164,19 +190,54 @@ WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
-WifiMacQueueContainer::ExtractAllExpiredMpdus() const
+WifiMacQueueContainer::ExtractAllExpiredMpdus(bool useExpiryIndex) const
 {
     std::optional<WifiMacQueueContainer::iterator> firstExpiredIt;
 
-    for (auto& queue : m_queues)
-    {
-        auto [firstIt, lastIt] = DoExtractExpiredMpdus(queue.second);
+    auto extract = [&](QueueInfo& info) {
+        auto [firstIt, lastIt] = DoExtractExpiredMpdus(info);
 
         if (firstIt != lastIt && !firstExpiredIt)
         {
             // this is the first queue with MPDUs with expired lifetime
             firstExpiredIt = firstIt;
         }
+    };
+
+    if (!useExpiryIndex)
+    {
+        for (auto& [queueId, info] : m_queues)
+        {
+            extract(info);
+        }
+    }
+    else
+    {
+        // take out the queues which may hold MPDUs with expired lifetime
+        const auto now = Simulator::Now();
+        std::vector<uint32_t> indices;
+        for (auto it = m_expiryIndex.begin(); it != m_expiryIndex.end() && it->first <= now;)
+        {
+            indices.push_back(it->second);
+            m_queueInfos[it->second]->check.reset();
+            it = m_expiryIndex.erase(it);
+        }
+        for (const auto index : indices)
+        {
+            auto& info = *m_queueInfos[index];
+            extract(info);
+            // the queue may hold MPDUs with expired lifetime once the first of its remaining
+            // MPDUs expires, which is already the case if expired MPDUs are left inflight
+            if (!info.queue.empty())
+            {
+                const auto elemIt = std::min_element(info.queue.cbegin(),
+                                                     info.queue.cend(),
+                                                     [](const auto& a, const auto& b) {
+                                                         return a.expiryTime < b.expiryTime;
+                                                     });
+                info.check = m_expiryIndex.emplace(elemIt->expiryTime, index);
+            }
+        }
     }
     return std::make_pair(firstExpiredIt ? *firstExpiredIt : m_expiredQueue.end(),
                           m_expiredQueue.end());
@@ -200,7 +261,8 @@ std::hash<ns3::WifiContainerQueueId>::operator()(ns3::WifiContainerQueueId queue
     auto [type, addrType, address, tid] = queueId;
     const std::size_t size = tid.has_value() ? 8 : 7;
 
-    std::vector<uint8_t> buffer(size);
+    // hash the bytes in place, which gives the same value as hashing them in a std::string
+    std::array<uint8_t, 8> buffer;
     buffer[0] = type;
     address.CopyTo(&buffer[1]);
     if (tid.has_value())
@@ -208,6 +270,6 @@ std::hash<ns3::WifiContainerQueueId>::operator()(ns3::WifiContainerQueueId queue
         buffer[7] = *tid;
     }
 
-    std::string s(buffer.begin(), buffer.end());
-    return std::hash<std::string>{}(s);
+    return std::hash<std::string_view>{}(
+        std::string_view(reinterpret_cast<const char*>(buffer.data()), size));
 }
@@ -14,9 +14,11 @@
 #include "ns3/mac48-address.h"
 
 #include <list>
+#include <map>
 #include <optional>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -98,6 +100,13 @@ namespace ns3
  *
  * This container holds multiple container queues organized in an hash table
  * whose keys are WifiContainerQueueId tuples identifying the container queues.
+ * Each container queue is given a dense index when it is created, which is
+ * stored in its elements, so that the elements are removed without hashing
+ * the identifier of their queue.
+ *
+ * The container also keeps an index of the container queues by the time from
+ * which they may hold MPDUs with expired lifetime, which can be used to only
+ * visit these queues when extracting all the MPDUs with expired lifetime.
  */
 class WifiMacQueueContainer
 {
@@ -180,10 +189,16 @@ class WifiMacQueueContainer
      * Transfer non-inflight MPDUs with expired lifetime in all the container queues to the
      * container queue storing MPDUs with expired lifetime.
      *
+     * If the expiry index is used, only the container queues which may hold MPDUs with
+     * expired lifetime are visited, by increasing time from which they may hold them.
+     * Otherwise, all the container queues are visited. The same MPDUs are transferred in
+     * both cases, possibly in a different order.
+     *
+     * \param useExpiryIndex whether to use the expiry index
      * \return the range [first, last) of iterators pointing to the MPDUs transferred
      *         to the container queue storing MPDUs with expired lifetime
      */
-    std::pair<iterator, iterator> ExtractAllExpiredMpdus() const;
+    std::pair<iterator, iterator> ExtractAllExpiredMpdus(bool useExpiryIndex = false) const;
     /**
      * Get the range [first, last) of iterators pointing to all the MPDUs queued
      * in the container queue storing MPDUs with expired lifetime.
@@ -194,21 +209,42 @@ class WifiMacQueueContainer
     std::pair<iterator, iterator> GetAllExpiredMpdus() const;
 
   private:
+    /// Index of the container queues by the time from which they may hold expired MPDUs
+    using ExpiryIndex = std::multimap<Time, uint32_t>;
+
+    /// Information about a container queue
+    struct QueueInfo
+    {
+        ContainerQueue queue;                       //!< the container queue
+        uint32_t index{0};                          //!< index of the container queue
+        uint32_t nBytes{0};                         //!< size in bytes of the container queue
+        std::optional<ExpiryIndex::iterator> check; //!< entry in the expiry index, if any
+    };
+
+    /**
+     * Get the information about the container queue identified by the given QueueId.
+     * The container queue is created if it does not exist.
+     *
+     * \param queueId the given QueueId
+     * \return the information about the container queue identified by the given QueueId
+     */
+    QueueInfo& GetQueueInfo(const WifiContainerQueueId& queueId) const;
+
     /**
      * Transfer non-inflight MPDUs with expired lifetime in the given container queue to the
      * container queue storing MPDUs with expired lifetime.
      *
-     * \param queue the given container queue
+     * \param info the information about the given container queue
      * \return the range [first, last) of iterators pointing to the MPDUs transferred
      *         to the container queue storing MPDUs with expired lifetime
      */
-    std::pair<iterator, iterator> DoExtractExpiredMpdus(ContainerQueue& queue) const;
+    std::pair<iterator, iterator> DoExtractExpiredMpdus(QueueInfo& info) const;
 
-    mutable std::unordered_map<WifiContainerQueueId, ContainerQueue>
-        m_queues;                          //!< the container queues
-    mutable ContainerQueue m_expiredQueue; //!< queue storing MPDUs with expired lifetime
-    mutable std::unordered_map<WifiContainerQueueId, uint32_t>
-        m_nBytesPerQueue; //!< size in bytes of the container queues
+    mutable std::unordered_map<WifiContainerQueueId, QueueInfo>
+        m_queues;                                //!< the container queues
+    mutable std::vector<QueueInfo*> m_queueInfos; //!< the container queues, by index
+    mutable ContainerQueue m_expiredQueue;       //!< queue storing MPDUs with expired lifetime
+    mutable ExpiryIndex m_expiryIndex; //!< index of the queues which may hold expired MPDUs
 };
 
 } // namespace ns3
@@ -43,6 +43,8 @@ struct WifiMacQueueElem
     AcIndex ac{AC_UNDEF};                       ///< the Access Category associated with the queue
                                                 ///< storing this element (set by WifiMacQueue)
     bool expired{false};                        ///< whether this MPDU has been marked as expired
+    uint32_t queueIndex{0};                     ///< index of the container queue storing this
+                                                ///< element (set by WifiMacQueueContainer)
     std::map<uint8_t, Ptr<WifiMpdu>> inflights; ///< map of MPDUs in-flight on each link
     Callback<void, Ptr<WifiMpdu>> deleter;      ///< reset the iterator stored by the MPDU
 
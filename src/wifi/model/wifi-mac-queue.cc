@@ -13,6 +13,7 @@
 
 #include "wifi-mac-queue-scheduler.h"
 
+#include "ns3/boolean.h"
 #include "ns3/simulator.h"
 
 #include <functional>
@@ -44,6 +45,15 @@ WifiMacQueue::GetTypeId()
                           TimeValue(MilliSeconds(500)),
                           MakeTimeAccessor(&WifiMacQueue::SetMaxDelay),
                           MakeTimeChecker())
+            .AddAttribute("ExpiryIndex",
+                          "Whether to only visit the container queues which may hold MPDUs with "
+                          "expired lifetime, found in an index of the queues by expiry time, "
+                          "when all the MPDUs with expired lifetime are removed (e.g., when "
+                          "the queue is full). Otherwise, all the container queues are visited. "
+                          "The same MPDUs are removed, possibly in a different order.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&WifiMacQueue::m_expiryIndex),
+                          MakeBooleanChecker())
             .AddTraceSource("Expired",
                             "MPDU dropped because its lifetime expired.",
                             MakeTraceSourceAccessor(&WifiMacQueue::m_traceExpired),
@@ -135,7 +145,7 @@ WifiMacQueue::ExtractAllExpiredMpdus() const
     NS_LOG_FUNCTION(this);
 
     std::list<Ptr<WifiMpdu>> mpdus;
-    auto [first, last] = GetContainer().ExtractAllExpiredMpdus();
+    auto [first, last] = GetContainer().ExtractAllExpiredMpdus(m_expiryIndex);
 
     for (auto it = first; it != last; it++)
     {
@@ -463,8 +473,8 @@ WifiMacQueue::DoEnqueue(ConstIterator pos, Ptr<WifiMpdu> item)
         return false;
     }
 
-    auto queueId = WifiMacQueueContainer::GetQueueId(item);
-    if (pos != GetContainer().GetQueue(queueId).cend() && mpdu && pos->mpdu == mpdu->GetOriginal())
+    if (mpdu && pos != GetContainer().GetQueue(WifiMacQueueContainer::GetQueueId(item)).cend() &&
+        pos->mpdu == mpdu->GetOriginal())
     {
         // the element pointed to by pos must be dropped; update insert position
         pos = std::next(pos);
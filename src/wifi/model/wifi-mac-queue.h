@@ -339,6 +339,7 @@ class WifiMacQueue : public Queue<WifiMpdu, ns3::WifiMacQueueContainer>
     Time m_maxDelay;                        //!< Time to live for packets in the queue
     AcIndex m_ac;                           //!< the access category
     Ptr<WifiMacQueueScheduler> m_scheduler; //!< the MAC queue scheduler
+    bool m_expiryIndex;                     //!< whether to use the expiry index of the container
 
     /// Traced callback: fired when a packet is dropped due to lifetime expiration
     TracedCallback<Ptr<const WifiMpdu>> m_traceExpired;
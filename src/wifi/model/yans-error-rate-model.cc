@@ -9,12 +9,17 @@
 
 #include "yans-error-rate-model.h"
 
+#include "error-rate-lookup-table.h"
 #include "wifi-tx-vector.h"
 #include "wifi-utils.h"
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 
 #include <cmath>
+#include <map>
+#include <mutex>
+#include <tuple>
 
 namespace ns3
 {
@@ -29,11 +34,20 @@ YansErrorRateModel::GetTypeId()
     static TypeId tid = TypeId("ns3::YansErrorRateModel")
                             .SetParent<ErrorRateModel>()
                             .SetGroupName("Wifi")
-                            .AddConstructor<YansErrorRateModel>();
+                            .AddConstructor<YansErrorRateModel>()
+                            .AddAttribute("LookupTable",
+                                          "Whether to compute the success rate of the OFDM "
+                                          "chunks from lookup tables rather than from the "
+                                          "closed-form expressions (see ErrorRateLookupTable "
+                                          "for the accuracy).",
+                                          BooleanValue(false),
+                                          MakeBooleanAccessor(&YansErrorRateModel::m_lookupTable),
+                                          MakeBooleanChecker());
     return tid;
 }
 
 YansErrorRateModel::YansErrorRateModel()
+    : m_lookupTable(false)
 {
 }
 
@@ -183,219 +197,191 @@ YansErrorRateModel::GetFecQamBer(double snr,
 }
 
 double
-YansErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
-                                          const WifiTxVector& txVector,
-                                          double snr,
-                                          uint64_t nbits,
-                                          uint8_t numRxAntennas,
-                                          WifiPpduField field,
-                                          uint16_t staId) const
+YansErrorRateModel::GetCodedBer(double ebNo, const FecParameters& fec) const
 {
-    NS_LOG_FUNCTION(this << mode << txVector << snr << nbits << +numRxAntennas << field << staId);
-    if (mode.GetModulationClass() >= WIFI_MOD_CLASS_ERP_OFDM)
+    NS_LOG_FUNCTION(this << ebNo << fec.m << fec.dFree << fec.adFree << fec.adFreePlusOne);
+    double ber = (fec.m == 2) ? GetBpskBer(ebNo, 1, 1) : GetQamBer(ebNo, fec.m, 1, 1);
+    if (ber == 0.0)
     {
-        uint64_t phyRate;
-        if ((txVector.IsMu() && (staId == SU_STA_ID)) || (mode != txVector.GetMode(staId)))
-        {
-            phyRate = mode.GetPhyRate(txVector.GetChannelWidth() >= 40
-                                          ? 20
-                                          : txVector.GetChannelWidth()); // This is the PHY header
-        }
-        else
-        {
-            phyRate = mode.GetPhyRate(txVector, staId);
-        }
-        if (mode.GetConstellationSize() == 2)
+        return 0.0;
+    }
+    double pmu = fec.adFree * CalculatePd(ber, fec.dFree);
+    if (fec.m != 2)
+    {
+        pmu += fec.adFreePlusOne * CalculatePd(ber, fec.dFree + 1);
+    }
+    return std::min(pmu, 1.0);
+}
+
+const ErrorRateLookupTable&
+YansErrorRateModel::GetLookupTable(const FecParameters& fec) const
+{
+    const auto key = std::make_tuple(fec.m, fec.dFree, fec.adFree, fec.adFreePlusOne);
+    if (auto cached = m_tables.find(key); cached != m_tables.end())
+    {
+        return *cached->second;
+    }
+    // the tables only depend on the mode, they are shared by all the models,
+    // which may run in different threads: the lock is only taken the first
+    // time a model uses a mode, the tables are never erased nor moved
+    static std::map<std::tuple<uint32_t, uint32_t, uint32_t, uint32_t>, ErrorRateLookupTable>
+        tables;
+    static std::mutex mutex;
+    std::lock_guard lock{mutex};
+    auto it = tables.find(key);
+    if (it == tables.end())
+    {
+        NS_LOG_DEBUG("Building the table of " << fec.m << "-QAM with dFree=" << fec.dFree);
+        it = tables
+                 .emplace(key,
+                          ErrorRateLookupTable(
+                              [this, fec](double ebNo) { return GetCodedBer(ebNo, fec); }))
+                 .first;
+    }
+    m_tables.emplace(key, &it->second);
+    return it->second;
+}
+
+std::optional<YansErrorRateModel::FecParameters>
+YansErrorRateModel::GetFecParameters(WifiMode mode) const
+{
+    const auto codeRate = mode.GetCodeRate();
+    switch (mode.GetConstellationSize())
+    {
+    case 2:
+        if (codeRate == WIFI_CODE_RATE_1_2)
         {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_1_2)
-            {
-                return GetFecBpskBer(snr,
-                                     nbits,
-                                     txVector.GetChannelWidth() * 1000000, // signal spread
-                                     phyRate,                              // PHY rate
-                                     10,                                   // dFree
-                                     11);                                  // adFree
-            }
-            else
-            {
-                return GetFecBpskBer(snr,
-                                     nbits,
-                                     txVector.GetChannelWidth() * 1000000, // signal spread
-                                     phyRate,                              // PHY rate
-                                     5,                                    // dFree
-                                     8);                                   // adFree
-            }
+            return FecParameters{2, 10, 11, 0};
         }
-        else if (mode.GetConstellationSize() == 4)
+        return FecParameters{2, 5, 8, 0};
+    case 4:
+    case 16:
+        if (codeRate == WIFI_CODE_RATE_1_2)
         {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_1_2)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    4,                                    // m
-                                    10,                                   // dFree
-                                    11,                                   // adFree
-                                    0);                                   // adFreePlusOne
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    4,                                    // m
-                                    5,                                    // dFree
-                                    8,                                    // adFree
-                                    31);                                  // adFreePlusOne
-            }
+            return FecParameters{mode.GetConstellationSize(), 10, 11, 0};
         }
-        else if (mode.GetConstellationSize() == 16)
+        return FecParameters{mode.GetConstellationSize(), 5, 8, 31};
+    case 64:
+        if (codeRate == WIFI_CODE_RATE_2_3)
         {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_1_2)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    16,                                   // m
-                                    10,                                   // dFree
-                                    11,                                   // adFree
-                                    0);                                   // adFreePlusOne
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    16,                                   // m
-                                    5,                                    // dFree
-                                    8,                                    // adFree
-                                    31);                                  // adFreePlusOne
-            }
+            return FecParameters{64, 6, 1, 16};
         }
-        else if (mode.GetConstellationSize() == 64)
+        if (codeRate == WIFI_CODE_RATE_5_6)
         {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_2_3)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    64,                                   // m
-                                    6,                                    // dFree
-                                    1,                                    // adFree
-                                    16);                                  // adFreePlusOne
-            }
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
-            {
-                // Table B.32  in Pâl Frenger et al., "Multi-rate Convolutional Codes".
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    64,                                   // m
-                                    4,                                    // dFree
-                                    14,                                   // adFree
-                                    69);                                  // adFreePlusOne
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    64,                                   // m
-                                    5,                                    // dFree
-                                    8,                                    // adFree
-                                    31);                                  // adFreePlusOne
-            }
+            // Table B.32  in Pâl Frenger et al., "Multi-rate Convolutional Codes".
+            return FecParameters{64, 4, 14, 69};
         }
-        else if (mode.GetConstellationSize() == 256)
+        return FecParameters{64, 5, 8, 31};
+    case 256:
+    case 1024:
+    case 4096:
+        if (codeRate == WIFI_CODE_RATE_5_6)
         {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    256,                                  // m
-                                    4,                                    // dFree
-                                    14,                                   // adFree
-                                    69                                    // adFreePlusOne
-                );
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    256,                                  // m
-                                    5,                                    // dFree
-                                    8,                                    // adFree
-                                    31                                    // adFreePlusOne
-                );
-            }
+            return FecParameters{mode.GetConstellationSize(), 4, 14, 69};
         }
-        else if (mode.GetConstellationSize() == 1024)
+        return FecParameters{mode.GetConstellationSize(), 5, 8, 31};
+    default:
+        return std::nullopt;
+    }
+}
+
+uint64_t
+YansErrorRateModel::GetPhyRate(WifiMode mode, const WifiTxVector& txVector, uint16_t staId) const
+{
+    if ((txVector.IsMu() && (staId == SU_STA_ID)) || (mode != txVector.GetMode(staId)))
+    {
+        return mode.GetPhyRate(txVector.GetChannelWidth() >= 40
+                                   ? 20
+                                   : txVector.GetChannelWidth()); // This is the PHY header
+    }
+    return mode.GetPhyRate(txVector, staId);
+}
+
+double
+YansErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
+                                          const WifiTxVector& txVector,
+                                          double snr,
+                                          uint64_t nbits,
+                                          uint8_t numRxAntennas,
+                                          WifiPpduField field,
+                                          uint16_t staId) const
+{
+    NS_LOG_FUNCTION(this << mode << txVector << snr << nbits << +numRxAntennas << field << staId);
+    if (mode.GetModulationClass() < WIFI_MOD_CLASS_ERP_OFDM)
+    {
+        return 0;
+    }
+    const auto fec = GetFecParameters(mode);
+    if (!fec)
+    {
+        return 0;
+    }
+    const auto signalSpread = static_cast<uint32_t>(txVector.GetChannelWidth() * 1000000);
+    const auto phyRate = GetPhyRate(mode, txVector, staId);
+    double logSuccess;
+    if (m_lookupTable &&
+        GetLookupTable(*fec).GetLogSuccessRate(snr * signalSpread / phyRate, logSuccess))
+    {
+        return std::exp(nbits * logSuccess);
+    }
+    if (fec->m == 2)
+    {
+        return GetFecBpskBer(snr, nbits, signalSpread, phyRate, fec->dFree, fec->adFree);
+    }
+    return GetFecQamBer(snr,
+                        nbits,
+                        signalSpread,
+                        phyRate,
+                        fec->m,
+                        fec->dFree,
+                        fec->adFree,
+                        fec->adFreePlusOne);
+}
+
+double
+YansErrorRateModel::DoGetChunksSuccessRate(WifiMode mode,
+                                           const WifiTxVector& txVector,
+                                           const std::vector<Chunk>& chunks,
+                                           uint8_t numRxAntennas,
+                                           WifiPpduField field,
+                                           uint16_t staId) const
+{
+    NS_LOG_FUNCTION(this << mode << chunks.size() << +numRxAntennas << field << staId);
+    const auto fec = GetFecParameters(mode);
+    if (!m_lookupTable || mode.GetModulationClass() < WIFI_MOD_CLASS_ERP_OFDM || !fec)
+    {
+        return ErrorRateModel::DoGetChunksSuccessRate(mode,
+                                                      txVector,
+                                                      chunks,
+                                                      numRxAntennas,
+                                                      field,
+                                                      staId);
+    }
+    const auto& table = GetLookupTable(*fec);
+    const auto signalSpread = static_cast<uint32_t>(txVector.GetChannelWidth() * 1000000);
+    const auto phyRate = GetPhyRate(mode, txVector, staId);
+    // the success rates of the chunks in the table are multiplied by adding their logarithms
+    double psr = 1.0;
+    double logPsr = 0.0;
+    for (const auto& chunk : chunks)
+    {
+        double logSuccess;
+        if (table.GetLogSuccessRate(chunk.snr * signalSpread / phyRate, logSuccess))
         {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    1024,                                 // m
-                                    4,                                    // dFree
-                                    14,                                   // adFree
-                                    69                                    // adFreePlusOne
-                );
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    1024,                                 // m
-                                    5,                                    // dFree
-                                    8,                                    // adFree
-                                    31                                    // adFreePlusOne
-                );
-            }
+            logPsr += chunk.nbits * logSuccess;
         }
-        else if (mode.GetConstellationSize() == 4096)
+        else
         {
-            if (mode.GetCodeRate() == WIFI_CODE_RATE_5_6)
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    4096,                                 // m
-                                    4,                                    // dFree
-                                    14,                                   // adFree
-                                    69                                    // adFreePlusOne
-                );
-            }
-            else
-            {
-                return GetFecQamBer(snr,
-                                    nbits,
-                                    txVector.GetChannelWidth() * 1000000, // signal spread
-                                    phyRate,                              // PHY rate
-                                    4096,                                 // m
-                                    5,                                    // dFree
-                                    8,                                    // adFree
-                                    31                                    // adFreePlusOne
-                );
-            }
+            psr *= DoGetChunkSuccessRate(mode,
+                                         txVector,
+                                         chunk.snr,
+                                         chunk.nbits,
+                                         numRxAntennas,
+                                         field,
+                                         staId);
         }
     }
-    return 0;
+    return psr * std::exp(logPsr);
 }
 
 } // namespace ns3
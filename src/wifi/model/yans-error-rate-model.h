@@ -11,9 +11,15 @@
 
 #include "error-rate-model.h"
 
+#include <map>
+#include <optional>
+#include <tuple>
+
 namespace ns3
 {
 
+class ErrorRateLookupTable;
+
 /**
  * \brief Model the error rate for different modulations.
  * \ingroup wifi
@@ -38,6 +44,11 @@ namespace ns3
  *      57(2):440-449, February 2009.
  *    - More detailed description and validation can be found in
  *      http://www.nsnam.org/~pei/80211b.pdf
+ *
+ * If the LookupTable attribute is set, the success rate of the OFDM chunks
+ * is interpolated from a table of the coded BER of their mode as a function
+ * of Eb/No (see ErrorRateLookupTable), built the first time the mode is used,
+ * and the success rate of the chunks of a payload is computed at once.
  */
 class YansErrorRateModel : public ErrorRateModel
 {
@@ -51,6 +62,15 @@ class YansErrorRateModel : public ErrorRateModel
     YansErrorRateModel();
 
   private:
+    /// Parameters of the convolutional code of a mode
+    struct FecParameters
+    {
+        uint32_t m;             //!< the constellation size
+        uint32_t dFree;         //!< the free distance of the code
+        uint32_t adFree;        //!< the number of paths at the free distance
+        uint32_t adFreePlusOne; //!< the number of paths at the free distance plus one
+    };
+
     double DoGetChunkSuccessRate(WifiMode mode,
                                  const WifiTxVector& txVector,
                                  double snr,
@@ -58,6 +78,42 @@ class YansErrorRateModel : public ErrorRateModel
                                  uint8_t numRxAntennas,
                                  WifiPpduField field,
                                  uint16_t staId) const override;
+    double DoGetChunksSuccessRate(WifiMode mode,
+                                  const WifiTxVector& txVector,
+                                  const std::vector<Chunk>& chunks,
+                                  uint8_t numRxAntennas,
+                                  WifiPpduField field,
+                                  uint16_t staId) const override;
+    /**
+     * \param mode the Wi-Fi mode
+     *
+     * \return the parameters of the convolutional code of the mode, if it is supported
+     */
+    std::optional<FecParameters> GetFecParameters(WifiMode mode) const;
+    /**
+     * \param mode the Wi-Fi mode applicable to the chunk
+     * \param txVector TXVECTOR of the overall transmission
+     * \param staId the station ID for MU
+     *
+     * \return the PHY rate of the chunk
+     */
+    uint64_t GetPhyRate(WifiMode mode, const WifiTxVector& txVector, uint16_t staId) const;
+    /**
+     * \param ebNo the Eb/No ratio (not dB)
+     * \param fec the parameters of the convolutional code
+     *
+     * \return the coded BER
+     */
+    double GetCodedBer(double ebNo, const FecParameters& fec) const;
+    /**
+     * Return the lookup table of the coded BER as a function of Eb/No for the given code,
+     * building it if needed.
+     *
+     * \param fec the parameters of the convolutional code
+     *
+     * \return the lookup table
+     */
+    const ErrorRateLookupTable& GetLookupTable(const FecParameters& fec) const;
     /**
      * Return BER of BPSK with the given parameters.
      *
@@ -154,6 +210,12 @@ class YansErrorRateModel : public ErrorRateModel
                         uint32_t dfree,
                         uint32_t adFree,
                         uint32_t adFreePlusOne) const;
+
+    bool m_lookupTable; //!< whether the success rates are computed from lookup tables
+    /// the shared lookup tables already used by this model, by FEC parameters
+    mutable std::map<std::tuple<uint32_t, uint32_t, uint32_t, uint32_t>,
+                     const ErrorRateLookupTable*>
+        m_tables;
 };
 
 } // namespace ns3
@@ -14,6 +14,9 @@
 #include "wifi-utils.h"
 #include "yans-wifi-phy.h"
 
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
@@ -22,6 +25,11 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
 namespace ns3
 {
 
@@ -29,6 +37,246 @@ NS_LOG_COMPONENT_DEFINE("YansWifiChannel");
 
 NS_OBJECT_ENSURE_REGISTERED(YansWifiChannel);
 
+/**
+ * \brief Grid of the positions of the PHYs of a YansWifiChannel.
+ *
+ * The PHYs are binned by the horizontal position of their mobility model in
+ * square cells, which are updated when the mobility models notify a course
+ * change.  Since the PHYs may have moved since they were binned, the grid is
+ * searched beyond the requested range, by the distance traveled at the
+ * highest speed since the grid was built, and is rebuilt when this distance
+ * exceeds half a cell.
+ */
+class YansWifiChannel::SpatialIndex
+{
+  public:
+    /**
+     * Build the grid.
+     *
+     * \param phys the PHYs of the channel
+     * \param cellSize the size of the cells
+     */
+    SpatialIndex(const PhyList& phys, meter_u cellSize);
+    ~SpatialIndex();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    SpatialIndex(const SpatialIndex&) = delete;
+    SpatialIndex& operator=(const SpatialIndex&) = delete;
+
+    /**
+     * \returns the lowest RX sensitivity minus RX gain of the PHYs, when the
+     * grid was built
+     */
+    dBm_u GetRxThreshold() const;
+
+    /**
+     * \param position a position
+     * \param range the range
+     * \returns the indices, in increasing order, of the PHYs which may be
+     * within the range of the position
+     */
+    const std::vector<std::size_t>& GetCandidates(const Vector& position, meter_u range);
+
+  private:
+    /**
+     * Bin the PHYs by their current position.
+     *
+     * \param cellSize the size of the cells
+     */
+    void Build(meter_u cellSize);
+    /**
+     * \param x a coordinate
+     * \returns the index of the cell along this coordinate
+     */
+    int32_t GetCellIndex(double x) const;
+    /**
+     * \param x the index of a cell along the x axis
+     * \param y the index of the cell along the y axis
+     * \returns the cell
+     */
+    static uint64_t GetCell(int32_t x, int32_t y);
+    /**
+     * \param position a position
+     * \returns the cell of this position
+     */
+    uint64_t GetCell(const Vector& position) const;
+    /**
+     * Move the PHYs using a mobility model to the cell of its new position.
+     *
+     * \param mobility the mobility model
+     */
+    void CourseChanged(Ptr<const MobilityModel> mobility);
+
+    /// PHY in the grid
+    struct IndexedPhy
+    {
+        Ptr<MobilityModel> mobility; //!< mobility model of the PHY
+        uint64_t cell;               //!< cell of the PHY
+    };
+
+    std::vector<IndexedPhy> m_phys; //!< PHYs, by index
+    /// indices of the PHYs using each mobility model
+    std::unordered_map<const MobilityModel*, std::vector<std::size_t>> m_physByMobility;
+    std::unordered_map<uint64_t, std::vector<std::size_t>> m_cells; //!< PHYs in each cell
+    std::vector<std::size_t> m_candidates; //!< result of GetCandidates
+    meter_u m_cellSize;                    //!< size of the cells
+    Time m_buildTime;                      //!< time at which the grid was built
+    double m_maxSpeed;                     //!< highest speed of the PHYs since then (m/s)
+    dBm_u m_rxThreshold;                   //!< lowest RX sensitivity minus RX gain
+};
+
+YansWifiChannel::SpatialIndex::SpatialIndex(const PhyList& phys, meter_u cellSize)
+    : m_rxThreshold(std::numeric_limits<double>::infinity())
+{
+    NS_LOG_FUNCTION(this << cellSize);
+    for (std::size_t i = 0; i < phys.size(); ++i)
+    {
+        auto mobility = phys[i]->GetMobility();
+        NS_ABORT_MSG_IF(!mobility, "The PHYs of the channel must have a mobility model");
+        m_phys.push_back({mobility, 0});
+        auto& indices = m_physByMobility[PeekPointer(mobility)];
+        if (indices.empty())
+        {
+            mobility->TraceConnectWithoutContext(
+                "CourseChange",
+                MakeCallback(&YansWifiChannel::SpatialIndex::CourseChanged, this));
+        }
+        indices.push_back(i);
+        m_rxThreshold =
+            std::min(m_rxThreshold, phys[i]->GetRxSensitivity() - phys[i]->GetRxGain());
+    }
+    Build(cellSize);
+}
+
+YansWifiChannel::SpatialIndex::~SpatialIndex()
+{
+    NS_LOG_FUNCTION(this);
+    for (const auto& [mobility, indices] : m_physByMobility)
+    {
+        m_phys[indices.front()].mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&YansWifiChannel::SpatialIndex::CourseChanged, this));
+    }
+}
+
+dBm_u
+YansWifiChannel::SpatialIndex::GetRxThreshold() const
+{
+    return m_rxThreshold;
+}
+
+void
+YansWifiChannel::SpatialIndex::Build(meter_u cellSize)
+{
+    NS_LOG_FUNCTION(this << cellSize);
+    // cells smaller than a meter are not worth it
+    m_cellSize = std::max(cellSize, 1.0);
+    m_buildTime = Simulator::Now();
+    m_maxSpeed = 0;
+    m_cells.clear();
+    for (std::size_t i = 0; i < m_phys.size(); ++i)
+    {
+        m_phys[i].cell = GetCell(m_phys[i].mobility->GetPosition());
+        m_cells[m_phys[i].cell].push_back(i);
+        m_maxSpeed = std::max(m_maxSpeed, m_phys[i].mobility->GetVelocity().GetLength());
+    }
+}
+
+int32_t
+YansWifiChannel::SpatialIndex::GetCellIndex(double x) const
+{
+    double index = std::floor(x / m_cellSize);
+    return std::clamp<double>(index,
+                              std::numeric_limits<int32_t>::min(),
+                              std::numeric_limits<int32_t>::max());
+}
+
+uint64_t
+YansWifiChannel::SpatialIndex::GetCell(int32_t x, int32_t y)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+uint64_t
+YansWifiChannel::SpatialIndex::GetCell(const Vector& position) const
+{
+    return GetCell(GetCellIndex(position.x), GetCellIndex(position.y));
+}
+
+void
+YansWifiChannel::SpatialIndex::CourseChanged(Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    auto it = m_physByMobility.find(PeekPointer(mobility));
+    NS_ASSERT(it != m_physByMobility.end());
+    uint64_t cell = GetCell(mobility->GetPosition());
+    m_maxSpeed = std::max(m_maxSpeed, mobility->GetVelocity().GetLength());
+    for (auto i : it->second)
+    {
+        if (m_phys[i].cell == cell)
+        {
+            continue;
+        }
+        auto& previous = m_cells[m_phys[i].cell];
+        previous.erase(std::find(previous.begin(), previous.end(), i));
+        if (previous.empty())
+        {
+            m_cells.erase(m_phys[i].cell);
+        }
+        m_phys[i].cell = cell;
+        m_cells[cell].push_back(i);
+    }
+}
+
+const std::vector<std::size_t>&
+YansWifiChannel::SpatialIndex::GetCandidates(const Vector& position, meter_u range)
+{
+    NS_LOG_FUNCTION(this << position << range);
+    meter_u slack = m_maxSpeed * (Simulator::Now() - m_buildTime).GetSeconds();
+    if (slack > m_cellSize / 2 || range > 2 * m_cellSize)
+    {
+        Build(range);
+        slack = 0;
+    }
+    meter_u radius = range + slack;
+    int64_t xMin = GetCellIndex(position.x - radius);
+    int64_t xMax = GetCellIndex(position.x + radius);
+    int64_t yMin = GetCellIndex(position.y - radius);
+    int64_t yMax = GetCellIndex(position.y + radius);
+
+    m_candidates.clear();
+    if (static_cast<uint64_t>(xMax - xMin + 1) * (yMax - yMin + 1) < m_cells.size())
+    {
+        for (int64_t x = xMin; x <= xMax; ++x)
+        {
+            for (int64_t y = yMin; y <= yMax; ++y)
+            {
+                auto it = m_cells.find(GetCell(x, y));
+                if (it != m_cells.end())
+                {
+                    m_candidates.insert(m_candidates.end(), it->second.begin(), it->second.end());
+                }
+            }
+        }
+    }
+    else
+    {
+        // fewer cells are occupied than searched
+        for (const auto& [cell, indices] : m_cells)
+        {
+            int64_t x = static_cast<int32_t>(cell >> 32);
+            int64_t y = static_cast<int32_t>(cell & 0xffffffff);
+            if (x >= xMin && x <= xMax && y >= yMin && y <= yMax)
+            {
+                m_candidates.insert(m_candidates.end(), indices.begin(), indices.end());
+            }
+        }
+    }
+    // deliver the PPDU in the order of the PHY list, as without culling
+    std::sort(m_candidates.begin(), m_candidates.end());
+    return m_candidates;
+}
+
 TypeId
 YansWifiChannel::GetTypeId()
 {
@@ -46,11 +294,30 @@ YansWifiChannel::GetTypeId()
                           "A pointer to the propagation delay model attached to this channel.",
                           PointerValue(),
                           MakePointerAccessor(&YansWifiChannel::m_delay),
-                          MakePointerChecker<PropagationDelayModel>());
+                          MakePointerChecker<PropagationDelayModel>())
+            .AddAttribute("SpatialCulling",
+                          "If true, the PPDUs are not delivered to the PHYs beyond the range "
+                          "at which they are received below the RX sensitivity, found through "
+                          "a grid of the PHY positions. These PHYs do not fire their "
+                          "SignalArrival trace, and the propagation models are not called for "
+                          "them. The RX sensitivity and gain of the PHYs are read when the "
+                          "grid is built, at the first transmission after a PHY is added.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&YansWifiChannel::m_spatialCulling),
+                          MakeBooleanChecker())
+            .AddAttribute("MaxRange",
+                          "The range (m) beyond which the PPDUs are not delivered when "
+                          "SpatialCulling is true. If 0, the range is given by the propagation "
+                          "loss model, if it can bound it.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&YansWifiChannel::m_maxRange),
+                          MakeDoubleChecker<meter_u>(0));
     return tid;
 }
 
 YansWifiChannel::YansWifiChannel()
+    : m_spatialCulling(false),
+      m_maxRange(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -59,6 +326,15 @@ YansWifiChannel::~YansWifiChannel()
 {
     NS_LOG_FUNCTION(this);
     m_phyList.clear();
+    m_phyIndices.clear();
+}
+
+void
+YansWifiChannel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_index.reset();
+    Channel::DoDispose();
 }
 
 void
@@ -81,42 +357,105 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u t
     NS_LOG_FUNCTION(this << sender << ppdu << txPower);
     Ptr<MobilityModel> senderMobility = sender->GetMobility();
     NS_ASSERT(senderMobility);
-    for (auto i = m_phyList.begin(); i != m_phyList.end(); i++)
+    // For now don't account for inter channel interference nor channel bonding
+    const auto channelNumber = sender->GetChannelNumber();
+    auto channelIt = m_physByChannel.find(channelNumber);
+    if (channelIt == m_physByChannel.end())
     {
-        if (sender != (*i))
+        return;
+    }
+    const auto& receivers = channelIt->second;
+    if (m_spatialCulling)
+    {
+        const auto range = GetCullingRange(txPower, ppdu);
+        if (std::isfinite(range))
         {
-            // For now don't account for inter channel interference nor channel bonding
-            if ((*i)->GetChannelNumber() != sender->GetChannelNumber())
+            const auto& candidates =
+                m_index->GetCandidates(senderMobility->GetPosition(), range);
+            // both lists are in the order of the PHY list: go through the shortest one
+            const auto byChannel = (receivers.size() <= candidates.size());
+            for (auto i : (byChannel ? receivers : candidates))
             {
-                continue;
+                const auto& receiver = m_phyList[i];
+                if (sender == receiver || (!byChannel && m_phyChannels[i] != channelNumber))
+                {
+                    continue;
+                }
+                // a small margin keeps the receivers at the range, up to rounding errors
+                if (senderMobility->GetDistanceFrom(receiver->GetMobility()) >
+                    range * (1 + 1e-9))
+                {
+                    continue;
+                }
+                SendTo(senderMobility, receiver, ppdu, txPower);
             }
+            return;
+        }
+    }
+    for (auto i : receivers)
+    {
+        if (sender != m_phyList[i])
+        {
+            NS_ASSERT_MSG(m_phyList[i]->GetChannelNumber() == channelNumber,
+                          "Channel switch not notified to the YansWifiChannel");
+            SendTo(senderMobility, m_phyList[i], ppdu, txPower);
+        }
+    }
+}
 
-            auto receiverMobility = (*i)->GetMobility()->GetObject<MobilityModel>();
-            const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
-            const auto rxPower = m_loss->CalcRxPower(txPower, senderMobility, receiverMobility);
-            NS_LOG_DEBUG("propagation: txPower="
-                         << txPower << "dBm, rxPower=" << rxPower << "dBm, "
-                         << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
-                         << "m, delay=" << delay);
-            auto dstNetDevice = (*i)->GetDevice();
-            uint32_t dstNode;
-            if (!dstNetDevice)
-            {
-                dstNode = 0xffffffff;
-            }
-            else
-            {
-                dstNode = dstNetDevice->GetNode()->GetId();
-            }
+void
+YansWifiChannel::SendTo(Ptr<MobilityModel> senderMobility,
+                        Ptr<YansWifiPhy> receiver,
+                        Ptr<const WifiPpdu> ppdu,
+                        dBm_u txPower) const
+{
+    auto receiverMobility = receiver->GetMobility()->GetObject<MobilityModel>();
+    const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
+    const auto rxPower = m_loss->CalcRxPower(txPower, senderMobility, receiverMobility);
+    NS_LOG_DEBUG("propagation: txPower="
+                 << txPower << "dBm, rxPower=" << rxPower << "dBm, "
+                 << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
+                 << "m, delay=" << delay);
+    auto dstNetDevice = receiver->GetDevice();
+    uint32_t dstNode;
+    if (!dstNetDevice)
+    {
+        dstNode = 0xffffffff;
+    }
+    else
+    {
+        dstNode = dstNetDevice->GetNode()->GetId();
+    }
+
+    Simulator::ScheduleWithContext(dstNode,
+                                   delay,
+                                   &YansWifiChannel::Receive,
+                                   receiver,
+                                   ppdu,
+                                   rxPower);
+}
 
-            Simulator::ScheduleWithContext(dstNode,
-                                           delay,
-                                           &YansWifiChannel::Receive,
-                                           (*i),
-                                           ppdu,
-                                           rxPower);
+meter_u
+YansWifiChannel::GetCullingRange(dBm_u txPower, Ptr<const WifiPpdu> ppdu) const
+{
+    NS_LOG_FUNCTION(this << txPower << ppdu);
+    if (m_maxRange > 0)
+    {
+        if (!m_index)
+        {
+            m_index = std::make_unique<SpatialIndex>(m_phyList, m_maxRange);
         }
+        return m_maxRange;
     }
+    if (!m_index)
+    {
+        // the cells are sized after the range, once it is known
+        m_index = std::make_unique<SpatialIndex>(m_phyList, 0);
+    }
+    // the signal is discarded by Receive below this power
+    const auto rxThreshold =
+        m_index->GetRxThreshold() + RatioToDb(ppdu->GetTxChannelWidth() / 20.0);
+    return m_loss->GetMaxRange(txPower, rxThreshold);
 }
 
 void
@@ -155,7 +494,52 @@ void
 YansWifiChannel::Add(Ptr<YansWifiPhy> phy)
 {
     NS_LOG_FUNCTION(this << phy);
+    m_phyIndices.emplace(PeekPointer(phy), m_phyList.size());
+    m_phyChannels.emplace_back();
     m_phyList.push_back(phy);
+    IndexChannel(m_phyList.size() - 1);
+    m_index.reset();
+}
+
+void
+YansWifiChannel::NotifyChannelSwitch(Ptr<YansWifiPhy> phy)
+{
+    NS_LOG_FUNCTION(this << phy);
+    auto it = m_phyIndices.find(PeekPointer(phy));
+    NS_ASSERT_MSG(it != m_phyIndices.end(), "PHY not connected to this channel");
+    IndexChannel(it->second);
+}
+
+void
+YansWifiChannel::IndexChannel(std::size_t index)
+{
+    NS_LOG_FUNCTION(this << index);
+    const auto& phy = m_phyList[index];
+    std::optional<uint8_t> channelNumber;
+    if (phy->GetOperatingChannel().IsSet())
+    {
+        channelNumber = phy->GetChannelNumber();
+    }
+    auto& previous = m_phyChannels[index];
+    if (previous == channelNumber)
+    {
+        return;
+    }
+    if (previous)
+    {
+        auto& indices = m_physByChannel[*previous];
+        indices.erase(std::lower_bound(indices.begin(), indices.end(), index));
+        if (indices.empty())
+        {
+            m_physByChannel.erase(*previous);
+        }
+    }
+    if (channelNumber)
+    {
+        auto& indices = m_physByChannel[*channelNumber];
+        indices.insert(std::lower_bound(indices.begin(), indices.end(), index), index);
+    }
+    previous = channelNumber;
 }
 
 int64_t
@@ -13,9 +13,15 @@
 
 #include "ns3/channel.h"
 
+#include <map>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
 namespace ns3
 {
 
+class MobilityModel;
 class NetDevice;
 class PropagationLossModel;
 class PropagationDelayModel;
@@ -32,6 +38,18 @@ class WifiPpdu;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * The PHYs are indexed by the number of their operating channel, which the
+ * PHYs notify when they switch channel, so that a PPDU is only delivered to
+ * the PHYs on the channel of the sender without going through the others.
+ *
+ * When the SpatialCulling attribute is true, the PHYs are indexed by their
+ * position in a grid, and a PPDU is only delivered to the PHYs within the
+ * range beyond which its power is below the RX sensitivity of every PHY,
+ * given by the MaxRange attribute or the propagation loss model (see
+ * PropagationLossModel::GetMaxRange).  The grid is updated when the
+ * mobility models notify a course change, and the motion between course
+ * changes is assumed to be at constant velocity.
  */
 class YansWifiChannel : public Channel
 {
@@ -76,6 +94,16 @@ class YansWifiChannel : public Channel
      */
     void Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u txPower) const;
 
+    /**
+     * \param phy the PHY object which switched to another operating channel.
+     *
+     * This method should not be invoked by normal users. It is
+     * currently invoked only from YansWifiPhy::FinalizeChannelSwitch.
+     * The channel moves the PHY to the list of the PHYs on its new
+     * operating channel.
+     */
+    void NotifyChannelSwitch(Ptr<YansWifiPhy> phy);
+
     /**
      * Assign a fixed random variable stream number to the random variables
      * used by this model.  Return the number of streams (possibly zero) that
@@ -87,7 +115,12 @@ class YansWifiChannel : public Channel
      */
     int64_t AssignStreams(int64_t stream);
 
+  protected:
+    void DoDispose() override;
+
   private:
+    class SpatialIndex;
+
     /**
      * A vector of pointers to YansWifiPhy.
      */
@@ -104,9 +137,46 @@ class YansWifiChannel : public Channel
      */
     static void Receive(Ptr<YansWifiPhy> receiver, Ptr<const WifiPpdu> ppdu, dBm_u txPower);
 
+    /**
+     * Schedule the reception of a PPDU by a PHY.
+     *
+     * \param senderMobility the mobility model of the sender
+     * \param receiver the PHY receiving the PPDU
+     * \param ppdu the PPDU being sent
+     * \param txPower the TX power associated to the packet being sent
+     */
+    void SendTo(Ptr<MobilityModel> senderMobility,
+                Ptr<YansWifiPhy> receiver,
+                Ptr<const WifiPpdu> ppdu,
+                dBm_u txPower) const;
+
+    /**
+     * \param txPower the TX power of the PPDU
+     * \param ppdu the PPDU being sent
+     * \returns the distance beyond which the PPDU cannot be received, or infinity
+     */
+    meter_u GetCullingRange(dBm_u txPower, Ptr<const WifiPpdu> ppdu) const;
+
+    /**
+     * Move a PHY to the list of the PHYs on its current operating channel,
+     * if it is set.
+     *
+     * \param index the index of the PHY in the PHY list
+     */
+    void IndexChannel(std::size_t index);
+
     PhyList m_phyList;                  //!< List of YansWifiPhys connected to this YansWifiChannel
+    /// Index of each PHY in the PHY list
+    std::unordered_map<const YansWifiPhy*, std::size_t> m_phyIndices;
+    /// Channel number under which each PHY of the PHY list is indexed, if any
+    std::vector<std::optional<uint8_t>> m_phyChannels;
+    /// Indices, in increasing order, of the PHYs on each channel number
+    std::map<uint8_t, std::vector<std::size_t>> m_physByChannel;
     Ptr<PropagationLossModel> m_loss;   //!< Propagation loss model
     Ptr<PropagationDelayModel> m_delay; //!< Propagation delay model
+    bool m_spatialCulling;              //!< Whether the receivers out of range are skipped
+    meter_u m_maxRange;                 //!< Range set by the user, or 0
+    mutable std::unique_ptr<SpatialIndex> m_index; //!< Spatial index of the PHYs
 };
 
 } // namespace ns3
@@ -132,6 +132,10 @@ YansWifiPhy::FinalizeChannelSwitch()
     NS_LOG_FUNCTION(this);
     NS_ABORT_MSG_IF(GetOperatingChannel().GetNSegments() > 1,
                     "operating channel made of non-contiguous segments cannot be used with Yans");
+    if (m_channel)
+    {
+        m_channel->NotifyChannelSwitch(this);
+    }
 }
 
 } // namespace ns3
@@ -8,6 +8,7 @@
 # See test.py for more information.
 cpp_examples = [
     ("wifi-phy-configuration --testCase=0", "True", "True"),
+    ("wifi-bss-scaling --maxBss=4 --simulationTime=0.1s", "True", "False"),
     ("wifi-phy-configuration --testCase=1", "True", "False"),
     ("wifi-phy-configuration --testCase=2", "True", "False"),
     ("wifi-phy-configuration --testCase=3", "True", "False"),
@@ -14,11 +14,13 @@
 #include <gsl/gsl_sf_bessel.h>
 #endif
 
+#include "ns3/boolean.h"
 #include "ns3/dsss-error-rate-model.h"
 #include "ns3/he-phy.h" //includes HT and VHT
 #include "ns3/interference-helper.h"
 #include "ns3/log.h"
 #include "ns3/nist-error-rate-model.h"
+#include "ns3/object-factory.h"
 #include "ns3/table-based-error-rate-model.h"
 #include "ns3/test.h"
 #include "ns3/wifi-phy.h"
@@ -1025,6 +1027,101 @@ TableBasedErrorRateTestCase::DoRun()
     }
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test the LookupTable attribute of the NIST and YANS error rate models
+ *
+ * The success rates of chunks of various sizes computed from the lookup tables
+ * are compared with the ones computed from the closed-form expressions, for all
+ * the HE MCSs, over a range of SNRs, as well as the success rate of several
+ * chunks computed at once.
+ */
+class ErrorRateLookupTableTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param model the TypeId name of the error rate model
+     */
+    ErrorRateLookupTableTestCase(const std::string& model);
+
+  private:
+    void DoRun() override;
+
+    std::string m_model; ///< The TypeId name of the error rate model
+};
+
+ErrorRateLookupTableTestCase::ErrorRateLookupTableTestCase(const std::string& model)
+    : TestCase("Check the lookup tables of " + model),
+      m_model(model)
+{
+}
+
+void
+ErrorRateLookupTableTestCase::DoRun()
+{
+    ObjectFactory factory;
+    factory.SetTypeId(m_model);
+    auto exact = factory.Create<ErrorRateModel>();
+    factory.Set("LookupTable", BooleanValue(true));
+    auto table = factory.Create<ErrorRateModel>();
+
+    const double tolerance = 1e-4; // see ErrorRateLookupTable
+    for (uint8_t mcs = 0; mcs <= 11; ++mcs)
+    {
+        for (MHz_u width : {MHz_u{20}, MHz_u{160}})
+        {
+            WifiTxVector txVector;
+            txVector.SetMode(HePhy::GetHeMcs(mcs));
+            txVector.SetPreambleType(WIFI_PREAMBLE_HE_SU);
+            txVector.SetChannelWidth(width);
+            txVector.SetGuardInterval(NanoSeconds(800));
+
+            for (dB_u snr = -10; snr <= dB_u{50}; snr += dB_u{0.0137})
+            {
+                for (uint64_t nbits : {1, 100, 12000, 1000000})
+                {
+                    const auto ratio = std::pow(10.0, snr / 10.0);
+                    const auto expected =
+                        exact->GetChunkSuccessRate(txVector.GetMode(), txVector, ratio, nbits);
+                    const auto actual =
+                        table->GetChunkSuccessRate(txVector.GetMode(), txVector, ratio, nbits);
+                    NS_TEST_ASSERT_MSG_EQ_TOL(actual,
+                                              expected,
+                                              tolerance,
+                                              "Wrong success rate for MCS "
+                                                  << +mcs << " in " << width << " MHz at " << snr
+                                                  << " dB for " << nbits << " bits");
+                }
+            }
+
+            // chunks at and around the SNR at which a 1500-byte frame is lost half of the time
+            const auto snr = exact->CalculateSnr(txVector, 1 - std::pow(0.5, 1.0 / 12000));
+            std::vector<ErrorRateModel::Chunk> chunks;
+            double expected = 1.0;
+            for (double factor : {0.1, 0.9, 1.0, 1.1, 1.2, 5.0})
+            {
+                chunks.push_back({snr * factor, 2000});
+                expected *= exact->GetChunkSuccessRate(txVector.GetMode(),
+                                                       txVector,
+                                                       snr * factor,
+                                                       2000);
+            }
+            NS_TEST_EXPECT_MSG_EQ(exact->GetChunksSuccessRate(txVector.GetMode(), txVector, chunks),
+                                  expected,
+                                  "The chunks should be evaluated one at a time");
+            NS_TEST_ASSERT_MSG_EQ_TOL(
+                table->GetChunksSuccessRate(txVector.GetMode(), txVector, chunks),
+                expected,
+                tolerance,
+                "Wrong success rate of the chunks for MCS " << +mcs << " in " << width << " MHz");
+        }
+    }
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -1043,6 +1140,10 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite()
     AddTestCase(new WifiErrorRateModelsTestCaseDsss, TestCase::Duration::QUICK);
     AddTestCase(new WifiErrorRateModelsTestCaseNist, TestCase::Duration::QUICK);
     AddTestCase(new WifiErrorRateModelsTestCaseMimo, TestCase::Duration::QUICK);
+    AddTestCase(new ErrorRateLookupTableTestCase("ns3::NistErrorRateModel"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new ErrorRateLookupTableTestCase("ns3::YansErrorRateModel"),
+                TestCase::Duration::QUICK);
     AddTestCase(new TableBasedErrorRateTestCase("DefaultTableBasedHtMcs0-1458bytes",
                                                 HtPhy::GetHtMcs0(),
                                                 1458),
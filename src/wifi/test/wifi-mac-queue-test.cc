@@ -119,12 +119,18 @@ WifiMacQueueDropOldestTest::DoRun()
  *
  * This test verifies the correctness of the WifiMacQueueContainer methods
  * (ExtractExpiredMpdus and ExtractAllExpiredMpdus) that extract MPDUs with
- * expired lifetime from the MAC queue container.
+ * expired lifetime from the MAC queue container, with and without the expiry
+ * index of the container.
  */
 class WifiExtractExpiredMpdusTest : public TestCase
 {
   public:
-    WifiExtractExpiredMpdusTest();
+    /**
+     * Constructor
+     *
+     * \param useExpiryIndex whether ExtractAllExpiredMpdus uses the expiry index
+     */
+    WifiExtractExpiredMpdusTest(bool useExpiryIndex);
 
   private:
     void DoRun() override;
@@ -138,13 +144,16 @@ class WifiExtractExpiredMpdusTest : public TestCase
      */
     void Enqueue(Mac48Address rxAddr, bool inflight, Time expiryTime);
 
+    bool m_useExpiryIndex;             //!< whether to use the expiry index
     WifiMacQueueContainer m_container; //!< MAC queue container
     uint16_t m_currentSeqNo{0};        //!< sequence number of current MPDU
     Mac48Address m_txAddr;             //!< Transmitter Address of MPDUs
 };
 
-WifiExtractExpiredMpdusTest::WifiExtractExpiredMpdusTest()
-    : TestCase("Test extraction of expired MPDUs from MAC queue container")
+WifiExtractExpiredMpdusTest::WifiExtractExpiredMpdusTest(bool useExpiryIndex)
+    : TestCase(std::string("Test extraction of expired MPDUs from MAC queue container") +
+               (useExpiryIndex ? " with expiry index" : "")),
+      m_useExpiryIndex(useExpiryIndex)
 {
 }
 
@@ -284,7 +293,7 @@ WifiExtractExpiredMpdusTest::DoRun()
         /**
          * Extract all expired MPDUs (from container queue 1 and 2)
          */
-        auto [first, last] = m_container.ExtractAllExpiredMpdus();
+        auto [first, last] = m_container.ExtractAllExpiredMpdus(m_useExpiryIndex);
 
         std::set<uint16_t> expectedSeqNo{5, 7, 8, 14, 17};
         std::set<uint16_t> actualSeqNo;
@@ -306,7 +315,7 @@ WifiExtractExpiredMpdusTest::DoRun()
 
         // If we try to extract expired MPDUs again, the returned set is empty
         {
-            auto [first, last] = m_container.ExtractAllExpiredMpdus();
+            auto [first, last] = m_container.ExtractAllExpiredMpdus(m_useExpiryIndex);
             NS_TEST_EXPECT_MSG_EQ((first == last), true, "Did not expect other expired MPDUs");
         }
 
@@ -413,6 +422,29 @@ WifiExtractExpiredMpdusTest::DoRun()
                               "There should be no other MPDU in container queue 2");
     });
 
+    /**
+     * At simulation time 80ms, all the MPDUs have expired, and the MPDUs that are
+     * not inflight (9, 10, 18 and 19) are extracted
+     */
+    Simulator::Schedule(MilliSeconds(80), [&]() {
+        auto [first, last] = m_container.ExtractAllExpiredMpdus(m_useExpiryIndex);
+
+        std::set<uint16_t> expectedSeqNo{9, 10, 18, 19};
+        std::set<uint16_t> actualSeqNo;
+
+        std::transform(first, last, std::inserter(actualSeqNo, actualSeqNo.end()), [](auto& elem) {
+            return elem.mpdu->GetHeader().GetSequenceNumber();
+        });
+
+        NS_TEST_EXPECT_MSG_EQ((expectedSeqNo == actualSeqNo), true, "Unexpected extracted MPDUs");
+        NS_TEST_EXPECT_MSG_EQ(m_container.GetQueue(queueId1).size(),
+                              4,
+                              "Unexpected number of MPDUs in container queue 1");
+        NS_TEST_EXPECT_MSG_EQ(m_container.GetQueue(queueId2).size(),
+                              4,
+                              "Unexpected number of MPDUs in container queue 2");
+    });
+
     Simulator::Run();
     Simulator::Destroy();
 }
@@ -433,7 +465,8 @@ WifiMacQueueTestSuite::WifiMacQueueTestSuite()
     : TestSuite("wifi-mac-queue", Type::UNIT)
 {
     AddTestCase(new WifiMacQueueDropOldestTest, TestCase::Duration::QUICK);
-    AddTestCase(new WifiExtractExpiredMpdusTest, TestCase::Duration::QUICK);
+    AddTestCase(new WifiExtractExpiredMpdusTest(false), TestCase::Duration::QUICK);
+    AddTestCase(new WifiExtractExpiredMpdusTest(true), TestCase::Duration::QUICK);
 }
 
 static WifiMacQueueTestSuite g_wifiMacQueueTestSuite; ///< the test suite
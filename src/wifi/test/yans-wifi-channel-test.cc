@@ -0,0 +1,382 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/interference-helper.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/ofdm-phy.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/wifi-mac-header.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-psdu.h"
+#include "ns3/yans-error-rate-model.h"
+#include "ns3/yans-wifi-channel.h"
+#include "ns3/yans-wifi-phy.h"
+
+#include <map>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("YansWifiChannelTest");
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Base class of the YansWifiChannel tests, recording the PPDUs
+ * received by the PHYs of the channel.
+ */
+class YansWifiChannelTestBase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param name the name of the test case
+     */
+    YansWifiChannelTestBase(const std::string& name);
+
+  protected:
+    /**
+     * Create the channel, and clear the PPDUs received.
+     *
+     * \param culling whether the spatial culling is enabled
+     */
+    void CreateChannel(bool culling);
+
+    /**
+     * Create a PHY on the channel.
+     *
+     * \param mobility the mobility model of the PHY
+     * \returns the PHY
+     */
+    Ptr<YansWifiPhy> CreatePhy(Ptr<MobilityModel> mobility);
+
+    /**
+     * Send a PPDU.
+     *
+     * \param phy the sender
+     */
+    void Send(Ptr<YansWifiPhy> phy);
+
+    Ptr<YansWifiChannel> m_channel;           //!< the channel
+    std::map<std::size_t, double> m_rxPowers; //!< received power of each PHY
+    std::map<std::size_t, Time> m_rxTimes;    //!< time of the first arrival at each PHY
+    std::map<std::size_t, std::size_t> m_nRx; //!< number of arrivals at each PHY
+
+  private:
+    /**
+     * Callback of the SignalArrival trace of the PHYs.
+     *
+     * \param index the index of the PHY
+     * \param ppdu the PPDU
+     * \param rxPowerDbm the received power
+     * \param duration the duration of the PPDU
+     */
+    void SignalArrival(std::size_t index,
+                       Ptr<const WifiPpdu> ppdu,
+                       double rxPowerDbm,
+                       Time duration);
+
+    std::size_t m_nPhys; //!< number of PHYs created
+};
+
+YansWifiChannelTestBase::YansWifiChannelTestBase(const std::string& name)
+    : TestCase(name),
+      m_nPhys(0)
+{
+}
+
+void
+YansWifiChannelTestBase::CreateChannel(bool culling)
+{
+    m_channel = CreateObject<YansWifiChannel>();
+    m_channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
+    m_channel->SetPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    m_channel->SetAttribute("SpatialCulling", BooleanValue(culling));
+    m_rxPowers.clear();
+    m_rxTimes.clear();
+    m_nRx.clear();
+    m_nPhys = 0;
+}
+
+Ptr<YansWifiPhy>
+YansWifiChannelTestBase::CreatePhy(Ptr<MobilityModel> mobility)
+{
+    auto node = CreateObject<Node>();
+    node->AggregateObject(mobility);
+    auto dev = CreateObject<WifiNetDevice>();
+    node->AddDevice(dev);
+    auto phy = CreateObject<YansWifiPhy>();
+    phy->SetInterferenceHelper(CreateObject<InterferenceHelper>());
+    phy->SetErrorRateModel(CreateObject<YansErrorRateModel>());
+    phy->SetChannel(m_channel);
+    phy->SetDevice(dev);
+    phy->ConfigureStandard(WIFI_STANDARD_80211a);
+    dev->SetPhy(phy);
+    phy->TraceConnectWithoutContext(
+        "SignalArrival",
+        MakeCallback(&YansWifiChannelTestBase::SignalArrival, this).Bind(m_nPhys++));
+    return phy;
+}
+
+void
+YansWifiChannelTestBase::Send(Ptr<YansWifiPhy> phy)
+{
+    WifiTxVector txVector{OfdmPhy::GetOfdmRate6Mbps(),
+                          0,
+                          WIFI_PREAMBLE_LONG,
+                          NanoSeconds(800),
+                          1,
+                          1,
+                          0,
+                          20,
+                          false};
+    WifiMacHeader hdr;
+    hdr.SetType(WIFI_MAC_QOSDATA);
+    hdr.SetQosTid(0);
+    phy->Send(Create<WifiPsdu>(Create<Packet>(100), hdr), txVector);
+}
+
+void
+YansWifiChannelTestBase::SignalArrival(std::size_t index,
+                                       Ptr<const WifiPpdu> ppdu,
+                                       double rxPowerDbm,
+                                       Time duration)
+{
+    m_rxPowers[index] = rxPowerDbm;
+    m_rxTimes.emplace(index, Simulator::Now());
+    ++m_nRx[index];
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that the spatial culling of YansWifiChannel only skips the
+ * PHYs which would not receive the PPDUs above their RX sensitivity, as the
+ * PHYs move.
+ */
+class YansWifiChannelCullingTest : public YansWifiChannelTestBase
+{
+  public:
+    YansWifiChannelCullingTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Send a PPDU from the center of a grid of PHYs.
+     *
+     * \param culling whether the spatial culling is enabled
+     * \returns the power at which each PHY received the PPDU
+     */
+    std::map<std::size_t, double> RunGrid(bool culling);
+
+    /**
+     * Send PPDUs as a PHY comes into range.
+     */
+    void RunMoving();
+};
+
+YansWifiChannelCullingTest::YansWifiChannelCullingTest()
+    : YansWifiChannelTestBase("Check that YansWifiChannel only culls the PHYs out of range")
+{
+}
+
+std::map<std::size_t, double>
+YansWifiChannelCullingTest::RunGrid(bool culling)
+{
+    CreateChannel(culling);
+
+    std::vector<Ptr<YansWifiPhy>> phys;
+    for (int x = -3; x <= 3; ++x)
+    {
+        for (int y = -3; y <= 3; ++y)
+        {
+            auto mobility = CreateObject<ConstantPositionMobilityModel>();
+            mobility->SetPosition(Vector(x * 60.0, y * 60.0, 1.5));
+            phys.push_back(CreatePhy(mobility));
+        }
+    }
+    Simulator::Schedule(Seconds(1), &YansWifiChannelCullingTest::Send, this, phys[24]);
+    Simulator::Run();
+    Simulator::Destroy();
+    m_channel = nullptr;
+    return m_rxPowers;
+}
+
+void
+YansWifiChannelCullingTest::RunMoving()
+{
+    CreateChannel(true);
+
+    auto sender = CreatePhy(CreateObject<ConstantPositionMobilityModel>());
+    // moves into range without notifying a course change
+    auto moving = CreateObject<ConstantVelocityMobilityModel>();
+    moving->SetPosition(Vector(1000, 0, 0));
+    moving->SetVelocity(Vector(-100, 0, 0));
+    CreatePhy(moving);
+    // moved into range, notifying a course change
+    auto moved = CreateObject<ConstantPositionMobilityModel>();
+    moved->SetPosition(Vector(0, 1000, 0));
+    CreatePhy(moved);
+
+    for (int t = 1; t <= 9; t += 2)
+    {
+        Simulator::Schedule(Seconds(t), &YansWifiChannelCullingTest::Send, this, sender);
+    }
+    Simulator::Schedule(Seconds(4), &MobilityModel::SetPosition, moved, Vector(0, 100, 0));
+    Simulator::Run();
+    Simulator::Destroy();
+    m_channel = nullptr;
+}
+
+void
+YansWifiChannelCullingTest::DoRun()
+{
+    auto all = RunGrid(false);
+    auto culled = RunGrid(true);
+    NS_TEST_ASSERT_MSG_EQ(all.size(), 48, "The PPDU should arrive at every other PHY");
+    std::size_t nReceived = 0;
+    for (const auto& [index, rxPower] : all)
+    {
+        auto it = culled.find(index);
+        // the RX sensitivity is -101 dBm
+        if (rxPower >= -101)
+        {
+            ++nReceived;
+            NS_TEST_ASSERT_MSG_EQ((it != culled.end()), true, "PHY " << index << " was culled");
+            NS_TEST_EXPECT_MSG_EQ(it->second, rxPower, "Wrong RX power at PHY " << index);
+        }
+    }
+    NS_TEST_EXPECT_MSG_GT(nReceived, 0, "No PHY is in range");
+    NS_TEST_EXPECT_MSG_LT(culled.size(), all.size(), "No PHY was culled");
+    NS_TEST_EXPECT_MSG_LT(nReceived, all.size(), "Every PHY is in range");
+
+    // the range of the log distance model is about 221 m with the default
+    // parameters; at 7 s, the moving PHY is 300 m away, and at 9 s, 100 m
+    RunMoving();
+    NS_TEST_ASSERT_MSG_EQ((m_rxTimes.find(1) != m_rxTimes.end()),
+                          true,
+                          "The moving PHY did not receive");
+    NS_TEST_EXPECT_MSG_GT(m_rxTimes[1], Seconds(9), "The moving PHY received too early");
+    NS_TEST_ASSERT_MSG_EQ((m_rxTimes.find(2) != m_rxTimes.end()),
+                          true,
+                          "The moved PHY did not receive");
+    NS_TEST_EXPECT_MSG_GT(m_rxTimes[2], Seconds(5), "The moved PHY received too early");
+    NS_TEST_EXPECT_MSG_LT(m_rxTimes[2], Seconds(6), "The moved PHY did not receive at 5 s");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that YansWifiChannel delivers the PPDUs to the PHYs on the
+ * channel of the sender, as the PHYs switch channel.
+ */
+class YansWifiChannelSwitchTest : public YansWifiChannelTestBase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param culling whether the spatial culling is enabled
+     */
+    YansWifiChannelSwitchTest(bool culling);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the number of PPDUs received by each PHY so far.
+     *
+     * \param nRx the expected number of PPDUs received by each PHY
+     */
+    void CheckRx(std::vector<std::size_t> nRx);
+
+    bool m_culling; //!< whether the spatial culling is enabled
+};
+
+YansWifiChannelSwitchTest::YansWifiChannelSwitchTest(bool culling)
+    : YansWifiChannelTestBase(std::string("Check that YansWifiChannel only delivers the PPDUs "
+                                          "on the channel of the sender, ") +
+                              (culling ? "with" : "without") + " spatial culling"),
+      m_culling(culling)
+{
+}
+
+void
+YansWifiChannelSwitchTest::CheckRx(std::vector<std::size_t> nRx)
+{
+    for (std::size_t i = 0; i < nRx.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_nRx[i],
+                              nRx[i],
+                              "Unexpected number of PPDUs received by PHY "
+                                  << i << " at " << Simulator::Now().As(Time::S));
+    }
+}
+
+void
+YansWifiChannelSwitchTest::DoRun()
+{
+    CreateChannel(m_culling);
+    std::vector<Ptr<YansWifiPhy>> phys;
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        auto mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(Vector(10.0 * i, 0, 0));
+        phys.push_back(CreatePhy(mobility));
+    }
+    // the PHYs are on channel 36 after ConfigureStandard; move the last one
+    // before the first transmission
+    phys[3]->SetOperatingChannel(WifiPhy::ChannelTuple{40, 20, WIFI_PHY_BAND_5GHZ, 0});
+
+    Simulator::Schedule(Seconds(1), &YansWifiChannelSwitchTest::Send, this, phys[0]);
+    Simulator::Schedule(Seconds(1.5),
+                        &YansWifiChannelSwitchTest::CheckRx,
+                        this,
+                        std::vector<std::size_t>{0, 1, 1, 0});
+    Simulator::Schedule(Seconds(2), [=]() {
+        phys[1]->SetOperatingChannel(WifiPhy::ChannelTuple{40, 20, WIFI_PHY_BAND_5GHZ, 0});
+    });
+    Simulator::Schedule(Seconds(3), &YansWifiChannelSwitchTest::Send, this, phys[0]);
+    Simulator::Schedule(Seconds(3), &YansWifiChannelSwitchTest::Send, this, phys[3]);
+    Simulator::Schedule(Seconds(3.5),
+                        &YansWifiChannelSwitchTest::CheckRx,
+                        this,
+                        std::vector<std::size_t>{0, 2, 2, 0});
+    Simulator::Run();
+    Simulator::Destroy();
+    m_channel = nullptr;
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief YansWifiChannel Test Suite
+ */
+class YansWifiChannelTestSuite : public TestSuite
+{
+  public:
+    YansWifiChannelTestSuite();
+};
+
+YansWifiChannelTestSuite::YansWifiChannelTestSuite()
+    : TestSuite("yans-wifi-channel", Type::UNIT)
+{
+    AddTestCase(new YansWifiChannelCullingTest, TestCase::Duration::QUICK);
+    AddTestCase(new YansWifiChannelSwitchTest(false), TestCase::Duration::QUICK);
+    AddTestCase(new YansWifiChannelSwitchTest(true), TestCase::Duration::QUICK);
+}
+
+static YansWifiChannelTestSuite g_yansWifiChannelTestSuite; ///< the test suite
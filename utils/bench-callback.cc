@@ -0,0 +1,149 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/core-module.h"
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * \file
+ * \ingroup callback
+ * Benchmark the construction and invocation of callbacks and trace sources.
+ */
+
+/** Callback target. */
+class Target
+{
+  public:
+    /**
+     * Member function target.
+     * \param [in] value The value to accumulate.
+     */
+    void Add(uint32_t value)
+    {
+        m_sum += value;
+    }
+
+    /**
+     * Member function target with more arguments, typical of trace sinks.
+     * \param [in] context The trace context.
+     * \param [in] value The value to accumulate.
+     * \param [in] scale The scale of the value.
+     */
+    void AddScaled(std::string context, uint32_t value, double scale)
+    {
+        m_sum += value * scale;
+    }
+
+    /** The accumulated value. */
+    double m_sum{0};
+};
+
+/**
+ * Run a benchmark and print its results.
+ *
+ * \param [in] name The benchmark name.
+ * \param [in] n The number of iterations.
+ * \param [in] body The benchmark body, run once per iteration.
+ */
+void
+Run(const std::string& name, uint64_t n, const std::function<void(uint64_t)>& body)
+{
+    auto start = std::chrono::steady_clock::now();
+    body(n);
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::cout << std::left << std::setw(32) << name << std::right << std::setw(10)
+              << std::fixed << std::setprecision(2) << ns / n << " ns/op" << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t n = 10000000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the construction and invocation of callbacks.\n");
+    cmd.AddValue("n", "number of iterations", n);
+    cmd.Parse(argc, argv);
+
+    Target target;
+    TracedCallback<uint32_t> trace;
+    trace.ConnectWithoutContext(MakeCallback(&Target::Add, &target));
+    trace.ConnectWithoutContext(MakeCallback(&Target::Add, &target));
+    TracedCallback<uint32_t, double> contextTrace;
+    contextTrace.Connect(MakeCallback(&Target::AddScaled, &target), "/NodeList/0");
+    TracedCallback<std::string> unused;
+
+    Callback<void, uint32_t> member = MakeCallback(&Target::Add, &target);
+    Callback<void, uint32_t, double> bound =
+        MakeCallback(&Target::AddScaled, &target).Bind("ctx");
+    Callback<void, uint32_t> lambda = [&target](uint32_t value) { target.m_sum += value; };
+
+    Run("MakeCallback (member)", n / 10, [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            Callback<void, uint32_t> cb = MakeCallback(&Target::Add, &target);
+            cb(i);
+        }
+    });
+    Run("Callback copy", n, [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            Callback<void, uint32_t> cb = member;
+            cb(i);
+        }
+    });
+    Run("Invoke (member)", n, [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            member(i);
+        }
+    });
+    Run("Invoke (bound member)", n, [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            bound(i, 0.5);
+        }
+    });
+    Run("Invoke (lambda)", n, [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            lambda(i);
+        }
+    });
+    Run("TracedCallback (2 sinks)", n, [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            trace(i);
+        }
+    });
+    Run("TracedCallback (context sink)", n, [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            contextTrace(i, 0.5);
+        }
+    });
+    Run("TracedCallback (no sink)", n, [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            unused(std::to_string(i));
+        }
+    });
+    Run("NS_TRACE (no sink)", n, [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i)
+        {
+            NS_TRACE(unused, std::to_string(i));
+        }
+    });
+
+    std::cout << "checksum " << target.m_sum << std::endl;
+    return 0;
+}
@@ -0,0 +1,213 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program benchmarks the Internet checksum of Buffer::Iterator and the
+// CRC-32 of the Ethernet trailer, against the byte-at-a-time loops they
+// replaced, after checking that both give the same results.
+// Sample usage:  ./ns3 run 'bench-checksum --n=100000 --size=1500'
+
+#include "ns3/buffer.h"
+#include "ns3/command-line.h"
+#include "ns3/crc32.h"
+#include "ns3/ip-checksum.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdlib.h> // for exit ()
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Calculate the Internet checksum one word at a time.
+ *
+ * \param i The iterator from which the bytes are read.
+ * \param size The number of bytes.
+ * \param initialChecksum The initial value.
+ * \returns The checksum.
+ */
+static uint16_t
+ReferenceIpChecksum(Buffer::Iterator i, uint16_t size, uint32_t initialChecksum)
+{
+    uint32_t sum = initialChecksum;
+    for (int j = 0; j < size / 2; j++)
+    {
+        sum += i.ReadU16();
+    }
+    if (size & 1)
+    {
+        sum += i.ReadU8();
+    }
+    while (sum >> 16)
+    {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    return ~sum;
+}
+
+/**
+ * Calculate the CRC-32 one byte at a time, with a table.
+ *
+ * \param data The buffer.
+ * \param length The length of the buffer.
+ * \returns The CRC-32.
+ */
+static uint32_t
+ReferenceCrc32(const uint8_t* data, uint32_t length)
+{
+    static uint32_t table[256];
+    if (table[1] == 0)
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+            }
+            table[i] = crc;
+        }
+    }
+    uint32_t crc = 0xffffffff;
+    while (length--)
+    {
+        crc = (crc >> 8) ^ table[(crc & 0xFF) ^ *data++];
+    }
+    return ~crc;
+}
+
+/**
+ * Run a benchmark, and print its throughput.
+ *
+ * \param name The name of the benchmark.
+ * \param n The number of packets processed.
+ * \param size The size of the packets.
+ * \param bench The benchmark, which returns a value depending on its results.
+ * \returns The value returned by the benchmark.
+ */
+template <typename F>
+static uint64_t
+RunBench(const char* name, uint32_t n, uint32_t size, F bench)
+{
+    SystemWallClockMs time;
+    time.Start();
+    uint64_t result = bench();
+    int64_t deltaMs = std::max<int64_t>(time.End(), 1);
+    double mbps = 8.0 * n * size / deltaMs / 1000;
+    std::cout << mbps << " Mbit/s (" << deltaMs << " ms elapsed)\t" << name << std::endl;
+    return result;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 100000;
+    uint32_t size = 1500;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the Internet checksum and the CRC-32");
+    cmd.AddValue("n", "number of packets", n);
+    cmd.AddValue("size", "size of the packets", size);
+    cmd.Parse(argc, argv);
+
+    if (size == 0 || size > 65535)
+    {
+        std::cerr << "Error-- the size must be between 1 and 65535" << std::endl;
+        exit(1);
+    }
+
+    // a few packets of random bytes, with a zero area in the middle
+    const uint32_t nBuffers = 16;
+    std::vector<Buffer> buffers;
+    std::vector<std::vector<uint8_t>> frames;
+    uint32_t seed = 1;
+    for (uint32_t b = 0; b < nBuffers; b++)
+    {
+        std::vector<uint8_t> frame(size);
+        for (auto& byte : frame)
+        {
+            seed = seed * 1103515245 + 12345;
+            byte = seed >> 16;
+        }
+        uint32_t zero = b % 2 ? size / 4 : 0;
+        uint32_t start = (size - zero) / 2 + b % 3;
+        start = std::min(start, size - zero);
+        Buffer buffer(zero);
+        buffer.AddAtStart(start);
+        buffer.Begin().Write(frame.data(), start);
+        buffer.AddAtEnd(size - zero - start);
+        Buffer::Iterator it = buffer.Begin();
+        it.Next(start + zero);
+        it.Write(frame.data() + start + zero, size - zero - start);
+        std::fill(frame.begin() + start, frame.begin() + start + zero, 0);
+        buffers.push_back(buffer);
+        frames.push_back(frame);
+    }
+
+    for (uint32_t b = 0; b < nBuffers; b++)
+    {
+        for (uint32_t offset = 0; offset < 4 && offset < size; offset++)
+        {
+            Buffer::Iterator i = buffers[b].Begin();
+            i.Next(offset);
+            uint16_t expected = ReferenceIpChecksum(i, size - offset, 0x1234);
+            if (i.CalculateIpChecksum(size - offset, 0x1234) != expected)
+            {
+                std::cerr << "Error-- wrong checksum of packet " << b << std::endl;
+                exit(1);
+            }
+            if (CRC32Calculate(frames[b].data() + offset, size - offset) !=
+                ReferenceCrc32(frames[b].data() + offset, size - offset))
+            {
+                std::cerr << "Error-- wrong CRC-32 of packet " << b << std::endl;
+                exit(1);
+            }
+        }
+    }
+    std::cout << "Running bench-checksum with n=" << n << " size=" << size
+              << ", ones' complement sum: " << GetOnesComplementSumImplementation()
+              << std::endl;
+
+    uint64_t check = 0;
+    check += RunBench("Internet checksum, one word at a time", n, size, [&]() {
+        uint64_t result = 0;
+        for (uint32_t k = 0; k < n; k++)
+        {
+            result += ReferenceIpChecksum(buffers[k % nBuffers].Begin(), size, 0);
+        }
+        return result;
+    });
+    check -= RunBench("Internet checksum", n, size, [&]() {
+        uint64_t result = 0;
+        for (uint32_t k = 0; k < n; k++)
+        {
+            result += buffers[k % nBuffers].Begin().CalculateIpChecksum(size, 0);
+        }
+        return result;
+    });
+    check += RunBench("CRC-32, one byte at a time", n, size, [&]() {
+        uint64_t result = 0;
+        for (uint32_t k = 0; k < n; k++)
+        {
+            result += ReferenceCrc32(frames[k % nBuffers].data(), size);
+        }
+        return result;
+    });
+    check -= RunBench("CRC-32", n, size, [&]() {
+        uint64_t result = 0;
+        for (uint32_t k = 0; k < n; k++)
+        {
+            result += CRC32Calculate(frames[k % nBuffers].data(), size);
+        }
+        return result;
+    });
+
+    if (check != 0)
+    {
+        std::cerr << "Error-- the results differ" << std::endl;
+        exit(1);
+    }
+    return 0;
+}
@@ -0,0 +1,194 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program benchmarks the InterferenceHelper of the wifi module.  Signals
+// of random power and duration arrive at random times on a receiver tracking
+// the bands of a channel of the given width, split down to 2.5 MHz like the
+// RU bands of a SpectrumWifiPhy.  When it is idle, the receiver starts
+// receiving the arriving signal, and computes its SNR and PER at its end.  The
+// program prints the time per signal, and the sum of the SNRs and PERs, which
+// does not depend on the implementation.
+// Sample usage:  ./ns3 run 'bench-interference --n=20000 --overlap=4'
+
+#include "ns3/command-line.h"
+#include "ns3/double.h"
+#include "ns3/interference-helper.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/ofdm-phy.h"
+#include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/wifi-phy-operating-channel.h"
+#include "ns3/wifi-psdu.h"
+#include "ns3/wifi-utils.h"
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+/// Receiver of the benchmark
+class BenchReceiver
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param width The width of the channel.
+     * \param meanDuration The mean duration of the signals.
+     */
+    BenchReceiver(MHz_u width, Time meanDuration);
+
+    /**
+     * Add a signal, and start receiving it if the receiver is idle.
+     */
+    void AddSignal();
+
+    double m_snrSum{0}; //!< Sum of the SNRs of the received signals
+    double m_perSum{0}; //!< Sum of the PERs of the received signals
+    uint32_t m_nRx{0};  //!< Number of received signals
+
+  private:
+    /**
+     * End the reception of a signal.
+     *
+     * \param event The event of the signal.
+     */
+    void EndRx(Ptr<Event> event);
+
+    MHz_u m_width;                             //!< The width of the channel
+    Ptr<InterferenceHelper> m_interference;    //!< The interference helper
+    std::vector<WifiSpectrumBandInfo> m_bands; //!< The tracked bands
+    FrequencyRange m_range;                    //!< The frequency range of the receiver
+    WifiTxVector m_txVector;                   //!< The TXVECTOR of the signals
+    Ptr<WifiPpdu> m_ppdu;                      //!< The PPDU of the signals
+    Ptr<UniformRandomVariable> m_power;        //!< Power of the signals (dBm)
+    Ptr<ExponentialRandomVariable> m_duration; //!< Duration of the signals (us)
+    bool m_rxing{false};                       //!< Whether a signal is being received
+};
+
+BenchReceiver::BenchReceiver(MHz_u width, Time meanDuration)
+    : m_width(width),
+      m_range{5000, 6000}
+{
+    m_interference = CreateObject<InterferenceHelper>();
+    m_interference->SetNoiseFigure(DbToRatio(7));
+    m_interference->SetErrorRateModel(CreateObject<NistErrorRateModel>());
+    const Hz_u start = (5250 - width / 2) * 1e6;
+    for (MHz_u bw = width; bw >= 2.5; bw /= 2)
+    {
+        for (uint32_t i = 0; i < width / bw; ++i)
+        {
+            WifiSpectrumBandInfo band;
+            const auto first = static_cast<uint32_t>(i * bw / 0.3125);
+            const auto last = static_cast<uint32_t>((i + 1) * bw / 0.3125) - 1;
+            band.indices.emplace_back(first, last);
+            band.frequencies.emplace_back(start + i * bw * 1e6, start + (i + 1) * bw * 1e6);
+            m_bands.push_back(band);
+            m_interference->AddBand(band);
+        }
+    }
+
+    m_txVector.SetMode(OfdmPhy::GetOfdmRate6Mbps());
+    m_txVector.SetChannelWidth(20);
+    m_txVector.SetPreambleType(WIFI_PREAMBLE_LONG);
+    WifiMacHeader hdr;
+    hdr.SetType(WIFI_MAC_QOSDATA);
+    m_ppdu = Create<WifiPpdu>(Create<WifiPsdu>(Create<Packet>(1000), hdr),
+                              m_txVector,
+                              WifiPhyOperatingChannel());
+
+    // the signals are the same, whatever the width
+    m_power = CreateObject<UniformRandomVariable>();
+    m_power->SetStream(1);
+    m_power->SetAttribute("Min", DoubleValue(-85));
+    m_power->SetAttribute("Max", DoubleValue(-60));
+    m_duration = CreateObject<ExponentialRandomVariable>();
+    m_duration->SetStream(2);
+    m_duration->SetAttribute("Mean", DoubleValue(meanDuration.GetMicroSeconds()));
+    m_duration->SetAttribute("Bound", DoubleValue(10 * meanDuration.GetMicroSeconds()));
+}
+
+void
+BenchReceiver::AddSignal()
+{
+    RxPowerWattPerChannelBand rxPower;
+    const auto power = DbmToW(m_power->GetValue());
+    for (const auto& band : m_bands)
+    {
+        const auto& [low, high] = band.frequencies.front();
+        rxPower.emplace(band, power * (high - low) / (m_width * 1e6));
+    }
+    const auto duration = MicroSeconds(20 + m_duration->GetInteger());
+    auto event = m_interference->Add(m_ppdu, duration, rxPower, m_range);
+    if (!m_rxing)
+    {
+        m_rxing = true;
+        m_interference->NotifyRxStart(m_range);
+        Simulator::Schedule(duration, &BenchReceiver::EndRx, this, event);
+    }
+}
+
+void
+BenchReceiver::EndRx(Ptr<Event> event)
+{
+    const auto payloadDuration = event->GetDuration() - MicroSeconds(20);
+    const auto snrPer = m_interference->CalculatePayloadSnrPer(event,
+                                                               20,
+                                                               m_bands.back(),
+                                                               SU_STA_ID,
+                                                               {Time{0}, payloadDuration});
+    m_snrSum += snrPer.snr;
+    m_perSum += snrPer.per;
+    ++m_nRx;
+    m_interference->NotifyRxEnd(Simulator::Now(), m_range);
+    m_rxing = false;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 20000;
+    double overlap = 4;
+    Time duration = MicroSeconds(500);
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the InterferenceHelper of the wifi module");
+    cmd.AddValue("n", "number of signals", n);
+    cmd.AddValue("overlap", "mean number of overlapping signals", overlap);
+    cmd.AddValue("duration", "mean duration of the signals", duration);
+    cmd.Parse(argc, argv);
+
+    std::cout << std::setw(12) << "width (MHz)" << std::setw(8) << "bands" << std::setw(14)
+              << "us/signal" << std::setw(12) << "received" << std::setw(20) << "SNR sum"
+              << std::setw(20) << "PER sum" << std::endl;
+    for (MHz_u width : {20, 40, 80, 160, 320})
+    {
+        BenchReceiver receiver(width, duration);
+        auto interval = CreateObject<ExponentialRandomVariable>();
+        interval->SetStream(3);
+        interval->SetAttribute("Mean", DoubleValue(duration.GetMicroSeconds() / overlap));
+        Time t;
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            t += MicroSeconds(interval->GetInteger());
+            Simulator::Schedule(t, &BenchReceiver::AddSignal, &receiver);
+        }
+
+        SystemWallClockMs time;
+        time.Start();
+        Simulator::Run();
+        const auto deltaMs = time.End();
+        Simulator::Destroy();
+
+        const auto nBands = static_cast<uint32_t>(2 * width / 2.5 - 1);
+        std::cout << std::setw(12) << static_cast<uint32_t>(width) << std::setw(8) << nBands
+                  << std::setw(14) << std::fixed << std::setprecision(2) << 1000.0 * deltaMs / n
+                  << std::setw(12) << receiver.m_nRx << std::setw(20) << std::setprecision(6)
+                  << receiver.m_snrSum << std::setw(20) << receiver.m_perSum << std::endl;
+    }
+    return 0;
+}
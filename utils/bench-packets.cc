@@ -21,6 +21,7 @@
 #include <sstream>
 #include <stdlib.h> // for exit ()
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -321,6 +322,71 @@ benchFragment(uint32_t n)
     }
 }
 
+/**
+ * Create a packet whose payload is made of real bytes, rather than
+ * of the virtual zero area of Create<Packet> (size).
+ *
+ * \param size the payload size
+ * \returns the packet
+ */
+static Ptr<Packet>
+CreateRealPacket(uint32_t size)
+{
+    std::vector<uint8_t> payload(size, 0x5a);
+    return Create<Packet>(payload.data(), size);
+}
+
+static void
+benchFragmentReal(uint32_t n)
+{
+    BenchHeader<25> ipv4;
+    Ptr<Packet> p = CreateRealPacket(2000);
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        for (uint32_t offset = 0; offset < 2000; offset += 250)
+        {
+            Ptr<Packet> frag = p->CreateFragment(offset, 250);
+            frag->AddHeader(ipv4);
+        }
+    }
+}
+
+static void
+benchConcatenate(uint32_t n)
+{
+    Ptr<Packet> p = CreateRealPacket(2000);
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> whole = p->CreateFragment(0, 250);
+        for (uint32_t offset = 250; offset < 2000; offset += 250)
+        {
+            whole->AddAtEnd(p->CreateFragment(offset, 250));
+        }
+    }
+}
+
+static void
+benchAggregate(uint32_t n)
+{
+    BenchHeader<14> subframe;
+    Ptr<Packet> msdu = CreateRealPacket(1500);
+    Ptr<Packet> pad = CreateRealPacket(2);
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> aggregate = Create<Packet>();
+        for (uint32_t j = 0; j < 32; j++)
+        {
+            Ptr<Packet> tmp = msdu->Copy();
+            tmp->AddHeader(subframe);
+            aggregate->AddAtEnd(tmp);
+            aggregate->AddAtEnd(pad);
+        }
+    }
+}
+
 static void
 benchByteTags(uint32_t n)
 {
@@ -339,6 +405,44 @@ benchByteTags(uint32_t n)
     }
 }
 
+static void
+benchPacketTags(uint32_t n)
+{
+    BenchTag<1> snr;
+    BenchTag<2> ampdu;
+    BenchTag<4> flowId;
+    BenchTag<6> bearer;
+    BenchTag<8> priority;
+    BenchTag<12> txVector;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(1500);
+        p->AddPacketTag(flowId);
+        p->AddPacketTag(priority);
+        p->AddPacketTag(bearer);
+        p->AddPacketTag(txVector);
+
+        // Each receiver gets its own copy and tags it further
+        for (uint32_t j = 0; j < 4; j++)
+        {
+            Ptr<Packet> copy = p->Copy();
+            copy->AddPacketTag(snr);
+            copy->AddPacketTag(ampdu);
+            for (uint32_t k = 0; k < 4; k++)
+            {
+                copy->PeekPacketTag(flowId);
+                copy->PeekPacketTag(priority);
+                copy->PeekPacketTag(txVector);
+                copy->PeekPacketTag(snr);
+            }
+            copy->ReplacePacketTag(priority);
+            copy->RemovePacketTag(ampdu);
+            copy->RemovePacketTag(bearer);
+        }
+    }
+}
+
 static uint64_t
 runBenchOneIteration(void (*bench)(uint32_t), uint32_t n)
 {
@@ -395,7 +499,11 @@ main(int argc, char* argv[])
     runBench(&benchC, n, minIterations, "Remove by func call");
     runBench(&benchD, n, minIterations, "Intermixed add/remove headers and tags");
     runBench(&benchFragment, n, minIterations, "Fragmentation and concatenation");
+    runBench(&benchFragmentReal, n, minIterations, "Fragmentation of a real payload");
+    runBench(&benchConcatenate, n, minIterations, "In-order concatenation of fragments");
+    runBench(&benchAggregate, n, minIterations, "Aggregation of 32 real payloads");
     runBench(&benchByteTags, n, minIterations, "Benchmark byte tags");
+    runBench(&benchPacketTags, n, minIterations, "Add, copy, peek and remove packet tags");
 
     return 0;
 }
@@ -376,24 +376,94 @@ BenchSuite::Log() const
 
 } // BenchSuite::Log()
 
+/**
+ *  Bimodal event delays: a mixture of short and long exponential delays.
+ *
+ *  This models packet-level events mixed with long-horizon timers,
+ *  such as application and protocol timeouts.
+ */
+class BimodalRandomVariable : public RandomVariableStream
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("BimodalRandomVariable")
+                                .SetParent<RandomVariableStream>()
+                                .AddConstructor<BimodalRandomVariable>();
+        return tid;
+    }
+
+    /** Constructor. */
+    BimodalRandomVariable()
+    {
+        m_short = CreateObject<ExponentialRandomVariable>();
+        m_short->SetAttribute("Mean", DoubleValue(100));
+        m_long = CreateObject<ExponentialRandomVariable>();
+        m_long->SetAttribute("Mean", DoubleValue(1000000));
+        m_choice = CreateObject<UniformRandomVariable>();
+    }
+
+    double GetValue() override
+    {
+        // One event in a hundred is a 1 ms timer
+        return m_choice->GetValue() < 0.01 ? m_long->GetValue() : m_short->GetValue();
+    }
+
+    uint32_t GetInteger() override
+    {
+        return static_cast<uint32_t>(GetValue());
+    }
+
+  private:
+    Ptr<ExponentialRandomVariable> m_short; /**< Short delays, mean 100 ns. */
+    Ptr<ExponentialRandomVariable> m_long;  /**< Long delays, mean 1 ms. */
+    Ptr<UniformRandomVariable> m_choice;    /**< Choice between the two modes. */
+
+}; // class BimodalRandomVariable
+
 /**
  *  Create a RandomVariableStream to generate next event delays.
  *
- *  If the \p filename parameter is empty a default exponential time
- *  distribution will be used, with mean delay of 100 ns.
+ *  If the \p filename parameter is empty the distribution given by
+ *  \p dist will be used:
+ *  - \c exp: exponential, with mean delay of 100 ns (the default);
+ *  - \c pareto: heavy-tailed Pareto, with minimum delay of 10 ns,
+ *    mean delay of 110 ns and delays bounded by 1 s;
+ *  - \c bimodal: 99% exponential with mean delay 100 ns,
+ *    1% exponential with mean delay 1 ms.
  *
  *  If the \p filename is `-` standard input will be used.
  *
  *  \param [in] filename The delay interval source file name.
+ *  \param [in] dist The delay distribution, if \p filename is empty.
  *  \returns The RandomVariableStream.
  */
 Ptr<RandomVariableStream>
-GetRandomStream(std::string filename)
+GetRandomStream(std::string filename, std::string dist)
 {
     Ptr<RandomVariableStream> stream = nullptr;
 
-    if (filename.empty())
+    if (filename.empty() && dist == "pareto")
+    {
+        LOG("  Event time distribution:      skewed (Pareto)");
+        auto prv = CreateObject<ParetoRandomVariable>();
+        prv->SetAttribute("Scale", DoubleValue(10));
+        prv->SetAttribute("Shape", DoubleValue(1.1));
+        prv->SetAttribute("Bound", DoubleValue(1e9));
+        stream = prv;
+    }
+    else if (filename.empty() && dist == "bimodal")
     {
+        LOG("  Event time distribution:      bimodal");
+        stream = CreateObject<BimodalRandomVariable>();
+    }
+    else if (filename.empty())
+    {
+        NS_ABORT_MSG_IF(dist != "exp", "Unknown event time distribution " << dist);
         LOG("  Event time distribution:      default exponential");
         auto erv = CreateObject<ExponentialRandomVariable>();
         erv->SetAttribute("Mean", DoubleValue(100));
@@ -446,6 +516,7 @@ main(int argc, char* argv[])
     bool allSched = false;
     bool schedCal = false;
     bool schedHeap = false;
+    bool schedLadder = false;
     bool schedList = false;
     bool schedMap = false; // default scheduler
     bool schedPQ = false;
@@ -454,13 +525,16 @@ main(int argc, char* argv[])
     uint64_t total = 1000000;
     uint64_t runs = 1;
     std::string filename = "";
+    std::string dist = "exp";
     bool calRev = false;
+    bool pool = false;
 
     CommandLine cmd(__FILE__);
     cmd.Usage("Benchmark the simulator scheduler.\n"
               "\n"
               "Event intervals are taken from one of:\n"
               "  an exponential distribution, with mean 100 ns,\n"
+              "  a skewed or bimodal distribution, given by the --dist argument,\n"
               "  an ascii file, given by the --file=\"<filename>\" argument,\n"
               "  or standard input, by the argument --file=\"-\"\n"
               "In the case of either --file form, the input is expected\n"
@@ -471,6 +545,7 @@ main(int argc, char* argv[])
     cmd.AddValue("cal", "use CalendarScheduler", schedCal);
     cmd.AddValue("calrev", "reverse ordering in the CalendarScheduler", calRev);
     cmd.AddValue("heap", "use HeapScheduler", schedHeap);
+    cmd.AddValue("ladder", "use LadderScheduler", schedLadder);
     cmd.AddValue("list", "use ListScheduler", schedList);
     cmd.AddValue("map", "use MapScheduler (default)", schedMap);
     cmd.AddValue("pri", "use PriorityQueue", schedPQ);
@@ -479,7 +554,9 @@ main(int argc, char* argv[])
     cmd.AddValue("total", "total number of events to run", total);
     cmd.AddValue("runs", "number of runs", runs);
     cmd.AddValue("file", "file of relative event times", filename);
+    cmd.AddValue("dist", "event time distribution: exp, pareto or bimodal", dist);
     cmd.AddValue("prec", "printed output precision", g_fwidth);
+    cmd.AddValue("pool", "allocate the events from the EventPool", pool);
     cmd.Parse(argc, argv);
 
     g_me = cmd.GetName() + ": ";
@@ -492,17 +569,23 @@ main(int argc, char* argv[])
     LOG("  Number of runs per scheduler: " << runs);
     DEB("debugging is ON");
 
+    if (pool)
+    {
+        LOG("  Event allocation:             pooled");
+        EventPool::Enable();
+    }
+
     if (allSched)
     {
-        schedCal = schedHeap = schedList = schedMap = schedPQ = true;
+        schedCal = schedHeap = schedLadder = schedList = schedMap = schedPQ = true;
     }
     // Set the default case if nothing else is set
-    if (!(schedCal || schedHeap || schedList || schedMap || schedPQ))
+    if (!(schedCal || schedHeap || schedLadder || schedList || schedMap || schedPQ))
     {
         schedMap = true;
     }
 
-    auto eventStream = GetRandomStream(filename);
+    auto eventStream = GetRandomStream(filename, dist);
 
     ObjectFactory factory("ns3::MapScheduler");
     if (schedCal)
@@ -521,6 +604,11 @@ main(int argc, char* argv[])
         factory.SetTypeId("ns3::HeapScheduler");
         BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
     }
+    if (schedLadder)
+    {
+        factory.SetTypeId("ns3::LadderScheduler");
+        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+    }
     if (schedList)
     {
         factory.SetTypeId("ns3::ListScheduler");
@@ -0,0 +1,176 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program benchmarks the trace sources of a Wi-Fi network, and the
+// callbacks which connect its layers.  Ad hoc stations placed on a grid send
+// packets to their neighbor; the program runs the same scenario with no sink,
+// then with the given number of sinks connected to each of the PHY, PHY state
+// and MAC trace sources of every station, and prints the wall clock time of
+// each run and the extra time per sink invocation.
+// Sample usage:  ./ns3 run 'bench-wifi-trace --nodes=20 --sinks=4'
+
+#include "ns3/command-line.h"
+#include "ns3/config.h"
+#include "ns3/double.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-helper.h"
+#include "ns3/wifi-mac-helper.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-phy-state.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+
+/// Trace sink counting its invocations
+class BenchSink
+{
+  public:
+    /**
+     * Count an invocation.
+     * \tparam Args \explicit The types of the trace source arguments.
+     */
+    template <typename... Args>
+    void Count(Args...)
+    {
+        ++m_count;
+    }
+
+    uint64_t m_count{0}; //!< Number of invocations
+};
+
+/**
+ * Send a packet to the next station, and schedule the next one.
+ *
+ * \param device The device of the station.
+ * \param to The address of the next station.
+ * \param interval The interval between two packets.
+ * \param left The number of packets left to send.
+ */
+void
+SendPacket(Ptr<NetDevice> device, Address to, Time interval, uint32_t left)
+{
+    device->Send(Create<Packet>(1000), to, 0x0800);
+    if (left > 1)
+    {
+        Simulator::Schedule(interval, &SendPacket, device, to, interval, left - 1);
+    }
+}
+
+/**
+ * Run the scenario.
+ *
+ * \param nodes The number of stations.
+ * \param packets The number of packets sent by each station.
+ * \param sinks The number of sinks connected to each trace source.
+ * \param sink The sink.
+ * \return The wall clock time of the simulation, in milliseconds.
+ */
+int64_t
+RunScenario(uint32_t nodes, uint32_t packets, uint32_t sinks, BenchSink& sink)
+{
+    NodeContainer stations;
+    stations.Create(nodes);
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("OfdmRate54Mbps"));
+    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel.Create());
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    NetDeviceContainer devices = wifi.Install(phy, mac, stations);
+
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                  "DeltaX",
+                                  DoubleValue(5),
+                                  "DeltaY",
+                                  DoubleValue(5),
+                                  "GridWidth",
+                                  UintegerValue(5));
+    mobility.Install(stations);
+
+    const std::string device = "/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/";
+    for (uint32_t i = 0; i < sinks; ++i)
+    {
+        Config::ConnectWithoutContext(
+            device + "Phy/PhyTxBegin",
+            MakeCallback(&BenchSink::Count<Ptr<const Packet>, double>, &sink));
+        Config::ConnectWithoutContext(device + "Phy/PhyTxEnd",
+                                      MakeCallback(&BenchSink::Count<Ptr<const Packet>>, &sink));
+        Config::ConnectWithoutContext(device + "Phy/PhyRxEnd",
+                                      MakeCallback(&BenchSink::Count<Ptr<const Packet>>, &sink));
+        Config::ConnectWithoutContext(
+            device + "Phy/PhyRxDrop",
+            MakeCallback(&BenchSink::Count<Ptr<const Packet>, WifiPhyRxfailureReason>, &sink));
+        Config::ConnectWithoutContext(
+            device + "Phy/State/State",
+            MakeCallback(&BenchSink::Count<Time, Time, WifiPhyState>, &sink));
+        Config::ConnectWithoutContext(
+            device + "Phy/State/RxOk",
+            MakeCallback(&BenchSink::Count<Ptr<const Packet>, double, WifiMode, WifiPreamble>,
+                         &sink));
+        Config::ConnectWithoutContext(device + "Mac/MacTx",
+                                      MakeCallback(&BenchSink::Count<Ptr<const Packet>>, &sink));
+        Config::ConnectWithoutContext(device + "Mac/MacRx",
+                                      MakeCallback(&BenchSink::Count<Ptr<const Packet>>, &sink));
+    }
+
+    for (uint32_t i = 0; i < nodes; ++i)
+    {
+        Simulator::Schedule(MicroSeconds(100 + 37 * i),
+                            &SendPacket,
+                            devices.Get(i),
+                            devices.Get((i + 1) % nodes)->GetAddress(),
+                            MilliSeconds(2),
+                            packets);
+    }
+
+    SystemWallClockMs time;
+    time.Start();
+    Simulator::Run();
+    int64_t elapsed = time.End();
+    Simulator::Destroy();
+    return elapsed;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nodes = 20;
+    uint32_t packets = 2000;
+    uint32_t sinks = 4;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the trace sources and callbacks of a Wi-Fi network");
+    cmd.AddValue("nodes", "number of stations", nodes);
+    cmd.AddValue("packets", "number of packets sent by each station", packets);
+    cmd.AddValue("sinks", "number of sinks connected to each trace source", sinks);
+    cmd.Parse(argc, argv);
+
+    BenchSink none;
+    const auto base = RunScenario(nodes, packets, 0, none);
+    BenchSink sink;
+    const auto traced = RunScenario(nodes, packets, sinks, sink);
+
+    std::cout << std::setw(8) << "sinks" << std::setw(12) << "wall (ms)" << std::setw(14)
+              << "invocations" << std::setw(20) << "ns/invocation" << std::endl;
+    std::cout << std::setw(8) << 0 << std::setw(12) << base << std::setw(14) << none.m_count
+              << std::setw(20) << "-" << std::endl;
+    std::cout << std::setw(8) << sinks << std::setw(12) << traced << std::setw(14)
+              << sink.m_count << std::setw(20)
+              << (sink.m_count > 0 ? (traced - base) * 1e6 / sink.m_count : 0) << std::endl;
+    return 0;
+}
@@ -0,0 +1,55 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program converts a binary trace, written by the ascii trace helpers
+// when the AsciiTraceBinary global value is true, to the ascii trace format.
+// Sample usage:  ./ns3 run 'convert-binary-trace --input=trace.tr.bin --output=trace.tr'
+
+#include "ns3/binary-trace.h"
+#include "ns3/command-line.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    std::string input;
+    std::string output;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Convert a binary trace to the ascii trace format.\n"
+              "The packets are printed as their uid, size and digest.");
+    cmd.AddValue("input", "binary trace file", input);
+    cmd.AddValue("output", "ascii trace file, or empty for the standard output", output);
+    cmd.Parse(argc, argv);
+
+    if (input.empty())
+    {
+        std::cerr << "No input file, see --help" << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!output.empty())
+    {
+        file.open(output);
+        if (!file)
+        {
+            std::cerr << "Cannot open " << output << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& os = output.empty() ? std::cout : file;
+
+    if (!BinaryTraceReader::ConvertToText(input, os))
+    {
+        std::cerr << "Cannot read the binary trace " << input << std::endl;
+        return 1;
+    }
+    return 0;
+}